@@ -228,6 +228,15 @@ public:
         bench =       opts.parse("-bench", "learning speed benchmarking");
         learnStdp =   opts.parse("-learn-stdp", 0U, "number of STDP learning steps");
         presentTime =   opts.parse("-present-time", 1.0, "presentation time in Us");
+        eventsWheel = opts.parse("-events-wheel", "schedule the spiking events with a "
+                                                  "timing wheel instead of a heap");
+        eventsWheelResolution = opts.parse("-events-wheel-resolution", 0.0,
+                                           "timing wheel slot duration in Us "
+                                           "(default is the presentation time "
+                                           "/ 1024)");
+        partitions =  opts.parse("-partitions", 0U, "simulate the spiking "
+                                                    "network in parallel "
+                                                    "partitions of layers");
         avgWindow =   opts.parse("-ws", 10000U, "average window to compute success rate "
                                                 "during learning");
         testIndex =   opts.parse("-test-index", -1, "test a single specific stimulus index"
@@ -317,6 +326,9 @@ public:
     bool bench;
     unsigned int learnStdp;
     double presentTime;
+    bool eventsWheel;
+    double eventsWheelResolution;
+    unsigned int partitions;
     unsigned int avgWindow;
     int testIndex;
     int testId;
@@ -729,6 +741,7 @@ void findLearningRate(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
     const unsigned int nbBatch = std::ceil(opt.findLr / (double)batchSize);
     std::vector<std::pair<std::string, double> >* timings = NULL;
 
+    sp->startPrefetch(Database::Learn);
     sp->readRandomBatch(Database::Learn);
 
     std::vector<double> learningRate;
@@ -877,6 +890,7 @@ void findLearningRate(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
 
     // We are still in future batch, need to synchronize for the following
     sp->synchronize();
+    sp->stopPrefetch();
 
     std::cout << "Done!" << std::endl;
 }
@@ -899,6 +913,7 @@ void learn(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
     const unsigned int nbBatch = std::ceil(opt.learn / (double)batchSize);
     const unsigned int avgBatchWindow = opt.avgWindow / (double)batchSize;
 
+    sp->startPrefetch(Database::Learn);
     sp->readRandomBatch(Database::Learn);
 
     std::vector<std::pair<std::string, double> > timings, cumTimings;
@@ -1058,6 +1073,36 @@ void learn(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
                 deepNet->logTimings("timings/learning_timings.dat", cumTimings);
             }
 
+            if (sp->isPrefetching(Database::Learn)) {
+                const StimuliProvider::PrefetchStats stats
+                    = sp->getPrefetchStats();
+
+                std::cout << "Prefetch queue: " << std::setprecision(2)
+                    << stats.avgOccupancy << "/" << stats.depth
+                    << " ready batches on average, stall time: "
+                    << stats.consumerStallTime << " s (learning) / "
+                    << stats.producerStallTime << " s (prefetch)"
+                    << std::setprecision(4) << std::endl;
+            }
+
+            StimuliDataCache& dataCache = database->getDataCache();
+
+            if (dataCache.getCapacity() > 0) {
+                std::cout << "Data cache: " << dataCache.getNbEntries()
+                    << " entries (" << (dataCache.getSize() / 1024 / 1024)
+                    << "/" << (dataCache.getCapacity() / 1024 / 1024)
+                    << " MB), " << dataCache.getNbHits() << " hits, "
+                    << dataCache.getNbMisses() << " misses, "
+                    << dataCache.getNbEvictions() << " evictions"
+                    << std::endl;
+            }
+
+            if (!sp->getTransformationsProfile().empty()) {
+                Utils::createDirectories("timings");
+                sp->logTransformationsProfile(
+                    "timings/transformations_profile.csv");
+            }
+
             deepNet->logEstimatedLabels("learning");
             deepNet->log("learning", Database::Learn);
             deepNet->clear(Database::Learn);
@@ -1071,6 +1116,10 @@ void learn(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
                 std::cout << "Validation" << std::flush;
                 unsigned int progress = 0, progressPrev = 0;
 
+                // The prefetch producer shares the transformations and the
+                // database with the validation reads
+                sp->pausePrefetch();
+
                 // We are alread in sp->future(), read the first validation
                 // batch
                 sp->readBatch(Database::Validation, 0);
@@ -1102,6 +1151,8 @@ void learn(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
 
                 std::cout << std::endl;
 
+                sp->resumePrefetch();
+
                 // We are in sp->future(), must read the next batch for the 
                 // learning
                 sp->readRandomBatch(Database::Learn);
@@ -1320,6 +1371,7 @@ void learn(const Options& opt, std::shared_ptr<DeepNet>& deepNet) {
 
     // We are still in future batch, need to synchronize for the following
     sp->synchronize();
+    sp->stopPrefetch();
 }
 
 void learnStdp(const Options& opt, std::shared_ptr<DeepNet>& deepNet, 
@@ -1800,7 +1852,15 @@ int main(int argc, char* argv[]) try
     SGDSolver::mMaxSteps = opt.learn;
     SGDSolver::mLogSteps = opt.log;
 
-    Network net(opt.seed);
+    // The timing wheel resolution must be fine enough to spread the events of
+    // a presentation over many slots, which also spans 64 presentations with
+    // the default 65536 slots
+    const double wheelResolution = (opt.eventsWheelResolution > 0.0)
+        ? opt.eventsWheelResolution : opt.presentTime / 1024.0;
+
+    Network net(opt.seed, (opt.eventsWheel) ? Network::WheelScheduler
+                                            : Network::HeapScheduler,
+                std::max<Time_T>(1, (Time_T)(wheelResolution * TimeUs)));
     std::shared_ptr<DeepNet> deepNet
         = DeepNetGenerator::generate(net, opt.iniConfig);
     deepNet->initialize();
@@ -1987,6 +2047,9 @@ int main(int argc, char* argv[]) try
     if (!env)
         return 0;
 
+    if (opt.partitions > 0)
+        deepNet->setPartitioning(opt.partitions);
+
     // Spike-based testing
     Monitor monitorEnv(net);
     monitorEnv.add(env->getNodes());
@@ -0,0 +1,103 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_CELL_CSPIKE_H
+#define N2D2_CELL_CSPIKE_H
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Cell.hpp"
+#include "Cell_CSpike_Top.hpp"
+#include "controler/Interface.hpp"
+
+namespace N2D2 {
+
+class DeepNet;
+
+/**
+ * Base class of the clock-driven spiking cells computed on CPU.
+ *
+ * At each DeepNet::cTicks() timestep, the whole layer is processed at once
+ * with tick(): the inputs are the spikes (or analog values, with a
+ * CEnvironment without conversion) emitted during the current timestep by the
+ * CEnvironment or by the parent Cell_CSpike cells, and the outputs are the
+ * spikes emitted by the cell during the same timestep (-1, 0 or 1).
+*/
+class Cell_CSpike : public virtual Cell, public Cell_CSpike_Top {
+public:
+    Cell_CSpike(const DeepNet& deepNet, const std::string& name,
+                unsigned int nbOutputs);
+    virtual void addInput(StimuliProvider& sp,
+                          unsigned int channel,
+                          unsigned int x0,
+                          unsigned int y0,
+                          unsigned int width,
+                          unsigned int height,
+                          const Tensor<bool>& mapping = Tensor<bool>());
+    virtual void addInput(StimuliProvider& sp,
+                          unsigned int x0 = 0,
+                          unsigned int y0 = 0,
+                          unsigned int width = 0,
+                          unsigned int height = 0,
+                          const Tensor<bool>& mapping = Tensor<bool>());
+    virtual void addInput(Cell* cell,
+                          const Tensor<bool>& mapping = Tensor<bool>());
+    virtual void addInput(Cell* cell,
+                          unsigned int x0,
+                          unsigned int y0,
+                          unsigned int width = 0,
+                          unsigned int height = 0);
+    virtual void clearInputs();
+    virtual void reset(Time_T timestamp);
+    virtual Tensor<Float_T>& getOutputsActivity()
+    {
+        return mOutputsActivity;
+    };
+    virtual Tensor<Float_T>& getOutputs()
+    {
+        return mOutputs;
+    };
+    bool isCuda() const
+    {
+        return false;
+    }
+    virtual ~Cell_CSpike() {};
+
+protected:
+    void resizeOutputs(unsigned int batchSize);
+    /// Gather the non-zero inputs of the current timestep in mInputsSpikes
+    void gatherInputsSpikes();
+
+    // Forward
+    Interface<Float_T> mInputs;
+    /// Spikes emitted during the last timestep
+    Tensor<Float_T> mOutputs;
+    /// Sum of the spikes emitted since the last reset()
+    Tensor<Float_T> mOutputsActivity;
+    // mInputsSpikes[batch position] = list of (input index, value), where the
+    // input index runs over all the inputs concatenated along the channels
+    std::vector<std::vector<std::pair<unsigned int, Float_T> > >
+    mInputsSpikes;
+};
+}
+
+#endif // N2D2_CELL_CSPIKE_H
@@ -0,0 +1,68 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_CELL_FRAME_INT8_KERNELS_H
+#define N2D2_CELL_FRAME_INT8_KERNELS_H
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace N2D2 {
+
+// Conversions between the float tensors of the Frame cells and the 8 bits
+// integer operands of Gemm::gemmInt8(), for the Frame_INT8 cell models.
+// After DeepNetQuantization::quantizeNetwork(), the free parameters and the
+// activations hold integer values, stored in float.
+namespace Cell_Frame_INT8_Kernels {
+    /**
+     * Offset making the inputs unsigned 8 bits integers: 0 if they are all
+     * integers in [0, 255], 128 if they are all integers in [-128, 127] and
+     * -1 otherwise.
+    */
+    int getInputsOffset(const float* inputs, std::size_t size);
+
+    /**
+     * Convert the inputs to unsigned 8 bits integers, adding the offset
+     * returned by getInputsOffset().
+    */
+    void convertInputs(const float* inputs,
+                       std::size_t size,
+                       int offset,
+                       uint8_t* outputs);
+
+    /**
+     * Convert the weights to signed 8 bits integers. Return false if they
+     * are not all integers in [-128, 127].
+    */
+    bool convertWeights(const float* weights,
+                        std::size_t size,
+                        int8_t* outputs);
+
+    /**
+     * Convert the biases to 32 bits integers. Return false if they are not
+     * all integers in the 32 bits range.
+    */
+    bool convertBiases(const float* biases,
+                       std::size_t size,
+                       int32_t* outputs);
+}
+}
+
+#endif // N2D2_CELL_FRAME_INT8_KERNELS_H
@@ -59,6 +59,29 @@ public:
                           unsigned int height = 0);
     
     virtual void clearInputs();
+    /**
+     * Set the partition of this cell, for Network::setPartitioning(). The
+     * input and output nodes of the cell are assigned to @p partition. A
+     * spike from a node of another partition is handed to the cell through
+     * an event, delayed by the minimum synaptic delay of the cell (see
+     * getMinDelay()), which is subtracted back from the synaptic delays, so
+     * that the lookahead can be as large as this delay. The minimum is taken
+     * when this method is called, after the synapses are initialized or
+     * loaded.
+    */
+    void setPartition(unsigned int partition);
+    /// Returns true if an input of the cell comes from another partition
+    bool isPartitionBoundary() const;
+    /// Returns the minimum synaptic delay of the cell, 0 if unknown
+    virtual Time_T getMinDelay() const
+    {
+        return 0;
+    };
+    /// Returns the delay of the spikes received from another partition
+    Time_T getPartitionDelay() const
+    {
+        return mPartitionDelay;
+    };
 
     inline virtual void
     propagateSpike(NodeIn* node, Time_T timestamp, EventType_T type = 0);
@@ -87,6 +110,7 @@ protected:
 
     // Internal
     Network& mNet;
+    Time_T mPartitionDelay;
     // Forward
     std::vector<NodeIn*> mInputs;
     Tensor<NodeOut*> mOutputs;
@@ -0,0 +1,156 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_CONVCELL_CSPIKE_H
+#define N2D2_CONVCELL_CSPIKE_H
+
+#include "Cell_CSpike.hpp"
+#include "ConvCell.hpp"
+#include "DeepNet.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven convolutional layer of integrate-and-fire neurons, computed on
+ * CPU.
+ *
+ * The state of the neurons is kept in dense tensors. At each tick, the
+ * membrane potentials are leaked, the weights of the inputs that spiked are
+ * scattered to the output neurons (in parallel across the batch and the
+ * output channels), the bias is integrated and the neurons above the
+ * threshold fire.
+*/
+class ConvCell_CSpike : public virtual ConvCell, public Cell_CSpike {
+public:
+    ConvCell_CSpike(const DeepNet& deepNet,
+                    const std::string& name,
+                    const std::vector<unsigned int>& kernelDims,
+                    unsigned int nbOutputs,
+                    const std::vector<unsigned int>& subSampleDims
+                        = std::vector<unsigned int>(2, 1U),
+                    const std::vector<unsigned int>& strideDims
+                        = std::vector<unsigned int>(2, 1U),
+                    const std::vector<int>& paddingDims
+                        = std::vector<int>(2, 0),
+                    const std::vector<unsigned int>& dilationDims
+                        = std::vector<unsigned int>(2, 1U));
+    static std::shared_ptr<ConvCell>
+    create(Network& /*net*/, const DeepNet& deepNet,
+           const std::string& name,
+           const std::vector<unsigned int>& kernelDims,
+           unsigned int nbOutputs,
+           const std::vector<unsigned int>& subSampleDims
+                = std::vector<unsigned int>(2, 1U),
+           const std::vector<unsigned int>& strideDims
+                = std::vector<unsigned int>(2, 1U),
+           const std::vector<int>& paddingDims
+                = std::vector<int>(2, 0),
+           const std::vector<unsigned int>& dilationDims
+                = std::vector<unsigned int>(2, 1U),
+           const std::shared_ptr<Activation>& /*activation*/
+           = std::shared_ptr<Activation>())
+    {
+        return std::make_shared<ConvCell_CSpike>(deepNet,
+                                                 name,
+                                                 kernelDims,
+                                                 nbOutputs,
+                                                 subSampleDims,
+                                                 strideDims,
+                                                 paddingDims,
+                                                 dilationDims);
+    }
+
+    virtual void setExtendedPadding(const std::vector<int>& paddingDims);
+    virtual void initialize();
+    virtual bool tick(Time_T timestamp);
+    virtual void reset(Time_T timestamp);
+    inline void getWeight(unsigned int output,
+                          unsigned int channel,
+                          BaseTensor& value) const;
+    inline void getBias(unsigned int output, BaseTensor& value) const;
+    void saveFreeParameters(const std::string& fileName) const;
+    void loadFreeParameters(const std::string& fileName,
+                            bool ignoreNotExists = false);
+    virtual ~ConvCell_CSpike() {};
+
+protected:
+    inline void setWeight(unsigned int output,
+                          unsigned int channel,
+                          const BaseTensor& value);
+    inline void setBias(unsigned int output, const BaseTensor& value);
+
+    /// Threshold of the neuron \f$I_{thres}\f$
+    Parameter<double> mThreshold;
+    Parameter<bool> mBipolarThreshold;
+    /// Neural leak time constant \f$\tau_{leak}\f$ (if 0, no leak)
+    Parameter<Time_T> mLeak;
+    /// Neural refractory period \f$T_{refrac}\f$
+    Parameter<Time_T> mRefractory;
+
+    // mSharedSynapses(sx, sy, input channel, output feature map)
+    Tensor<Float_T> mSharedSynapses;
+    Tensor<Float_T> mBias;
+
+    Tensor<Float_T> mOutputsIntegration;
+    Tensor<Time_T> mOutputsRefractoryEnd;
+    Time_T mLastTick;
+
+private:
+    static Registrar<ConvCell> mRegistrar;
+};
+}
+
+void N2D2::ConvCell_CSpike::setWeight(unsigned int output,
+                                      unsigned int channel,
+                                      const BaseTensor& value)
+{
+    if (value.nbDims() < mKernelDims.size()) {
+        Tensor<Float_T> valueND = tensor_cast<Float_T>(value);
+        valueND.reshape({mKernelDims[0], mKernelDims[1]});
+        mSharedSynapses[output][channel] = valueND;
+    }
+    else
+        mSharedSynapses[output][channel] = tensor_cast<Float_T>(value);
+}
+
+void N2D2::ConvCell_CSpike::getWeight(unsigned int output,
+                                      unsigned int channel,
+                                      BaseTensor& value) const
+{
+    value.resize({mKernelDims[0], mKernelDims[1]});
+    value = mSharedSynapses[output][channel];
+}
+
+void N2D2::ConvCell_CSpike::setBias(unsigned int output,
+                                    const BaseTensor& value)
+{
+    if (mBias.empty())
+        mBias.resize({getNbOutputs()}, 0.0);
+
+    mBias(output) = tensor_cast<Float_T>(value)(0);
+}
+
+void N2D2::ConvCell_CSpike::getBias(unsigned int output,
+                                    BaseTensor& value) const
+{
+    value.resize({1});
+    value = Tensor<Float_T>({1}, mBias(output));
+}
+
+#endif // N2D2_CONVCELL_CSPIKE_H
@@ -101,6 +101,8 @@ public:
     };
     inline BaseInterface* getWeights()
     {
+        // The weights may be modified through the returned interface
+        invalidateWinogradFilters();
         return &mSharedSynapses;
     };
     void setWeights(unsigned int k,
@@ -119,6 +121,11 @@ public:
                                      " invalid type");
         }
     }
+    inline void invalidateWinogradFilters()
+    {
+        for (unsigned int k = 0; k < mWinogradFilters.size(); ++k)
+            mWinogradFilters[k].valid = false;
+    }
     void checkGradient(double epsilon = 1.0e-4, double maxError = 1.0e-6);
     void saveFreeParameters(const std::string& fileName) const;
     void loadFreeParameters(const std::string& fileName,
@@ -146,7 +153,11 @@ protected:
         }
         else
             sharedSynapses[output][channel] = tensor_cast<T>(value);
+
+        invalidateWinogradFilters();
     }
+    ConvCell_Frame_Kernels::WinogradFilters<T>* getWinogradFilters(
+        unsigned int k);
     inline void setBias(unsigned int output, const BaseTensor& value)
     {
         if (!mNoBias && mBias->empty())
@@ -155,6 +166,9 @@ protected:
         (*mBias)(output) = tensor_cast<T>(value)(0);
     };
 
+    /// Convolution algorithm (Auto, Direct, GEMM, Winograd2x2 or Winograd4x4)
+    Parameter<ConvCell_Frame_Kernels::Algorithm> mAlgorithm;
+
     // Internal
     std::vector<std::shared_ptr<Solver> > mWeightsSolvers;
     Interface<T> mSharedSynapses;
@@ -164,6 +178,8 @@ protected:
     Interface<T> mDiffSharedSynapses;
     Tensor<T> mDiffBias;
     ConvCell_Frame_Kernels::Descriptor mConvDesc;
+    ConvCell_Frame_Kernels::Workspace<T> mWorkspace;
+    std::vector<ConvCell_Frame_Kernels::WinogradFilters<T> > mWinogradFilters;
 
 private:
     static Registrar<ConvCell> mRegistrar;
@@ -23,25 +23,50 @@
 
 #include <vector>
 #include "containers/Tensor.hpp"
+#include "utils/Utils.hpp"
 
 namespace N2D2 {
 
 namespace ConvCell_Frame_Kernels {
+    enum Algorithm {
+        // GEMM when the layer allows it, Direct otherwise
+        Auto,
+        // Reference direct convolution, supports every configuration
+        Direct,
+        // im2col/col2im + packed GEMM. Falls back to Direct for sparse
+        // connectivity maps and subsampling.
+        GEMM,
+        // Winograd F(2x2,3x3) and F(4x4,3x3) fast convolution, for 3x3
+        // kernels with stride 1 in float or double. Falls back to GEMM
+        // otherwise. F(4x4,3x3) needs less multiplications per output (2.25
+        // instead of 4 for F(2x2,3x3), vs. 9 for direct) but is less
+        // accurate.
+        Winograd2x2,
+        Winograd4x4
+    };
+
+    // Required for Parameter<Algorithm>
+    using ::operator<<;
+    using ::operator>>;
+
     struct Descriptor {
         const std::vector<unsigned int> subSample;
         const std::vector<unsigned int> stride;
         // left, top, right, bottom (if 2D)
         std::vector<int> padding;
         const std::vector<unsigned int> dilation;
+        Algorithm algorithm;
 
         Descriptor(const std::vector<unsigned int>& subSample_,
                    const std::vector<unsigned int>& stride_,
                    const std::vector<int>& padding_,
-                   const std::vector<unsigned int>& dilation_)
+                   const std::vector<unsigned int>& dilation_,
+                   Algorithm algorithm_ = Auto)
             : subSample(subSample_),
               stride(stride_),
               padding(padding_),
-              dilation(dilation_)
+              dilation(dilation_),
+              algorithm(algorithm_)
         {
             if (padding.size() == stride.size()) {
                 // Duplicate left, top padding for right, bottom padding
@@ -51,6 +76,28 @@ namespace ConvCell_Frame_Kernels {
         }
     };
 
+    // Scratch buffers of the GEMM algorithm, one per OpenMP thread. Keeping
+    // it in the cell avoids re-allocating the buffers at each call.
+    template <class T>
+    struct Workspace {
+        std::vector<std::vector<T> > columns;
+        std::vector<std::vector<T> > packing;
+    };
+
+    // Winograd transformed filters, computed on first use. valid should be
+    // set to false each time the untransformed filters are modified. The
+    // filters are recomputed anyway if the untransformed filters differ from
+    // the copy in weights.
+    template <class T>
+    struct WinogradFilters {
+        std::vector<T> weights;
+        std::vector<T> forward;
+        std::vector<T> backwardData;
+        bool valid;
+
+        WinogradFilters() : valid(false) {}
+    };
+
     // Forward
     template <class T>
     void forward(const T* alpha,
@@ -59,7 +106,9 @@ namespace ConvCell_Frame_Kernels {
                  const Descriptor& desc,
                  const T* beta,
                  Tensor<T>& outputs,
-                 const Tensor<bool>& maps = Tensor<bool>());
+                 const Tensor<bool>& maps = Tensor<bool>(),
+                 Workspace<T>* workspace = NULL,
+                 WinogradFilters<T>* winogradFilters = NULL);
     template <class T>
     void forwardBias(const T* alpha,
                      const Tensor<T>& bias,
@@ -74,7 +123,9 @@ namespace ConvCell_Frame_Kernels {
                       const Descriptor& desc,
                       const T* beta,
                       Tensor<T>& diffOutputs,
-                      const Tensor<bool>& maps = Tensor<bool>());
+                      const Tensor<bool>& maps = Tensor<bool>(),
+                      Workspace<T>* workspace = NULL,
+                      WinogradFilters<T>* winogradFilters = NULL);
     template <class T>
     void backwardFilter(const T* alpha,
                         const Tensor<T>& inputs,
@@ -82,7 +133,8 @@ namespace ConvCell_Frame_Kernels {
                         const Descriptor& desc,
                         const T* beta,
                         Tensor<T>& diffSharedSynapses,
-                        const Tensor<bool>& maps = Tensor<bool>());
+                        const Tensor<bool>& maps = Tensor<bool>(),
+                        Workspace<T>* workspace = NULL);
     template <class T>
     void backwardBias(const T* alpha,
                       const Tensor<T>& diffInputs,
@@ -91,4 +143,11 @@ namespace ConvCell_Frame_Kernels {
 }
 }
 
+namespace {
+template <>
+const char* const EnumStrings
+    <N2D2::ConvCell_Frame_Kernels::Algorithm>::data[]
+    = {"Auto", "Direct", "GEMM", "Winograd2x2", "Winograd4x4"};
+}
+
 #endif // N2D2_CONVCELL_FRAME_KERNELS_H
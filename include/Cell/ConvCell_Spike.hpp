@@ -24,6 +24,7 @@
 #include "Cell_Spike.hpp"
 #include "ConvCell.hpp"
 #include "DeepNet.hpp"
+#include "SynapseStore_Static.hpp"
 #include "Synapse_Behavioral.hpp"
 
 namespace N2D2 {
@@ -77,6 +78,10 @@ public:
     propagateSpike(NodeIn* node, Time_T timestamp, EventType_T type = 0);
     virtual void
     incomingSpike(NodeIn* node, Time_T timestamp, EventType_T type = 0);
+    virtual Time_T getMinDelay() const
+    {
+        return mPackedSynapses.getMinDelay();
+    };
     virtual void notify(Time_T timestamp, NotifyType notify);
     inline void getWeight(unsigned int output,
                           unsigned int channel,
@@ -118,6 +123,10 @@ protected:
                             bool negative) const;
     inline std::tuple<unsigned int, unsigned int, unsigned int, bool>
     unmaps(EventType_T type) const;
+    inline size_t synapseIndex(unsigned int sx,
+                               unsigned int sy,
+                               unsigned int channel,
+                               unsigned int output) const;
 
     /// Relative initial synaptic weight \f$w_{init}\f$
     ParameterWithSpread<Weight_T> mWeightsRelInit;
@@ -129,10 +138,16 @@ protected:
     Parameter<Time_T> mLeak;
     /// Neural refractory period \f$T_{refrac}\f$
     Parameter<Time_T> mRefractory;
+    /// If false, the number of read events of the synapses is not counted
+    /// (only for Synapse_Static synapses)
+    Parameter<bool> mSynapticStats;
 
     // mSharedSynapses[output feature map][input channel][synapse, in a 2D
     // matrix = convolution kernel]
+    // Only used for the synapse models other than Synapse_Static, which are
+    // packed in mPackedSynapses instead, in the same order.
     Tensor<Synapse*> mSharedSynapses;
+    SynapseStore_Static mPackedSynapses;
 
     Tensor<Time_T> mOutputsLastIntegration;
     Tensor<double> mOutputsIntegration;
@@ -156,24 +171,44 @@ void N2D2::ConvCell_Spike::setWeight(unsigned int output,
                                      unsigned int channel,
                                      const BaseTensor& value)
 {
-    Tensor<Synapse*> sharedSynapses = mSharedSynapses[output][channel];
-    assert(value.dims() == sharedSynapses.dims());
-
     const Tensor<Float_T>& kernel = tensor_cast<Float_T>(value);
 
-    for (size_t index = 0; index < value.size(); ++index)
-        sharedSynapses(index)->setRelativeWeight(kernel(index));
+    if (!mPackedSynapses.empty()) {
+        assert(value.size() == mKernelDims[0] * mKernelDims[1]);
+
+        const size_t offset = synapseIndex(0, 0, channel, output);
+
+        for (size_t index = 0; index < value.size(); ++index)
+            mPackedSynapses.setRelativeWeight(offset + index, kernel(index));
+    } else {
+        Tensor<Synapse*> sharedSynapses = mSharedSynapses[output][channel];
+        assert(value.dims() == sharedSynapses.dims());
+
+        for (size_t index = 0; index < value.size(); ++index)
+            sharedSynapses(index)->setRelativeWeight(kernel(index));
+    }
 }
 
 void N2D2::ConvCell_Spike::getWeight(unsigned int output,
                                      unsigned int channel,
                                      BaseTensor& value) const
 {
-    const Tensor<Synapse*>& sharedSynapses = mSharedSynapses[output][channel];
-    Tensor<Float_T> values(sharedSynapses.dims());
+    Tensor<Float_T> values({mKernelDims[0], mKernelDims[1]});
 
-    for (size_t index = 0; index < values.size(); ++index)
-        values(index) = sharedSynapses(index)->getRelativeWeight(true);
+    if (!mPackedSynapses.empty()) {
+        const size_t offset = synapseIndex(0, 0, channel, output);
+
+        for (size_t index = 0; index < values.size(); ++index) {
+            values(index)
+                = mPackedSynapses.getRelativeWeight(offset + index, true);
+        }
+    } else {
+        const Tensor<Synapse*>& sharedSynapses
+            = mSharedSynapses[output][channel];
+
+        for (size_t index = 0; index < values.size(); ++index)
+            values(index) = sharedSynapses(index)->getRelativeWeight(true);
+    }
 
     value.resize(values.dims());
     value = values;
@@ -201,4 +236,13 @@ N2D2::ConvCell_Spike::unmaps(EventType_T type) const
         type & 1);
 }
 
+size_t N2D2::ConvCell_Spike::synapseIndex(unsigned int sx,
+                                          unsigned int sy,
+                                          unsigned int channel,
+                                          unsigned int output) const
+{
+    return sx + mKernelDims[0]
+        * (sy + mKernelDims[1] * (channel + getNbChannels() * output));
+}
+
 #endif // N2D2_CONVCELL_SPIKE_H
@@ -24,6 +24,7 @@
 #include "Cell_Frame.hpp"
 #include "DeepNet.hpp"
 #include "FMPCell.hpp"
+#include "PoolCell_Frame_Kernels_struct.hpp"
 
 namespace N2D2 {
 class FMPCell_Frame : public virtual FMPCell, public Cell_Frame<Float_T> {
@@ -58,13 +59,18 @@ protected:
     void generateRegions(std::vector<unsigned int>& grid,
                          unsigned int sizeIn,
                          unsigned int sizeOut);
+    void getRegion(const std::vector<unsigned int>& grid,
+                   unsigned int sizeIn,
+                   unsigned int o,
+                   unsigned int& iStart,
+                   unsigned int& iStop) const;
 
     std::vector<unsigned int> mGridX;
     std::vector<unsigned int> mGridY;
 
-    // mInputsBackProp (ix, iy, channel, batchPos)
-    // list of the output node(s) to backpropagate from] (for Max pooling)
-    Tensor<std::vector<unsigned int> > mInputsBackProp;
+    // mArgMax (ox, oy, output, batchPos)
+    // input node selected by each output node (for Max pooling)
+    Tensor<PoolCell_Frame_Kernels::ArgMax> mArgMax;
     bool mLockRandom;
 
 private:
@@ -0,0 +1,104 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_FCCELL_CSPIKE_H
+#define N2D2_FCCELL_CSPIKE_H
+
+#include "Cell_CSpike.hpp"
+#include "DeepNet.hpp"
+#include "FcCell.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven fully connected layer of integrate-and-fire neurons, computed
+ * on CPU. Same neuron model as ConvCell_CSpike.
+*/
+class FcCell_CSpike : public virtual FcCell, public Cell_CSpike {
+public:
+    FcCell_CSpike(const DeepNet& deepNet, const std::string& name,
+                  unsigned int nbOutputs);
+    static std::shared_ptr<FcCell> create(Network& /*net*/,
+                                          const DeepNet& deepNet,
+                                          const std::string& name,
+                                          unsigned int nbOutputs,
+                                          const std::shared_ptr
+                                          <Activation>& /*activation*/
+                                          = std::shared_ptr
+                                          <Activation>())
+    {
+        return std::make_shared<FcCell_CSpike>(deepNet, name, nbOutputs);
+    }
+
+    virtual void initialize();
+    virtual bool tick(Time_T timestamp);
+    virtual void reset(Time_T timestamp);
+    inline void getWeight(unsigned int output, unsigned int channel,
+                          BaseTensor& value) const
+    {
+        value.resize({1});
+        value = Tensor<Float_T>({1}, mSynapses(channel, output));
+    };
+    inline void getBias(unsigned int output, BaseTensor& value) const
+    {
+        value.resize({1});
+        value = Tensor<Float_T>({1}, mBias(output));
+    };
+    void saveFreeParameters(const std::string& fileName) const;
+    void loadFreeParameters(const std::string& fileName,
+                            bool ignoreNotExists = false);
+    virtual ~FcCell_CSpike() {};
+
+protected:
+    inline void setWeight(unsigned int output, unsigned int channel,
+                          const BaseTensor& value)
+    {
+        mSynapses(channel, output) = tensor_cast<Float_T>(value)(0);
+    };
+    inline void setBias(unsigned int output, const BaseTensor& value)
+    {
+        if (mBias.empty())
+            mBias.resize({getNbOutputs()}, 0.0);
+
+        mBias(output) = tensor_cast<Float_T>(value)(0);
+    };
+
+    /// Threshold of the neuron \f$I_{thres}\f$
+    Parameter<double> mThreshold;
+    Parameter<bool> mBipolarThreshold;
+    /// Neural leak time constant \f$\tau_{leak}\f$ (if 0, no leak)
+    Parameter<Time_T> mLeak;
+    /// Neural refractory period \f$T_{refrac}\f$
+    Parameter<Time_T> mRefractory;
+
+    // mSynapses(input, output), with the inputs concatenated along the
+    // channels
+    Tensor<Float_T> mSynapses;
+    Tensor<Float_T> mBias;
+
+    Tensor<Float_T> mOutputsIntegration;
+    Tensor<Time_T> mOutputsRefractoryEnd;
+    Time_T mLastTick;
+
+private:
+    static Registrar<FcCell> mRegistrar;
+};
+}
+
+#endif // N2D2_FCCELL_CSPIKE_H
@@ -96,6 +96,7 @@ protected:
 
     Interface<bool> mDropConnectMask;
     bool mLockRandom;
+    std::vector<std::vector<T> > mGemmWorkspaces;
 
 private:
     static Registrar<FcCell> mRegistrar;
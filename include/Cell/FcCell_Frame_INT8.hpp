@@ -0,0 +1,94 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_FCCELL_FRAME_INT8_H
+#define N2D2_FCCELL_FRAME_INT8_H
+
+#include <stdint.h>
+
+#include "FcCell_Frame.hpp"
+
+namespace N2D2 {
+/**
+ * Integer inference model of FcCell_Frame<float>, for networks quantized
+ * with DeepNetQuantization on 8 bits or less: the weights and the inputs are
+ * converted to 8 bits integers and the products are accumulated in 32 bits
+ * integers. Learning, and the inference of a cell that is not quantized,
+ * use the FcCell_Frame<float> implementation.
+*/
+class FcCell_Frame_INT8 : public FcCell_Frame<float> {
+public:
+    FcCell_Frame_INT8(const DeepNet& deepNet, const std::string& name,
+                      unsigned int nbOutputs,
+                      const std::shared_ptr<Activation>& activation
+                      = std::make_shared<TanhActivation_Frame<float> >());
+    static std::shared_ptr<FcCell> create(Network& /*net*/, const DeepNet& deepNet, 
+                                          const std::string& name,
+                                          unsigned int nbOutputs,
+                                          const std::shared_ptr
+                                          <Activation>& activation
+                                          = std::make_shared
+                                          <TanhActivation_Frame<float> >())
+    {
+        return std::make_shared<FcCell_Frame_INT8>(deepNet, name, nbOutputs,
+                                                   activation);
+    }
+
+    virtual void initialize();
+    virtual void propagate(bool inference = false);
+    virtual void update();
+    virtual void loadFreeParameters(const std::string& fileName,
+                                    bool ignoreNotExists = false);
+    virtual ~FcCell_Frame_INT8() {};
+
+protected:
+    virtual void setWeight(unsigned int output, unsigned int channel,
+                           const BaseTensor& value);
+    virtual void setBias(unsigned int output, const BaseTensor& value);
+
+    /**
+     * Integer forward computation. Return false, without modifying the
+     * outputs, if the weights or the inputs are not 8 bits integers.
+    */
+    bool propagateInt8();
+    /**
+     * Convert the weights and the biases to integers. Return false if they
+     * are not 8 bits and 32 bits integers respectively.
+    */
+    bool convertFreeParameters();
+
+    // Integer weights, their sum for each output and integer biases. They
+    // are converted once and kept until the free parameters are modified.
+    std::vector<std::vector<int8_t> > mWeightsInt8;
+    std::vector<std::vector<int32_t> > mWeightsInt8Sums;
+    std::vector<int32_t> mBiasesInt8;
+    bool mFreeParametersInt8Valid;
+    bool mFreeParametersInt8;
+    // Integer inputs, for each input tensor
+    std::vector<std::vector<uint8_t> > mInputsInt8;
+    // outputs x batch accumulators
+    std::vector<int32_t> mAccumulators;
+
+private:
+    static Registrar<FcCell> mRegistrar;
+};
+}
+
+#endif // N2D2_FCCELL_FRAME_INT8_H
@@ -26,6 +26,7 @@
 #include "Cell_Spike.hpp"
 #include "DeepNet.hpp"
 #include "FcCell.hpp"
+#include "SynapseStore_Static.hpp"
 #include "containers/Tensor.hpp"
 
 
@@ -52,6 +53,10 @@ public:
     propagateSpike(NodeIn* node, Time_T timestamp, EventType_T type = 0);
     virtual void
     incomingSpike(NodeIn* node, Time_T timestamp, EventType_T type = 0);
+    virtual Time_T getMinDelay() const
+    {
+        return mPackedSynapses.getMinDelay();
+    };
     virtual void notify(Time_T timestamp, NotifyType notify);
     inline void getWeight(unsigned int output, unsigned int channel,
                           BaseTensor& value) const;
@@ -80,6 +85,14 @@ protected:
     {
         return std::make_pair(type >> 1, type & 1);
     };
+    size_t synapseIndex(unsigned int x,
+                        unsigned int y,
+                        unsigned int channel,
+                        unsigned int output) const
+    {
+        return x + mInputsDims[0]
+            * (y + mInputsDims[1] * (channel + mInputsDims[2] * output));
+    };
 
     /// Relative initial synaptic weight \f$w_{init}\f$
     ParameterWithSpread<Weight_T> mWeightsRelInit;
@@ -93,9 +106,15 @@ protected:
     Parameter<Time_T> mRefractory;
     Parameter<unsigned int> mTerminateDelta;
     Parameter<unsigned int> mTerminateMax;
+    /// If false, the number of read events of the synapses is not counted
+    /// (only for Synapse_Static synapses)
+    Parameter<bool> mSynapticStats;
 
     // mSynapses[output node][input node]
+    // Only used for the synapse models other than Synapse_Static, which are
+    // packed in mPackedSynapses instead, in the same order.
     Tensor<Synapse*> mSynapses;
+    SynapseStore_Static mPackedSynapses;
 
     std::vector<Time_T> mOutputsLastIntegration;
     std::vector<double> mOutputsIntegration;
@@ -112,7 +131,12 @@ void N2D2::FcCell_Spike::setWeight(unsigned int output,
                                    const BaseTensor& value)
 {
     const Tensor<Float_T>& weight = tensor_cast<Float_T>(value);
-    mSynapses(channel, output)->setRelativeWeight(weight(0));
+
+    if (!mPackedSynapses.empty()) {
+        mPackedSynapses.setRelativeWeight(
+            channel + getInputsSize() * output, weight(0));
+    } else
+        mSynapses(channel, output)->setRelativeWeight(weight(0));
 }
 
 void N2D2::FcCell_Spike::getWeight(unsigned int output,
@@ -120,8 +144,10 @@ void N2D2::FcCell_Spike::getWeight(unsigned int output,
                                    BaseTensor& value) const
 {
     value.resize({1});
-    value = Tensor<Float_T>({1},
-                        mSynapses(channel, output)->getRelativeWeight(true));
+    value = Tensor<Float_T>({1}, (!mPackedSynapses.empty())
+        ? mPackedSynapses.getRelativeWeight(
+            channel + getInputsSize() * output, true)
+        : mSynapses(channel, output)->getRelativeWeight(true));
 }
 
 #endif // N2D2_FCCELL_SPIKE_H
@@ -34,6 +34,8 @@ public:
     NodeIn(Network& net, Cell_Spike& cell, unsigned int channel);
     void addLink(Node* origin);
     inline void
+    propagateSpike(Node* origin, Time_T timestamp, EventType_T type = 0);
+    inline void
     incomingSpike(Node* origin, Time_T timestamp, EventType_T type = 0);
     inline void emitSpike(Time_T timestamp, EventType_T type = 0);
     Cell_Spike& getCell() const
@@ -58,11 +60,25 @@ private:
 };
 }
 
+void N2D2::NodeIn::propagateSpike(Node* origin,
+                                  Time_T timestamp,
+                                  EventType_T type)
+{
+    if (origin->getPartition() == mPartition)
+        mCell.propagateSpike(this, timestamp, type);
+    else {
+        // The cell is processed by another partition, which receives the
+        // spike through an event (see Cell_Spike::setPartition())
+        mNet.newEvent(
+            origin, this, timestamp + mCell.getPartitionDelay(), type);
+    }
+}
+
 void N2D2::NodeIn::incomingSpike(Node* /*origin*/,
                                  Time_T timestamp,
                                  EventType_T type)
 {
-    mCell.propagateSpike(this, timestamp, type);
+    mCell.propagateSpike(this, timestamp - mCell.getPartitionDelay(), type);
 }
 
 void N2D2::NodeIn::emitSpike(Time_T timestamp, EventType_T type)
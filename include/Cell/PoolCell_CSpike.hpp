@@ -0,0 +1,91 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_POOLCELL_CSPIKE_H
+#define N2D2_POOLCELL_CSPIKE_H
+
+#include "Cell_CSpike.hpp"
+#include "DeepNet.hpp"
+#include "PoolCell.hpp"
+
+namespace N2D2 {
+/**
+ * Clock-driven pooling layer, computed on CPU.
+ *
+ * The activity (sum of the spikes) of each input is accumulated. At each tick,
+ * the target activity of each output is computed over its pooling window:
+ * the max. input activity for Max pooling, and the rounded average input
+ * activity for Average pooling. The output emits a spike (positive or
+ * negative) whenever its own activity lags the target by at least one spike.
+*/
+class PoolCell_CSpike : public virtual PoolCell, public Cell_CSpike {
+public:
+    PoolCell_CSpike(const DeepNet& deepNet,
+                    const std::string& name,
+                    const std::vector<unsigned int>& poolDims,
+                    unsigned int nbOutputs,
+                    const std::vector<unsigned int>& strideDims
+                       = std::vector<unsigned int>(2, 1U),
+                    const std::vector<unsigned int>& paddingDims
+                       = std::vector<unsigned int>(2, 0),
+                    Pooling pooling = Max);
+    static std::shared_ptr<PoolCell>
+    create(Network& /*net*/,
+           const DeepNet& deepNet,
+           const std::string& name,
+           const std::vector<unsigned int>& poolDims,
+           unsigned int nbOutputs,
+           const std::vector<unsigned int>& strideDims
+              = std::vector<unsigned int>(2, 1U),
+           const std::vector<unsigned int>& paddingDims
+              = std::vector<unsigned int>(2, 0),
+           Pooling pooling = Max,
+           const std::shared_ptr<Activation>& /*activation*/
+           = std::shared_ptr<Activation>())
+    {
+        return std::make_shared<PoolCell_CSpike>(deepNet,
+                                                 name,
+                                                 poolDims,
+                                                 nbOutputs,
+                                                 strideDims,
+                                                 paddingDims,
+                                                 pooling);
+    }
+
+    virtual void setExtendedPadding(const std::vector<int>& paddingDims);
+    virtual void initialize();
+    virtual bool tick(Time_T timestamp);
+    virtual void reset(Time_T timestamp);
+    virtual ~PoolCell_CSpike() {};
+
+protected:
+    // Sum of the input spikes since the last reset(), with the inputs
+    // concatenated along the channels
+    Tensor<Float_T> mInputsActivity;
+    // mPoolNbChannels[output channel] -> number of input channels connected to
+    // this output channel
+    std::vector<unsigned int> mPoolNbChannels;
+
+private:
+    static Registrar<PoolCell> mRegistrar;
+};
+}
+
+#endif // N2D2_POOLCELL_CSPIKE_H
@@ -22,6 +22,7 @@
 #define N2D2_DATAFILE_H
 
 #include <memory>
+#include <stdexcept>
 
 #ifdef OPENCV_USE_OLD_HEADERS       //  before OpenCV 2.2.0
     #include "cv.h"
@@ -52,7 +53,30 @@ public:
         return rMap;
     }
 
+    /// Reduced-resolution decoding of a file, returned by getReduction()
+    struct Reduction {
+        Reduction(unsigned int factor_ = 1U, int flags_ = 0)
+            : factor(factor_), flags(flags_)
+        {
+        }
+
+        /// Reduction factor of the decoded size
+        unsigned int factor;
+        /// Decoding flags, specific to the DataFile
+        int flags;
+    };
+
     virtual cv::Mat read(const std::string& fileName) = 0;
+    /// Return the largest factor by which @p fileName can be decoded at
+    /// reduced resolution, with a decoded size of at least @p minSize
+    /// (1 if reduced-resolution decoding is not supported)
+    virtual Reduction getReduction(const std::string& /*fileName*/,
+                                   const cv::Size& /*minSize*/)
+        { return Reduction(); }
+    /// Read @p fileName decoded at reduced resolution, with @p reduction
+    /// returned by getReduction() (the file is not parsed again)
+    virtual cv::Mat readReduced(const std::string& fileName,
+                                const Reduction& reduction);
     virtual cv::Mat readLabel(const std::string& /*fileName*/)
         { return cv::Mat(); }
     virtual void write(const std::string& fileName, const cv::Mat& data) = 0;
@@ -60,4 +84,16 @@ public:
 };
 }
 
+inline cv::Mat N2D2::DataFile::readReduced(const std::string& fileName,
+                                           const Reduction& reduction)
+{
+    if (reduction.factor != 1) {
+        throw std::runtime_error("DataFile::readReduced(): reduced-resolution"
+                                 " decoding is not supported for: "
+                                 + fileName);
+    }
+
+    return read(fileName);
+}
+
 #endif // N2D2_DATAFILE_H
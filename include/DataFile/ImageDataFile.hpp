@@ -34,6 +34,12 @@ public:
     }
 
     virtual cv::Mat read(const std::string& fileName);
+    /// Reduced-resolution decoding is supported for 8 bits JPEG files, with
+    /// a factor of 2, 4 or 8 (DCT-domain downscaling)
+    virtual Reduction getReduction(const std::string& fileName,
+                                   const cv::Size& minSize);
+    virtual cv::Mat readReduced(const std::string& fileName,
+                                const Reduction& reduction);
     virtual void write(const std::string& fileName, const cv::Mat& data);
     virtual ~ImageDataFile() {};
 
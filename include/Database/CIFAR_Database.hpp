@@ -21,9 +21,18 @@
 #ifndef N2D2_CIFAR_DATABASE_H
 #define N2D2_CIFAR_DATABASE_H
 
+#include <memory>
+#include <unordered_map>
+
 #include "Database/Database.hpp"
+#include "utils/MemoryMappedFile.hpp"
 
 namespace N2D2 {
+/**
+ * CIFAR binary files database. The files are memory-mapped and the stimuli
+ * are assembled directly from the mapped color planes, without intermediate
+ * image file.
+*/
 class CIFAR_Database : public Database {
 public:
     CIFAR_Database(double validation = 0.0);
@@ -37,7 +46,16 @@ public:
     virtual ~CIFAR_Database() {};
 
 protected:
+    virtual cv::Mat readData(StimulusID id, const std::string& fileName) const;
+
+    struct MappedData {
+        std::shared_ptr<MemoryMappedFile> file;
+        std::size_t offset;
+    };
+
     double mValidation;
+    /// Location of the stimuli data in the mapped files, by stimulus name
+    std::unordered_map<std::string, MappedData> mMappedData;
 };
 
 class CIFAR10_Database : public CIFAR_Database {
@@ -52,16 +52,59 @@ public:
                          int depth = 0,
                          const std::string& labelName = "",
                          int labelDepth = 0);
+    /**
+     * Same as loadDir() for several directories, loaded in the order of
+     * @p dirPaths, with the corresponding label name in @p labelNames.
+     * The directories and their sub-directories are scanned in parallel,
+     * the stimuli and labels are registered in the same deterministic order
+     * as with successive loadDir() calls.
+    */
+    void loadDirs(const std::vector<std::string>& dirPaths,
+                  int depth = 0,
+                  const std::vector<std::string>& labelNames
+                    = std::vector<std::string>(),
+                  int labelDepth = 0);
     virtual StimulusID loadFile(const std::string& fileName);
     virtual StimulusID loadFile(const std::string& fileName,
                           const std::string& labelName);
     virtual ~DIR_Database() {};
 
 protected:
+    /// Content of a directory
+    struct DirScan {
+        DirScan() : mtime(0) {};
+
+        /// Modification time of the directory when it was scanned
+        long long int mtime;
+        /// Valid stimuli files, sorted
+        std::vector<std::string> files;
+        /// Sub-directories, sorted
+        std::vector<std::string> subDirs;
+        /// Notices emitted during the scan
+        std::vector<std::string> notices;
+    };
+
     virtual StimulusID loadFile(const std::string& fileName, int label);
+    DirScan scanDir(const std::string& dirPath) const;
+    void registerDir(const std::string& dirPath,
+                     int depth,
+                     const std::string& labelName,
+                     int labelDepth,
+                     const std::map<std::string, DirScan>& scans);
+    std::string getManifestOptions() const;
+    void loadManifest();
+    void saveManifest() const;
+
+    /// Path of the scan manifest file, caching the content of the scanned
+    /// directories as long as their modification time is unchanged
+    /// (no manifest if empty)
+    Parameter<std::string> mManifestPath;
 
     std::vector<std::string> mIgnoreMasks;
     std::vector<std::string> mValidExtensions;
+    /// Scanned directories, indexed by path
+    std::map<std::string, DirScan> mManifest;
+    std::string mManifestLoadedPath;
 };
 }
 
@@ -22,6 +22,7 @@
 #define N2D2_DATABASE_H
 
 #include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,8 @@
     #endif
 #endif
 
+#include "DataFile/DataFile.hpp"
+#include "Database/StimuliDataCache.hpp"
 #include "Transformation/CompositeTransformation.hpp"
 #include "utils/Parameterizable.hpp"
 #include "utils/Utils.hpp"
@@ -87,12 +90,16 @@ public:
         /// ROIs associated to the stimulus
         std::vector<ROI*> ROIs;
         ROI* slice;
+        /// Reduced-resolution decoding of the stimulus file, determined from
+        /// the file header on first use (factor 0 = not determined yet)
+        mutable DataFile::Reduction reduction;
 
         Stimulus(const std::string& name_,
                  int label_ = -1,
                  const std::vector<ROI*>& ROIs_ = std::vector<ROI*>(),
                  ROI* slice_ = NULL)
-            : name(name_), label(label_), ROIs(ROIs_), slice(slice_)
+            : name(name_), label(label_), ROIs(ROIs_), slice(slice_),
+              reduction(0U)
         {
         }
     };
@@ -294,6 +301,52 @@ public:
         unsigned int index) const;
     unsigned int getNbROIs() const;
     unsigned int getNbROIsWithLabel(int label) const;
+
+    /**
+     * Returns, for each label, the indexes in the stimuli set @p set of the
+     * stimuli with this label or with at least one ROI of this label.
+     * The index is built once per set and rebuilt on first use after a
+     * change of the stimuli, their labels or the partitioning.
+     *
+     * @param set           Set of stimuli
+     * @return Stimuli indexes in the set, indexed by label ID
+    */
+    const std::vector<std::vector<unsigned int> >&
+    getLabelsIndexes(StimuliSet set) const;
+    const std::vector<unsigned int>& getLabelIndexes(StimuliSet set,
+                                                     int label) const;
+    /**
+     * Returns the cumulative weights of the labels, for a weighted draw of a
+     * label among the labels with stimuli in the set @p set. It is cached
+     * with the labels index and rebuilt with it, or when @p labelsWeights
+     * changes.
+     *
+     * @param set           Set of stimuli
+     * @param labelsWeights Weight of each label (1 if not specified)
+     * @return Cumulative weights, indexed by label ID
+    */
+    const std::vector<double>& getLabelsCumulativeWeights(StimuliSet set,
+        const std::vector<double>& labelsWeights = std::vector<double>())
+        const;
+
+    /**
+     * Returns a random permutation of the indexes of the stimuli set @p set
+     * for one epoch, with a bounded locality: the set is split into shards of
+     * @p shardSize consecutive stimuli in StimulusID order (the loading
+     * order, usually the storage order), the shards order is shuffled, then
+     * the stimuli are streamed through a shuffle buffer of @p bufferSize
+     * stimuli. Consecutive stimuli of the permutation are therefore read
+     * from at most bufferSize / shardSize + 1 shards.
+     *
+     * @param set           Set of stimuli
+     * @param shardSize     Number of consecutive stimuli per shard (1 for a
+     *                      uniform permutation)
+     * @param bufferSize    Size of the shuffle buffer
+     * @return Stimuli indexes in the set, in epoch order
+    */
+    std::vector<unsigned int> getEpochIndexes(StimuliSet set,
+                                              unsigned int shardSize,
+                                              unsigned int bufferSize) const;
     inline unsigned int getNbROIsWithLabel(const std::string& labelName) const;
     bool isLabel(const std::string& labelName) const;
     bool isMatchingLabel(const std::string& labelMask) const;
@@ -327,6 +380,20 @@ public:
                             = std::vector<std::shared_ptr<ROI> >());
     std::vector<StimuliSet> getStimuliSets(StimuliSetMask setMask) const;
     StimuliSetMask getStimuliSetMask(StimuliSet set) const;
+    StimuliDataCache& getDataCache()
+    {
+        return mDataCache;
+    };
+    /// Set the minimum size of the stimuli data needed by the readers,
+    /// allowing reduced-resolution decoding if ReducedDecode is true
+    void setDecodeMinSize(const cv::Size& minSize);
+    const cv::Size& getDecodeMinSize() const
+    {
+        return mDecodeMinSize;
+    };
+    /// Return the factor by which the stimulus data is decoded at reduced
+    /// resolution. The stimulus labels and ROIs are scaled accordingly.
+    virtual unsigned int getStimulusReduction(StimulusID id) const;
 
     virtual ~Database();
 
@@ -339,7 +406,15 @@ protected:
     cv::Mat loadStimulusData(StimulusID id);
     cv::Mat loadStimulusLabelsData(StimulusID id) const;
     cv::Mat loadStimulusTargetData(StimulusID id);
+    bool isDataCacheEnabled();
     cv::Mat loadData(StimulusID id, int depth, const std::string fileName) const;
+    /// Return the reduced-resolution decoding of the stimulus file. The file
+    /// header is parsed only once per stimulus.
+    DataFile::Reduction getStimulusDecoding(StimulusID id) const;
+    /// Read the data of stimulus @p id, stored in @p fileName, before any
+    /// depth conversion or ROI/slice extraction. By default, the file is
+    /// read with the DataFile matching its extension.
+    virtual cv::Mat readData(StimulusID id, const std::string& fileName) const;
     std::vector<unsigned int> getLabelStimuliSetIndexes(int label,
                                                         StimuliSet set) const;
     std::vector<std::vector<unsigned int> >
@@ -350,6 +425,10 @@ protected:
                           StimuliSet set);
     void removeIndexesFromSet(std::vector<unsigned int>& indexes,
                               StimuliSet set);
+    /// Invalidate the labels index of every set (see getLabelsIndexes()).
+    /// Must be called by any method changing the stimuli labels, their ROIs
+    /// labels or the stimuli sets, except when only appending stimuli.
+    void invalidateLabelsIndex();
     void plotStats(
         const std::string& sizeFileName,
         const std::string& labelFileName,
@@ -399,6 +478,13 @@ protected:
     Parameter<std::string> mTargetDataPath;
     Parameter<std::string> mMultiChannelMatch;
     Parameter<std::vector<std::string> > mMultiChannelReplace;
+    /// Budget, in MB, of the LRU cache of the decoded stimuli, labels and
+    /// target data, shared by all the readers (0 = disabled). Unused when
+    /// all the data is loaded in memory
+    Parameter<unsigned int> mDataCacheSize;
+    /// If true, decode the stimuli at a reduced resolution when the readers
+    /// do not need the full resolution (see setDecodeMinSize())
+    Parameter<bool> mReducedDecode;
 
     /**
      * TABLES
@@ -418,10 +504,31 @@ protected:
 
     /// Put data in program memory
     bool mLoadDataInMemory;
+    /// Bounded cache of the decoded data, when not loaded in memory
+    StimuliDataCache mDataCache;
     /// Stimuli depth
     int mStimuliDepth;
     /// Stimuli target depth
     int mStimuliTargetDepth;
+    /// Minimum size of the decoded stimuli data
+    cv::Size mDecodeMinSize;
+
+private:
+    struct LabelsIndex {
+        LabelsIndex() : valid(false), nbStimuli(0), cumWeightsValid(false) {};
+
+        bool valid;
+        /// Size of the set when the index was built
+        unsigned int nbStimuli;
+        std::vector<std::vector<unsigned int> > indexes;
+        /// Cumulative labels weights, for the labels weights cumWeightsFor
+        bool cumWeightsValid;
+        std::vector<double> cumWeightsFor;
+        std::vector<double> cumWeights;
+    };
+
+    /// Per set and per label stimuli index, built on first use
+    mutable std::map<StimuliSet, LabelsIndex> mLabelsIndex;
 };
 }
 
@@ -508,6 +615,7 @@ void N2D2::Database::setStimulusLabel(StimulusID id,
 {
     assert(id < mStimuli.size());
     mStimuli[id].label = getLabelID(labelName);
+    invalidateLabelsIndex();
 }
 
 void N2D2::Database::setStimulusROIs(StimulusID id,
@@ -515,6 +623,7 @@ void N2D2::Database::setStimulusROIs(StimulusID id,
 {
     assert(id < mStimuli.size());
     mStimuli[id].ROIs = ROIs;
+    invalidateLabelsIndex();
 }
 
 N2D2::Database::StimulusID
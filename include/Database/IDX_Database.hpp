@@ -21,9 +21,19 @@
 #ifndef N2D2_IDX_DATABASE_H
 #define N2D2_IDX_DATABASE_H
 
+#include <memory>
+#include <unordered_map>
+
 #include "Database/Database.hpp"
+#include "utils/MemoryMappedFile.hpp"
 
 namespace N2D2 {
+/**
+ * IDX files database. The IDX files are memory-mapped and the stimuli data
+ * returned by getStimulusData() point directly to the mapped images, without
+ * any copy nor intermediate image file. The mapped pages are shared through
+ * the OS page cache with any other process using the same files.
+*/
 class IDX_Database : public Database {
 public:
     enum DataType {
@@ -45,6 +55,19 @@ public:
                       const std::string& labelPath = "",
                       bool /*extractROIs*/ = false);
     virtual ~IDX_Database() {};
+
+protected:
+    virtual cv::Mat readData(StimulusID id, const std::string& fileName) const;
+
+    struct MappedData {
+        std::shared_ptr<MemoryMappedFile> file;
+        std::size_t offset;
+        int rows;
+        int cols;
+    };
+
+    /// Location of the stimuli data in the mapped files, by stimulus name
+    std::unordered_map<std::string, MappedData> mMappedData;
 };
 }
 
@@ -0,0 +1,133 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_STIMULIDATACACHE_H
+#define N2D2_STIMULIDATACACHE_H
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef OPENCV_USE_OLD_HEADERS       //  before OpenCV 2.2.0
+    #include "cv.h"
+#else
+    #include "opencv2/core/version.hpp"
+    #if CV_MAJOR_VERSION == 2
+        #include "opencv2/core/core.hpp"
+    #elif CV_MAJOR_VERSION >= 3
+        #include "opencv2/core.hpp"
+    #endif
+#endif
+
+namespace N2D2 {
+/**
+ * Bounded, thread-safe LRU cache of decoded stimuli data.
+ * The cache is split into NbShards independent shards, each with its own
+ * lock, LRU list and byte budget (capacity / NbShards), so that concurrent
+ * readers rarely contend. A matrix larger than the budget of a shard is not
+ * cached. The cached matrices are shared with the callers and must not be
+ * modified in place.
+*/
+class StimuliDataCache {
+public:
+    enum DataType {
+        Data,
+        LabelsData,
+        TargetData
+    };
+
+    /// @param capacity Budget of the cache, in bytes (0 = disabled)
+    StimuliDataCache(std::size_t capacity = 0);
+
+    /**
+     * Get the cached matrix of stimulus @p id. Return false on cache miss.
+    */
+    bool get(unsigned int id, DataType type, cv::Mat& data);
+    void insert(unsigned int id, DataType type, const cv::Mat& data);
+    /// Change the budget of the cache, evicting the entries in excess
+    void setCapacity(std::size_t capacity);
+    void clear();
+    void resetStats();
+    std::size_t getCapacity() const
+    {
+        return mCapacity;
+    };
+    /// Return the cumulated size of the cached matrices, in bytes
+    std::size_t getSize();
+    unsigned int getNbEntries();
+    unsigned long long int getNbHits() const
+    {
+        return mNbHits;
+    };
+    unsigned long long int getNbMisses() const
+    {
+        return mNbMisses;
+    };
+    unsigned long long int getNbEvictions() const
+    {
+        return mNbEvictions;
+    };
+    virtual ~StimuliDataCache() {};
+
+    static const unsigned int NbShards = 16;
+
+private:
+    typedef unsigned long long int Key;
+
+    struct Entry {
+        Key key;
+        cv::Mat data;
+        std::size_t size;
+    };
+
+    struct Shard {
+        Shard() : size(0) {};
+
+        std::mutex mutex;
+        // Most recently used entry first
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator> index;
+        std::size_t size;
+    };
+
+    Shard& getShard(unsigned int id)
+    {
+        return mShards[id % NbShards];
+    };
+    static Key getKey(unsigned int id, DataType type)
+    {
+        return 3ULL * id + type;
+    };
+    static std::size_t getDataSize(const cv::Mat& data)
+    {
+        return data.total() * data.elemSize();
+    };
+    void evict(Shard& shard, std::size_t shardCapacity);
+
+    std::atomic<std::size_t> mCapacity;
+    Shard mShards[NbShards];
+    std::atomic<unsigned long long int> mNbHits;
+    std::atomic<unsigned long long int> mNbMisses;
+    std::atomic<unsigned long long int> mNbEvictions;
+};
+}
+
+#endif // N2D2_STIMULIDATACACHE_H
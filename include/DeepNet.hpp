@@ -22,6 +22,7 @@
 #ifndef N2D2_DEEPNET_H
 #define N2D2_DEEPNET_H
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -103,6 +104,12 @@ public:
     void cReset(Time_T timestamp = 0);
     void initializeCMonitors(unsigned int nbTimesteps);
     void spikeCodingCompare(const std::string& dirName, unsigned int idx) const;
+    /// Simulate a spiking network in @p nbPartitions partitions of the
+    /// Network (see Network::setPartitioning()): the environment is in
+    /// partition 0 and the cells of layer i in partition i % nbPartitions.
+    /// The lookahead is the minimum synaptic delay of the cells that receive
+    /// spikes from another partition.
+    void setPartitioning(unsigned int nbPartitions);
 
     void fuseBatchNormWithConv();
     void fusePadding();
@@ -223,8 +230,16 @@ protected:
     Parameter<std::string> mName;
     Parameter<unsigned int> mSignalsDiscretization;
     Parameter<unsigned int> mFreeParametersDiscretization;
+    // If true, the independent cells are propagated and back-propagated
+    // concurrently, following the dependency graph of the network
+    Parameter<bool> mConcurrentExecution;
 
 private:
+    void runCells(const std::function<void(const std::string&)>& func,
+                  bool backward,
+                  std::vector<std::pair<std::string, double> >* timings,
+                  const std::string& suffix);
+
     Network& mNet;
     std::shared_ptr<Database> mDatabase;
     std::shared_ptr<StimuliProvider> mStimuliProvider;
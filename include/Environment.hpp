@@ -113,6 +113,13 @@ public:
 protected:
     void fillNodes(Tensor<NodeEnv*> nodes, double orientation = 0.0);
 
+    // Parameters
+    /// If true, each input node only keeps its next spike in the network
+    /// events queue: the following spike is generated when it is released
+    /// (see NodeEnv::streamSpikes()), instead of generating all the spikes of
+    /// the presentation up front
+    Parameter<bool> mStreamInputs;
+
     Network& mNetwork;
     /// For each scale, tensor (x, y, channel, batch)
     Tensor<NodeEnv*> mNodes;
@@ -23,6 +23,7 @@
 #define N2D2_NETWORK_H
 
 #include <chrono>
+#include <exception>
 #include <functional>
 #include <queue>
 #include <set>
@@ -43,6 +44,8 @@
 #include <unistd.h>
 #endif
 
+#include "utils/Random.hpp"
+#include "utils/TimingWheel.hpp"
 #include "utils/Utils.hpp"
 
 namespace N2D2 {
@@ -71,6 +74,10 @@ typedef std::vector<std::pair<Time_T, EventType_T> > NodeEvents_T;
 void exceptionHandler(int sig);
 #endif
 
+struct SpikeEventTimestamp {
+    inline Time_T operator()(const SpikeEvent* event) const;
+};
+
 class NetworkObserver {
 public:
     enum NotifyType {
@@ -116,27 +123,85 @@ protected:
  *processed, the N2D2::Node::emitSpike() method
  * is called. This method handles all the internal events created by the node
  *itself, either in the N2D2::Node::incomingSpike()
- * or any other method and create events to its child nodes.
+ * or any other method and create events to its child nodes. @n
+ * The events can be scheduled either with a binary heap (HeapScheduler, the
+ *default), or with a timing wheel (WheelScheduler, see N2D2::TimingWheel),
+ *whose insertion is O(1) for the events within the wheel horizon
+ *(wheelResolution x wheelNbSlots). The timing wheel is faster when the
+ *timestamps of the pending events are close to each other. Both schedulers
+ *follow the same ordering (N2D2::SpikeEvent::operator<()). @n
+ * With setPartitioning(), the nodes are distributed in partitions (see
+ *N2D2::Node::setPartition()), each with its own event queue, processed in
+ *parallel by one thread per partition. The simulation advances by
+ *synchronization windows of duration lookahead: an event created for a node
+ *of another partition must be at least lookahead after the current window
+ *start (for example a synaptic delay). It is stored in a mailbox owned by
+ *the sending partition, and moved to the destination queue at the end of
+ *the window.
+ *Within a partition, the simultaneous events are ordered by their origin,
+ *destination and type, and the random numbers drawn while processing the
+ *events of a node come from its own stream (see N2D2::Random::Stream), keyed
+ *by the seed of the network and the index of the node in the network. The
+ *results therefore do not depend on the number of partitions and threads:
+ *setPartitioning(1) gives the same results in a single thread. They can
+ *differ from the sequential mode, which keeps the original ordering of the
+ *simultaneous events and the global random generator. The nodes of
+ *different partitions must only interact through events, and a call to
+ *stop() during a run is applied to the other partitions at the end of the
+ *current window.
+ *@n
+ * The cells of a N2D2::DeepNet receive the spikes of another partition
+ *through an event delayed by their minimum synaptic delay (see
+ *N2D2::Cell_Spike::setPartition()). DeepNet::setPartitioning(), and the
+ *-partitions option of n2d2, distribute the layers in partitions and derive
+ *the lookahead from these delays (IncomingDelay parameter).
 */
 class Network {
 public:
+    enum EventsScheduler {
+        HeapScheduler,
+        WheelScheduler
+    };
+
     /// Constructor.
     /// @param seed Seed for the random generator, used in any N2D2 function. If
     /// left to 0, a seed based on the system clock
     /// is produced. If the seed is set to a positive value, it is garanteed
     /// that the simulation will always produce the
     /// same results.
-    Network(unsigned int seed = 0);
+    /// @param scheduler Data structure used to schedule the events.
+    /// @param wheelResolution Duration of a time slot of the timing wheel. It
+    /// should be a small fraction of the time scale of the events (like the
+    /// presentation time of a stimulus), otherwise most of the events fall in
+    /// the same slot and are scheduled by its heap.
+    /// @param wheelNbSlots Number of time slots of the timing wheel (must be a
+    /// power of 2).
+    Network(unsigned int seed = 0,
+            EventsScheduler scheduler = HeapScheduler,
+            Time_T wheelResolution = TimeUs,
+            unsigned int wheelNbSlots = 65536);
     /// Process all the events in the network until no further event remains in
     /// the priority queue.
     /// @param stop If not 0, stop the simulation to the specified timestamp.
     /// Usefull for debug purpose, or to stop network
     /// simulations containing oscillations.
     bool run(Time_T stop = 0, bool clearActivity = true);
-    void stop(Time_T stop = 0, bool discard = false)
+    void stop(Time_T stop = 0, bool discard = false);
+    /// Enable the partitioned mode, where the events of each partition are
+    /// processed in parallel.
+    /// @param nbPartitions Number of partitions (0 = sequential mode). The
+    /// partition of each node is set with Node::setPartition().
+    /// @param lookahead Duration of the synchronization windows, which must
+    /// not be larger than the minimum delay of the events between two
+    /// partitions.
+    void setPartitioning(unsigned int nbPartitions, Time_T lookahead = TimeFs);
+    unsigned int getNbPartitions() const
     {
-        mStop = stop;
-        mDiscard = discard;
+        return mPartitions.size();
+    };
+    Time_T getLookahead() const
+    {
+        return mLookahead;
     };
     void reset(Time_T timestamp = 0);
     /// Save the entire network state in a given location (binary format, not
@@ -167,6 +232,10 @@ public:
     {
         return mLoadSavePath;
     };
+    EventsScheduler getEventsScheduler() const
+    {
+        return mEventsScheduler;
+    };
     /// Destructor.
     virtual ~Network();
 
@@ -175,6 +244,16 @@ public:
     // Internal functions, not to be called directly
     void addObserver(NetworkObserver* obs);
     void removeObserver(NetworkObserver* obs);
+    /// Returns the index of a new node in the network, which keys its random
+    /// stream in the partitioned mode
+    unsigned int newNodeIndex()
+    {
+        return mNbNodes++;
+    };
+    /// Returns the random stream of @p node in the partitioned mode, or NULL
+    /// in the sequential mode (see Random::ThreadStream). Must not be called
+    /// during a synchronization window.
+    Random::Stream* getNodeRandom(const Node& node);
     /// Create a new event and add it to the priority queue.
     SpikeEvent* newEvent(Node* origin,
                          Node* destination,
@@ -184,14 +263,63 @@ public:
     recordSpike(NodeId_T nodeId, Time_T timestamp = 0, EventType_T type = 0);
 
 private:
+    struct Partition {
+        Partition(Time_T wheelResolution, unsigned int wheelNbSlots);
+
+        std::priority_queue
+            <SpikeEvent*, std::vector<SpikeEvent*>,
+             Utils::PtrLess<SpikeEvent*> > events;
+        TimingWheel<SpikeEvent*, Utils::PtrLess<SpikeEvent*>,
+                    SpikeEventTimestamp> eventsWheel;
+        std::stack<SpikeEvent*> eventsPool;
+        /// Events created during the current window for the nodes of the
+        /// other partitions, for each destination partition
+        std::vector<std::vector<SpikeEvent*> > mailboxes;
+        std::unordered_map<NodeId_T, NodeEvents_T> spikeRecording;
+        Time_T lastEvent;
+        bool stopRequested;
+        Time_T stop;
+        bool discard;
+        std::exception_ptr exception;
+    };
+
+    inline bool eventsEmpty() const;
+    inline SpikeEvent* eventsTop();
+    inline void eventsPop();
+    inline void eventsPush(SpikeEvent* event);
+    inline bool eventsEmpty(const Partition& partition) const;
+    inline SpikeEvent* eventsTop(Partition& partition);
+    inline void eventsPop(Partition& partition);
+    inline void eventsPush(Partition& partition, SpikeEvent* event);
+    SpikeEvent* newPartitionEvent(Node* origin,
+                                  Node* destination,
+                                  Time_T timestamp,
+                                  EventType_T type);
+    bool runPartitioned();
+    void runPartition(unsigned int partition);
+    void updateNodesRandom();
+    void recordPartitionSpike(NodeId_T nodeId,
+                              Time_T timestamp,
+                              EventType_T type);
+
     // Internal variables
     std::set<NetworkObserver*> mObservers;
+    unsigned int mSeed;
+    unsigned int mNbNodes;
+    /// Random streams of the nodes in the partitioned mode, keyed by the seed
+    /// and the index of the node
+    std::vector<Random::Stream> mNodesRandom;
     std::string mLoadSavePath;
+    const EventsScheduler mEventsScheduler;
     /// The priority queue containing the events to be processed by the
-    /// simulator.
+    /// simulator (with HeapScheduler).
     std::priority_queue
         <SpikeEvent*, std::vector<SpikeEvent*>, Utils::PtrLess<SpikeEvent*> >
     mEvents;
+    /// The timing wheel containing the events to be processed by the
+    /// simulator (with WheelScheduler).
+    TimingWheel<SpikeEvent*, Utils::PtrLess<SpikeEvent*>, SpikeEventTimestamp>
+    mEventsWheel;
     std::unordered_map<NodeId_T, NodeEvents_T> mSpikeRecording;
     bool mInitialized;
     Time_T mFirstEvent;
@@ -199,6 +327,11 @@ private:
     Time_T mStop;
     bool mDiscard;
     std::stack<SpikeEvent*> mEventsPool;
+    /// Partitions of the partitioned mode (empty in sequential mode)
+    std::vector<Partition> mPartitions;
+    Time_T mLookahead;
+    /// End of the current synchronization window (partitioned mode)
+    Time_T mWindowEnd;
     const std::chrono::high_resolution_clock::time_point mStartTime;
 };
 }
@@ -206,7 +339,10 @@ private:
 void
 N2D2::Network::recordSpike(NodeId_T nodeId, Time_T timestamp, EventType_T type)
 {
-    mSpikeRecording[nodeId].push_back(std::make_pair(timestamp, type));
+    if (mPartitions.empty())
+        mSpikeRecording[nodeId].push_back(std::make_pair(timestamp, type));
+    else
+        recordPartitionSpike(nodeId, timestamp, type);
 }
 
 #endif // N2D2_NETWORK_H
@@ -164,11 +164,26 @@ public:
     {
         return mLayer;
     };
+    /// Set the partition of the node, for Network::setPartitioning()
+    void setPartition(unsigned int partition)
+    {
+        mPartition = partition;
+    };
+    /// Returns node partition number
+    unsigned int getPartition() const
+    {
+        return mPartition;
+    };
     /// Returns node branches
     const std::vector<Node*>& getBranches()
     {
         return mBranches;
     };
+    /// Returns the index of the node in its network
+    unsigned int getNetworkIndex() const
+    {
+        return mNetworkIndex;
+    };
     /// Destructor
     virtual ~Node() {};
 
@@ -186,7 +201,9 @@ protected:
     float mScale;
     float mOrientation;
     unsigned short mLayer;
+    unsigned int mPartition;
     Area mArea;
+    unsigned int mNetworkIndex;
 
     static unsigned int mIdCnt;
 
@@ -25,6 +25,8 @@
 #include "Node.hpp"
 
 namespace N2D2 {
+class SpikeGenerator;
+
 /**
  * Input node, receives external stimuli. It is not a real neuron as it has no
  * input or integration circuit.
@@ -38,7 +40,30 @@ public:
             unsigned int y = 0);
     inline void
     incomingSpike(Node* origin, Time_T timestamp, EventType_T type = 0);
+    /**
+     * Generate the spikes of the input @p value between @p start and @p end
+     *with @p generator, one at a time: only the next spike is scheduled in the
+     *network, the following one is generated when it is released.
+     * A new stream replaces the current one.
+    */
+    void streamSpikes(const SpikeGenerator* generator,
+                      double value,
+                      Time_T start,
+                      Time_T end);
+    virtual void emitSpike(Time_T timestamp, EventType_T type = 0);
     virtual ~NodeEnv() {};
+
+private:
+    void nextStreamSpike();
+
+    // Internal variables
+    /// Generator of the current stream (NULL if no stream is pending)
+    const SpikeGenerator* mStreamGenerator;
+    double mStreamValue;
+    Time_T mStreamStart;
+    Time_T mStreamEnd;
+    /// Pending spike of the stream
+    std::pair<Time_T, int> mStreamEvent;
 };
 }
 
@@ -43,6 +43,9 @@ public:
                            Node* destination,
                            Time_T timestamp,
                            EventType_T type);
+    /// Order the simultaneous events by their origin and destination (see
+    /// operator<()), for the partitioned mode of the Network
+    inline void setTieKey();
     inline Time_T release();
     void discard()
     {
@@ -60,6 +63,11 @@ public:
     {
         return mType;
     };
+    /// Returns the node that processes the event
+    Node* getNode() const
+    {
+        return (mDestination != NULL) ? mDestination : mOrigin;
+    };
     // We really want this function to be inlined for better performances
     inline bool operator<(const SpikeEvent& event) const;
     virtual ~SpikeEvent() {};
@@ -70,6 +78,8 @@ private:
     Node* mDestination;
     Time_T mTimestamp;
     EventType_T mType;
+    /// Origin and destination IDs, 0 in the sequential mode
+    unsigned long long int mTieKey;
     bool mDiscarded;
 };
 }
@@ -82,6 +92,7 @@ N2D2::SpikeEvent::SpikeEvent(Node* origin,
       mDestination(destination),
       mTimestamp(timestamp),
       mType(type),
+      mTieKey(0),
       mDiscarded(false)
 {
     // ctor
@@ -96,9 +107,20 @@ void N2D2::SpikeEvent::initialize(Node* origin,
     mDestination = destination;
     mTimestamp = timestamp;
     mType = type;
+    mTieKey = 0;
     mDiscarded = false;
 }
 
+void N2D2::SpikeEvent::setTieKey()
+{
+    const unsigned long long int origin = (mOrigin != NULL)
+        ? mOrigin->getId() : 0;
+    const unsigned long long int destination = (mDestination != NULL)
+        ? mDestination->getId() : 0;
+
+    mTieKey = (origin << 32) | destination;
+}
+
 N2D2::Time_T N2D2::SpikeEvent::release()
 {
     if (mDestination == NULL)
@@ -111,9 +133,21 @@ N2D2::Time_T N2D2::SpikeEvent::release()
 
 bool N2D2::SpikeEvent::operator<(const SpikeEvent& event) const
 {
-    return (mTimestamp > event.mTimestamp
-            || (mTimestamp == event.mTimestamp && mDestination == NULL
-                && event.mDestination != NULL));
+    if (mTimestamp != event.mTimestamp)
+        return (mTimestamp > event.mTimestamp);
+
+    if ((mDestination == NULL) != (event.mDestination == NULL))
+        return (mDestination == NULL);
+
+    // In the partitioned mode of the Network, simultaneous events are ordered
+    // by their origin, destination and type, so that the processing order
+    // does not depend on the order in which they were pushed. In the
+    // sequential mode, the tie keys are 0, which leaves the original ordering
+    // unchanged.
+    if (mTieKey != event.mTieKey)
+        return (mTieKey > event.mTieKey);
+
+    return (mTieKey != 0 && mType > event.mType);
 }
 
 #endif // N2D2_SPIKEEVENT_H
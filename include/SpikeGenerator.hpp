@@ -51,6 +51,8 @@ public:
     SpikeGenerator();
     virtual ~SpikeGenerator();
 
+    friend class NodeEnv;
+
 protected:
     void checkParameters() const;
     void nextEvent(std::pair<Time_T, int>& event,
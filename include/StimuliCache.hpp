@@ -0,0 +1,112 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_STIMULICACHE_H
+#define N2D2_STIMULICACHE_H
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Database/Database.hpp"
+#include "utils/MemoryMappedFile.hpp"
+
+namespace N2D2 {
+/**
+ * Packed disk cache of pre-processed stimuli.
+ * For each stimuli set, the stimuli are appended as BinaryCvMat records into
+ * large shard files ("shard_<set>_<n>.bin"). Each record holds the data and
+ * the labels channels of a stimulus. The record locations are appended to an
+ * index file ("index_<set>.bin"), after the record itself, so that the index
+ * only refers to complete records.
+ * The shards are memory-mapped for reading and the returned cv::Mat point
+ * directly to the mapped records (zero-copy).
+ * The methods are thread-safe. Use open() to share a cache between the
+ * StimuliProvider objects using the same path.
+*/
+class StimuliCache {
+public:
+    StimuliCache(const std::string& path,
+                 std::size_t maxShardSize = DefaultMaxShardSize);
+
+    /**
+     * Return the cache for @p path, shared by all the callers.
+    */
+    static std::shared_ptr<StimuliCache> open(const std::string& path);
+
+    bool isCached(Database::StimulusID id, Database::StimuliSet set);
+
+    /**
+     * Load a stimulus from the cache. Return false if it is not cached.
+     * The data and labels matrices are read-only views of the mapped shard,
+     * only valid as long as @p mapping is alive: clone() them before any
+     * in-place modification.
+    */
+    bool load(Database::StimulusID id,
+              Database::StimuliSet set,
+              std::vector<cv::Mat>& data,
+              std::vector<cv::Mat>& labels,
+              std::shared_ptr<MemoryMappedFile>& mapping);
+    void save(Database::StimulusID id,
+              Database::StimuliSet set,
+              const std::vector<cv::Mat>& data,
+              const std::vector<cv::Mat>& labels);
+    const std::string& getPath() const
+    {
+        return mPath;
+    };
+    virtual ~StimuliCache() {};
+
+    static const std::size_t DefaultMaxShardSize;
+
+private:
+    struct Location {
+        unsigned int shard;
+        unsigned long long int offset;
+        unsigned long long int size;
+    };
+
+    struct SetCache {
+        SetCache() : initialized(false), shardSize(0) {};
+
+        bool initialized;
+        // Location of each cached stimulus, indexed by StimulusID
+        std::vector<Location> locations;
+        std::vector<bool> cached;
+        std::vector<std::shared_ptr<MemoryMappedFile> > shards;
+        std::ofstream shard;
+        unsigned long long int shardSize;
+        std::ofstream index;
+    };
+
+    SetCache& getSetCache(Database::StimuliSet set);
+    std::string getShardFileName(Database::StimuliSet set,
+                                 unsigned int shard) const;
+    std::string getIndexFileName(Database::StimuliSet set) const;
+
+    const std::string mPath;
+    const std::size_t mMaxShardSize;
+    std::map<Database::StimuliSet, SetCache> mSets;
+};
+}
+
+#endif // N2D2_STIMULICACHE_H
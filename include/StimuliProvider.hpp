@@ -23,13 +23,20 @@
 #define N2D2_STIMULIPROVIDER_H
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Database/Database.hpp"
 #include "Transformation/CompositeTransformation.hpp"
+#include "TransformationsProfile.hpp"
 #ifdef CUDA
 #include "containers/CudaTensor.hpp"
 #else
@@ -40,6 +47,8 @@
 
 namespace N2D2 {
 
+class StimuliCache;
+
 class StimuliProvider : virtual public Parameterizable, public std::enable_shared_from_this<StimuliProvider> {
 public:
     struct Transformations {
@@ -64,6 +73,34 @@ public:
     typedef Tensor<Float_T> TensorData_T;
 #endif
 
+    /// Sampling of the random stimuli
+    enum Sampling {
+        /// Uniform over the stimuli of the set
+        Uniform,
+        /// Uniform over the labels of the set, then over the stimuli of the
+        /// drawn label
+        LabelBalanced,
+        /// Same as LabelBalanced, with the labels drawn according to the
+        /// LabelsWeights parameter
+        LabelWeighted,
+        /// Each epoch is a permutation of the set with a bounded locality
+        /// (see Database::getEpochIndexes()), for mostly sequential reads
+        EpochShuffle
+    };
+
+    struct PrefetchStats {
+        /// Maximum number of batches in flight
+        unsigned int depth;
+        /// Number of batches consumed
+        unsigned long long int nbBatches;
+        /// Average number of ready batches when a batch is consumed
+        double avgOccupancy;
+        /// Cumulated time waiting for a ready batch (in s)
+        double consumerStallTime;
+        /// Cumulated time waiting for a free batch slot (in s)
+        double producerStallTime;
+    };
+
     StimuliProvider(Database& database,
                     const std::vector<size_t>& size,
                     unsigned int batchSize = 1,
@@ -157,16 +194,47 @@ public:
     bool normalizeIntegersStimuli(int envCvDepth);
 
     void logTransformations(const std::string& fileName) const;
+    /// Return the time and bytes processed per stage and per transformation
+    /// type, summed over all the threads (requires ProfileTransformations)
+    TransformationsProfile getTransformationsProfile() const;
+    /// Log the profile of each thread and the total in a CSV file
+    void logTransformationsProfile(const std::string& fileName) const;
+    void clearTransformationsProfile();
 
 
     void future();
     void synchronize();
 
+    /// Start a background producer of random batches for the StimuliSet
+    /// @p set, with up to PrefetchDepth batches in flight, decoded by a
+    /// dedicated pool of PrefetchThreads threads. While prefetching,
+    /// readRandomBatch() for @p set swaps the next assembled batch in place,
+    /// without copy. Does nothing if PrefetchDepth is 0.
+    /// The StimuliProvider must not be moved, nor its batch size changed,
+    /// while prefetching.
+    /// The producer shares the transformations and the database with the
+    /// other read methods: they throw a std::runtime_error while
+    /// prefetching, unless the producer is paused with pausePrefetch().
+    void startPrefetch(Database::StimuliSet set = Database::Learn);
+    void stopPrefetch();
+    /// Wait for the batch being assembled by the producer, and suspend it
+    /// until resumePrefetch(). The batches in flight are kept.
+    void pausePrefetch();
+    void resumePrefetch();
+    bool isPrefetching(Database::StimuliSet set) const
+    {
+        return (mPrefetch && mPrefetch->set == set);
+    };
+    PrefetchStats getPrefetchStats() const;
+
     /// Return a random index from the StimuliSet @p set
     unsigned int getRandomIndex(Database::StimuliSet set);
 
-    /// Return a random StimulusID from the StimuliSet @p set
+    /// Return a random StimulusID from the StimuliSet @p set, according to
+    /// the Sampling parameter
     Database::StimulusID getRandomID(Database::StimuliSet set);
+    /// Return a random StimulusID from the StimuliSet @p set among the
+    /// stimuli with the label @p label or with a ROI of this label
     Database::StimulusID getRandomIDWithLabel(Database::StimuliSet set, int label);
 
     /// Read a whole random batch from the StimuliSet @p set, apply all the
@@ -336,7 +404,10 @@ public:
     {
         return mCachePath;
     };
-    virtual ~StimuliProvider() {};
+    virtual ~StimuliProvider()
+    {
+        stopPrefetch();
+    };
 
     static void logData(const std::string& fileName,
                         Tensor<Float_T> data);
@@ -356,6 +427,57 @@ protected:
     std::vector<cv::Mat> loadDataCache(const std::string& fileName) const;
     void saveDataCache(const std::string& fileName,
                        const std::vector<cv::Mat>& data) const;
+    std::shared_ptr<StimuliCache> getStimuliCache();
+    void updateDecodeMinSize();
+    void readStimulusData(Database::StimulusID id,
+                          Database::StimuliSet set,
+                          unsigned int batchPos,
+                          TensorData_T& dataRef,
+                          Tensor<int>& labelsRef,
+                          TensorData_T& targetDataRef,
+                          std::vector<std::shared_ptr<ROI> >& labelsROI);
+    void applyTransformations(CompositeTransformation& transformations,
+                              bool fused,
+                              cv::Mat& frame,
+                              cv::Mat& labels,
+                              std::vector<std::shared_ptr<ROI> >& labelsROI,
+                              int id,
+                              TransformationsProfile* profile,
+                              const std::string& stage) const;
+    static unsigned long long int getNbBytes(const std::vector<cv::Mat>& mats);
+
+    /// Batch assembled by the prefetch producer
+    struct BatchData {
+        std::vector<int> batch;
+        TensorData_T data;
+        Tensor<int> labelsData;
+        TensorData_T targetData;
+        std::vector<std::vector<std::shared_ptr<ROI> > > labelsROI;
+    };
+
+    struct PrefetchQueue {
+        Database::StimuliSet set;
+        unsigned int depth;
+        unsigned int seed;
+        std::thread producer;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<std::unique_ptr<BatchData> > free;
+        std::deque<std::unique_ptr<BatchData> > ready;
+        bool stop;
+        bool paused;
+        /// The producer is assembling a batch
+        bool busy;
+        std::exception_ptr error;
+        unsigned long long int nbBatches;
+        unsigned long long int cumOccupancy;
+        double consumerStallTime;
+        double producerStallTime;
+    };
+
+    void prefetchProducer();
+    void checkPrefetchPaused(const std::string& method) const;
+    void readPrefetchedBatch();
 
 protected:
     /// Map unsigned integer range to signed before convertion to Float_T
@@ -367,6 +489,30 @@ protected:
     Parameter<Float_T> mQuantizationMin;
     /// Max. value for quantization
     Parameter<Float_T> mQuantizationMax;
+    /// If true, the disk cache is stored in packed shard files with an index
+    /// (see StimuliCache) instead of three files per stimulus
+    Parameter<bool> mPackedCache;
+    /// Maximum number of random batches in flight in the prefetch queue
+    /// (0 = no prefetch queue)
+    Parameter<unsigned int> mPrefetchDepth;
+    /// Number of decoding threads of the prefetch producer
+    /// (0 = OpenMP default)
+    Parameter<unsigned int> mPrefetchThreads;
+    /// If true, the global transformations are applied with
+    /// CompositeTransformation::applyFused()
+    Parameter<bool> mFuseTransformations;
+    /// If true, the wall time and the bytes processed by each stage of the
+    /// stimuli reading and by each transformation are accumulated per thread
+    Parameter<bool> mProfileTransformations;
+    /// Sampling of the random batches
+    Parameter<Sampling> mSampling;
+    /// Relative weight of each label ID for the LabelWeighted sampling
+    /// (1.0 for the labels without weight)
+    Parameter<std::vector<double> > mLabelsWeights;
+    /// Number of consecutive stimuli per shard for the EpochShuffle sampling
+    Parameter<unsigned int> mEpochShardSize;
+    /// Size of the shuffle buffer for the EpochShuffle sampling
+    Parameter<unsigned int> mEpochBufferSize;
 
     // Internal variables
     Database& mDatabase;
@@ -376,6 +522,8 @@ protected:
     bool mCompositeStimuli;
     /// Disk cache path for pre-processed stimuli (no disk cache if empty)
     std::string mCachePath;
+    /// Packed disk cache, opened on first use
+    std::shared_ptr<StimuliCache> mStimuliCache;
     /// Global transformations
     TransformationsSets mTransformations;
     /// Channel transformations
@@ -396,9 +544,23 @@ protected:
     std::vector<std::vector<std::shared_ptr<ROI> > > mLabelsROI;
     std::vector<std::vector<std::shared_ptr<ROI> > > mFutureLabelsROI;
     bool mFuture;
+    /// Background random batches producer
+    std::unique_ptr<PrefetchQueue> mPrefetch;
+    /// Transformations profile of each thread
+    std::map<std::thread::id, TransformationsProfile> mProfiles;
+    /// Current epoch order and position of each set, for the EpochShuffle
+    /// sampling
+    std::map<Database::StimuliSet,
+             std::pair<std::vector<unsigned int>, unsigned int> > mEpochs;
 };
 }
 
+namespace {
+template <>
+const char* const EnumStrings<N2D2::StimuliProvider::Sampling>::data[]
+    = {"Uniform", "LabelBalanced", "LabelWeighted", "EpochShuffle"};
+}
+
 N2D2::StimuliProvider::Transformations&
 N2D2::StimuliProvider::TransformationsSets::
 operator()(Database::StimuliSet set)
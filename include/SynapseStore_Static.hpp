@@ -0,0 +1,123 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_SYNAPSESTORE_STATIC_H
+#define N2D2_SYNAPSESTORE_STATIC_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Synapse_Static.hpp"
+
+namespace N2D2 {
+/**
+ * Packed storage of Synapse_Static synapses, as a structure of arrays, in
+ * which a synapse is addressed by its integer index.
+ *
+ * The weights are stored in a contiguous array. The delays are stored in a
+ * parallel array, which is only allocated when at least one delay is not 0,
+ * and the number of read events in another parallel array, which is only
+ * allocated when the stats are enabled.
+ * The binary format of save() and load() is the same as the one of
+ * consecutive Synapse_Static::saveInternal() calls.
+*/
+class SynapseStore_Static {
+public:
+    SynapseStore_Static(bool bipolar = true, bool stats = true);
+    void reserve(size_t size);
+    /// Append a synapse, with the delay and the weight of @p synapse
+    void push_back(const Synapse_Static& synapse);
+    void clear();
+    size_t size() const
+    {
+        return mWeights.size();
+    };
+    bool empty() const
+    {
+        return mWeights.empty();
+    };
+    bool isBipolar() const
+    {
+        return mBipolar;
+    };
+    bool hasDelays() const
+    {
+        return !mDelays.empty();
+    };
+    bool hasStats() const
+    {
+        return mStats;
+    };
+    inline Time_T getDelay(size_t index) const;
+    /// Returns the minimum delay of the synapses
+    Time_T getMinDelay() const;
+    double getWeight(size_t index) const
+    {
+        return mWeights[index];
+    };
+    /// Return the weight of the synapse and count the read event
+    inline double read(size_t index);
+    inline double getRelativeWeight(size_t index,
+                                    bool allowBipolarRange = false) const;
+    void setRelativeWeight(size_t index, double relWeight);
+    void save(std::ofstream& dataFile) const;
+    void load(std::ifstream& dataFile);
+    void getStats(size_t index, Synapse::Stats* statsObj) const;
+    void logStats(size_t index,
+                  std::ofstream& dataFile,
+                  const std::string& suffix) const;
+    /// Clear the read events of all the synapses
+    void clearStats();
+
+private:
+    bool mBipolar;
+    bool mStats;
+    /// Weights \f$w\f$
+    std::vector<double> mWeights;
+    /// Synaptic delays (empty if all the delays are 0)
+    std::vector<Time_T> mDelays;
+    /// Number of read events (empty if the stats are disabled)
+    std::vector<unsigned long long int> mReadEvents;
+};
+}
+
+N2D2::Time_T N2D2::SynapseStore_Static::getDelay(size_t index) const
+{
+    return (mDelays.empty()) ? 0 : mDelays[index];
+}
+
+double N2D2::SynapseStore_Static::read(size_t index)
+{
+    if (mStats)
+        ++mReadEvents[index];
+
+    return mWeights[index];
+}
+
+double N2D2::SynapseStore_Static::getRelativeWeight(size_t index,
+                                                    bool allowBipolarRange)
+    const
+{
+    return (mBipolar && !allowBipolarRange) ? (mWeights[index] + 1.0) / 2.0
+                                            : mWeights[index];
+}
+
+#endif // N2D2_SYNAPSESTORE_STATIC_H
@@ -66,6 +66,10 @@ struct Synapse_Static : public Synapse {
     {
         mCheckWeightRange = checkWeightRange;
     };
+    static bool getCheckWeightRange()
+    {
+        return mCheckWeightRange;
+    };
     /// Destructor
     virtual ~Synapse_Static() {};
 
@@ -22,6 +22,7 @@
 #define N2D2_COMPOSITETRANSFORMATION_H
 
 #include "Transformation.hpp"
+#include "TransformationsProfile.hpp"
 
 namespace N2D2 {
 class CompositeTransformation : public Transformation {
@@ -43,6 +44,32 @@ public:
                       cv::Mat& labels,
                       std::vector<std::shared_ptr<ROI> >& labelsROI,
                       int /*id*/ = -1);
+    /// Same as apply(), accumulating in @p profile the time spent in each
+    /// transformation, under the stage @p stage
+    void apply(cv::Mat& frame,
+               cv::Mat& labels,
+               std::vector<std::shared_ptr<ROI> >& labelsROI,
+               int id,
+               TransformationsProfile& profile,
+               const std::string& stage);
+    /**
+     * Same as apply(), with the runs of adjacent affine warp transformations
+     * (see Transformation::isAffineWarp()) applied as a single warp, and the
+     * runs of point-wise transformations on 8 bits frames (see
+     * Transformation::isPointWise()) applied as a single look-up table.
+     * The point-wise fusion is exact. The fused warp interpolates the frame
+     * only once, so that its result may slightly differ from the sequential
+     * application, especially near the borders.
+     * If @p profile is not NULL, the time spent in each transformation, or
+     * in each fused run of transformations, is accumulated under the stage
+     * @p stage.
+    */
+    void applyFused(cv::Mat& frame,
+                    cv::Mat& labels,
+                    std::vector<std::shared_ptr<ROI> >& labelsROI,
+                    int id = -1,
+                    TransformationsProfile* profile = NULL,
+                    const std::string& stage = "");
     inline void reverse(cv::Mat& frame,
                         cv::Mat& labels,
                         std::vector<std::shared_ptr<ROI> >& labelsROI,
@@ -63,12 +90,27 @@ public:
     }
     std::pair<unsigned int, unsigned int>
     getOutputsSize(unsigned int width, unsigned int height) const;
+    std::pair<unsigned int, unsigned int> getMinInputsSize() const;
     int getOutputsDepth(int depth) const;
     inline void setStimuliProvider(StimuliProvider* sp);
     virtual ~CompositeTransformation() {};
 
 private:
     inline virtual CompositeTransformation* doClone() const;
+    unsigned int getNbFusableWarps(unsigned int first,
+                                   const cv::Mat& frame,
+                                   const cv::Mat& labels) const;
+    unsigned int getNbFusablePointWise(unsigned int first,
+                                       const cv::Mat& frame) const;
+    void applyWarps(unsigned int first,
+                    unsigned int nbWarps,
+                    cv::Mat& frame,
+                    cv::Mat& labels,
+                    std::vector<std::shared_ptr<ROI> >& labelsROI);
+    void applyPointWise(unsigned int first,
+                        unsigned int nbPointWise,
+                        cv::Mat& frame,
+                        int id);
 
     std::vector<std::shared_ptr<Transformation> > mTransformationSet;
 };
@@ -30,7 +30,7 @@ class DistortionTransformation : public Transformation {
 public:
     using Transformation::apply;
 
-    typedef std::pair<Matrix<double>, Matrix<double> > DistortionMap_T;
+    typedef std::pair<Matrix<float>, Matrix<float> > DistortionMap_T;
 
     static const char* Type;
 
@@ -60,10 +60,21 @@ public:
     virtual ~DistortionTransformation();
 
 private:
+    /// Pool of precomputed elastic fields (see ElasticFieldsPool)
+    struct ElasticFieldsPool {
+        unsigned int size;
+        unsigned int gaussianSize;
+        double sigma;
+        std::vector<DistortionMap_T> fields;
+    };
+
     virtual DistortionTransformation* doClone() const
     {
         return new DistortionTransformation(*this);
     }
+    void getElasticField(DistortionMap_T& field) const;
+    void getPooledElasticField(DistortionMap_T& field);
+    void smoothField(Matrix<float>& field, bool periodic) const;
     void applyDistortion(cv::Mat& mat,
                          const DistortionMap_T& distortionMap,
                          bool nearestNeighbor) const;
@@ -72,7 +83,7 @@ private:
                              const DistortionMap_T& distortionMap,
                              bool nearestNeighbor) const;
 
-    Matrix<double> mKernel;
+    std::shared_ptr<const ElasticFieldsPool> mFieldsPool;
 
     Parameter<unsigned int> mElasticGaussianSize;
     Parameter<double> mElasticSigma;
@@ -80,6 +91,10 @@ private:
     Parameter<double> mScaling;
     Parameter<double> mRotation;
     Parameter<bool> mIgnoreMissingData;
+    /// Number of precomputed elastic fields, randomly shifted, rotated and
+    /// mirrored for each stimulus (0 = a new field is computed for each
+    /// stimulus)
+    Parameter<unsigned int> mElasticFieldsPool;
 };
 }
 
@@ -92,7 +107,6 @@ N2D2::DistortionTransformation::applyDistortionType(cv::Mat& mat,
 {
     const int rows = mat.rows;
     const int cols = mat.cols;
-    // const int size = rows*cols;
 
     std::vector<cv::Mat> channels;
     cv::split(mat, channels);
@@ -102,13 +116,8 @@ N2D2::DistortionTransformation::applyDistortionType(cv::Mat& mat,
     for (int ch = 0; ch < mat.channels(); ++ch)
         distortedChannels.push_back(
             cv::Mat(mat.rows, mat.cols, channels[ch].type(), cv::Scalar(0)));
-    /*
-    #if defined(_OPENMP) && _OPENMP >= 200805
-        #pragma omp parallel for collapse(2) if (size > 256)
-    #else
-        #pragma omp parallel for if (rows > 16 && size > 256)
-    #endif
-    */
+
+#pragma omp parallel for if (rows > 16 && rows * cols > 256)
     for (int i = 0; i < rows; ++i) { // rows
         for (int j = 0; j < cols; ++j) { // columns
             const double isrc_abs = (double)i - distortionMap.second(i, j);
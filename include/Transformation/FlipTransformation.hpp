@@ -53,6 +53,12 @@ public:
     {
         return std::make_pair(width, height);
     };
+    bool isAffineWarp() const
+    {
+        return true;
+    };
+    cv::Mat getAffineWarp(cv::Size& size,
+                          std::vector<std::shared_ptr<ROI> >& labelsROI);
     int getOutputsDepth(int depth) const
     {
         return depth;
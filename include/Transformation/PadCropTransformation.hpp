@@ -67,6 +67,14 @@ public:
         else
             return std::pair<unsigned int, unsigned int>(mWidth, mHeight);
     };
+    bool isAffineWarp() const
+    {
+        // The mean border depends on the image
+        return (mBorderType != MeanBorder);
+    };
+    bool getWarpBorder(int& borderType, cv::Scalar& borderValue) const;
+    cv::Mat getAffineWarp(cv::Size& size,
+                          std::vector<std::shared_ptr<ROI> >& labelsROI);
     int getOutputsDepth(int depth) const
     {
         return depth;
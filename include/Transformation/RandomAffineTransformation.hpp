@@ -58,6 +58,10 @@ public:
     {
         return std::make_pair(width, height);
     };
+    bool isPointWise() const
+    {
+        return true;
+    };
     int getOutputsDepth(int depth) const
     {
         return depth;
@@ -65,6 +65,10 @@ public:
     {
         return std::make_pair(width, height);
     };
+    bool isPointWise() const
+    {
+        return true;
+    };
     int getOutputsDepth(int /*depth*/) const
     {
         return opencv_data_type<Float_T>::value;
@@ -54,6 +54,16 @@ public:
         return (!mKeepAspectRatio) ? std::make_pair(mWidth, mHeight)
                                    : std::make_pair(0U, 0U);
     };
+    std::pair<unsigned int, unsigned int> getMinInputsSize() const
+    {
+        return std::make_pair(mWidth, mHeight);
+    };
+    bool isAffineWarp() const
+    {
+        return true;
+    };
+    cv::Mat getAffineWarp(cv::Size& size,
+                          std::vector<std::shared_ptr<ROI> >& labelsROI);
     int getOutputsDepth(int depth) const
     {
         return depth;
@@ -68,6 +78,9 @@ private:
     void resize(cv::Mat& mat,
                 int interpolation,
                 std::vector<std::shared_ptr<ROI> >& labelsROI) const;
+    cv::Size getResizedSize(const cv::Size& size,
+                            double& xRatio,
+                            double& yRatio) const;
 
     const unsigned int mWidth;
     const unsigned int mHeight;
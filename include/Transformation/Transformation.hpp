@@ -99,6 +99,46 @@ public:
         // Default: size is unknown
         return std::make_pair(0U, 0U);
     };
+    /// Minimum input size needed by the transformation, allowing the input
+    /// to be decoded at a reduced resolution.
+    /// Default: the full resolution is needed
+    virtual std::pair<unsigned int, unsigned int> getMinInputsSize() const
+    {
+        return std::make_pair(0U, 0U);
+    };
+    /// Return true if the transformation is a pure affine warp of the frame
+    /// and the labels, which can be fused with the adjacent ones into a
+    /// single warp (see CompositeTransformation::applyFused())
+    virtual bool isAffineWarp() const
+    {
+        return false;
+    };
+    /// Return true if the affine warp introduces a border, whose type and
+    /// value are then returned in @p borderType and @p borderValue
+    virtual bool getWarpBorder(int& /*borderType*/,
+                               cv::Scalar& /*borderValue*/) const
+    {
+        return false;
+    };
+    /// Sample the affine warp of the transformation for an input of size
+    /// @p size and apply it to @p labelsROI. @p size is set to the output
+    /// size. Return the 2x3 CV_64F matrix mapping the input pixel centers to
+    /// the output pixel centers.
+    virtual cv::Mat getAffineWarp(cv::Size& /*size*/,
+                                  std::vector<std::shared_ptr<ROI> >&
+                                    /*labelsROI*/)
+    {
+        throw std::runtime_error("Transformation::getAffineWarp(): "
+                                 "not an affine warp transformation");
+    };
+    /// Return true if each output pixel only depends on the input pixel at
+    /// the same location (and not on the image statistics) and the labels
+    /// are left unchanged, allowing the transformation to be applied through
+    /// a look-up table
+    virtual bool isPointWise() const
+    {
+        return false;
+    };
     virtual int getOutputsDepth(int depth) const = 0;
     virtual void setStimuliProvider(StimuliProvider* sp)
     {
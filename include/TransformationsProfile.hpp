@@ -0,0 +1,76 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_TRANSFORMATIONSPROFILE_H
+#define N2D2_TRANSFORMATIONSPROFILE_H
+
+#include <iosfwd>
+#include <map>
+#include <string>
+
+namespace N2D2 {
+/**
+ * Wall time and bytes processed by the stages of the data pipeline and by
+ * each transformation type, accumulated by (stage, name) key.
+ * By convention, the name "*" is used for a whole stage.
+ * The methods are not thread-safe: use a profile per thread and merge them.
+*/
+class TransformationsProfile {
+public:
+    struct Entry {
+        Entry() : nbCalls(0), time(0.0), nbBytes(0) {};
+
+        unsigned long long int nbCalls;
+        /// Cumulated wall time (in s)
+        double time;
+        /// Cumulated size of the inputs (in bytes)
+        unsigned long long int nbBytes;
+    };
+
+    typedef std::pair<std::string, std::string> Key_T;
+
+    void add(const std::string& stage,
+             const std::string& name,
+             double time,
+             unsigned long long int nbBytes);
+    void merge(const TransformationsProfile& profile);
+    void clear()
+    {
+        mEntries.clear();
+    };
+    bool empty() const
+    {
+        return mEntries.empty();
+    };
+    const std::map<Key_T, Entry>& getEntries() const
+    {
+        return mEntries;
+    };
+
+    /// Write the profile as CSV lines, with the @p prefix columns first
+    void log(std::ostream& os, const std::string& prefix = "") const;
+    static void logHeader(std::ostream& os, const std::string& prefix = "");
+
+private:
+    std::map<Key_T, Entry> mEntries;
+};
+}
+
+#endif // N2D2_TRANSFORMATIONSPROFILE_H
@@ -182,6 +182,9 @@ public:
      * results, use the method Network::getSpikeRecording()
     */
     void setActivityRecording(bool activityRecording);
+    /// Set the partition of the neurons of this Xcell, for
+    /// Network::setPartitioning()
+    void setPartition(unsigned int partition);
     std::string getNeuronsParameter(const std::string& name) const;
     template <class T> T getNeuronsParameter(const std::string& name) const;
     template <class T>
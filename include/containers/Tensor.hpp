@@ -361,6 +361,11 @@ public:
     virtual void assign(const std::vector<size_t>& dims,
                                const T& value);
     virtual void fill(const T& value);
+    /// Convert @p mat in place into the data of the tensor, which can be a
+    /// sub-tensor (like a slot of a batch). The layout and the conversion are
+    /// the same as for Tensor(const cv::Mat&, bool), without any intermediate
+    /// allocation. The number of elements of @p mat must match size().
+    void convertFrom(const cv::Mat& mat, bool signedMapping = false);
     virtual void push_back(const T& value);
     virtual void push_back(const std::vector<T>& vec);
     virtual void push_back(const Tensor<T>& frame);
@@ -439,6 +444,20 @@ protected:
                         std::vector<U>& data,
                         bool signedMapping = false);
 
+    template <class CV_T, class U,
+              typename std::enable_if<std::is_arithmetic<U>::value &&
+                                      !std::is_same<U, bool>::value>::type* = nullptr>
+    static void convert(const cv::Mat& mat,
+                        typename std::vector<U>::iterator data,
+                        bool signedMapping = false);
+
+    template <class CV_T, class U,
+              typename std::enable_if<!(std::is_arithmetic<U>::value &&
+                                        !std::is_same<U, bool>::value)>::type* = nullptr>
+    static void convert(const cv::Mat& mat,
+                        typename std::vector<U>::iterator data,
+                        bool signedMapping = false);
+
 protected:
     template <class U>
     friend typename std::enable_if<std::is_convertible<float,U>::value
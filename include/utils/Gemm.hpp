@@ -0,0 +1,161 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_GEMM_H
+#define N2D2_GEMM_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+#include "third_party/half.hpp"
+
+namespace N2D2 {
+namespace Gemm {
+    enum Transpose {
+        NoTrans,
+        Trans
+    };
+
+    /**
+     * Single-threaded general matrix-matrix product, with row-major storage:
+     * C = alpha * op(A) * op(B) + beta * C
+     * where op(A) is a M x K matrix, op(B) a K x N matrix and C a M x N
+     * matrix.
+     * The operands are packed in cache-sized blocks and the product is
+     * computed by a register-blocked micro-kernel. For each element of C, the
+     * products are accumulated in increasing k order.
+     *
+     * @param transA        If Trans, A is stored as a K x M matrix
+     * @param transB        If Trans, B is stored as a N x K matrix
+     * @param lda           Row stride of A, as stored
+     * @param ldb           Row stride of B, as stored
+     * @param ldc           Row stride of C
+     * @param workspace     Packing buffer, resized if needed. Can be reused
+     *                      across calls, but not shared between threads.
+    */
+    template <class T>
+    void gemm(Transpose transA,
+              Transpose transB,
+              unsigned int M,
+              unsigned int N,
+              unsigned int K,
+              const T& alpha,
+              const T* A,
+              unsigned int lda,
+              const T* B,
+              unsigned int ldb,
+              const T& beta,
+              T* C,
+              unsigned int ldc,
+              std::vector<T>& workspace);
+
+    /**
+     * Mixed precision gemm() for half: the operands are stored in half and
+     * converted to float by blocks (with the F16C instructions when
+     * available). The products are accumulated in float and C is rounded to
+     * half once at the end. The workspace is not used.
+    */
+    template <>
+    void gemm<half_float::half>(Transpose transA,
+                                Transpose transB,
+                                unsigned int M,
+                                unsigned int N,
+                                unsigned int K,
+                                const half_float::half& alpha,
+                                const half_float::half* A,
+                                unsigned int lda,
+                                const half_float::half* B,
+                                unsigned int ldb,
+                                const half_float::half& beta,
+                                half_float::half* C,
+                                unsigned int ldc,
+                                std::vector<half_float::half>& workspace);
+
+    /**
+     * Multi-threaded gemm(): C is split in blocks of columns (or rows, if C
+     * has more rows than columns) computed in parallel by the OpenMP
+     * threads. The result is identical to gemm().
+     *
+     * @param workspaces    Per-thread packing buffers, resized if needed
+    */
+    template <class T>
+    void gemmParallel(Transpose transA,
+                      Transpose transB,
+                      unsigned int M,
+                      unsigned int N,
+                      unsigned int K,
+                      const T& alpha,
+                      const T* A,
+                      unsigned int lda,
+                      const T* B,
+                      unsigned int ldb,
+                      const T& beta,
+                      T* C,
+                      unsigned int ldc,
+                      std::vector<std::vector<T> >& workspaces);
+
+    /**
+     * Integer matrix product for quantized inference, accumulated in 32 bits:
+     * C += A * B^T
+     * where A is a M x K matrix of signed 8 bits integers, B a N x K matrix
+     * of unsigned 8 bits integers and C a M x N matrix, all row-major.
+     * Each element of C is the dot product of two contiguous rows, computed
+     * with the AVX512-VNNI or AVX2 instructions when the CPU supports them
+     * (detected at runtime). The result is exact as long as it fits in 32
+     * bits.
+    */
+    void gemmInt8(unsigned int M,
+                  unsigned int N,
+                  unsigned int K,
+                  const int8_t* A,
+                  unsigned int lda,
+                  const uint8_t* B,
+                  unsigned int ldb,
+                  int32_t* C,
+                  unsigned int ldc);
+
+    /**
+     * Return true if gemmInt8() uses SIMD instructions on this CPU. The
+     * scalar fallback is slower than the float gemm().
+    */
+    bool gemmInt8Accelerated();
+
+    /**
+     * Multi-threaded gemmInt8(), split like gemmParallel().
+    */
+    void gemmInt8Parallel(unsigned int M,
+                          unsigned int N,
+                          unsigned int K,
+                          const int8_t* A,
+                          unsigned int lda,
+                          const uint8_t* B,
+                          unsigned int ldb,
+                          int32_t* C,
+                          unsigned int ldc);
+
+    /**
+     * Size of the packing buffer required by gemm().
+    */
+    std::size_t workspaceSize();
+}
+}
+
+#endif // N2D2_GEMM_H
@@ -0,0 +1,72 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_MEMORYMAPPEDFILE_H
+#define N2D2_MEMORYMAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace N2D2 {
+/**
+ * View of a whole file, memory-mapped with mmap(). The pages are loaded on
+ * demand by the OS and shared with the page cache, without any copy. The
+ * mapping is private (copy-on-write): writing through data() copies the
+ * modified pages and never changes the file. On Windows, the file is read in
+ * memory instead.
+ * The content is the one of the file at construction: bytes appended
+ * afterwards require a new mapping.
+*/
+class MemoryMappedFile {
+public:
+    MemoryMappedFile(const std::string& fileName);
+    const std::string& getFileName() const
+    {
+        return mFileName;
+    };
+    char* data()
+    {
+        return mData;
+    };
+    const char* data() const
+    {
+        return mData;
+    };
+    std::size_t size() const
+    {
+        return mSize;
+    };
+    virtual ~MemoryMappedFile();
+
+private:
+    MemoryMappedFile(const MemoryMappedFile&);
+    MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+    const std::string mFileName;
+    char* mData;
+    std::size_t mSize;
+#ifdef WIN32
+    std::vector<char> mBuffer;
+#endif
+};
+}
+
+#endif // N2D2_MEMORYMAPPEDFILE_H
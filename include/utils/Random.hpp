@@ -105,7 +105,175 @@ namespace Random {
      * @return 1 with probability p and 0 with probability 1-p
     */
     bool randBernoulli(double p = 0.5);
+
+    /**
+     * Counter-based Philox4x32-10 pseudorandom number generator, from J. K.
+     *Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011.
+     * A stream is identified by its (seed, stream) key: streams with different
+     *keys are independent and can be used concurrently by different threads
+     *without any synchronization. The sequence of a stream only depends on
+     *its key, which makes multi-threaded generation reproducible regardless
+     *of the number of threads and their scheduling.
+    */
+    class Stream {
+    public:
+        Stream(unsigned int seed = 0, unsigned int stream = 0);
+
+        /**
+         * Generates uniformly distributed 32-bit integers in the range [0,
+         *(2^32)-1].
+        */
+        unsigned int rand();
+        double randUniform(double vmin = 0.0,
+                           double vmax = 1.0,
+                           Endpoints endpoints = ClosedInterval);
+        int randUniform(int vmin, int vmax);
+        double randNormal(double mean = 0.0, double stdDev = 1.0);
+        bool randBernoulli(double p = 0.5);
+
+        /**
+         * Bulk versions of randUniform(), randNormal() and randBernoulli(),
+         *consuming the generated numbers 4 by 4.
+        */
+        template <class Iterator>
+        void fillUniform(Iterator first,
+                         Iterator last,
+                         double vmin = 0.0,
+                         double vmax = 1.0);
+        template <class Iterator>
+        void fillNormal(Iterator first,
+                        Iterator last,
+                        double mean = 0.0,
+                        double stdDev = 1.0);
+        template <class Iterator>
+        void fillBernoulli(Iterator first, Iterator last, double p = 0.5);
+
+    private:
+        void generate();
+
+        unsigned int mKey[2];
+        unsigned int mCounter[4];
+        unsigned int mBuffer[4];
+        unsigned int mIndex;
+        bool mAvailableDeviate;
+        double mStoredDeviate;
+    };
+
+    /**
+     * While an object of this class is alive, the random functions of this
+     *namespace (mtRand(), randUniform(), randNormal()...) called from the
+     *current thread draw their numbers from a Stream keyed by (seed, stream)
+     *instead of the global Mersenne Twister.
+     * This removes the synchronization on the global generator in parallel
+     *regions and makes their results reproducible: the seed is typically
+     *drawn once with mtRand() before the parallel region and the stream is
+     *the index of the work item.
+     * The code outside of these objects, such as the weights fillers, keeps
+     *drawing from the global generator, so that a given seed gives the same
+     *results; it can opt in by being called within a ThreadStream.
+     * The second constructor redirects the calls to an existing @p stream,
+     *whose state is kept after the destruction of the object, for work items
+     *that are processed by a different thread at each step. It does not
+     *allocate anything, and keeps the current generator if @p stream is NULL.
+    */
+    class ThreadStream {
+    public:
+        ThreadStream(unsigned int seed, unsigned int stream);
+        explicit ThreadStream(Stream* stream);
+        ~ThreadStream();
+
+    private:
+        ThreadStream(const ThreadStream&);
+        ThreadStream& operator=(const ThreadStream&);
+
+        /// Stream owned by the object (first constructor only)
+        Stream* mStream;
+        Stream* mPrevious;
+    };
 }
 }
 
+template <class Iterator>
+void N2D2::Random::Stream::fillUniform(Iterator first,
+                                       Iterator last,
+                                       double vmin,
+                                       double vmax)
+{
+    if (vmax < vmin)
+        throw std::domain_error("Random::Stream::fillUniform(): vmax must be"
+                                " >= vmin.");
+
+    const double scale = (vmax - vmin) / MT_RAND_MAX;
+
+    // Start from a fresh block of 4 numbers
+    mIndex = 4;
+
+    while (first != last) {
+        generate();
+
+        for (unsigned int i = 0; i < 4 && first != last; ++i, ++first)
+            (*first) = vmin + (double)mBuffer[i] * scale;
+    }
+
+    mIndex = 4;
+}
+
+template <class Iterator>
+void N2D2::Random::Stream::fillNormal(Iterator first,
+                                      Iterator last,
+                                      double mean,
+                                      double stdDev)
+{
+    if (stdDev < 0.0)
+        throw std::domain_error("Random::Stream::fillNormal(): standard"
+                                " deviation must be >= 0.");
+
+    mIndex = 4;
+    mAvailableDeviate = false;
+
+    while (first != last) {
+        generate();
+
+        // Box-Muller transform of two pairs of uniform numbers in (0,1]
+        for (unsigned int i = 0; i < 4 && first != last; i += 2) {
+            const double u1 = ((double)mBuffer[i] + 1.0)
+                              / (MT_RAND_MAX + 1.0);
+            const double u2 = ((double)mBuffer[i + 1] + 1.0)
+                              / (MT_RAND_MAX + 1.0);
+            const double r = std::sqrt(-2.0 * std::log(u1));
+            const double theta = 2.0 * M_PI * u2;
+
+            (*first) = mean + stdDev * (r * std::cos(theta));
+            ++first;
+
+            if (first != last) {
+                (*first) = mean + stdDev * (r * std::sin(theta));
+                ++first;
+            }
+        }
+    }
+
+    mIndex = 4;
+}
+
+template <class Iterator>
+void N2D2::Random::Stream::fillBernoulli(Iterator first,
+                                         Iterator last,
+                                         double p)
+{
+    // Same test as randBernoulli(): x in [0,1[ < p
+    const double threshold = p * (MT_RAND_MAX + 1.0);
+
+    mIndex = 4;
+
+    while (first != last) {
+        generate();
+
+        for (unsigned int i = 0; i < 4 && first != last; ++i, ++first)
+            (*first) = ((double)mBuffer[i] < threshold);
+    }
+
+    mIndex = 4;
+}
+
 #endif // N2D2_RANDOM_H
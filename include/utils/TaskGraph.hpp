@@ -0,0 +1,76 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_TASKGRAPH_H
+#define N2D2_TASKGRAPH_H
+
+#include <exception>
+#include <functional>
+#include <vector>
+
+namespace N2D2 {
+/**
+ * Directed acyclic graph of tasks, executed concurrently by the OpenMP
+ * threads: a task is started as soon as all its predecessors completed.
+ * The ready tasks are scheduled with OpenMP tasks, which are dispatched to
+ * the idle threads by the runtime (work-stealing with most runtimes).
+ * A task can use nested OpenMP parallel regions: its number of threads is
+ * the number of threads of the pool divided by the number of tasks running
+ * when it starts.
+*/
+class TaskGraph {
+public:
+    TaskGraph(unsigned int nbNodes = 0);
+    unsigned int addNode();
+
+    /**
+     * Node @p to cannot start before node @p from completed.
+    */
+    void addEdge(unsigned int from, unsigned int to);
+
+    /**
+     * Call func(node) for each node of the graph, in a dependency-compatible
+     * order. If a call throws, the nodes depending on it are not run and the
+     * first exception is rethrown once the running calls completed.
+    */
+    void run(const std::function<void(unsigned int)>& func) const;
+    unsigned int getNbNodes() const
+    {
+        return mSuccessors.size();
+    };
+    virtual ~TaskGraph() {};
+
+private:
+    struct State {
+        const std::function<void(unsigned int)>* func;
+        std::vector<unsigned int> nbPredecessors;
+        unsigned int nbThreads;
+        unsigned int nbRunning;
+        std::exception_ptr exception;
+    };
+
+    void runNode(unsigned int node, State* state) const;
+
+    std::vector<std::vector<unsigned int> > mSuccessors;
+    std::vector<unsigned int> mNbPredecessors;
+};
+}
+
+#endif // N2D2_TASKGRAPH_H
@@ -0,0 +1,233 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#ifndef N2D2_TIMINGWHEEL_H
+#define N2D2_TIMINGWHEEL_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace N2D2 {
+/**
+ * Priority queue of timestamped elements, with the same interface and the
+ * same ordering as std::priority_queue<T, std::vector<T>, Compare>, for
+ * elements whose timestamps are mostly close to the current one.
+ *
+ * The time is divided in slots of @p resolution. The elements of the next
+ * @p nbSlots slots are appended without any ordering in the slots of a
+ * circular wheel (O(1)). Only the elements of the current slot are kept in a
+ * (small) heap ordered by Compare. The elements beyond the horizon of the
+ * wheel are kept in an overflow heap, and are moved into the wheel when it
+ * reaches them.
+ * An element pushed with a timestamp earlier than the current slot goes to
+ * the current heap, and is therefore popped next, like with a
+ * std::priority_queue.
+ *
+ * @p Compare must order the elements by decreasing timestamp first (the top
+ * element is the one with the lowest timestamp), and @p Timestamp returns
+ * the (unsigned integer) timestamp of an element.
+*/
+template <class T, class Compare, class Timestamp>
+class TimingWheel {
+public:
+    typedef unsigned long long int Time_T;
+
+    TimingWheel(Time_T resolution, unsigned int nbSlots = 4096);
+    bool empty() const
+    {
+        return (mSize == 0);
+    };
+    size_t size() const
+    {
+        return mSize;
+    };
+    inline const T& top();
+    inline void push(const T& value);
+    inline void pop();
+    void clear();
+    Time_T getResolution() const
+    {
+        return mResolution;
+    };
+    unsigned int getNbSlots() const
+    {
+        return (mMask + 1);
+    };
+    virtual ~TimingWheel() {};
+
+private:
+    inline Time_T getSlot(const T& value) const;
+    void advance();
+
+    const Time_T mResolution;
+    const Time_T mMask;
+    Compare mCompare;
+    Timestamp mTimestamp;
+    /// Absolute index of the current slot
+    Time_T mCurrentSlot;
+    /// Heap of the elements of the current slot
+    std::vector<T> mCurrent;
+    /// Unordered elements of the next slots (allocated on the first push)
+    std::vector<std::vector<T> > mSlots;
+    size_t mNbInSlots;
+    /// Heap of the elements beyond the horizon of the wheel
+    std::vector<T> mOverflow;
+    size_t mSize;
+};
+}
+
+template <class T, class Compare, class Timestamp>
+N2D2::TimingWheel<T, Compare, Timestamp>::TimingWheel(Time_T resolution,
+                                                      unsigned int nbSlots)
+    : mResolution(resolution),
+      mMask(nbSlots - 1),
+      mCurrentSlot(0),
+      mNbInSlots(0),
+      mSize(0)
+{
+    // ctor
+    if (resolution == 0) {
+        throw std::domain_error("TimingWheel::TimingWheel(): resolution must "
+                                "be > 0");
+    }
+
+    if (nbSlots < 2 || (nbSlots & (nbSlots - 1)) != 0) {
+        throw std::domain_error("TimingWheel::TimingWheel(): the number of "
+                                "slots must be a power of 2");
+    }
+}
+
+template <class T, class Compare, class Timestamp>
+const T& N2D2::TimingWheel<T, Compare, Timestamp>::top()
+{
+    if (mCurrent.empty())
+        advance();
+
+    return mCurrent.front();
+}
+
+template <class T, class Compare, class Timestamp>
+void N2D2::TimingWheel<T, Compare, Timestamp>::push(const T& value)
+{
+    const Time_T slot = getSlot(value);
+
+    if (slot <= mCurrentSlot) {
+        mCurrent.push_back(value);
+        std::push_heap(mCurrent.begin(), mCurrent.end(), mCompare);
+    }
+    else if (slot - mCurrentSlot <= mMask) {
+        if (mSlots.empty())
+            mSlots.resize(mMask + 1);
+
+        mSlots[slot & mMask].push_back(value);
+        ++mNbInSlots;
+    }
+    else {
+        mOverflow.push_back(value);
+        std::push_heap(mOverflow.begin(), mOverflow.end(), mCompare);
+    }
+
+    ++mSize;
+}
+
+template <class T, class Compare, class Timestamp>
+void N2D2::TimingWheel<T, Compare, Timestamp>::pop()
+{
+    if (mCurrent.empty())
+        advance();
+
+    std::pop_heap(mCurrent.begin(), mCurrent.end(), mCompare);
+    mCurrent.pop_back();
+    --mSize;
+}
+
+template <class T, class Compare, class Timestamp>
+void N2D2::TimingWheel<T, Compare, Timestamp>::clear()
+{
+    mCurrent.clear();
+
+    for (typename std::vector<std::vector<T> >::iterator it = mSlots.begin(),
+         itEnd = mSlots.end(); it != itEnd; ++it)
+    {
+        (*it).clear();
+    }
+
+    mOverflow.clear();
+    mNbInSlots = 0;
+    mSize = 0;
+}
+
+template <class T, class Compare, class Timestamp>
+typename N2D2::TimingWheel<T, Compare, Timestamp>::Time_T
+N2D2::TimingWheel<T, Compare, Timestamp>::getSlot(const T& value) const
+{
+    return (mTimestamp(value) / mResolution);
+}
+
+template <class T, class Compare, class Timestamp>
+void N2D2::TimingWheel<T, Compare, Timestamp>::advance()
+{
+    if (mSize == 0)
+        throw std::runtime_error("TimingWheel::advance(): empty wheel");
+
+    if (mSlots.empty())
+        mSlots.resize(mMask + 1);
+
+    // Move to the next non-empty slot. If the wheel is empty, jump directly
+    // to the first element beyond its horizon.
+    while (mCurrent.empty()) {
+        if (mNbInSlots > 0)
+            ++mCurrentSlot;
+        else
+            mCurrentSlot = getSlot(mOverflow.front());
+
+        std::vector<T>& slot = mSlots[mCurrentSlot & mMask];
+
+        if (!slot.empty()) {
+            mNbInSlots -= slot.size();
+            mCurrent.swap(slot);
+            std::make_heap(mCurrent.begin(), mCurrent.end(), mCompare);
+        }
+
+        // The horizon moved forward: the overflow elements within it are
+        // moved into the wheel
+        while (!mOverflow.empty()
+               && getSlot(mOverflow.front()) - mCurrentSlot <= mMask)
+        {
+            const T value = mOverflow.front();
+            std::pop_heap(mOverflow.begin(), mOverflow.end(), mCompare);
+            mOverflow.pop_back();
+
+            const Time_T valueSlot = getSlot(value);
+
+            if (valueSlot == mCurrentSlot) {
+                mCurrent.push_back(value);
+                std::push_heap(mCurrent.begin(), mCurrent.end(), mCompare);
+            }
+            else {
+                mSlots[valueSlot & mMask].push_back(value);
+                ++mNbInSlots;
+            }
+        }
+    }
+}
+
+#endif // N2D2_TIMINGWHEEL_H
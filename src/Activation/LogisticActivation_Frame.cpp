@@ -25,6 +25,7 @@ template <>
 N2D2::Registrar<N2D2::LogisticActivation>
 N2D2::LogisticActivation_Frame<half_float::half>::mRegistrar(
     {"Frame",
+    "Frame_INT8",
     "Transcode",
     "Spike",
     "Spike_Analog",
@@ -38,6 +39,7 @@ template <>
 N2D2::Registrar<N2D2::LogisticActivation>
 N2D2::LogisticActivation_Frame<float>::mRegistrar(
     {"Frame",
+    "Frame_INT8",
     "Transcode",
     "Spike",
     "Spike_Analog",
@@ -51,6 +53,7 @@ template <>
 N2D2::Registrar<N2D2::LogisticActivation>
 N2D2::LogisticActivation_Frame<double>::mRegistrar(
     {"Frame",
+    "Frame_INT8",
     "Transcode",
     "Spike",
     "Spike_Analog",
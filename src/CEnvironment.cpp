@@ -111,9 +111,12 @@ void N2D2::CEnvironment::tick(Time_T timestamp, Time_T start, Time_T stop)
         return;
     }
     if (mNoConversion) {
-        for (unsigned int idx = 0, size = mData.size(); idx < size; ++idx) {
-            mTickData(idx) = mScaling*mData(idx);
-            mTickActivity(idx) += mScaling*mTickData(idx);
+        const Float_T scaling = mScaling;
+
+#pragma omp parallel for if (mData.size() > 1024)
+        for (int idx = 0; idx < (int)mData.size(); ++idx) {
+            mTickData(idx) = scaling * mData(idx);
+            mTickActivity(idx) += mTickData(idx);
         }
 #ifdef CUDA
             mTickActivity.synchronizeHToD();
@@ -123,8 +126,9 @@ void N2D2::CEnvironment::tick(Time_T timestamp, Time_T start, Time_T stop)
     }
 
     AER_Database * aerDatabase = dynamic_cast<AER_Database*>(&mDatabase);
-    if (aerDatabase) {
-
+    if (!aerDatabase) {
+        // The spikes are generated sequentially, as SpikeGenerator::nextEvent()
+        // draws from the global random generator (reproducible results)
         SpikeGenerator::checkParameters();
         for (unsigned int idx = 0, size = mData.size(); idx < size; ++idx) {
             // If next event is valid set mTickData to spiking and search next event,
@@ -177,8 +181,8 @@ void N2D2::CEnvironment::tick(Time_T timestamp, Time_T start, Time_T stop)
             unsigned int y = (*mEventIterator).y;
             unsigned int channel = (*mEventIterator).channel;
 
-            if (x > mTickData.dimX() || y > mTickData.dimY()
-            || channel > mTickData.dimZ()) {
+            if (x >= mTickData.dimX() || y >= mTickData.dimY()
+            || channel >= mTickData.dimZ()) {
                  throw std::runtime_error("Event coordinate out of range");
             }
 
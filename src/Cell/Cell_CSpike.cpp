@@ -0,0 +1,187 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/Cell_CSpike.hpp"
+#include "CEnvironment.hpp"
+#include "DeepNet.hpp"
+
+N2D2::Cell_CSpike::Cell_CSpike(const DeepNet& deepNet,
+                               const std::string& name,
+                               unsigned int nbOutputs)
+    : Cell(deepNet, name, nbOutputs)
+{
+    // ctor
+}
+
+void N2D2::Cell_CSpike::addInput(StimuliProvider& /*sp*/,
+                                 unsigned int /*channel*/,
+                                 unsigned int /*x0*/,
+                                 unsigned int /*y0*/,
+                                 unsigned int /*width*/,
+                                 unsigned int /*height*/,
+                                 const Tensor<bool>& /*mapping*/)
+{
+    throw std::runtime_error("Cell_CSpike::addInput(): adding a single "
+                             "environment channel as input is not supported");
+}
+
+void N2D2::Cell_CSpike::addInput(StimuliProvider& sp,
+                                 unsigned int x0,
+                                 unsigned int y0,
+                                 unsigned int width,
+                                 unsigned int height,
+                                 const Tensor<bool>& mapping)
+{
+    CEnvironment* cEnv = dynamic_cast<CEnvironment*>(&sp);
+
+    if (cEnv == NULL)
+        throw std::runtime_error(
+            "Cell_CSpike::addInput(): CSpike models require CEnvironment");
+
+    if (width == 0)
+        width = sp.getSizeX() - x0;
+    if (height == 0)
+        height = sp.getSizeY() - y0;
+
+    if (x0 > 0 || y0 > 0 || width < sp.getSizeX() || height < sp.getSizeY())
+        throw std::runtime_error("Cell_CSpike::addInput(): adding a cropped "
+                                 "environment channel map as input is not "
+                                 "supported");
+
+    // Define input-output sizes
+    setInputsDims(sp.getSize());
+    mInputs.push_back(&cEnv->getTickData());
+
+    setOutputsDims();
+    resizeOutputs(sp.getBatchSize());
+
+    // Define input-output connections
+    if (!mapping.empty() && mapping.dimY() != sp.getNbChannels())
+        throw std::runtime_error("Cell_CSpike::addInput(): number of mapping "
+                                 "rows must be equal to the number of input "
+                                 "channels");
+
+    mMapping.append((!mapping.empty())
+        ? mapping
+        : Tensor<bool>({getNbOutputs(), sp.getNbChannels()}, true));
+}
+
+void N2D2::Cell_CSpike::addInput(Cell* cell, const Tensor<bool>& mapping)
+{
+    Cell_CSpike_Top* cellCSpike = dynamic_cast<Cell_CSpike_Top*>(cell);
+
+    if (cellCSpike == NULL)
+        throw std::runtime_error(
+            "Cell_CSpike::addInput(): cannot mix CSpike and other models");
+
+    // Define input-output sizes
+    setInputsDims(cell->getOutputsDims());
+    mInputs.push_back(&cellCSpike->getOutputs());
+
+    setOutputsDims();
+    resizeOutputs(mInputs.dimB());
+
+    // Define input-output connections
+    const unsigned int cellNbOutputs = cell->getNbOutputs();
+
+    if (!mapping.empty() && mapping.dimY() != cellNbOutputs)
+        throw std::runtime_error("Cell_CSpike::addInput(): number of mapping "
+                                 "rows must be equal to the number of input "
+                                 "channels");
+
+    mMapping.append((!mapping.empty())
+        ? mapping
+        : Tensor<bool>({getNbOutputs(), cellNbOutputs}, true));
+}
+
+void N2D2::Cell_CSpike::addInput(Cell* cell,
+                                 unsigned int x0,
+                                 unsigned int y0,
+                                 unsigned int width,
+                                 unsigned int height)
+{
+    if (width == 0)
+        width = cell->getOutputsWidth() - x0;
+    if (height == 0)
+        height = cell->getOutputsHeight() - y0;
+
+    if (x0 > 0 || y0 > 0 || width < cell->getOutputsWidth()
+        || height < cell->getOutputsHeight())
+        throw std::runtime_error("Cell_CSpike::addInput(): adding a cropped "
+                                 "output map as input is not supported");
+
+    Cell_CSpike::addInput(cell);
+}
+
+void N2D2::Cell_CSpike::clearInputs()
+{
+    mInputs.clear();
+
+    mInputsDims.clear();
+    mMapping.clear();
+}
+
+void N2D2::Cell_CSpike::reset(Time_T /*timestamp*/)
+{
+    mOutputs.assign(mOutputs.dims(), 0.0);
+    mOutputsActivity.assign(mOutputsActivity.dims(), 0.0);
+}
+
+void N2D2::Cell_CSpike::resizeOutputs(unsigned int batchSize)
+{
+    if (mOutputs.empty()) {
+        std::vector<size_t> outputsDims(mOutputsDims);
+        outputsDims.push_back(batchSize);
+
+        mOutputs.resize(outputsDims, 0.0);
+        mOutputsActivity.resize(outputsDims, 0.0);
+    }
+}
+
+void N2D2::Cell_CSpike::gatherInputsSpikes()
+{
+    const unsigned int batchSize = mInputs.dimB();
+    mInputsSpikes.resize(batchSize);
+
+#pragma omp parallel for if (batchSize > 1)
+    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+        std::vector<std::pair<unsigned int, Float_T> >& inputsSpikes
+            = mInputsSpikes[batchPos];
+        inputsSpikes.clear();
+
+        unsigned int offset = 0;
+
+        for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+            const Tensor<Float_T>& input = mInputs[k];
+            const unsigned int inputSize = input.size() / batchSize;
+            const unsigned int batchOffset = batchPos * inputSize;
+
+            for (unsigned int index = 0; index < inputSize; ++index) {
+                const Float_T value = input(batchOffset + index);
+
+                if (value != 0.0)
+                    inputsSpikes.push_back(std::make_pair(offset + index,
+                                                          value));
+            }
+
+            offset += inputSize;
+        }
+    }
+}
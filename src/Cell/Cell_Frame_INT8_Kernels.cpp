@@ -0,0 +1,90 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "Cell/Cell_Frame_INT8_Kernels.hpp"
+
+int N2D2::Cell_Frame_INT8_Kernels::getInputsOffset(const float* inputs,
+                                                   std::size_t size)
+{
+    float minVal = 0.0f;
+    float maxVal = 0.0f;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        if (inputs[i] != std::round(inputs[i]))
+            return -1;
+
+        minVal = std::min(minVal, inputs[i]);
+        maxVal = std::max(maxVal, inputs[i]);
+    }
+
+    if (minVal >= 0.0f && maxVal <= 255.0f)
+        return 0;
+    else if (minVal >= -128.0f && maxVal <= 127.0f)
+        return 128;
+    else
+        return -1;
+}
+
+void N2D2::Cell_Frame_INT8_Kernels::convertInputs(const float* inputs,
+                                                  std::size_t size,
+                                                  int offset,
+                                                  uint8_t* outputs)
+{
+    for (std::size_t i = 0; i < size; ++i)
+        outputs[i] = (uint8_t)((int)inputs[i] + offset);
+}
+
+bool N2D2::Cell_Frame_INT8_Kernels::convertWeights(const float* weights,
+                                                   std::size_t size,
+                                                   int8_t* outputs)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        if (weights[i] != std::round(weights[i])
+            || weights[i] < -128.0f || weights[i] > 127.0f)
+        {
+            return false;
+        }
+
+        outputs[i] = (int8_t)weights[i];
+    }
+
+    return true;
+}
+
+bool N2D2::Cell_Frame_INT8_Kernels::convertBiases(const float* biases,
+                                                  std::size_t size,
+                                                  int32_t* outputs)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        // 2^31 is exactly representable in float
+        if (biases[i] != std::round(biases[i])
+            || biases[i] < -2147483648.0f || biases[i] >= 2147483648.0f)
+        {
+            return false;
+        }
+
+        outputs[i] = (int32_t)biases[i];
+    }
+
+    return true;
+}
@@ -35,7 +35,8 @@ N2D2::Cell_Spike::Cell_Spike(Network& net, const DeepNet& deepNet,
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().
       mIncomingDelay(this, "IncomingDelay", 1 * TimePs, 100 * TimeFs),
-      mNet(net)
+      mNet(net),
+      mPartitionDelay(0)
 {
     // ctor
 }
@@ -226,6 +227,37 @@ void N2D2::Cell_Spike::clearInputs() {
     throw std::runtime_error("Cell_Spike::clearInputs(): not supported.");
 }
 
+void N2D2::Cell_Spike::setPartition(unsigned int partition)
+{
+    for (std::vector<NodeIn*>::const_iterator it = mInputs.begin(),
+         itEnd = mInputs.end(); it != itEnd; ++it)
+    {
+        (*it)->setPartition(partition);
+    }
+
+    for (Tensor<NodeOut*>::const_iterator it = mOutputs.begin(),
+         itEnd = mOutputs.end(); it != itEnd; ++it)
+    {
+        (*it)->setPartition(partition);
+    }
+
+    mPartitionDelay = getMinDelay();
+}
+
+bool N2D2::Cell_Spike::isPartitionBoundary() const
+{
+    for (std::vector<NodeIn*>::const_iterator it = mInputs.begin(),
+         itEnd = mInputs.end(); it != itEnd; ++it)
+    {
+        const Node* parent = (*it)->getParent();
+
+        if (parent != NULL && parent->getPartition() != (*it)->getPartition())
+            return true;
+    }
+
+    return false;
+}
+
 void N2D2::Cell_Spike::populateOutputs()
 {
     if (mOutputs.empty()) {
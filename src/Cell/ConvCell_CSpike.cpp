@@ -0,0 +1,275 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/ConvCell_CSpike.hpp"
+#include "DeepNet.hpp"
+#include "Filler/NormalFiller.hpp"
+
+N2D2::Registrar<N2D2::ConvCell>
+N2D2::ConvCell_CSpike::mRegistrar("CSpike",
+    N2D2::ConvCell_CSpike::create,
+    N2D2::Registrar<N2D2::ConvCell>::Type<Float_T>());
+
+N2D2::ConvCell_CSpike::ConvCell_CSpike(const DeepNet& deepNet,
+                                 const std::string& name,
+                                 const std::vector<unsigned int>& kernelDims,
+                                 unsigned int nbOutputs,
+                                 const std::vector<unsigned int>& subSampleDims,
+                                 const std::vector<unsigned int>& strideDims,
+                                 const std::vector<int>& paddingDims,
+                                 const std::vector<unsigned int>& dilationDims)
+    : Cell(deepNet, name, nbOutputs),
+      ConvCell(deepNet, name,
+               kernelDims,
+               nbOutputs,
+               subSampleDims,
+               strideDims,
+               paddingDims,
+               dilationDims),
+      Cell_CSpike(deepNet, name, nbOutputs),
+      // IMPORTANT: Do not change the value of the parameters here! Use
+      // setParameter() or loadParameters().
+      mThreshold(this, "Threshold", 1.0),
+      mBipolarThreshold(this, "BipolarThreshold", true),
+      mLeak(this, "Leak", 0.0),
+      mRefractory(this, "Refractory", 0 * TimeS),
+      mLastTick(0)
+{
+    // ctor
+    if (mKernelDims.size() != 2) {
+        throw std::domain_error("ConvCell_CSpike: only 2D convolution is"
+                                " supported");
+    }
+
+    mWeightsFiller = std::make_shared<NormalFiller<Float_T> >(0.0, 0.05);
+    mBiasFiller = std::make_shared<NormalFiller<Float_T> >(0.0, 0.05);
+}
+
+void N2D2::ConvCell_CSpike::setExtendedPadding(
+    const std::vector<int>& /*paddingDims*/)
+{
+    throw std::domain_error("ConvCell_CSpike: extended padding is currently"
+                            " not supported.");
+}
+
+void N2D2::ConvCell_CSpike::initialize()
+{
+    if (mSharedSynapses.empty()) {
+        mSharedSynapses.resize({mKernelDims[0], mKernelDims[1],
+                                getNbChannels(), getNbOutputs()});
+        mWeightsFiller->apply(mSharedSynapses);
+    }
+
+    if (mBias.empty()) {
+        mBias.resize({getNbOutputs()}, 0.0);
+
+        if (!mNoBias)
+            mBiasFiller->apply(mBias);
+    }
+
+    mOutputsIntegration.resize(mOutputs.dims(), 0.0);
+    mOutputsRefractoryEnd.resize(mOutputs.dims(), 0);
+}
+
+bool N2D2::ConvCell_CSpike::tick(Time_T timestamp)
+{
+    gatherInputsSpikes();
+
+    const unsigned int outputsWidth = mOutputs.dimX();
+    const unsigned int outputsHeight = mOutputs.dimY();
+    const unsigned int outputSize = outputsWidth * outputsHeight;
+    const unsigned int nbOutputs = getNbOutputs();
+    const unsigned int batchSize = mOutputs.dimB();
+    const unsigned int inputSize = mInputsDims[0] * mInputsDims[1];
+
+    // Number of output positions before sub-sampling
+    const int nbOx = ((int)mInputsDims[0] + 2 * mPaddingDims[0]
+        - (int)(mDilationDims[0] * (mKernelDims[0] - 1) + 1)
+        + (int)mStrideDims[0]) / (int)mStrideDims[0];
+    const int nbOy = ((int)mInputsDims[1] + 2 * mPaddingDims[1]
+        - (int)(mDilationDims[1] * (mKernelDims[1] - 1) + 1)
+        + (int)mStrideDims[1]) / (int)mStrideDims[1];
+
+    const double expVal = (mLeak > 0)
+        ? -((double)(timestamp - mLastTick) / (double)mLeak) : 0.0;
+    const Float_T leak = (expVal > std::log(1e-20)) ? std::exp(expVal) : 0.0;
+    const Float_T threshold = mThreshold;
+    const bool bipolarThreshold = mBipolarThreshold;
+    const Time_T refractory = mRefractory;
+
+#pragma omp parallel for collapse(2) if (batchSize * nbOutputs > 16)
+    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+        for (int output = 0; output < (int)nbOutputs; ++output) {
+            const unsigned int offset = outputSize
+                * (output + nbOutputs * batchPos);
+            Float_T* integration = &mOutputsIntegration(offset);
+
+            // Leak
+            if (leak != 1.0) {
+                for (unsigned int index = 0; index < outputSize; ++index)
+                    integration[index] *= leak;
+            }
+
+            // Integrate the input spikes
+            const std::vector<std::pair<unsigned int, Float_T> >&
+                inputsSpikes = mInputsSpikes[batchPos];
+
+            for (std::vector<std::pair<unsigned int, Float_T> >
+                ::const_iterator it = inputsSpikes.begin(),
+                itEnd = inputsSpikes.end(); it != itEnd; ++it)
+            {
+                const unsigned int channel = (*it).first / inputSize;
+
+                if (!isConnection(channel, output))
+                    continue;
+
+                const int ix = (*it).first % mInputsDims[0]
+                    + mPaddingDims[0];
+                const int iy = ((*it).first / mInputsDims[0]) % mInputsDims[1]
+                    + mPaddingDims[1];
+                const Float_T* kernel = &mSharedSynapses(0, 0, channel, output);
+
+                for (unsigned int sy = 0; sy < mKernelDims[1]; ++sy) {
+                    const int dy = iy - (int)(sy * mDilationDims[1]);
+
+                    if (dy < 0)
+                        break;
+
+                    if (dy % (int)mStrideDims[1] != 0
+                        || dy / (int)mStrideDims[1] >= nbOy)
+                    {
+                        continue;
+                    }
+
+                    const unsigned int oy = (dy / (int)mStrideDims[1])
+                        / mSubSampleDims[1];
+
+                    for (unsigned int sx = 0; sx < mKernelDims[0]; ++sx) {
+                        const int dx = ix - (int)(sx * mDilationDims[0]);
+
+                        if (dx < 0)
+                            break;
+
+                        if (dx % (int)mStrideDims[0] != 0
+                            || dx / (int)mStrideDims[0] >= nbOx)
+                        {
+                            continue;
+                        }
+
+                        const unsigned int ox = (dx / (int)mStrideDims[0])
+                            / mSubSampleDims[0];
+
+                        integration[ox + outputsWidth * oy] += (*it).second
+                            * kernel[sx + mKernelDims[0] * sy];
+                    }
+                }
+            }
+
+            // Bias
+            if (!mNoBias) {
+                for (unsigned int index = 0; index < outputSize; ++index)
+                    integration[index] += mBias(output);
+            }
+
+            // Fire
+            for (unsigned int index = 0; index < outputSize; ++index) {
+                Float_T& outputSpike = mOutputs(offset + index);
+                Time_T& refractoryEnd = mOutputsRefractoryEnd(offset + index);
+
+                if ((integration[index] >= threshold
+                     || (bipolarThreshold
+                         && (-integration[index]) >= threshold))
+                    && timestamp >= refractoryEnd)
+                {
+                    outputSpike = (integration[index] < 0) ? -1.0 : 1.0;
+                    integration[index] -= outputSpike * threshold;
+                    refractoryEnd = timestamp + refractory;
+                }
+                else
+                    outputSpike = 0.0;
+
+                mOutputsActivity(offset + index) += outputSpike;
+            }
+        }
+    }
+
+    mLastTick = timestamp;
+    return false;
+}
+
+void N2D2::ConvCell_CSpike::reset(Time_T timestamp)
+{
+    Cell_CSpike::reset(timestamp);
+
+    mOutputsIntegration.assign(mOutputs.dims(), 0.0);
+    mOutputsRefractoryEnd.assign(mOutputs.dims(), 0);
+    mLastTick = timestamp;
+}
+
+void N2D2::ConvCell_CSpike::saveFreeParameters(const std::string& fileName)
+    const
+{
+    std::ofstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good())
+        throw std::runtime_error("Could not create synaptic file (.SYN): "
+                                 + fileName);
+
+    mSharedSynapses.save(syn);
+
+    if (!mNoBias)
+        mBias.save(syn);
+
+    if (!syn.good())
+        throw std::runtime_error("Error writing synaptic file: " + fileName);
+}
+
+void N2D2::ConvCell_CSpike::loadFreeParameters(const std::string& fileName,
+                                               bool ignoreNotExists)
+{
+    std::ifstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good()) {
+        if (ignoreNotExists) {
+            std::cout << Utils::cnotice
+                      << "Notice: Could not open synaptic file (.SYN): "
+                      << fileName << Utils::cdef << std::endl;
+            return;
+        } else
+            throw std::runtime_error("Could not open synaptic file (.SYN): "
+                                     + fileName);
+    }
+
+    mSharedSynapses.load(syn);
+
+    if (!mNoBias)
+        mBias.load(syn);
+
+    if (syn.eof())
+        throw std::runtime_error(
+            "End-of-file reached prematurely in synaptic file (.SYN): "
+            + fileName);
+    else if (!syn.good())
+        throw std::runtime_error("Error while reading synaptic file (.SYN): "
+                                 + fileName);
+    else if (syn.get() != std::fstream::traits_type::eof())
+        throw std::runtime_error(
+            "Synaptic file (.SYN) size larger than expected: " + fileName);
+}
@@ -64,6 +64,7 @@ N2D2::ConvCell_Frame<T>::ConvCell_Frame(const DeepNet& deepNet, const std::strin
       Cell_Frame<T>(deepNet, name, nbOutputs, activation),
       // IMPORTANT: Do not change the value of the parameters here! Use
       // setParameter() or loadParameters().
+      mAlgorithm(this, "Algorithm", ConvCell_Frame_Kernels::Auto),
       mBias(std::make_shared<Tensor<T> >()),
       mDiffBias({1, 1, getNbOutputs(), 1}),
       mConvDesc(mSubSampleDims, mStrideDims, mPaddingDims, mDilationDims)
@@ -126,6 +127,8 @@ void N2D2::ConvCell_Frame<T>::setExtendedPadding(
 template <class T>
 void N2D2::ConvCell_Frame<T>::initialize()
 {
+    mConvDesc.algorithm = mAlgorithm;
+
     if (!mNoBias) {
         if (mBias->empty()) {
             mBias->resize({1, 1, getNbOutputs(), 1});
@@ -149,6 +152,8 @@ void N2D2::ConvCell_Frame<T>::initialize()
             continue;  // already initialized, skip!
 
         mWeightsSolvers.push_back(mWeightsSolver->clone());
+        mWinogradFilters.push_back(
+            ConvCell_Frame_Kernels::WinogradFilters<T>());
 
         typename std::map<unsigned int,
             std::pair<Interface<T>*, unsigned int> >::iterator
@@ -239,7 +244,9 @@ void N2D2::ConvCell_Frame<T>::propagate(bool inference)
                                         mConvDesc,
                                         &beta,
                                         mOutputs,
-                                        mMapping.rows(offset, mInputs[k].dimZ()));
+                                        mMapping.rows(offset, mInputs[k].dimZ()),
+                                        &mWorkspace,
+                                        getWinogradFilters(k));
 
         offset += mInputs[k].dimZ();
     }
@@ -278,7 +285,8 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
                                                &beta,
                                                mDiffSharedSynapses[k],
                                                mMapping.rows(offset,
-                                                          mInputs[k].dimZ()));
+                                                          mInputs[k].dimZ()),
+                                               &mWorkspace);
 
         mDiffSharedSynapses[k].setValid();
         offset += mInputs[k].dimZ();
@@ -310,7 +318,9 @@ void N2D2::ConvCell_Frame<T>::backPropagate()
                                                  &beta,
                                                  diffOutput,
                                                  mMapping.rows(offset,
-                                                            mInputs[k].dimZ()));
+                                                            mInputs[k].dimZ()),
+                                                 &mWorkspace,
+                                                 getWinogradFilters(k));
 
             offset += mInputs[k].dimZ();
 
@@ -329,6 +339,7 @@ void N2D2::ConvCell_Frame<T>::update()
         if (mDiffSharedSynapses[k].isValid()) {
             mWeightsSolvers[k]->update(
                 mSharedSynapses[k], mDiffSharedSynapses[k], mInputs.dimB());
+            mWinogradFilters[k].valid = false;
         }
     }
 
@@ -349,6 +360,7 @@ void N2D2::ConvCell_Frame<T>::setWeights(unsigned int k,
     }
 
     mExtSharedSynapses[k] = std::make_pair(weightsInterface, offset);
+    invalidateWinogradFilters();
 }
 
 template <class T>
@@ -358,7 +370,11 @@ void N2D2::ConvCell_Frame<T>::checkGradient(double epsilon, double maxError)
     gc.initialize(mInputs,
                   mOutputs,
                   mDiffInputs,
-                  std::bind(&ConvCell_Frame<T>::propagate, this, false),
+                  [this](bool /*inference*/) {
+                      // The weights are perturbed between each propagation
+                      invalidateWinogradFilters();
+                      propagate(false);
+                  },
                   std::bind(&ConvCell_Frame<T>::backPropagate, this));
 
     for (unsigned int k = 0, size = mSharedSynapses.size(); k < size; ++k) {
@@ -424,6 +440,8 @@ void N2D2::ConvCell_Frame<T>::loadFreeParameters(const std::string& fileName,
     for (unsigned int k = 0; k < mSharedSynapses.size(); ++k)
         mSharedSynapses[k].load(syn);
 
+    invalidateWinogradFilters();
+
     if (!mNoBias)
         mBias->load(syn);
 
@@ -439,6 +457,15 @@ void N2D2::ConvCell_Frame<T>::loadFreeParameters(const std::string& fileName,
             "Synaptic file (.SYN) size larger than expected: " + fileName);
 }
 
+template <class T>
+N2D2::ConvCell_Frame_Kernels::WinogradFilters<T>*
+N2D2::ConvCell_Frame<T>::getWinogradFilters(unsigned int k)
+{
+    // External weights may be updated by another cell: the cache is then
+    // only reused if they did not change (see WinogradFilters)
+    return &mWinogradFilters[k];
+}
+
 template <class T>
 N2D2::ConvCell_Frame<T>::~ConvCell_Frame()
 {
@@ -0,0 +1,390 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/Cell_Frame_INT8_Kernels.hpp"
+#include "Cell/ConvCell_Frame_INT8.hpp"
+#include "DeepNet.hpp"
+#include "utils/Gemm.hpp"
+
+N2D2::Registrar<N2D2::ConvCell>
+N2D2::ConvCell_Frame_INT8::mRegistrar("Frame_INT8",
+    N2D2::ConvCell_Frame_INT8::create,
+    N2D2::Registrar<N2D2::ConvCell>::Type<float>());
+
+namespace {
+    // Maximum size of the unfolded inputs of a thread, in bytes
+    const std::size_t MAX_COLUMNS_SIZE = (1 << 20);
+
+    /**
+     * Unfold the receptive fields of the output positions [p0, p0 + nbP[
+     * (p = oy * oxSize + ox) into a nbP x (nbChannels * kernelY * kernelX)
+     * matrix, with the same channel, y, x order as the kernels. Positions
+     * falling into the padding are set to padValue, the integer zero.
+    */
+    void im2colInt8(const uint8_t* image,
+                    unsigned int nbChannels,
+                    unsigned int imageX,
+                    unsigned int imageY,
+                    unsigned int kernelX,
+                    unsigned int kernelY,
+                    const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                    unsigned int oxSize,
+                    unsigned int p0,
+                    unsigned int nbP,
+                    uint8_t padValue,
+                    uint8_t* columns)
+    {
+        unsigned int ox = p0 % oxSize;
+        unsigned int oy = p0 / oxSize;
+
+        for (unsigned int p = 0; p < nbP; ++p) {
+            const int ix0 = (int)(ox * desc.stride[0]) - desc.padding[0];
+            const int iy0 = (int)(oy * desc.stride[1]) - desc.padding[1];
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                const uint8_t* channelData = image + channel * imageX * imageY;
+
+                for (unsigned int sy = 0; sy < kernelY; ++sy) {
+                    const int iy = iy0 + (int)sy;
+
+                    for (unsigned int sx = 0; sx < kernelX; ++sx) {
+                        const int ix = ix0 + (int)sx;
+
+                        *columns++ = (ix >= 0 && ix < (int)imageX
+                                      && iy >= 0 && iy < (int)imageY)
+                            ? channelData[iy * imageX + ix]
+                            : padValue;
+                    }
+                }
+            }
+
+            if (++ox == oxSize) {
+                ox = 0;
+                ++oy;
+            }
+        }
+    }
+}
+
+N2D2::ConvCell_Frame_INT8::ConvCell_Frame_INT8(const DeepNet& deepNet,
+                                 const std::string& name,
+                                 const std::vector<unsigned int>& kernelDims,
+                                 unsigned int nbOutputs,
+                                 const std::vector<unsigned int>& subSampleDims,
+                                 const std::vector<unsigned int>& strideDims,
+                                 const std::vector<int>& paddingDims,
+                                 const std::vector<unsigned int>& dilationDims,
+                                 const std::shared_ptr
+                                 <Activation>& activation)
+    : Cell(deepNet, name, nbOutputs),
+      ConvCell(deepNet, name,
+               kernelDims,
+               nbOutputs,
+               subSampleDims,
+               strideDims,
+               paddingDims,
+               dilationDims),
+      ConvCell_Frame<float>(deepNet, name,
+                            kernelDims,
+                            nbOutputs,
+                            subSampleDims,
+                            strideDims,
+                            paddingDims,
+                            dilationDims,
+                            activation),
+      mFreeParametersInt8Valid(false),
+      mFreeParametersInt8(false)
+{
+    // ctor
+}
+
+void N2D2::ConvCell_Frame_INT8::initialize()
+{
+    ConvCell_Frame<float>::initialize();
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::ConvCell_Frame_INT8::propagate(bool inference)
+{
+    // Without SIMD instructions, the integer GEMM is slower than the float
+    // one
+    if (!inference || !Gemm::gemmInt8Accelerated() || !propagateInt8()) {
+        ConvCell_Frame<float>::propagate(inference);
+        return;
+    }
+
+    Cell_Frame<float>::propagate(inference);
+    mDiffInputs.clearValid();
+    mDiffSharedSynapses.clearValid();
+    mDiffBias.clearValid();
+}
+
+void N2D2::ConvCell_Frame_INT8::update()
+{
+    ConvCell_Frame<float>::update();
+    mFreeParametersInt8Valid = false;
+}
+
+N2D2::BaseInterface* N2D2::ConvCell_Frame_INT8::getWeights()
+{
+    // The weights may be modified through the returned interface
+    mFreeParametersInt8Valid = false;
+    return ConvCell_Frame<float>::getWeights();
+}
+
+void N2D2::ConvCell_Frame_INT8::setWeights(unsigned int k,
+                                           BaseInterface* weights,
+                                           unsigned int offset)
+{
+    ConvCell_Frame<float>::setWeights(k, weights, offset);
+    mFreeParametersInt8Valid = false;
+}
+
+std::shared_ptr<N2D2::BaseTensor> N2D2::ConvCell_Frame_INT8::getBiases()
+{
+    // The biases may be modified through the returned tensor
+    mFreeParametersInt8Valid = false;
+    return ConvCell_Frame<float>::getBiases();
+}
+
+void N2D2::ConvCell_Frame_INT8::setBiases(
+    const std::shared_ptr<BaseTensor>& biases)
+{
+    ConvCell_Frame<float>::setBiases(biases);
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::ConvCell_Frame_INT8::loadFreeParameters(const std::string& fileName,
+                                                   bool ignoreNotExists)
+{
+    ConvCell_Frame<float>::loadFreeParameters(fileName, ignoreNotExists);
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::ConvCell_Frame_INT8::setWeight(unsigned int output,
+                                          unsigned int channel,
+                                          const BaseTensor& value)
+{
+    ConvCell_Frame<float>::setWeight(output, channel, value);
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::ConvCell_Frame_INT8::setBias(unsigned int output,
+                                        const BaseTensor& value)
+{
+    ConvCell_Frame<float>::setBias(output, value);
+    mFreeParametersInt8Valid = false;
+}
+
+bool N2D2::ConvCell_Frame_INT8::convertFreeParameters()
+{
+    const unsigned int nbOutputs = mOutputs.dimZ();
+    const unsigned int nbInputs = mInputs.size();
+
+    mBiasesInt8.assign(nbOutputs, 0);
+
+    if (!mNoBias && !Cell_Frame_INT8_Kernels::convertBiases(&(*mBias)(0),
+                                                            nbOutputs,
+                                                            &mBiasesInt8[0]))
+    {
+        return false;
+    }
+
+    unsigned int channelOffset = 0;
+
+    mWeightsInt8.resize(nbInputs);
+    mWeightsInt8Sums.resize(nbInputs);
+
+    for (unsigned int k = 0; k < nbInputs; ++k) {
+        const Tensor<float>& sharedSynapses = mSharedSynapses[k];
+        const unsigned int nbChannels = sharedSynapses.dimZ();
+        const unsigned int kernelSize = sharedSynapses.dimX()
+                                        * sharedSynapses.dimY();
+        const unsigned int K = kernelSize * nbChannels;
+
+        mWeightsInt8[k].resize(sharedSynapses.size());
+        mWeightsInt8Sums[k].assign(nbOutputs, 0);
+
+        // Unconnected channels get null weights, so that the dense integer
+        // GEMM can be used for any connectivity map
+        const Tensor<bool> maps = mMapping.rows(channelOffset, nbChannels);
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            int8_t* weights = &mWeightsInt8[k][0] + output * K;
+
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                if (!maps.empty() && !maps(output, channel)) {
+                    std::fill(weights + channel * kernelSize,
+                              weights + (channel + 1) * kernelSize, 0);
+                }
+                else if (!Cell_Frame_INT8_Kernels::convertWeights(
+                    &sharedSynapses(0, 0, channel, output), kernelSize,
+                    weights + channel * kernelSize))
+                {
+                    return false;
+                }
+            }
+
+            int32_t sum = 0;
+
+            for (unsigned int i = 0; i < K; ++i)
+                sum += weights[i];
+
+            mWeightsInt8Sums[k][output] = sum;
+        }
+
+        channelOffset += nbChannels;
+    }
+
+    return true;
+}
+
+bool N2D2::ConvCell_Frame_INT8::propagateInt8()
+{
+    if (!isQuantized() || getQuantizedNbBits() > 8
+        || mSubSampleDims[0] > 1 || mSubSampleDims[1] > 1)
+    {
+        return false;
+    }
+
+    // External shared weights may be modified by their own cell
+    if (!mFreeParametersInt8Valid || !mExtSharedSynapses.empty()) {
+        mFreeParametersInt8 = convertFreeParameters();
+        mFreeParametersInt8Valid = true;
+    }
+
+    if (!mFreeParametersInt8)
+        return false;
+
+    mInputs.synchronizeDBasedToH();
+
+    const unsigned int nbOutputs = mOutputs.dimZ();
+    const unsigned int nbInputs = mInputs.size();
+
+    // Integer biases, minus the contribution of the inputs offsets
+    std::vector<int32_t> biases(mBiasesInt8);
+    std::vector<int> offsets(nbInputs);
+    unsigned int maxK = 0;
+
+    mInputsInt8.resize(nbInputs);
+
+    for (unsigned int k = 0; k < nbInputs; ++k) {
+        const Tensor<float>& input = tensor_cast<float>(mInputs[k]);
+        const Tensor<float>& sharedSynapses = mSharedSynapses[k];
+        const unsigned int K = sharedSynapses.dimX() * sharedSynapses.dimY()
+                               * sharedSynapses.dimZ();
+
+        offsets[k] = Cell_Frame_INT8_Kernels::getInputsOffset(&input(0),
+                                                              input.size());
+
+        if (offsets[k] < 0)
+            return false;
+
+        if (offsets[k] != 0) {
+            for (unsigned int output = 0; output < nbOutputs; ++output)
+                biases[output] -= offsets[k] * mWeightsInt8Sums[k][output];
+        }
+
+        mInputsInt8[k].resize(input.size());
+        Cell_Frame_INT8_Kernels::convertInputs(&input(0), input.size(),
+                                               offsets[k], &mInputsInt8[k][0]);
+
+        maxK = std::max(maxK, K);
+    }
+
+    // Split each image in chunks of output positions, to bound the size of
+    // the unfolded inputs and keep every thread busy
+    const unsigned int oxSize = mOutputs.dimX();
+    const unsigned int N = mOutputs.dimX() * mOutputs.dimY();
+    const unsigned int nbBatches = mOutputs.dimB();
+    const unsigned int chunk = std::min<std::size_t>(N,
+        std::max<std::size_t>(64, MAX_COLUMNS_SIZE / std::max(maxK, 1U)));
+    const unsigned int nbChunks = (N + chunk - 1) / chunk;
+    const int size = nbBatches * nbChunks;
+
+#ifdef _OPENMP
+    const unsigned int nbThreads = omp_get_max_threads();
+#else
+    const unsigned int nbThreads = 1;
+#endif
+
+    if (mColumnsInt8.size() < nbThreads) {
+        mColumnsInt8.resize(nbThreads);
+        mAccumulators.resize(nbThreads);
+    }
+
+#pragma omp parallel for schedule(dynamic) if (size > 1)
+    for (int task = 0; task < size; ++task) {
+        const unsigned int batchPos = task / nbChunks;
+        const unsigned int p0 = (task % nbChunks) * chunk;
+        const unsigned int nbP = std::min(chunk, N - p0);
+
+#ifdef _OPENMP
+        const unsigned int thread = omp_get_thread_num();
+#else
+        const unsigned int thread = 0;
+#endif
+        std::vector<uint8_t>& columns = mColumnsInt8[thread];
+        std::vector<int32_t>& acc = mAccumulators[thread];
+
+        if (columns.size() < (std::size_t)maxK * nbP)
+            columns.resize((std::size_t)maxK * nbP);
+
+        if (acc.size() < (std::size_t)nbOutputs * nbP)
+            acc.resize((std::size_t)nbOutputs * nbP);
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            std::fill(acc.begin() + output * nbP,
+                      acc.begin() + (output + 1) * nbP, biases[output]);
+        }
+
+        for (unsigned int k = 0; k < nbInputs; ++k) {
+            const Tensor<float>& sharedSynapses = mSharedSynapses[k];
+            const unsigned int nbChannels = sharedSynapses.dimZ();
+            const unsigned int imageX = mInputs[k].dimX();
+            const unsigned int imageY = mInputs[k].dimY();
+            const unsigned int K = sharedSynapses.dimX()
+                                   * sharedSynapses.dimY() * nbChannels;
+
+            im2colInt8(&mInputsInt8[k][0]
+                            + batchPos * nbChannels * imageX * imageY,
+                       nbChannels, imageX, imageY,
+                       sharedSynapses.dimX(), sharedSynapses.dimY(),
+                       mConvDesc, oxSize, p0, nbP, (uint8_t)offsets[k],
+                       &columns[0]);
+
+            // acc[nbOutputs x nbP] += weights[nbOutputs x K]
+            //                         * columns[nbP x K]^T
+            Gemm::gemmInt8(nbOutputs, nbP, K,
+                           &mWeightsInt8[k][0], K,
+                           &columns[0], K,
+                           &acc[0], nbP);
+        }
+
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            float* outputData = &mOutputs(0, 0, output, batchPos) + p0;
+
+            for (unsigned int p = 0; p < nbP; ++p)
+                outputData[p] = (float)acc[output * nbP + p];
+        }
+    }
+
+    return true;
+}
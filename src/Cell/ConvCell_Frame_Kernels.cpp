@@ -18,11 +18,801 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "Cell/ConvCell_Frame_Kernels.hpp"
 #include "containers/Tensor.hpp"
 #include "third_party/half.hpp"
+#include "utils/Gemm.hpp"
 #include "utils/Utils.hpp"
 
+namespace {
+    // Maximum size of the im2col buffer of a thread, in number of elements
+    const std::size_t MAX_COLUMNS_SIZE = (1 << 20);
+
+    unsigned int getNbThreads()
+    {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    unsigned int getThreadNum()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    template <class T>
+    void initWorkspace(N2D2::ConvCell_Frame_Kernels::Workspace<T>& workspace)
+    {
+        const unsigned int nbThreads = getNbThreads();
+
+        if (workspace.columns.size() < nbThreads) {
+            workspace.columns.resize(nbThreads);
+            workspace.packing.resize(nbThreads);
+        }
+    }
+
+    /**
+     * Return true if the GEMM algorithm can be used for this convolution.
+     * The image dimensions are the input (resp. output) dimensions for the
+     * forward (resp. backward data) computation.
+    */
+    template <class T>
+    bool useGemm(const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                 const N2D2::Tensor<T>& images,
+                 const N2D2::Tensor<T>& sharedSynapses,
+                 const N2D2::Tensor<T>& outputs,
+                 unsigned int oxSize,
+                 unsigned int oySize,
+                 const N2D2::Tensor<bool>& maps)
+    {
+        if (desc.algorithm == N2D2::ConvCell_Frame_Kernels::Direct
+            || desc.subSample[0] > 1 || desc.subSample[1] > 1)
+        {
+            return false;
+        }
+
+        if (sharedSynapses.nbDims() != 4 || images.nbDims() != 4
+            || outputs.nbDims() != 4
+            || sharedSynapses.dimZ() != images.dimZ()
+            || sharedSynapses.dimB() != outputs.dimZ()
+            || outputs.dimX() != oxSize || outputs.dimY() != oySize
+            || outputs.dimB() != images.dimB())
+        {
+            return false;
+        }
+
+        // Sparse connectivity is only handled by the direct algorithm
+        return (maps.empty()
+            || std::find(maps.begin(), maps.end(), false) == maps.end());
+    }
+
+    /**
+     * Unfold the receptive fields of the output positions [p0, p0 + nbP[
+     * (p = oy * oxSize + ox) into a (nbChannels * kernelY * kernelX) x nbP
+     * matrix. Positions falling into the padding are set to 0.
+    */
+    template <class T>
+    void im2col(const T* image,
+                unsigned int nbChannels,
+                unsigned int imageX,
+                unsigned int imageY,
+                unsigned int kernelX,
+                unsigned int kernelY,
+                const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                unsigned int oxSize,
+                unsigned int p0,
+                unsigned int nbP,
+                T* columns)
+    {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            const T* channelData = image + channel * imageX * imageY;
+
+            for (unsigned int sy = 0; sy < kernelY; ++sy) {
+                for (unsigned int sx = 0; sx < kernelX; ++sx) {
+                    unsigned int ox = p0 % oxSize;
+                    unsigned int oy = p0 / oxSize;
+
+                    for (unsigned int p = 0; p < nbP; ++p) {
+                        const int ix = (int)(ox * desc.stride[0] + sx)
+                            - desc.padding[0];
+                        const int iy = (int)(oy * desc.stride[1] + sy)
+                            - desc.padding[1];
+
+                        columns[p] = (ix >= 0 && ix < (int)imageX
+                                      && iy >= 0 && iy < (int)imageY)
+                            ? channelData[iy * imageX + ix]
+                            : T(0.0);
+
+                        if (++ox == oxSize) {
+                            ox = 0;
+                            ++oy;
+                        }
+                    }
+
+                    columns += nbP;
+                }
+            }
+        }
+    }
+
+    /**
+     * Inverse of im2col(): accumulate a (nbChannels * kernelY * kernelX) x nbP
+     * matrix into the image. Positions falling into the padding are dropped.
+    */
+    template <class T>
+    void col2im(const T* columns,
+                unsigned int nbChannels,
+                unsigned int imageX,
+                unsigned int imageY,
+                unsigned int kernelX,
+                unsigned int kernelY,
+                const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                unsigned int oxSize,
+                unsigned int p0,
+                unsigned int nbP,
+                T* image)
+    {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            T* channelData = image + channel * imageX * imageY;
+
+            for (unsigned int sy = 0; sy < kernelY; ++sy) {
+                for (unsigned int sx = 0; sx < kernelX; ++sx) {
+                    unsigned int ox = p0 % oxSize;
+                    unsigned int oy = p0 / oxSize;
+
+                    for (unsigned int p = 0; p < nbP; ++p) {
+                        const int ix = (int)(ox * desc.stride[0] + sx)
+                            - desc.padding[0];
+                        const int iy = (int)(oy * desc.stride[1] + sy)
+                            - desc.padding[1];
+
+                        if (ix >= 0 && ix < (int)imageX
+                            && iy >= 0 && iy < (int)imageY)
+                        {
+                            channelData[iy * imageX + ix] += columns[p];
+                        }
+
+                        if (++ox == oxSize) {
+                            ox = 0;
+                            ++oy;
+                        }
+                    }
+
+                    columns += nbP;
+                }
+            }
+        }
+    }
+
+    // Number of output positions processed at once, so that the im2col
+    // buffer of a thread stays below MAX_COLUMNS_SIZE
+    unsigned int getColumnsChunk(unsigned int nbRows, unsigned int nbP)
+    {
+        const unsigned int maxChunk = std::max<std::size_t>(64,
+            MAX_COLUMNS_SIZE / std::max(nbRows, 1U));
+        const unsigned int nbChunks = (nbP + maxChunk - 1) / maxChunk;
+        return (nbP + nbChunks - 1) / nbChunks;
+    }
+
+    template <class T>
+    void forwardGemm(const T* alpha,
+                     const N2D2::Tensor<T>& inputs,
+                     const N2D2::Tensor<T>& sharedSynapses,
+                     const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                     const T* beta,
+                     N2D2::Tensor<T>& outputs,
+                     N2D2::ConvCell_Frame_Kernels::Workspace<T>& workspace)
+    {
+        const unsigned int kernelX = sharedSynapses.dimX();
+        const unsigned int kernelY = sharedSynapses.dimY();
+        const unsigned int M = outputs.dimZ();
+        const unsigned int N = outputs.dimX() * outputs.dimY();
+        const unsigned int K = inputs.dimZ() * kernelY * kernelX;
+
+        // Split each image in chunks of output positions, to keep every
+        // thread busy even with small batches
+        const unsigned int nbBatches = inputs.dimB();
+        const unsigned int nbThreads = getNbThreads();
+        unsigned int chunk = getColumnsChunk(K, N);
+
+        if (nbBatches < nbThreads) {
+            const unsigned int nbChunks = std::min(
+                (nbThreads + nbBatches - 1) / nbBatches,
+                std::max(N / 64, 1U));
+            chunk = std::min(chunk, (N + nbChunks - 1) / nbChunks);
+        }
+
+        const unsigned int nbChunks = (N + chunk - 1) / chunk;
+        const int size = nbBatches * nbChunks;
+
+        initWorkspace(workspace);
+
+#pragma omp parallel for schedule(dynamic) if (size > 1)
+        for (int task = 0; task < size; ++task) {
+            const unsigned int batchPos = task / nbChunks;
+            const unsigned int p0 = (task % nbChunks) * chunk;
+            const unsigned int nbP = std::min(chunk, N - p0);
+
+            const unsigned int thread = getThreadNum();
+            std::vector<T>& columns = workspace.columns[thread];
+
+            if (columns.size() < (std::size_t)K * nbP)
+                columns.resize((std::size_t)K * nbP);
+
+            im2col(&inputs(0, 0, 0, batchPos),
+                   inputs.dimZ(), inputs.dimX(), inputs.dimY(),
+                   kernelX, kernelY, desc, outputs.dimX(),
+                   p0, nbP, &columns[0]);
+
+            // outputs[M x nbP] = sharedSynapses[M x K] * columns[K x nbP]
+            N2D2::Gemm::gemm(N2D2::Gemm::NoTrans, N2D2::Gemm::NoTrans,
+                             M, nbP, K,
+                             *alpha, &sharedSynapses(0), K,
+                             &columns[0], nbP,
+                             *beta, &outputs(0, 0, 0, batchPos) + p0, N,
+                             workspace.packing[thread]);
+        }
+    }
+
+    template <class T>
+    void backwardDataGemm(const T* alpha,
+                          const N2D2::Tensor<T>& sharedSynapses,
+                          const N2D2::Tensor<T>& diffInputs,
+                          const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                          const T* beta,
+                          N2D2::Tensor<T>& diffOutputs,
+                          N2D2::ConvCell_Frame_Kernels::Workspace<T>&
+                            workspace)
+    {
+        const unsigned int kernelX = sharedSynapses.dimX();
+        const unsigned int kernelY = sharedSynapses.dimY();
+        const unsigned int kernelSize = kernelX * kernelY;
+        const unsigned int nbChannels = diffOutputs.dimZ();
+        const unsigned int M = diffInputs.dimZ();
+        const unsigned int N = diffInputs.dimX() * diffInputs.dimY();
+        const unsigned int K = nbChannels * kernelSize;
+        const unsigned int imageSize = diffOutputs.dimX() * diffOutputs.dimY();
+
+        // col2im scatters to overlapping positions: the work is split by
+        // groups of channels instead of output positions
+        const unsigned int nbBatches = diffOutputs.dimB();
+        const unsigned int nbThreads = getNbThreads();
+        const unsigned int nbGroups = std::min(nbChannels,
+            (nbThreads + nbBatches - 1) / nbBatches);
+        const unsigned int groupSize = (nbChannels + nbGroups - 1) / nbGroups;
+        const int size = nbBatches * nbGroups;
+
+        initWorkspace(workspace);
+
+#pragma omp parallel for schedule(dynamic) if (size > 1)
+        for (int task = 0; task < size; ++task) {
+            const unsigned int batchPos = task / nbGroups;
+            const unsigned int c0 = (task % nbGroups) * groupSize;
+
+            if (c0 >= nbChannels)
+                continue;
+
+            const unsigned int nbC = std::min(groupSize, nbChannels - c0);
+            const unsigned int nbK = nbC * kernelSize;
+            const unsigned int chunk = getColumnsChunk(nbK, N);
+
+            const unsigned int thread = getThreadNum();
+            std::vector<T>& columns = workspace.columns[thread];
+
+            if (columns.size() < (std::size_t)nbK * chunk)
+                columns.resize((std::size_t)nbK * chunk);
+
+            T* image = &diffOutputs(0, 0, c0, batchPos);
+
+            if ((*beta) == T(0.0))
+                std::fill(image, image + nbC * imageSize, T(0.0));
+            else if ((*beta) != T(1.0)) {
+                for (unsigned int i = 0; i < nbC * imageSize; ++i)
+                    image[i] *= (*beta);
+            }
+
+            for (unsigned int p0 = 0; p0 < N; p0 += chunk) {
+                const unsigned int nbP = std::min(chunk, N - p0);
+
+                // columns[nbK x nbP] = sharedSynapses^T[nbK x M]
+                //                      * diffInputs[M x nbP]
+                N2D2::Gemm::gemm(N2D2::Gemm::Trans, N2D2::Gemm::NoTrans,
+                                 nbK, nbP, M,
+                                 *alpha, &sharedSynapses(0) + c0 * kernelSize,
+                                 K,
+                                 &diffInputs(0, 0, 0, batchPos) + p0, N,
+                                 T(0.0), &columns[0], nbP,
+                                 workspace.packing[thread]);
+
+                col2im(&columns[0],
+                       nbC, diffOutputs.dimX(), diffOutputs.dimY(),
+                       kernelX, kernelY, desc, diffInputs.dimX(),
+                       p0, nbP, image);
+            }
+        }
+    }
+
+    template <class T>
+    void backwardFilterGemm(const T* alpha,
+                            const N2D2::Tensor<T>& inputs,
+                            const N2D2::Tensor<T>& diffInputs,
+                            const N2D2::ConvCell_Frame_Kernels::Descriptor&
+                                desc,
+                            const T* beta,
+                            N2D2::Tensor<T>& diffSharedSynapses,
+                            N2D2::ConvCell_Frame_Kernels::Workspace<T>&
+                                workspace)
+    {
+        const unsigned int kernelX = diffSharedSynapses.dimX();
+        const unsigned int kernelY = diffSharedSynapses.dimY();
+        const unsigned int kernelSize = kernelX * kernelY;
+        const unsigned int nbChannels = inputs.dimZ();
+        const unsigned int nbOutputs = diffInputs.dimZ();
+        const unsigned int N = diffInputs.dimX() * diffInputs.dimY();
+        const unsigned int K = nbChannels * kernelSize;
+        const unsigned int imageSize = inputs.dimX() * inputs.dimY();
+
+        // Each task owns a block of diffSharedSynapses and accumulates over
+        // the whole batch, so that no reduction is needed
+        const unsigned int nbThreads = getNbThreads();
+        const unsigned int nbChannelGroups = std::min(nbChannels, nbThreads);
+        const unsigned int nbOutputGroups = std::min(nbOutputs,
+            (nbThreads + nbChannelGroups - 1) / nbChannelGroups);
+        const unsigned int channelGroupSize
+            = (nbChannels + nbChannelGroups - 1) / nbChannelGroups;
+        const unsigned int outputGroupSize
+            = (nbOutputs + nbOutputGroups - 1) / nbOutputGroups;
+        const int size = nbOutputGroups * nbChannelGroups;
+
+        initWorkspace(workspace);
+
+#pragma omp parallel for schedule(dynamic) if (size > 1)
+        for (int task = 0; task < size; ++task) {
+            const unsigned int m0 = (task / nbChannelGroups) * outputGroupSize;
+            const unsigned int c0 = (task % nbChannelGroups) * channelGroupSize;
+
+            if (m0 >= nbOutputs || c0 >= nbChannels)
+                continue;
+
+            const unsigned int nbM = std::min(outputGroupSize, nbOutputs - m0);
+            const unsigned int nbC = std::min(channelGroupSize,
+                                              nbChannels - c0);
+            const unsigned int nbK = nbC * kernelSize;
+            const unsigned int chunk = getColumnsChunk(nbK, N);
+
+            const unsigned int thread = getThreadNum();
+            std::vector<T>& columns = workspace.columns[thread];
+
+            if (columns.size() < (std::size_t)nbK * chunk)
+                columns.resize((std::size_t)nbK * chunk);
+
+            T* diffWeights = &diffSharedSynapses(0) + m0 * K + c0 * kernelSize;
+            T gemmBeta = (*beta);
+
+            for (unsigned int batchPos = 0; batchPos < inputs.dimB();
+                ++batchPos)
+            {
+                for (unsigned int p0 = 0; p0 < N; p0 += chunk) {
+                    const unsigned int nbP = std::min(chunk, N - p0);
+
+                    im2col(&inputs(0, 0, 0, batchPos) + c0 * imageSize,
+                           nbC, inputs.dimX(), inputs.dimY(),
+                           kernelX, kernelY, desc, diffInputs.dimX(),
+                           p0, nbP, &columns[0]);
+
+                    // diffSharedSynapses[nbM x nbK] += diffInputs[nbM x nbP]
+                    //                                  * columns^T[nbP x nbK]
+                    N2D2::Gemm::gemm(N2D2::Gemm::NoTrans, N2D2::Gemm::Trans,
+                                     nbM, nbK, nbP,
+                                     *alpha,
+                                     &diffInputs(0, 0, m0, batchPos) + p0, N,
+                                     &columns[0], nbP,
+                                     gemmBeta, diffWeights, K,
+                                     workspace.packing[thread]);
+
+                    gemmBeta = T(1.0);
+                }
+            }
+        }
+    }
+
+    // Winograd F(TILE x TILE, 3x3) transformation matrices, from A. Lavin
+    // and S. Gray, "Fast Algorithms for Convolutional Neural Networks"
+    template <unsigned int TILE>
+    struct Winograd;
+
+    template <>
+    struct Winograd<2> {
+        static const unsigned int SIZE = 4;
+        static const double BT[4][4];
+        static const double G[4][3];
+        static const double AT[2][4];
+    };
+
+    const double Winograd<2>::BT[4][4] = {
+        {1.0,  0.0, -1.0,  0.0},
+        {0.0,  1.0,  1.0,  0.0},
+        {0.0, -1.0,  1.0,  0.0},
+        {0.0,  1.0,  0.0, -1.0}};
+    const double Winograd<2>::G[4][3] = {
+        {1.0,  0.0, 0.0},
+        {0.5,  0.5, 0.5},
+        {0.5, -0.5, 0.5},
+        {0.0,  0.0, 1.0}};
+    const double Winograd<2>::AT[2][4] = {
+        {1.0, 1.0,  1.0,  0.0},
+        {0.0, 1.0, -1.0, -1.0}};
+
+    template <>
+    struct Winograd<4> {
+        static const unsigned int SIZE = 6;
+        static const double BT[6][6];
+        static const double G[6][3];
+        static const double AT[4][6];
+    };
+
+    const double Winograd<4>::BT[6][6] = {
+        {4.0,  0.0, -5.0,  0.0, 1.0, 0.0},
+        {0.0, -4.0, -4.0,  1.0, 1.0, 0.0},
+        {0.0,  4.0, -4.0, -1.0, 1.0, 0.0},
+        {0.0, -2.0, -1.0,  2.0, 1.0, 0.0},
+        {0.0,  2.0, -1.0, -2.0, 1.0, 0.0},
+        {0.0,  4.0,  0.0, -5.0, 0.0, 1.0}};
+    const double Winograd<4>::G[6][3] = {
+        { 1.0 / 4.0,         0.0,        0.0},
+        {-1.0 / 6.0, -1.0 / 6.0, -1.0 / 6.0},
+        {-1.0 / 6.0,  1.0 / 6.0, -1.0 / 6.0},
+        { 1.0 / 24.0,  1.0 / 12.0,  1.0 / 6.0},
+        { 1.0 / 24.0, -1.0 / 12.0,  1.0 / 6.0},
+        {        0.0,         0.0,        1.0}};
+    const double Winograd<4>::AT[4][6] = {
+        {1.0, 1.0,  1.0, 1.0,  1.0, 0.0},
+        {0.0, 1.0, -1.0, 2.0, -2.0, 0.0},
+        {0.0, 1.0,  1.0, 4.0,  4.0, 0.0},
+        {0.0, 1.0, -1.0, 8.0, -8.0, 1.0}};
+
+    template <class T>
+    bool useWinograd(const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                     const N2D2::Tensor<T>& sharedSynapses)
+    {
+        return ((desc.algorithm == N2D2::ConvCell_Frame_Kernels::Winograd2x2
+                || desc.algorithm == N2D2::ConvCell_Frame_Kernels::Winograd4x4)
+            && !std::is_same<T, half_float::half>::value
+            && sharedSynapses.dimX() == 3 && sharedSynapses.dimY() == 3
+            && desc.stride[0] == 1 && desc.stride[1] == 1);
+    }
+
+    /**
+     * Transform the 3x3 filters into a SIZE x SIZE array of nbOutputs x
+     * nbChannels matrices: U = G.g.G^T
+     * If backward is true, the filters are rotated by 180 degrees and the
+     * roles of the outputs and channels are swapped, for backwardData().
+    */
+    template <unsigned int TILE, class T>
+    void winogradFilterTransform(const N2D2::Tensor<T>& sharedSynapses,
+                                 bool backward,
+                                 std::vector<T>& transformed)
+    {
+        typedef Winograd<TILE> W;
+
+        const unsigned int nbChannels = (backward) ? sharedSynapses.dimB()
+                                                   : sharedSynapses.dimZ();
+        const unsigned int nbOutputs = (backward) ? sharedSynapses.dimZ()
+                                                  : sharedSynapses.dimB();
+        const unsigned int matrixSize = nbOutputs * nbChannels;
+
+        transformed.resize(W::SIZE * W::SIZE * matrixSize);
+
+#pragma omp parallel for if (nbOutputs > 16)
+        for (int output = 0; output < (int)nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+                T g[3][3];
+
+                for (unsigned int sy = 0; sy < 3; ++sy) {
+                    for (unsigned int sx = 0; sx < 3; ++sx) {
+                        g[sy][sx] = (backward)
+                            ? sharedSynapses(2 - sx, 2 - sy, output, channel)
+                            : sharedSynapses(sx, sy, channel, output);
+                    }
+                }
+
+                T tmp[W::SIZE][3];
+
+                for (unsigned int i = 0; i < W::SIZE; ++i) {
+                    for (unsigned int j = 0; j < 3; ++j) {
+                        tmp[i][j] = T(W::G[i][0]) * g[0][j]
+                                    + T(W::G[i][1]) * g[1][j]
+                                    + T(W::G[i][2]) * g[2][j];
+                    }
+                }
+
+                for (unsigned int i = 0; i < W::SIZE; ++i) {
+                    for (unsigned int j = 0; j < W::SIZE; ++j) {
+                        transformed[(i * W::SIZE + j) * matrixSize
+                                    + output * nbChannels + channel]
+                            = tmp[i][0] * T(W::G[j][0])
+                              + tmp[i][1] * T(W::G[j][1])
+                              + tmp[i][2] * T(W::G[j][2]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * 3x3 stride 1 convolution of images in the Winograd domain, with
+     * transformed filters from winogradFilterTransform().
+     * outputs(ox, oy) is computed from images(ox - paddingX + sx,
+     * oy - paddingY + sy), images being zero outside its bounds.
+    */
+    template <unsigned int TILE, class T>
+    void winogradConvolution(const T* alpha,
+                             const N2D2::Tensor<T>& images,
+                             const std::vector<T>& transformed,
+                             int paddingX,
+                             int paddingY,
+                             const T* beta,
+                             N2D2::Tensor<T>& outputs,
+                             N2D2::ConvCell_Frame_Kernels::Workspace<T>&
+                                workspace)
+    {
+        typedef Winograd<TILE> W;
+
+        const unsigned int nbChannels = images.dimZ();
+        const unsigned int nbOutputs = outputs.dimZ();
+        const unsigned int tilesX = (outputs.dimX() + TILE - 1) / TILE;
+        const unsigned int tilesY = (outputs.dimY() + TILE - 1) / TILE;
+        const unsigned int imageTiles = tilesX * tilesY;
+        const unsigned int nbTiles = imageTiles * outputs.dimB();
+
+        // Tiles of the whole batch are processed in chunks: each chunk is
+        // transformed, multiplied (one GEMM per transform point) and
+        // transformed back by a single thread
+        const unsigned int nbThreads = getNbThreads();
+        unsigned int chunk = getColumnsChunk(
+            W::SIZE * W::SIZE * (nbChannels + nbOutputs), nbTiles);
+        chunk = std::min(chunk, std::max(16U,
+            (nbTiles + nbThreads - 1) / nbThreads));
+        const int nbChunks = (nbTiles + chunk - 1) / chunk;
+
+        initWorkspace(workspace);
+
+#pragma omp parallel for schedule(dynamic) if (nbChunks > 1)
+        for (int chunkIdx = 0; chunkIdx < nbChunks; ++chunkIdx) {
+            const unsigned int t0 = chunkIdx * chunk;
+            const unsigned int nbT = std::min(chunk, nbTiles - t0);
+
+            const unsigned int thread = getThreadNum();
+            std::vector<T>& buffer = workspace.columns[thread];
+            const std::size_t inputsSize = (std::size_t)W::SIZE * W::SIZE
+                                            * nbChannels * nbT;
+            const std::size_t outputsSize = (std::size_t)W::SIZE * W::SIZE
+                                            * nbOutputs * nbT;
+
+            if (buffer.size() < inputsSize + outputsSize)
+                buffer.resize(inputsSize + outputsSize);
+
+            T* V = &buffer[0];
+            T* M = &buffer[inputsSize];
+
+            // Input transform: V = B^T.d.B
+            for (unsigned int t = 0; t < nbT; ++t) {
+                const unsigned int batchPos = (t0 + t) / imageTiles;
+                const unsigned int tx = ((t0 + t) % imageTiles) % tilesX;
+                const unsigned int ty = ((t0 + t) % imageTiles) / tilesX;
+                const int ix0 = (int)(tx * TILE) - paddingX;
+                const int iy0 = (int)(ty * TILE) - paddingY;
+
+                for (unsigned int channel = 0; channel < nbChannels;
+                    ++channel)
+                {
+                    const T* image = &images(0, 0, channel, batchPos);
+                    T d[W::SIZE][W::SIZE];
+
+                    for (unsigned int v = 0; v < W::SIZE; ++v) {
+                        const int iy = iy0 + (int)v;
+
+                        for (unsigned int u = 0; u < W::SIZE; ++u) {
+                            const int ix = ix0 + (int)u;
+
+                            d[v][u] = (ix >= 0 && ix < (int)images.dimX()
+                                       && iy >= 0 && iy < (int)images.dimY())
+                                ? image[iy * images.dimX() + ix]
+                                : T(0.0);
+                        }
+                    }
+
+                    T tmp[W::SIZE][W::SIZE];
+
+                    for (unsigned int i = 0; i < W::SIZE; ++i) {
+                        for (unsigned int j = 0; j < W::SIZE; ++j) {
+                            T sum(0.0);
+
+                            for (unsigned int k = 0; k < W::SIZE; ++k)
+                                sum += T(W::BT[i][k]) * d[k][j];
+
+                            tmp[i][j] = sum;
+                        }
+                    }
+
+                    for (unsigned int i = 0; i < W::SIZE; ++i) {
+                        for (unsigned int j = 0; j < W::SIZE; ++j) {
+                            T sum(0.0);
+
+                            for (unsigned int k = 0; k < W::SIZE; ++k)
+                                sum += tmp[i][k] * T(W::BT[j][k]);
+
+                            V[((i * W::SIZE + j) * nbChannels + channel) * nbT
+                              + t] = sum;
+                        }
+                    }
+                }
+            }
+
+            // Element-wise products, accumulated over the channels:
+            // M[xi] = U[xi] . V[xi]
+            for (unsigned int xi = 0; xi < W::SIZE * W::SIZE; ++xi) {
+                N2D2::Gemm::gemm(N2D2::Gemm::NoTrans, N2D2::Gemm::NoTrans,
+                                 nbOutputs, nbT, nbChannels,
+                                 T(1.0),
+                                 &transformed[xi * nbOutputs * nbChannels],
+                                 nbChannels,
+                                 V + xi * nbChannels * nbT, nbT,
+                                 T(0.0), M + xi * nbOutputs * nbT, nbT,
+                                 workspace.packing[thread]);
+            }
+
+            // Output transform: Y = A^T.M.A
+            for (unsigned int t = 0; t < nbT; ++t) {
+                const unsigned int batchPos = (t0 + t) / imageTiles;
+                const unsigned int tx = ((t0 + t) % imageTiles) % tilesX;
+                const unsigned int ty = ((t0 + t) % imageTiles) / tilesX;
+                const unsigned int oxMax = std::min(TILE,
+                    (unsigned int)outputs.dimX() - tx * TILE);
+                const unsigned int oyMax = std::min(TILE,
+                    (unsigned int)outputs.dimY() - ty * TILE);
+
+                for (unsigned int output = 0; output < nbOutputs; ++output) {
+                    T tmp[TILE][W::SIZE];
+
+                    for (unsigned int i = 0; i < TILE; ++i) {
+                        for (unsigned int j = 0; j < W::SIZE; ++j) {
+                            T sum(0.0);
+
+                            for (unsigned int k = 0; k < W::SIZE; ++k) {
+                                sum += T(W::AT[i][k])
+                                    * M[((k * W::SIZE + j) * nbOutputs
+                                         + output) * nbT + t];
+                            }
+
+                            tmp[i][j] = sum;
+                        }
+                    }
+
+                    T* outputData = &outputs(tx * TILE, ty * TILE, output,
+                                             batchPos);
+
+                    for (unsigned int i = 0; i < oyMax; ++i) {
+                        for (unsigned int j = 0; j < oxMax; ++j) {
+                            T sum(0.0);
+
+                            for (unsigned int k = 0; k < W::SIZE; ++k)
+                                sum += tmp[i][k] * T(W::AT[j][k]);
+
+                            T& value = outputData[i * outputs.dimX() + j];
+                            value = (*alpha) * sum
+                                + (((*beta) != T(0.0))
+                                    ? (*beta) * value : T(0.0));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // The cached transformed filters are also checked against a copy of the
+    // untransformed filters, as these may be modified without invalidating
+    // the cache (for example weights shared with another cell). The check
+    // is much cheaper than the transform.
+    template <class T>
+    void winogradFiltersCheck(const N2D2::Tensor<T>& sharedSynapses,
+                              N2D2::ConvCell_Frame_Kernels::WinogradFilters<T>&
+                                filters)
+    {
+        if (!filters.valid
+            || filters.weights.size() != sharedSynapses.size()
+            || !std::equal(filters.weights.begin(), filters.weights.end(),
+                           sharedSynapses.begin()))
+        {
+            filters.weights.assign(sharedSynapses.begin(),
+                                   sharedSynapses.end());
+            filters.forward.clear();
+            filters.backwardData.clear();
+            filters.valid = true;
+        }
+    }
+
+    template <class T>
+    void forwardWinograd(const T* alpha,
+                         const N2D2::Tensor<T>& inputs,
+                         const N2D2::Tensor<T>& sharedSynapses,
+                         const N2D2::ConvCell_Frame_Kernels::Descriptor& desc,
+                         const T* beta,
+                         N2D2::Tensor<T>& outputs,
+                         N2D2::ConvCell_Frame_Kernels::Workspace<T>&
+                            workspace,
+                         N2D2::ConvCell_Frame_Kernels::WinogradFilters<T>&
+                            filters)
+    {
+        winogradFiltersCheck(sharedSynapses, filters);
+
+        if (desc.algorithm == N2D2::ConvCell_Frame_Kernels::Winograd4x4) {
+            if (filters.forward.empty())
+                winogradFilterTransform<4>(sharedSynapses, false,
+                                           filters.forward);
+
+            winogradConvolution<4>(alpha, inputs, filters.forward,
+                                   desc.padding[0], desc.padding[1],
+                                   beta, outputs, workspace);
+        }
+        else {
+            if (filters.forward.empty())
+                winogradFilterTransform<2>(sharedSynapses, false,
+                                           filters.forward);
+
+            winogradConvolution<2>(alpha, inputs, filters.forward,
+                                   desc.padding[0], desc.padding[1],
+                                   beta, outputs, workspace);
+        }
+    }
+
+    template <class T>
+    void backwardDataWinograd(const T* alpha,
+                              const N2D2::Tensor<T>& sharedSynapses,
+                              const N2D2::Tensor<T>& diffInputs,
+                              const N2D2::ConvCell_Frame_Kernels::Descriptor&
+                                desc,
+                              const T* beta,
+                              N2D2::Tensor<T>& diffOutputs,
+                              N2D2::ConvCell_Frame_Kernels::Workspace<T>&
+                                workspace,
+                              N2D2::ConvCell_Frame_Kernels::WinogradFilters<T>&
+                                filters)
+    {
+        winogradFiltersCheck(sharedSynapses, filters);
+
+        // Full correlation of diffInputs with the rotated filters
+        if (desc.algorithm == N2D2::ConvCell_Frame_Kernels::Winograd4x4) {
+            if (filters.backwardData.empty())
+                winogradFilterTransform<4>(sharedSynapses, true,
+                                           filters.backwardData);
+
+            winogradConvolution<4>(alpha, diffInputs, filters.backwardData,
+                                   2 - desc.padding[0], 2 - desc.padding[1],
+                                   beta, diffOutputs, workspace);
+        }
+        else {
+            if (filters.backwardData.empty())
+                winogradFilterTransform<2>(sharedSynapses, true,
+                                           filters.backwardData);
+
+            winogradConvolution<2>(alpha, diffInputs, filters.backwardData,
+                                   2 - desc.padding[0], 2 - desc.padding[1],
+                                   beta, diffOutputs, workspace);
+        }
+    }
+}
+
 template <class T>
 void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
                                            const Tensor<T>& inputs,
@@ -31,7 +821,9 @@ void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
                                            const Descriptor& desc,
                                            const T* beta,
                                            Tensor<T>& outputs,
-                                           const Tensor<bool>& maps)
+                                           const Tensor<bool>& maps,
+                                           Workspace<T>* workspace,
+                                           WinogradFilters<T>* winogradFilters)
 {
     const unsigned int oxSize
         = (unsigned int)((inputs.dimX() + desc.padding[0] + desc.padding[2]
@@ -41,13 +833,26 @@ void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
         = (unsigned int)((inputs.dimY() + desc.padding[1] + desc.padding[3]
                           - sharedSynapses.dimY() + desc.stride[1])
                          / (double)desc.stride[1]);
-    const bool subSample = (desc.subSample[0] > 1 || desc.subSample[1] > 1);
 
-    if (subSample) {
-        for (unsigned int index = 0; index < outputs.size(); ++index)
-            outputs(index) *= (*beta);
+    if (useGemm(desc, inputs, sharedSynapses, outputs, oxSize, oySize, maps)) {
+        Workspace<T> localWorkspace;
+
+        if (useWinograd(desc, sharedSynapses)) {
+            WinogradFilters<T> localFilters;
+            forwardWinograd(alpha, inputs, sharedSynapses, desc, beta,
+                outputs,
+                (workspace != NULL) ? *workspace : localWorkspace,
+                (winogradFilters != NULL) ? *winogradFilters : localFilters);
+        }
+        else {
+            forwardGemm(alpha, inputs, sharedSynapses, desc, beta, outputs,
+                        (workspace != NULL) ? *workspace : localWorkspace);
+        }
+
+        return;
     }
 
+    const bool subSample = (desc.subSample[0] > 1 || desc.subSample[1] > 1);
     const unsigned int size = inputs.dimB() * outputs.dimZ();
 
 #if defined(_OPENMP) && _OPENMP >= 200805
@@ -57,6 +862,16 @@ void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
 #endif
     for (int batchPos = 0; batchPos < (int)inputs.dimB(); ++batchPos) {
         for (unsigned int output = 0; output < outputs.dimZ(); ++output) {
+            if (subSample) {
+                T* outputData = &outputs(0, 0, output, batchPos);
+
+                for (unsigned int index = 0;
+                     index < outputs.dimX() * outputs.dimY(); ++index)
+                {
+                    outputData[index] *= (*beta);
+                }
+            }
+
             for (unsigned int oy = 0; oy < oySize; ++oy) {
                 for (unsigned int ox = 0; ox < oxSize; ++ox) {
                     const unsigned int sxMin = (unsigned int)std::max(
@@ -122,7 +937,9 @@ void N2D2::ConvCell_Frame_Kernels::forward(const T* alpha,
                     }
 
                     if (subSample) {
-#pragma omp critical(ConvCell_Frame_Kernels__forward)
+                        // The (output, batchPos) planes are distributed
+                        // among the threads: each subsampled output is
+                        // only accumulated by its owning thread
                         outputs(ox / desc.subSample[0],
                                 oy / desc.subSample[1],
                                 output,
@@ -171,7 +988,10 @@ void N2D2::ConvCell_Frame_Kernels::backwardData(const T* alpha,
                                                 const Descriptor& desc,
                                                 const T* beta,
                                                 Tensor<T>& diffOutputs,
-                                                const Tensor<bool>& maps)
+                                                const Tensor<bool>& maps,
+                                                Workspace<T>* workspace,
+                                                WinogradFilters<T>*
+                                                    winogradFilters)
 {
     const unsigned int oxStride
         = desc.stride[0] * (unsigned int)((diffOutputs.dimX() + desc.padding[0]
@@ -181,6 +1001,27 @@ void N2D2::ConvCell_Frame_Kernels::backwardData(const T* alpha,
         = desc.stride[1] * (unsigned int)((diffOutputs.dimY() + desc.padding[1]
             + desc.padding[3] - sharedSynapses.dimY() + desc.stride[1])
                                         / (double)desc.stride[1]);
+
+    if (useGemm(desc, diffOutputs, sharedSynapses, diffInputs,
+                oxStride / desc.stride[0], oyStride / desc.stride[1], maps))
+    {
+        Workspace<T> localWorkspace;
+
+        if (useWinograd(desc, sharedSynapses)) {
+            WinogradFilters<T> localFilters;
+            backwardDataWinograd(alpha, sharedSynapses, diffInputs, desc, beta,
+                diffOutputs,
+                (workspace != NULL) ? *workspace : localWorkspace,
+                (winogradFilters != NULL) ? *winogradFilters : localFilters);
+        }
+        else {
+            backwardDataGemm(alpha, sharedSynapses, diffInputs, desc, beta,
+                             diffOutputs,
+                             (workspace != NULL) ? *workspace : localWorkspace);
+        }
+
+        return;
+    }
     const bool noSubSample = (desc.subSample[0] == 1 && desc.subSample[1] == 1);
 
     const unsigned int size = diffOutputs.dimB() * diffOutputs.dimZ();
@@ -323,7 +1164,8 @@ void N2D2::ConvCell_Frame_Kernels::backwardFilter(const T* alpha,
                                                   const T* beta,
                                                   Tensor
                                                   <T>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps)
+                                                  const Tensor<bool>& maps,
+                                                  Workspace<T>* workspace)
 {
     const unsigned int oxSize
         = (unsigned int)((inputs.dimX() + desc.padding[0] + desc.padding[2]
@@ -333,6 +1175,16 @@ void N2D2::ConvCell_Frame_Kernels::backwardFilter(const T* alpha,
         = (unsigned int)((inputs.dimY() + desc.padding[1] + desc.padding[3]
                           - diffSharedSynapses.dimY() + desc.stride[1])
                          / (double)desc.stride[1]);
+
+    if (useGemm(desc, inputs, diffSharedSynapses, diffInputs, oxSize, oySize,
+                maps))
+    {
+        Workspace<T> localWorkspace;
+        backwardFilterGemm(alpha, inputs, diffInputs, desc, beta,
+                           diffSharedSynapses,
+                           (workspace != NULL) ? *workspace : localWorkspace);
+        return;
+    }
     const bool noSubSample = (desc.subSample[0] == 1 && desc.subSample[1] == 1);
 
     const unsigned int size = diffInputs.dimZ() * inputs.dimZ();
@@ -439,7 +1291,9 @@ namespace N2D2 {
                                            const Descriptor& desc,
                                            const half_float::half* beta,
                                            Tensor<half_float::half>& outputs,
-                                           const Tensor<bool>& maps);
+                                           const Tensor<bool>& maps,
+                                           Workspace<half_float::half>* workspace,
+                                           WinogradFilters<half_float::half>* winogradFilters);
     template void ConvCell_Frame_Kernels::forward<float>(const float* alpha,
                                            const Tensor<float>& inputs,
                                            const Tensor
@@ -447,7 +1301,9 @@ namespace N2D2 {
                                            const Descriptor& desc,
                                            const float* beta,
                                            Tensor<float>& outputs,
-                                           const Tensor<bool>& maps);
+                                           const Tensor<bool>& maps,
+                                           Workspace<float>* workspace,
+                                           WinogradFilters<float>* winogradFilters);
     template void ConvCell_Frame_Kernels::forward<double>(const double* alpha,
                                            const Tensor<double>& inputs,
                                            const Tensor
@@ -455,7 +1311,9 @@ namespace N2D2 {
                                            const Descriptor& desc,
                                            const double* beta,
                                            Tensor<double>& outputs,
-                                           const Tensor<bool>& maps);
+                                           const Tensor<bool>& maps,
+                                           Workspace<double>* workspace,
+                                           WinogradFilters<double>* winogradFilters);
 
     template void ConvCell_Frame_Kernels::forwardBias<half_float::half>(const half_float::half* alpha,
                                                const Tensor<half_float::half>& bias,
@@ -478,7 +1336,9 @@ namespace N2D2 {
                                                 const Descriptor& desc,
                                                 const half_float::half* beta,
                                                 Tensor<half_float::half>& diffOutputs,
-                                                const Tensor<bool>& maps);
+                                                const Tensor<bool>& maps,
+                                                Workspace<half_float::half>* workspace,
+                                                WinogradFilters<half_float::half>* winogradFilters);
     template void ConvCell_Frame_Kernels::backwardData<float>(const float* alpha,
                                                 const Tensor
                                                 <float>& sharedSynapses,
@@ -487,7 +1347,9 @@ namespace N2D2 {
                                                 const Descriptor& desc,
                                                 const float* beta,
                                                 Tensor<float>& diffOutputs,
-                                                const Tensor<bool>& maps);
+                                                const Tensor<bool>& maps,
+                                                Workspace<float>* workspace,
+                                                WinogradFilters<float>* winogradFilters);
     template void ConvCell_Frame_Kernels::backwardData<double>(const double* alpha,
                                                 const Tensor
                                                 <double>& sharedSynapses,
@@ -496,7 +1358,9 @@ namespace N2D2 {
                                                 const Descriptor& desc,
                                                 const double* beta,
                                                 Tensor<double>& diffOutputs,
-                                                const Tensor<bool>& maps);
+                                                const Tensor<bool>& maps,
+                                                Workspace<double>* workspace,
+                                                WinogradFilters<double>* winogradFilters);
 
     template void ConvCell_Frame_Kernels::backwardFilter<half_float::half>(const half_float::half* alpha,
                                                   const Tensor
@@ -507,7 +1371,8 @@ namespace N2D2 {
                                                   const half_float::half* beta,
                                                   Tensor
                                                   <half_float::half>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps);
+                                                  const Tensor<bool>& maps,
+                                                  Workspace<half_float::half>* workspace);
     template void ConvCell_Frame_Kernels::backwardFilter<float>(const float* alpha,
                                                   const Tensor
                                                   <float>& inputs,
@@ -517,7 +1382,8 @@ namespace N2D2 {
                                                   const float* beta,
                                                   Tensor
                                                   <float>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps);
+                                                  const Tensor<bool>& maps,
+                                                  Workspace<float>* workspace);
     template void ConvCell_Frame_Kernels::backwardFilter<double>(const double* alpha,
                                                   const Tensor
                                                   <double>& inputs,
@@ -527,7 +1393,8 @@ namespace N2D2 {
                                                   const double* beta,
                                                   Tensor
                                                   <double>& diffSharedSynapses,
-                                                  const Tensor<bool>& maps);
+                                                  const Tensor<bool>& maps,
+                                                  Workspace<double>* workspace);
 
     template void ConvCell_Frame_Kernels::backwardBias<half_float::half>(const half_float::half* alpha,
                                                 const Tensor
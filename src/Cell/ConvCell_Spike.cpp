@@ -59,7 +59,8 @@ N2D2::ConvCell_Spike::ConvCell_Spike(Network& net,
       mThreshold(this, "Threshold", 1.0),
       mBipolarThreshold(this, "BipolarThreshold", true),
       mLeak(this, "Leak", 0.0),
-      mRefractory(this, "Refractory", 0 * TimeS)
+      mRefractory(this, "Refractory", 0 * TimeS),
+      mSynapticStats(this, "SynapticStats", true)
 {
     // ctor
     if (kernelDims.size() != 2) {
@@ -111,12 +112,34 @@ void N2D2::ConvCell_Spike::setExtendedPadding(
 
 void N2D2::ConvCell_Spike::initialize()
 {
-    mSharedSynapses.resize(
-        {mKernelDims[0], mKernelDims[1], getNbChannels(), getNbOutputs()});
+    const size_t nbSynapses = mKernelDims[0] * mKernelDims[1]
+                              * getNbChannels() * getNbOutputs();
+
+    // Synapse_Static synapses are packed in mPackedSynapses. The other
+    // synapse models are kept as individual objects in mSharedSynapses.
+    std::unique_ptr<Synapse> synapse(newSynapse());
+    const Synapse_Static* staticSynapse
+        = dynamic_cast<Synapse_Static*>(synapse.get());
+
+    if (staticSynapse != NULL) {
+        mPackedSynapses
+            = SynapseStore_Static(staticSynapse->bipolar, mSynapticStats);
+        mPackedSynapses.reserve(nbSynapses);
+        mPackedSynapses.push_back(*staticSynapse);
+
+        for (size_t index = 1; index < nbSynapses; ++index) {
+            synapse.reset(newSynapse());
+            mPackedSynapses.push_back(
+                *static_cast<Synapse_Static*>(synapse.get()));
+        }
+    } else {
+        mSharedSynapses.resize(
+            {mKernelDims[0], mKernelDims[1], getNbChannels(), getNbOutputs()});
+        mSharedSynapses(0) = synapse.release();
 
-    for (unsigned int index = 0, size = mSharedSynapses.size(); index < size;
-         ++index)
-        mSharedSynapses(index) = newSynapse();
+        for (size_t index = 1; index < nbSynapses; ++index)
+            mSharedSynapses(index) = newSynapse();
+    }
 
     mOutputsLastIntegration.resize(
         {mOutputsDims[0], mOutputsDims[1], getNbOutputs(), 1}, 0);
@@ -162,9 +185,8 @@ void N2D2::ConvCell_Spike::propagateSpike(NodeIn* origin,
                 if (!isConnection(origin->getChannel(), output))
                     continue;
 
-                const Time_T delay = static_cast<Synapse_Static*>(
-                    mSharedSynapses(sx, sy, origin->getChannel(), output))
-                                         ->delay;
+                const Time_T delay = mPackedSynapses.getDelay(
+                    synapseIndex(sx, sy, origin->getChannel(), output));
 
                 if (delay > 0)
                     mNet.newEvent(origin,
@@ -220,12 +242,9 @@ void N2D2::ConvCell_Spike::incomingSpike(NodeIn* origin,
 
     lastIntegration = timestamp;
 
-    Synapse_Static* synapse = static_cast<Synapse_Static*>(
-        mSharedSynapses(synX, synY, origin->getChannel(), output));
-    integration += (negative) ? -synapse->weight : synapse->weight;
-
-    // Stats
-    ++synapse->statsReadEvents;
+    const double weight = mPackedSynapses.read(
+        synapseIndex(synX, synY, origin->getChannel(), output));
+    integration += (negative) ? -weight : weight;
 
     if ((integration >= mThreshold
          || (mBipolarThreshold && (-integration) >= mThreshold))
@@ -336,10 +355,15 @@ void N2D2::ConvCell_Spike::saveFreeParameters(const std::string& fileName) const
         throw std::runtime_error("Could not create synaptic file (.SYN): "
                                  + fileName);
 
-    for (std::vector<Synapse*>::const_iterator it = mSharedSynapses.begin();
-         it != mSharedSynapses.end();
-         ++it)
-        (*it)->saveInternal(syn);
+    if (!mPackedSynapses.empty())
+        mPackedSynapses.save(syn);
+    else {
+        for (std::vector<Synapse*>::const_iterator it
+             = mSharedSynapses.begin();
+             it != mSharedSynapses.end();
+             ++it)
+            (*it)->saveInternal(syn);
+    }
 }
 
 void N2D2::ConvCell_Spike::loadFreeParameters(const std::string& fileName,
@@ -358,10 +382,14 @@ void N2D2::ConvCell_Spike::loadFreeParameters(const std::string& fileName,
                                      + fileName);
     }
 
-    for (std::vector<Synapse*>::iterator it = mSharedSynapses.begin();
-         it != mSharedSynapses.end();
-         ++it)
-        (*it)->loadInternal(syn);
+    if (!mPackedSynapses.empty())
+        mPackedSynapses.load(syn);
+    else {
+        for (std::vector<Synapse*>::iterator it = mSharedSynapses.begin();
+             it != mSharedSynapses.end();
+             ++it)
+            (*it)->loadInternal(syn);
+    }
 
     if (syn.eof())
         throw std::runtime_error(
@@ -416,15 +444,27 @@ N2D2::Synapse::Stats N2D2::ConvCell_Spike::logStats(const std::string
                 for (unsigned int y = 0; y < mKernelDims[1]; ++y) {
                     std::ostringstream suffixStr;
                     suffixStr << x << " " << y;
-                    mSharedSynapses(x, y, channel, output)
-                        ->logStats(data, suffixStr.str());
-
-                    mSharedSynapses(x, y, channel, output)
-                        ->getStats(stats.get());
-                    mSharedSynapses(x, y, channel, output)
-                        ->getStats(statsOutput.get());
-                    mSharedSynapses(x, y, channel, output)
-                        ->getStats(statsKernel.get());
+
+                    if (!mPackedSynapses.empty()) {
+                        const size_t index
+                            = synapseIndex(x, y, channel, output);
+
+                        mPackedSynapses.logStats(index, data,
+                                                 suffixStr.str());
+
+                        mPackedSynapses.getStats(index, stats.get());
+                        mPackedSynapses.getStats(index, statsOutput.get());
+                        mPackedSynapses.getStats(index, statsKernel.get());
+                    } else {
+                        Synapse* synapse
+                            = mSharedSynapses(x, y, channel, output);
+
+                        synapse->logStats(data, suffixStr.str());
+
+                        synapse->getStats(stats.get());
+                        synapse->getStats(statsOutput.get());
+                        synapse->getStats(statsKernel.get());
+                    }
                 }
             }
 
@@ -106,30 +106,33 @@ void N2D2::DropoutCell_Frame<T>::propagate(bool inference)
     } else {
         for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
             const Tensor<T>& input = tensor_cast<T>(mInputs[k]);
+            const unsigned int batchSize = mInputs[k].size() / mInputs.dimB();
+            const unsigned int outputStride = mOutputs.dimX() * mOutputs.dimY()
+                                              * mInputs.dimZ();
 
-            unsigned int outputOffset = offset;
-            unsigned int inputOffset = 0;
+            // One random stream per (input, batch position)
+            const unsigned int seed = Random::mtRand();
 
-            for (unsigned int batchPos = 0; batchPos < mInputs.dimB();
+#pragma omp parallel for if (mInputs.dimB() > 4 && batchSize > 256)
+            for (int batchPos = 0; batchPos < (int)mInputs.dimB();
                 ++batchPos)
             {
-                for (unsigned int index = 0,
-                     batchSize = (mInputs[k].size() / mInputs.dimB());
-                     index < batchSize;
-                     ++index)
-                {
+                const unsigned int outputOffset = offset
+                                            + batchPos * outputStride;
+                const unsigned int inputOffset = batchPos * batchSize;
+
+                Random::Stream stream(seed, batchPos);
+                stream.fillBernoulli(mMask.begin() + outputOffset,
+                                     mMask.begin() + outputOffset + batchSize,
+                                     1.0 - mDropout);
+
+                for (unsigned int index = 0; index < batchSize; ++index) {
                     const unsigned int outputIndex = index + outputOffset;
 
-                    mMask(outputIndex) = Random::randBernoulli(1.0 - mDropout);
                     mOutputs(outputIndex) = (mMask(outputIndex))
                         ? input(index + inputOffset)
                         : 0.0;
                 }
-
-                outputOffset += mOutputs.dimX() * mOutputs.dimY()
-                                * mInputs.dimZ();
-                inputOffset += mOutputs.dimX() * mOutputs.dimY()
-                               * mInputs[k].dimZ();
             }
 
             offset += mOutputs.dimX() * mOutputs.dimY() * mInputs[k].dimZ();
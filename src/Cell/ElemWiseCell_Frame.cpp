@@ -23,7 +23,8 @@
 #include "DeepNet.hpp"
 
 N2D2::Registrar<N2D2::ElemWiseCell>
-N2D2::ElemWiseCell_Frame::mRegistrar("Frame", N2D2::ElemWiseCell_Frame::create);
+N2D2::ElemWiseCell_Frame::mRegistrar({"Frame", "Frame_INT8"},
+                                     N2D2::ElemWiseCell_Frame::create);
 
 N2D2::ElemWiseCell_Frame::ElemWiseCell_Frame(const DeepNet& deepNet, const std::string& name,
                                      unsigned int nbOutputs,
@@ -60,11 +60,7 @@ void N2D2::FMPCell_Frame::propagate(bool inference)
     mInputs.synchronizeDBasedToH();
 
     if (!inference)
-        mInputsBackProp.assign({mInputs[0].dimX(),
-                               mInputs[0].dimY(),
-                               mInputs.dimZ(),
-                               mInputs.dimB()},
-                               std::vector<unsigned int>());
+        mArgMax.resize(mOutputs.dims());
 
     if (!mLockRandom) {
         generateRegions(mGridX, mInputs[0].dimX(), mOutputs.dimX());
@@ -75,6 +71,8 @@ void N2D2::FMPCell_Frame::propagate(bool inference)
 
     const Tensor<Float_T>& input0 = tensor_cast<Float_T>(mInputs[0]);
 
+    // Each output node is computed and stored by a single thread: no
+    // synchronization is needed
 #if defined(_OPENMP) && _OPENMP >= 200805
 #pragma omp parallel for collapse(2) if (size > 16)
 #else
@@ -84,8 +82,15 @@ void N2D2::FMPCell_Frame::propagate(bool inference)
         for (unsigned int output = 0; output < getNbOutputs(); ++output) {
             for (unsigned int oy = 0; oy < mOutputs.dimY(); ++oy) {
                 for (unsigned int ox = 0; ox < mOutputs.dimX(); ++ox) {
-                    if (mPoolNbChannels[output] == 0)
-                        continue; // No connection to this output...
+                    if (mPoolNbChannels[output] == 0) {
+                        // No connection to this output...
+                        if (!inference) {
+                            mArgMax(ox, oy, output, batchPos)
+                                = PoolCell_Frame_Kernels::ArgMax();
+                        }
+
+                        continue;
+                    }
 
                     // For each output, compute the pool value
                     Float_T poolValue =
@@ -94,29 +99,16 @@ void N2D2::FMPCell_Frame::propagate(bool inference)
                     unsigned int ixMax = 0;
                     unsigned int iyMax = 0;
 
+                    unsigned int ixStart, ixStop;
+                    unsigned int iyStart, iyStop;
+                    getRegion(mGridX, input0.dimX(), ox, ixStart, ixStop);
+                    getRegion(mGridY, input0.dimY(), oy, iyStart, iyStop);
+
                     for (unsigned int channel = 0; channel < getNbChannels();
                          ++channel) {
                         if (!isConnection(channel, output))
                             continue;
 
-                        const unsigned int ixStart = (ox > 0) ? mGridX[ox - 1]
-                                                              : 0;
-                        const unsigned int iyStart = (oy > 0) ? mGridY[oy - 1]
-                                                              : 0;
-                        unsigned int ixStop = mGridX[ox];
-                        unsigned int iyStop = mGridY[oy];
-
-                        if (!mOverlapping) {
-                            --ixStop;
-                            --iyStop;
-                        }
-
-                        if (ox == mOutputs.dimX() - 1)
-                            ixStop = input0.dimX() - 1;
-
-                        if (oy == mOutputs.dimY() - 1)
-                            iyStop = input0.dimY() - 1;
-
                         for (unsigned int iy = iyStart; iy <= iyStop; ++iy) {
                             for (unsigned int ix = ixStart; ix <= ixStop;
                                  ++ix) {
@@ -134,14 +126,11 @@ void N2D2::FMPCell_Frame::propagate(bool inference)
                     }
 
                     if (!inference) {
-// For this output node, take the max. input across all connected channels
-// Critical section needed because channelMax can be the same for several
-// outputs
-#pragma omp critical(FMPCell_Frame__propagate)
-                        mInputsBackProp(ixMax, iyMax, channelMax, batchPos)
-                            .push_back(ox + oy * mOutputs.dimX()
-                                       + output * mOutputs.dimX()
-                                         * mOutputs.dimY());
+                        mArgMax(ox, oy, output, batchPos)
+                            = PoolCell_Frame_Kernels::ArgMax(ixMax,
+                                                             iyMax,
+                                                             channelMax,
+                                                             true);
                     }
 
                     // Compute the output signal
@@ -162,6 +151,30 @@ void N2D2::FMPCell_Frame::backPropagate()
 
     Cell_Frame<Float_T>::backPropagate();
 
+    const unsigned int outputsSize = mOutputs.dimX() * mOutputs.dimY()
+                                     * getNbOutputs();
+
+    // Outputs whose max input is in each channel, for each batch position.
+    // The gradient of each (batch, channel) is then computed by a single
+    // thread, from these outputs only, at the same cost as propagate().
+    std::vector<std::vector<unsigned int> > channelOutputs(
+        mInputs.dimB() * getNbChannels());
+
+#pragma omp parallel for if (mInputs.dimB() > 4)
+    for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
+        const unsigned int batchOffset = batchPos * outputsSize;
+
+        for (unsigned int index = 0; index < outputsSize; ++index) {
+            const PoolCell_Frame_Kernels::ArgMax& inputMax
+                = mArgMax(batchOffset + index);
+
+            if (inputMax.valid) {
+                channelOutputs[batchPos * getNbChannels() + inputMax.channel]
+                    .push_back(batchOffset + index);
+            }
+        }
+    }
+
     const unsigned int size = mInputs.dimB() * getNbChannels();
 
     Tensor<Float_T> diffOutput0 = (mDiffOutputs[0].isValid())
@@ -177,25 +190,28 @@ void N2D2::FMPCell_Frame::backPropagate()
         for (unsigned int channel = 0; channel < getNbChannels(); ++channel)
         {
             const bool isValid = mDiffOutputs[0].isValid();
+            const std::vector<unsigned int>& outputs
+                = channelOutputs[batchPos * getNbChannels() + channel];
+
+            // In max pooling, the unit which was chosen as the max
+            // receives all the error since very small changes
+            // in input would perturb the result only through that unit
+            Tensor<Float_T> gradient({mInputs[0].dimX(), mInputs[0].dimY()},
+                                     0.0);
+
+            for (std::vector<unsigned int>::const_iterator it
+                 = outputs.begin(), itEnd = outputs.end(); it != itEnd; ++it)
+            {
+                const PoolCell_Frame_Kernels::ArgMax& inputMax
+                    = mArgMax(*it);
+
+                gradient(inputMax.ix, inputMax.iy) += mDiffInputs(*it);
+            }
 
             for (unsigned int iy = 0; iy < mInputs[0].dimY(); ++iy) {
                 for (unsigned int ix = 0; ix < mInputs[0].dimX(); ++ix) {
-                    Float_T gradient = 0.0;
-
-                    // In max pooling, the unit which was chosen as the max
-                    // receives all the error since very small changes
-                    // in input would perturb the result only through that unit
-                    for (std::vector<unsigned int>::const_iterator it
-                         = mInputsBackProp(ix, iy, channel, batchPos).begin(),
-                         itEnd
-                         = mInputsBackProp(ix, iy, channel, batchPos).end();
-                         it != itEnd;
-                         ++it) {
-                        gradient += mDiffInputs(*it, batchPos);
-                    }
-
                     diffOutput0(ix, iy, channel, batchPos)
-                        = gradient + isValid
+                        = gradient(ix, iy) + isValid
                                      * diffOutput0(ix, iy, channel, batchPos);
                 }
             }
@@ -271,6 +287,22 @@ void N2D2::FMPCell_Frame::logRegions(const std::string& fileName) const
     StimuliProvider::logData(fileName, regions);
 }
 
+void N2D2::FMPCell_Frame::getRegion(const std::vector<unsigned int>& grid,
+                                    unsigned int sizeIn,
+                                    unsigned int o,
+                                    unsigned int& iStart,
+                                    unsigned int& iStop) const
+{
+    iStart = (o > 0) ? grid[o - 1] : 0;
+    iStop = grid[o];
+
+    if (!mOverlapping)
+        --iStop;
+
+    if (o == grid.size() - 1)
+        iStop = sizeIn - 1;
+}
+
 void N2D2::FMPCell_Frame::generateRegions(std::vector<unsigned int>& grid,
                                           unsigned int sizeIn,
                                           unsigned int sizeOut)
@@ -0,0 +1,182 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/FcCell_CSpike.hpp"
+#include "DeepNet.hpp"
+#include "Filler/NormalFiller.hpp"
+
+N2D2::Registrar<N2D2::FcCell>
+N2D2::FcCell_CSpike::mRegistrar("CSpike",
+    N2D2::FcCell_CSpike::create,
+    N2D2::Registrar<N2D2::FcCell>::Type<Float_T>());
+
+N2D2::FcCell_CSpike::FcCell_CSpike(const DeepNet& deepNet,
+                                   const std::string& name,
+                                   unsigned int nbOutputs)
+    : Cell(deepNet, name, nbOutputs),
+      FcCell(deepNet, name, nbOutputs),
+      Cell_CSpike(deepNet, name, nbOutputs),
+      // IMPORTANT: Do not change the value of the parameters here! Use
+      // setParameter() or loadParameters().
+      mThreshold(this, "Threshold", 1.0),
+      mBipolarThreshold(this, "BipolarThreshold", true),
+      mLeak(this, "Leak", 0.0),
+      mRefractory(this, "Refractory", 0 * TimeS),
+      mLastTick(0)
+{
+    // ctor
+    mWeightsFiller = std::make_shared<NormalFiller<Float_T> >(0.0, 0.05);
+    mBiasFiller = std::make_shared<NormalFiller<Float_T> >(0.0, 0.05);
+}
+
+void N2D2::FcCell_CSpike::initialize()
+{
+    if (mSynapses.empty()) {
+        mSynapses.resize({getInputsSize(), getNbOutputs()});
+        mWeightsFiller->apply(mSynapses);
+    }
+
+    if (mBias.empty()) {
+        mBias.resize({getNbOutputs()}, 0.0);
+
+        if (!mNoBias)
+            mBiasFiller->apply(mBias);
+    }
+
+    mOutputsIntegration.resize(mOutputs.dims(), 0.0);
+    mOutputsRefractoryEnd.resize(mOutputs.dims(), 0);
+}
+
+bool N2D2::FcCell_CSpike::tick(Time_T timestamp)
+{
+    gatherInputsSpikes();
+
+    const unsigned int nbOutputs = getNbOutputs();
+    const unsigned int batchSize = mOutputs.dimB();
+    const unsigned int inputsSize = getInputsSize();
+
+    const double expVal = (mLeak > 0)
+        ? -((double)(timestamp - mLastTick) / (double)mLeak) : 0.0;
+    const Float_T leak = (expVal > std::log(1e-20)) ? std::exp(expVal) : 0.0;
+    const Float_T threshold = mThreshold;
+    const bool bipolarThreshold = mBipolarThreshold;
+    const Time_T refractory = mRefractory;
+
+#pragma omp parallel for collapse(2) if (batchSize * nbOutputs > 16)
+    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+        for (int output = 0; output < (int)nbOutputs; ++output) {
+            const unsigned int index = output + nbOutputs * batchPos;
+            const Float_T* synapses = &mSynapses(inputsSize * output);
+            const std::vector<std::pair<unsigned int, Float_T> >&
+                inputsSpikes = mInputsSpikes[batchPos];
+
+            Float_T weightedSum = (!mNoBias) ? mBias(output) : 0.0;
+
+            for (std::vector<std::pair<unsigned int, Float_T> >
+                ::const_iterator it = inputsSpikes.begin(),
+                itEnd = inputsSpikes.end(); it != itEnd; ++it)
+            {
+                weightedSum += (*it).second * synapses[(*it).first];
+            }
+
+            Float_T& integration = mOutputsIntegration(index);
+            integration = leak * integration + weightedSum;
+
+            Float_T& outputSpike = mOutputs(index);
+            Time_T& refractoryEnd = mOutputsRefractoryEnd(index);
+
+            if ((integration >= threshold
+                 || (bipolarThreshold && (-integration) >= threshold))
+                && timestamp >= refractoryEnd)
+            {
+                outputSpike = (integration < 0) ? -1.0 : 1.0;
+                integration -= outputSpike * threshold;
+                refractoryEnd = timestamp + refractory;
+            }
+            else
+                outputSpike = 0.0;
+
+            mOutputsActivity(index) += outputSpike;
+        }
+    }
+
+    mLastTick = timestamp;
+    return false;
+}
+
+void N2D2::FcCell_CSpike::reset(Time_T timestamp)
+{
+    Cell_CSpike::reset(timestamp);
+
+    mOutputsIntegration.assign(mOutputs.dims(), 0.0);
+    mOutputsRefractoryEnd.assign(mOutputs.dims(), 0);
+    mLastTick = timestamp;
+}
+
+void N2D2::FcCell_CSpike::saveFreeParameters(const std::string& fileName)
+    const
+{
+    std::ofstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good())
+        throw std::runtime_error("Could not create synaptic file (.SYN): "
+                                 + fileName);
+
+    mSynapses.save(syn);
+
+    if (!mNoBias)
+        mBias.save(syn);
+
+    if (!syn.good())
+        throw std::runtime_error("Error writing synaptic file: " + fileName);
+}
+
+void N2D2::FcCell_CSpike::loadFreeParameters(const std::string& fileName,
+                                             bool ignoreNotExists)
+{
+    std::ifstream syn(fileName.c_str(), std::fstream::binary);
+
+    if (!syn.good()) {
+        if (ignoreNotExists) {
+            std::cout << Utils::cnotice
+                      << "Notice: Could not open synaptic file (.SYN): "
+                      << fileName << Utils::cdef << std::endl;
+            return;
+        } else
+            throw std::runtime_error("Could not open synaptic file (.SYN): "
+                                     + fileName);
+    }
+
+    mSynapses.load(syn);
+
+    if (!mNoBias)
+        mBias.load(syn);
+
+    if (syn.eof())
+        throw std::runtime_error(
+            "End-of-file reached prematurely in synaptic file (.SYN): "
+            + fileName);
+    else if (!syn.good())
+        throw std::runtime_error("Error while reading synaptic file (.SYN): "
+                                 + fileName);
+    else if (syn.get() != std::fstream::traits_type::eof())
+        throw std::runtime_error(
+            "Synaptic file (.SYN) size larger than expected: " + fileName);
+}
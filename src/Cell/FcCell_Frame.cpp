@@ -24,6 +24,7 @@
 #include "Filler/NormalFiller.hpp"
 #include "Solver/SGDSolver_Frame.hpp"
 #include "third_party/half.hpp"
+#include "utils/Gemm.hpp"
 
 template <>
 N2D2::Registrar<N2D2::FcCell>
@@ -166,11 +167,10 @@ void N2D2::FcCell_Frame<T>::propagate(bool inference)
             beta = 1.0;
 
         if (mDropConnect < 1.0 && !inference && !mLockRandom) {
-            // Random::randBernoulli() is not thread-safe!
-            for (unsigned int index = 0; index < mDropConnectMask[k].size();
-                 ++index)
-                mDropConnectMask[k](index)
-                    = Random::randBernoulli(mDropConnect);
+            Random::Stream stream(Random::mtRand(), k);
+            stream.fillBernoulli(mDropConnectMask[k].begin(),
+                                 mDropConnectMask[k].end(),
+                                 mDropConnect);
         }
 
         const Tensor<T>& synapses = mSynapses[k];
@@ -178,17 +178,18 @@ void N2D2::FcCell_Frame<T>::propagate(bool inference)
         const unsigned int inputSize = input.dimX() * input.dimY()
                                         * input.dimZ();
 
+        if (mDropConnect < 1.0 && !inference) {
 #if defined(_OPENMP) && _OPENMP >= 200805
 #pragma omp parallel for collapse(2) if (count > 16)
 #else
 #pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
 #endif
-        for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-            for (unsigned int output = 0; output < outputSize; ++output) {
-                // Compute the weighted sum
-                T weightedSum((!mNoBias) ? mBias(output) : 0.0);
+            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos)
+            {
+                for (unsigned int output = 0; output < outputSize; ++output) {
+                    // Compute the weighted sum
+                    T weightedSum((!mNoBias) ? mBias(output) : 0.0);
 
-                if (mDropConnect < 1.0 && !inference) {
                     for (unsigned int channel = 0; channel < inputSize;
                         ++channel)
                     {
@@ -196,20 +197,34 @@ void N2D2::FcCell_Frame<T>::propagate(bool inference)
                             weightedSum += input(channel, batchPos)
                                            * synapses(channel, output);
                     }
-                } else {
-                    // init with weightedSum and not 0.0 to match for loop
-                    // (otherwise it can lead to different result because of
-                    // limited machine precision)
-                    weightedSum = std::inner_product(
-                                    input.begin() + batchPos * inputSize,
-                                    input.begin() + (batchPos + 1) * inputSize,
-                                    synapses[output].begin(),
-                                    weightedSum);
-                }
 
-                mOutputs(output, batchPos)
-                    = weightedSum + beta * mOutputs(output, batchPos);
+                    mOutputs(output, batchPos)
+                        = weightedSum + beta * mOutputs(output, batchPos);
+                }
+            }
+        }
+        else {
+#pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
+            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos)
+            {
+                for (unsigned int output = 0; output < outputSize; ++output) {
+                    mOutputs(output, batchPos)
+                        = ((!mNoBias) ? mBias(output) : T(0.0))
+                            + beta * mOutputs(output, batchPos);
+                }
             }
+
+            // outputs += inputs.synapses^T, with inputs a batch x inputSize
+            // matrix and synapses a outputSize x inputSize matrix: the
+            // synapses are reused across the whole batch
+            Gemm::gemmParallel<T>(Gemm::NoTrans, Gemm::Trans,
+                                  mInputs.dimB(), outputSize, inputSize,
+                                  T(1.0),
+                                  &input(0), inputSize,
+                                  &synapses(0), inputSize,
+                                  T(1.0),
+                                  &mOutputs(0), outputSize,
+                                  mGemmWorkspaces);
         }
     }
 
@@ -244,17 +259,20 @@ void N2D2::FcCell_Frame<T>::backPropagate()
             const Tensor<T>& synapses = mSynapses[k];
             const unsigned int count = mInputs.dimB() * nbChannels;
 
+            if (mDropConnect < 1.0) {
 #if defined(_OPENMP) && _OPENMP >= 200805
 #pragma omp parallel for collapse(2) if (count > 16)
 #else
 #pragma omp parallel for if (mInputs.dimB() > 4 && count > 16)
 #endif
-            for (int batchPos = 0; batchPos < (int)mInputs.dimB(); ++batchPos) {
-                for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                for (int batchPos = 0; batchPos < (int)mInputs.dimB();
+                    ++batchPos)
                 {
-                    T gradient(0.0);
+                    for (unsigned int channel = 0; channel < nbChannels;
+                        ++channel)
+                    {
+                        T gradient(0.0);
 
-                    if (mDropConnect < 1.0) {
                         for (unsigned int output = 0; output < outputSize;
                              ++output)
                         {
@@ -262,20 +280,23 @@ void N2D2::FcCell_Frame<T>::backPropagate()
                                 gradient += synapses(channel, output)
                                             * mDiffInputs(output, batchPos);
                         }
-                    }
-                    else {
-                        for (unsigned int output = 0; output < outputSize;
-                             ++output)
-                        {
-                            gradient += synapses(channel, output)
-                                        * mDiffInputs(output, batchPos);
-                        }
-                    }
 
-                    diffOutput(channel, batchPos) = gradient
-                        + beta * diffOutput(channel, batchPos);
+                        diffOutput(channel, batchPos) = gradient
+                            + beta * diffOutput(channel, batchPos);
+                    }
                 }
             }
+            else {
+                // diffOutput = diffInputs.synapses
+                Gemm::gemmParallel<T>(Gemm::NoTrans, Gemm::NoTrans,
+                                      mInputs.dimB(), nbChannels, outputSize,
+                                      T(1.0),
+                                      &mDiffInputs(0), outputSize,
+                                      &synapses(0), nbChannels,
+                                      beta,
+                                      &diffOutput(0), nbChannels,
+                                      mGemmWorkspaces);
+            }
 
             mDiffOutputs[k] = diffOutput;
             mDiffOutputs[k].setValid();
@@ -286,31 +307,46 @@ void N2D2::FcCell_Frame<T>::backPropagate()
 
         const float beta = (mWeightsSolvers[k]->isNewIteration()) ? 0.0f : 1.0f;
 
+        if (mDropConnect < 1.0) {
 #if defined(_OPENMP) && _OPENMP >= 200805
 #pragma omp parallel for collapse(2) if (count2 > 16)
 #else
 #pragma omp parallel for if (getNbOutputs() > 4 && count2 > 16)
 #endif
-        for (int output = 0; output < (int)getNbOutputs(); ++output) {
-            for (unsigned int channel = 0; channel < nbChannels; ++channel) {
-                if (!(mDropConnect < 1.0)
-                    || mDropConnectMask[k](channel, output)) {
-                    T sum(0.0);
-
-                    for (unsigned int batchPos = 0; batchPos < input.dimB();
-                         ++batchPos)
-                        sum += input(channel, batchPos)
-                               * mDiffInputs(output, batchPos);
-
-                    diffSynapses(channel, output) = sum
-                        + beta * diffSynapses(channel, output);
-                }
-                else {
-                    diffSynapses(channel, output) = beta
-                        * diffSynapses(channel, output);
+            for (int output = 0; output < (int)getNbOutputs(); ++output) {
+                for (unsigned int channel = 0; channel < nbChannels; ++channel)
+                {
+                    if (mDropConnectMask[k](channel, output)) {
+                        T sum(0.0);
+
+                        for (unsigned int batchPos = 0;
+                             batchPos < input.dimB(); ++batchPos)
+                        {
+                            sum += input(channel, batchPos)
+                                   * mDiffInputs(output, batchPos);
+                        }
+
+                        diffSynapses(channel, output) = sum
+                            + beta * diffSynapses(channel, output);
+                    }
+                    else {
+                        diffSynapses(channel, output) = beta
+                            * diffSynapses(channel, output);
+                    }
                 }
             }
         }
+        else {
+            // diffSynapses = diffInputs^T.inputs
+            Gemm::gemmParallel<T>(Gemm::Trans, Gemm::NoTrans,
+                                  getNbOutputs(), nbChannels, input.dimB(),
+                                  T(1.0),
+                                  &mDiffInputs(0), outputSize,
+                                  &input(0), nbChannels,
+                                  T(beta),
+                                  &diffSynapses(0), nbChannels,
+                                  mGemmWorkspaces);
+        }
 
         mDiffSynapses[k].setValid();
     }
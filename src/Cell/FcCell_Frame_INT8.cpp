@@ -0,0 +1,218 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/Cell_Frame_INT8_Kernels.hpp"
+#include "Cell/FcCell_Frame_INT8.hpp"
+#include "DeepNet.hpp"
+#include "utils/Gemm.hpp"
+
+N2D2::Registrar<N2D2::FcCell>
+N2D2::FcCell_Frame_INT8::mRegistrar("Frame_INT8",
+    N2D2::FcCell_Frame_INT8::create,
+    N2D2::Registrar<N2D2::FcCell>::Type<float>());
+
+N2D2::FcCell_Frame_INT8::FcCell_Frame_INT8(const DeepNet& deepNet,
+                                           const std::string& name,
+                                           unsigned int nbOutputs,
+                                           const std::shared_ptr
+                                           <Activation>& activation)
+    : Cell(deepNet, name, nbOutputs),
+      FcCell(deepNet, name, nbOutputs),
+      FcCell_Frame<float>(deepNet, name, nbOutputs, activation),
+      mFreeParametersInt8Valid(false),
+      mFreeParametersInt8(false)
+{
+    // ctor
+}
+
+void N2D2::FcCell_Frame_INT8::initialize()
+{
+    FcCell_Frame<float>::initialize();
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::FcCell_Frame_INT8::propagate(bool inference)
+{
+    // Without SIMD instructions, the integer GEMM is slower than the float
+    // one
+    if (!inference || !Gemm::gemmInt8Accelerated() || !propagateInt8()) {
+        FcCell_Frame<float>::propagate(inference);
+        return;
+    }
+
+    Cell_Frame<float>::propagate(inference);
+    mDiffInputs.clearValid();
+    mDiffSynapses.clearValid();
+    mDiffBias.clearValid();
+}
+
+void N2D2::FcCell_Frame_INT8::update()
+{
+    FcCell_Frame<float>::update();
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::FcCell_Frame_INT8::loadFreeParameters(const std::string& fileName,
+                                                 bool ignoreNotExists)
+{
+    FcCell_Frame<float>::loadFreeParameters(fileName, ignoreNotExists);
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::FcCell_Frame_INT8::setWeight(unsigned int output,
+                                        unsigned int channel,
+                                        const BaseTensor& value)
+{
+    FcCell_Frame<float>::setWeight(output, channel, value);
+    mFreeParametersInt8Valid = false;
+}
+
+void N2D2::FcCell_Frame_INT8::setBias(unsigned int output,
+                                      const BaseTensor& value)
+{
+    FcCell_Frame<float>::setBias(output, value);
+    mFreeParametersInt8Valid = false;
+}
+
+bool N2D2::FcCell_Frame_INT8::convertFreeParameters()
+{
+    const unsigned int outputSize = mOutputs.dimX() * mOutputs.dimY()
+                                    * mOutputs.dimZ();
+    const unsigned int nbInputs = mInputs.size();
+
+    mBiasesInt8.assign(outputSize, 0);
+
+    if (!mNoBias && !Cell_Frame_INT8_Kernels::convertBiases(&mBias(0),
+                                                            outputSize,
+                                                            &mBiasesInt8[0]))
+    {
+        return false;
+    }
+
+    // As in FcCell_Frame<T>::propagate(), the bias is added for each input
+    for (unsigned int output = 0; output < outputSize; ++output)
+        mBiasesInt8[output] *= (int32_t)nbInputs;
+
+    mWeightsInt8.resize(nbInputs);
+    mWeightsInt8Sums.resize(nbInputs);
+
+    for (unsigned int k = 0; k < nbInputs; ++k) {
+        const Tensor<float>& synapses = mSynapses[k];
+        const unsigned int inputSize = synapses.size() / outputSize;
+
+        mWeightsInt8[k].resize(synapses.size());
+        mWeightsInt8Sums[k].assign(outputSize, 0);
+
+        if (!Cell_Frame_INT8_Kernels::convertWeights(&synapses(0),
+                                                     synapses.size(),
+                                                     &mWeightsInt8[k][0]))
+        {
+            return false;
+        }
+
+        for (unsigned int output = 0; output < outputSize; ++output) {
+            const int8_t* weights = &mWeightsInt8[k][0] + output * inputSize;
+            int32_t sum = 0;
+
+            for (unsigned int i = 0; i < inputSize; ++i)
+                sum += weights[i];
+
+            mWeightsInt8Sums[k][output] = sum;
+        }
+    }
+
+    return true;
+}
+
+bool N2D2::FcCell_Frame_INT8::propagateInt8()
+{
+    // Normalize modifies the weights at each propagation
+    if (!isQuantized() || getQuantizedNbBits() > 8 || mNormalize)
+        return false;
+
+    if (!mFreeParametersInt8Valid) {
+        mFreeParametersInt8 = convertFreeParameters();
+        mFreeParametersInt8Valid = true;
+    }
+
+    if (!mFreeParametersInt8)
+        return false;
+
+    mInputs.synchronizeDBasedToH();
+
+    const unsigned int outputSize = mOutputs.dimX() * mOutputs.dimY()
+                                    * mOutputs.dimZ();
+    const unsigned int nbBatches = mInputs.dimB();
+    const unsigned int nbInputs = mInputs.size();
+
+    // Integer biases, minus the contribution of the inputs offsets
+    std::vector<int32_t> biases(mBiasesInt8);
+    std::vector<int> offsets(nbInputs);
+
+    mInputsInt8.resize(nbInputs);
+
+    for (unsigned int k = 0; k < nbInputs; ++k) {
+        const Tensor<float>& input = tensor_cast<float>(mInputs[k]);
+
+        offsets[k] = Cell_Frame_INT8_Kernels::getInputsOffset(&input(0),
+                                                              input.size());
+
+        if (offsets[k] < 0)
+            return false;
+
+        if (offsets[k] != 0) {
+            for (unsigned int output = 0; output < outputSize; ++output)
+                biases[output] -= offsets[k] * mWeightsInt8Sums[k][output];
+        }
+
+        mInputsInt8[k].resize(input.size());
+        Cell_Frame_INT8_Kernels::convertInputs(&input(0), input.size(),
+                                               offsets[k], &mInputsInt8[k][0]);
+    }
+
+    mAccumulators.resize((std::size_t)outputSize * nbBatches);
+
+    for (unsigned int output = 0; output < outputSize; ++output) {
+        std::fill(mAccumulators.begin() + output * nbBatches,
+                  mAccumulators.begin() + (output + 1) * nbBatches,
+                  biases[output]);
+    }
+
+    for (unsigned int k = 0; k < nbInputs; ++k) {
+        const unsigned int inputSize = mInputs[k].dimX() * mInputs[k].dimY()
+                                        * mInputs[k].dimZ();
+
+        // acc[outputSize x batch] += synapses[outputSize x inputSize]
+        //                            * inputs[batch x inputSize]^T
+        Gemm::gemmInt8Parallel(outputSize, nbBatches, inputSize,
+                               &mWeightsInt8[k][0], inputSize,
+                               &mInputsInt8[k][0], inputSize,
+                               &mAccumulators[0], nbBatches);
+    }
+
+    for (unsigned int batchPos = 0; batchPos < nbBatches; ++batchPos) {
+        for (unsigned int output = 0; output < outputSize; ++output) {
+            mOutputs(output, batchPos)
+                = (float)mAccumulators[output * nbBatches + batchPos];
+        }
+    }
+
+    return true;
+}
@@ -45,7 +45,8 @@ N2D2::FcCell_Spike::FcCell_Spike(Network& net, const DeepNet& deepNet,
       mLeak(this, "Leak", 0.0),
       mRefractory(this, "Refractory", 0 * TimeS),
       mTerminateDelta(this, "TerminateDelta", 0),
-      mTerminateMax(this, "TerminateMax", 0)
+      mTerminateMax(this, "TerminateMax", 0),
+      mSynapticStats(this, "SynapticStats", true)
 {
     // ctor
     mWeightsFiller = std::make_shared<NormalFiller<Float_T> >(0.0, 0.05);
@@ -57,10 +58,36 @@ void N2D2::FcCell_Spike::initialize()
     std::vector<size_t> synapsesDims = mInputsDims;
     synapsesDims.push_back(mOutputs.dimZ());
 
-    mSynapses.resize(synapsesDims);
+    const size_t nbSynapses = std::accumulate(synapsesDims.begin(),
+                                              synapsesDims.end(),
+                                              1U,
+                                              std::multiplies<size_t>());
+
+    // Synapse_Static synapses are packed in mPackedSynapses. The other
+    // synapse models are kept as individual objects in mSynapses.
+    std::unique_ptr<Synapse> synapse(newSynapse());
+    const Synapse_Static* staticSynapse
+        = dynamic_cast<Synapse_Static*>(synapse.get());
+
+    if (staticSynapse != NULL) {
+        mPackedSynapses
+            = SynapseStore_Static(staticSynapse->bipolar, mSynapticStats);
+        mPackedSynapses.reserve(nbSynapses);
+        mPackedSynapses.push_back(*staticSynapse);
+
+        for (size_t index = 1; index < nbSynapses; ++index) {
+            synapse.reset(newSynapse());
+            mPackedSynapses.push_back(
+                *static_cast<Synapse_Static*>(synapse.get()));
+        }
+    }
+    else {
+        mSynapses.resize(synapsesDims);
+        mSynapses(0) = synapse.release();
 
-    for (size_t index = 0; index < mSynapses.size(); ++index)
-        mSynapses(index) = newSynapse();
+        for (size_t index = 1; index < nbSynapses; ++index)
+            mSynapses(index) = newSynapse();
+    }
 
     mOutputsLastIntegration.resize(getNbOutputs(), 0);
     mOutputsIntegration.resize(getNbOutputs(), 0.0);
@@ -75,8 +102,8 @@ void N2D2::FcCell_Spike::propagateSpike(NodeIn* origin,
     const Area& area = origin->getArea();
 
     for (unsigned int output = 0; output < getNbOutputs(); ++output) {
-        const Time_T delay = static_cast<Synapse_Static*>(
-            mSynapses(area.x, area.y, origin->getChannel(), output))->delay;
+        const Time_T delay = mPackedSynapses.getDelay(
+            synapseIndex(area.x, area.y, origin->getChannel(), output));
 
         if (delay > 0)
             mNet.newEvent(origin, NULL, timestamp + delay, maps(output, type));
@@ -119,12 +146,9 @@ void N2D2::FcCell_Spike::incomingSpike(NodeIn* origin,
 
     lastIntegration = timestamp;
 
-    Synapse_Static* synapse = static_cast<Synapse_Static*>(
-        mSynapses(area.x, area.y, origin->getChannel(), output));
-    integration += (negative) ? -synapse->weight : synapse->weight;
-
-    // Stats
-    ++synapse->statsReadEvents;
+    const double weight = mPackedSynapses.read(
+        synapseIndex(area.x, area.y, origin->getChannel(), output));
+    integration += (negative) ? -weight : weight;
 
     if ((integration >= mThreshold
          || (mBipolarThreshold && (-integration) >= mThreshold))
@@ -233,11 +257,15 @@ void N2D2::FcCell_Spike::saveFreeParameters(const std::string& fileName) const
         throw std::runtime_error("Could not create synaptic file (.SYN): "
                                  + fileName);
 
-    for (std::vector<Synapse*>::const_iterator it = mSynapses.begin(),
-                                               itEnd = mSynapses.end();
-         it != itEnd;
-         ++it)
-        (*it)->saveInternal(syn);
+    if (!mPackedSynapses.empty())
+        mPackedSynapses.save(syn);
+    else {
+        for (std::vector<Synapse*>::const_iterator it = mSynapses.begin(),
+                                                   itEnd = mSynapses.end();
+             it != itEnd;
+             ++it)
+            (*it)->saveInternal(syn);
+    }
 }
 
 void N2D2::FcCell_Spike::loadFreeParameters(const std::string& fileName,
@@ -256,11 +284,15 @@ void N2D2::FcCell_Spike::loadFreeParameters(const std::string& fileName,
                                      + fileName);
     }
 
-    for (std::vector<Synapse*>::const_iterator it = mSynapses.begin(),
-                                               itEnd = mSynapses.end();
-         it != itEnd;
-         ++it)
-        (*it)->loadInternal(syn);
+    if (!mPackedSynapses.empty())
+        mPackedSynapses.load(syn);
+    else {
+        for (std::vector<Synapse*>::const_iterator it = mSynapses.begin(),
+                                                   itEnd = mSynapses.end();
+             it != itEnd;
+             ++it)
+            (*it)->loadInternal(syn);
+    }
 
     if (syn.eof())
         throw std::runtime_error(
@@ -308,10 +340,21 @@ N2D2::Synapse::Stats N2D2::FcCell_Spike::logStats(const std::string
         for (unsigned int i = 0; i < channelsSize; ++i) {
             std::ostringstream suffixStr;
             suffixStr << i;
-            mSynapses(i, output)->logStats(data, suffixStr.str());
 
-            mSynapses(i, output)->getStats(stats.get());
-            mSynapses(i, output)->getStats(statsOutput.get());
+            if (!mPackedSynapses.empty()) {
+                const size_t index = i + channelsSize * output;
+
+                mPackedSynapses.logStats(index, data, suffixStr.str());
+
+                mPackedSynapses.getStats(index, stats.get());
+                mPackedSynapses.getStats(index, statsOutput.get());
+            }
+            else {
+                mSynapses(i, output)->logStats(data, suffixStr.str());
+
+                mSynapses(i, output)->getStats(stats.get());
+                mSynapses(i, output)->getStats(statsOutput.get());
+            }
         }
 
         dummy->logStats(globalData, statsOutput.get());
@@ -0,0 +1,193 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Cell/PoolCell_CSpike.hpp"
+#include "DeepNet.hpp"
+
+N2D2::Registrar<N2D2::PoolCell>
+N2D2::PoolCell_CSpike::mRegistrar("CSpike",
+    N2D2::PoolCell_CSpike::create,
+    N2D2::Registrar<N2D2::PoolCell>::Type<Float_T>());
+
+N2D2::PoolCell_CSpike::PoolCell_CSpike(const DeepNet& deepNet,
+    const std::string& name,
+    const std::vector<unsigned int>& poolDims,
+    unsigned int nbOutputs,
+    const std::vector<unsigned int>& strideDims,
+    const std::vector<unsigned int>& paddingDims,
+    Pooling pooling)
+    : Cell(deepNet, name, nbOutputs),
+      PoolCell(deepNet, name,
+               poolDims,
+               nbOutputs,
+               strideDims,
+               paddingDims,
+               pooling),
+      Cell_CSpike(deepNet, name, nbOutputs),
+      mPoolNbChannels(nbOutputs, 0)
+{
+    // ctor
+    if (mPoolDims.size() != 2) {
+        throw std::domain_error("PoolCell_CSpike: only 2D pooling is"
+                                " supported");
+    }
+
+    if (strideDims.size() != poolDims.size()) {
+        throw std::domain_error("PoolCell_CSpike: the number of dimensions"
+                                " of stride must match the number of"
+                                " dimensions of the pooling.");
+    }
+
+    if (paddingDims.size() != poolDims.size()) {
+        throw std::domain_error("PoolCell_CSpike: the number of dimensions"
+                                " of padding must match the number of"
+                                " dimensions of the pooling.");
+    }
+}
+
+void N2D2::PoolCell_CSpike::setExtendedPadding(
+    const std::vector<int>& /*paddingDims*/)
+{
+    throw std::domain_error("PoolCell_CSpike: extended padding is currently"
+                            " not supported.");
+}
+
+void N2D2::PoolCell_CSpike::initialize()
+{
+    std::vector<size_t> inputsDims = mInputsDims;
+    inputsDims.push_back(mOutputs.dimB());
+
+    mInputsActivity.resize(inputsDims, 0.0);
+
+    std::fill(mPoolNbChannels.begin(), mPoolNbChannels.end(), 0U);
+
+    for (unsigned int output = 0; output < getNbOutputs(); ++output) {
+        for (unsigned int channel = 0; channel < getNbChannels(); ++channel)
+            mPoolNbChannels[output] += isConnection(channel, output);
+    }
+}
+
+bool N2D2::PoolCell_CSpike::tick(Time_T /*timestamp*/)
+{
+    const unsigned int batchSize = mOutputs.dimB();
+    const unsigned int inputsSize = getInputsSize();
+
+    // Accumulate the activity of the inputs
+    unsigned int offset = 0;
+
+    for (unsigned int k = 0, size = mInputs.size(); k < size; ++k) {
+        const Tensor<Float_T>& input = mInputs[k];
+        const unsigned int inputSize = input.size() / batchSize;
+
+#pragma omp parallel for if (batchSize > 1)
+        for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+            const Float_T* inputData = &input(inputSize * batchPos);
+            Float_T* inputsActivity
+                = &mInputsActivity(offset + inputsSize * batchPos);
+
+            for (unsigned int index = 0; index < inputSize; ++index)
+                inputsActivity[index] += inputData[index];
+        }
+
+        offset += inputSize;
+    }
+
+    // Emit the output spikes
+    const unsigned int outputsWidth = mOutputs.dimX();
+    const unsigned int outputsHeight = mOutputs.dimY();
+    const unsigned int nbOutputs = getNbOutputs();
+    const unsigned int nbChannels = getNbChannels();
+
+#pragma omp parallel for collapse(2) if (batchSize * nbOutputs > 16)
+    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+        for (int output = 0; output < (int)nbOutputs; ++output) {
+            if (mPoolNbChannels[output] == 0)
+                continue;
+
+            const unsigned int poolSize = mPoolDims[0] * mPoolDims[1]
+                                          * mPoolNbChannels[output];
+
+            for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+                for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+                    const int sxMin = (int)(ox * mStrideDims[0])
+                                      - (int)mPaddingDims[0];
+                    const int syMin = (int)(oy * mStrideDims[1])
+                                      - (int)mPaddingDims[1];
+                    const unsigned int ixMin = std::max(sxMin, 0);
+                    const unsigned int iyMin = std::max(syMin, 0);
+                    const unsigned int ixMax = std::min<int>(
+                        sxMin + mPoolDims[0], mInputsDims[0]);
+                    const unsigned int iyMax = std::min<int>(
+                        syMin + mPoolDims[1], mInputsDims[1]);
+
+                    bool valid = false;
+                    Float_T poolActivity = 0.0;
+
+                    for (unsigned int channel = 0; channel < nbChannels;
+                         ++channel)
+                    {
+                        if (!isConnection(channel, output))
+                            continue;
+
+                        for (unsigned int iy = iyMin; iy < iyMax; ++iy) {
+                            for (unsigned int ix = ixMin; ix < ixMax; ++ix) {
+                                const Float_T activity = mInputsActivity(
+                                    ix, iy, channel, batchPos);
+
+                                if (mPooling == Max) {
+                                    if (!valid || activity > poolActivity) {
+                                        poolActivity = activity;
+                                        valid = true;
+                                    }
+                                }
+                                else
+                                    poolActivity += activity;
+                            }
+                        }
+                    }
+
+                    if (mPooling == Average) {
+                        poolActivity = Utils::round(poolActivity
+                                                    / (Float_T)poolSize);
+                    }
+
+                    Float_T& outputActivity
+                        = mOutputsActivity(ox, oy, output, batchPos);
+                    const Float_T delta = poolActivity - outputActivity;
+                    const Float_T outputSpike = (delta >= 1.0) ? 1.0
+                        : (delta <= -1.0) ? -1.0
+                        : 0.0;
+
+                    mOutputs(ox, oy, output, batchPos) = outputSpike;
+                    outputActivity += outputSpike;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void N2D2::PoolCell_CSpike::reset(Time_T timestamp)
+{
+    Cell_CSpike::reset(timestamp);
+
+    mInputsActivity.assign(mInputsActivity.dims(), 0.0);
+}
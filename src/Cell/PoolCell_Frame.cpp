@@ -31,7 +31,7 @@ N2D2::PoolCell_Frame<half_float::half>::mRegistrar("Frame",
 
 template <>
 N2D2::Registrar<N2D2::PoolCell>
-N2D2::PoolCell_Frame<float>::mRegistrar("Frame",
+N2D2::PoolCell_Frame<float>::mRegistrar({"Frame", "Frame_INT8"},
     N2D2::PoolCell_Frame<float>::create,
     N2D2::Registrar<N2D2::PoolCell>::Type<float>());
 
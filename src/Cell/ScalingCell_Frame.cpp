@@ -35,7 +35,7 @@ static const N2D2::Registrar<N2D2::ScalingCell> registrarHalfFloat(
                     N2D2::Registrar<N2D2::ScalingCell>::Type<half_float::half>());
 
 static const N2D2::Registrar<N2D2::ScalingCell> registrarFloat(
-                    "Frame", N2D2::ScalingCell_Frame<float>::create,
+                    {"Frame", "Frame_INT8"}, N2D2::ScalingCell_Frame<float>::create,
                     N2D2::Registrar<N2D2::ScalingCell>::Type<float>());
 
 static const N2D2::Registrar<N2D2::ScalingCell> registrarDouble(
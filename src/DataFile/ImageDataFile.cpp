@@ -20,6 +20,72 @@
 
 #include "DataFile/ImageDataFile.hpp"
 
+#include <fstream>
+
+// IMREAD_REDUCED_* flags are available since OpenCV 3.0, and
+// IMREAD_IGNORE_ORIENTATION since OpenCV 3.1
+#if CV_MAJOR_VERSION > 3 || (CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION >= 1)
+#define N2D2_IMREAD_REDUCED
+#endif
+
+namespace {
+    /// Read the frame header of a JPEG file, without decoding it.
+    /// Return false if @p fileName is not a valid JPEG file.
+    bool readJpegHeader(const std::string& fileName,
+                        unsigned int& width,
+                        unsigned int& height,
+                        unsigned int& precision,
+                        unsigned int& nbComponents)
+    {
+        std::ifstream jpeg(fileName.c_str(), std::ios::binary);
+
+        if (jpeg.get() != 0xFF || jpeg.get() != 0xD8)
+            return false;
+
+        while (jpeg.good()) {
+            int marker = jpeg.get();
+
+            if (marker != 0xFF)
+                return false;
+
+            // Skip fill bytes
+            while (marker == 0xFF)
+                marker = jpeg.get();
+
+            // Standalone markers (TEM and RSTn)
+            if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+                continue;
+
+            // End of image or start of scan before any frame header
+            if (marker == 0xD9 || marker == 0xDA || marker == EOF)
+                return false;
+
+            unsigned int length = (jpeg.get() << 8);
+            length |= jpeg.get();
+
+            if (!jpeg.good() || length < 2)
+                return false;
+
+            // SOFn markers, except DHT (C4), JPG (C8) and DAC (CC)
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4
+                && marker != 0xC8 && marker != 0xCC)
+            {
+                precision = jpeg.get();
+                height = (jpeg.get() << 8);
+                height |= jpeg.get();
+                width = (jpeg.get() << 8);
+                width |= jpeg.get();
+                nbComponents = jpeg.get();
+                return jpeg.good();
+            }
+
+            jpeg.seekg(length - 2, std::ios::cur);
+        }
+
+        return false;
+    }
+}
+
 N2D2::Registrar<N2D2::DataFile>
 N2D2::ImageDataFile::mRegistrar({// Windows bitmaps
                                 "bmp",
@@ -59,6 +125,78 @@ cv::Mat N2D2::ImageDataFile::read(const std::string& fileName)
     return data;
 }
 
+N2D2::DataFile::Reduction
+N2D2::ImageDataFile::getReduction(const std::string& fileName,
+                                  const cv::Size& minSize)
+{
+#ifdef N2D2_IMREAD_REDUCED
+    unsigned int width, height, precision, nbComponents;
+
+    if (minSize.width <= 0 || minSize.height <= 0
+        || !readJpegHeader(fileName, width, height, precision, nbComponents)
+        || precision != 8 || (nbComponents != 1 && nbComponents != 3))
+    {
+        return Reduction();
+    }
+
+    // The JPEG decoder rounds up the reduced size
+    for (unsigned int reduction = 8; reduction > 1; reduction /= 2) {
+        if ((width + reduction - 1) / reduction >= (unsigned int)minSize.width
+            && (height + reduction - 1) / reduction
+                >= (unsigned int)minSize.height)
+        {
+            int flags;
+
+            if (reduction == 2) {
+                flags = (nbComponents == 1) ? cv::IMREAD_REDUCED_GRAYSCALE_2
+                                            : cv::IMREAD_REDUCED_COLOR_2;
+            }
+            else if (reduction == 4) {
+                flags = (nbComponents == 1) ? cv::IMREAD_REDUCED_GRAYSCALE_4
+                                            : cv::IMREAD_REDUCED_COLOR_4;
+            }
+            else {
+                flags = (nbComponents == 1) ? cv::IMREAD_REDUCED_GRAYSCALE_8
+                                            : cv::IMREAD_REDUCED_COLOR_8;
+            }
+
+            // Like IMREAD_UNCHANGED, ignore the EXIF orientation
+            return Reduction(reduction,
+                             flags | cv::IMREAD_IGNORE_ORIENTATION);
+        }
+    }
+#else
+    (void)fileName;
+    (void)minSize;
+#endif
+
+    return Reduction();
+}
+
+cv::Mat N2D2::ImageDataFile::readReduced(const std::string& fileName,
+                                         const Reduction& reduction)
+{
+    if (reduction.factor == 1)
+        return read(fileName);
+
+#ifdef N2D2_IMREAD_REDUCED
+    if (reduction.flags == 0) {
+        throw std::runtime_error("ImageDataFile::readReduced(): unsupported"
+                                 " reduction factor for image: " + fileName);
+    }
+
+    const cv::Mat data = cv::imread(fileName, reduction.flags);
+
+    if (!data.data)
+        throw std::runtime_error("ImageDataFile::readReduced(): unable to"
+                                 " read image: " + fileName);
+
+    return data;
+#else
+    return DataFile::readReduced(fileName, reduction);
+#endif
+}
+
 void N2D2::ImageDataFile::write(const std::string& fileName,
                                 const cv::Mat& data)
 {
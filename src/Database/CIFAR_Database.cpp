@@ -50,74 +50,82 @@ void N2D2::CIFAR_Database::loadCIFAR(const std::string& dataFile,
     labels.close();
 
     // Images
-    std::ifstream images(dataFile.c_str(), std::fstream::binary);
-
-    if (!images.good())
+    if (!std::ifstream(dataFile.c_str()).good())
         throw std::runtime_error("Could not open images file: " + dataFile);
 
-    const std::ifstream::pos_type size
-        = images.seekg(0, std::ifstream::end).tellg();
-    images.seekg(0, std::ifstream::beg);
+    const std::shared_ptr<MemoryMappedFile> images
+        = std::make_shared<MemoryMappedFile>(dataFile);
+
+    const std::size_t recordSize = 1 + coarseAndFine + 3 * nbRows * nbColumns;
+    const unsigned int nbImages = images->size() / recordSize;
+
+    if (images->size() > nbImages * recordSize)
+        throw std::runtime_error("Data file size larger than expected: "
+                                 + dataFile);
 
-    const unsigned int nbImages
-        = size / (1 + coarseAndFine + 3 * nbRows * nbColumns);
+    mStimuli.reserve(mStimuli.size() + nbImages);
+    mMappedData.reserve(mMappedData.size() + nbImages);
 
     // For each image...
     for (unsigned int i = 0; i < nbImages; ++i) {
+        const std::size_t offset = i * recordSize;
+
         // Read label
-        unsigned char label;
-        images.read(reinterpret_cast<char*>(&label), sizeof(label));
+        unsigned char label = images->data()[offset];
 
-        if (coarseAndFine) {
-            unsigned char fineLabel;
-            images.read(reinterpret_cast<char*>(&fineLabel), sizeof(fineLabel));
+        if (coarseAndFine && !useCoarse)
+            label = images->data()[offset + 1];
 
-            if (!useCoarse)
-                label = fineLabel;
+        if (label >= labelsName.size()) {
+            std::ostringstream msgStr;
+            msgStr << "Label ID (" << (unsigned int)label << ") out of range"
+                " in data file: " << dataFile;
+
+            throw std::runtime_error(msgStr.str());
         }
 
         std::ostringstream nameStr;
         nameStr << dataFile << "[" << std::setfill('0') << std::setw(5) << i
                 << "].ppm";
 
-        // ... generate the stimuli
-        if (!std::ifstream(nameStr.str()).good()) {
-            cv::Mat frame(
-                cv::Size(nbColumns, nbRows), CV_8UC3, cv::Scalar(0, 0, 0));
-
-            for (int c = 2; c >= 0; --c) {
-                for (unsigned int y = 0; y < nbRows; ++y) {
-                    for (unsigned int x = 0; x < nbColumns; ++x) {
-                        unsigned char color;
-                        images.read(reinterpret_cast<char*>(&color),
-                                    sizeof(color));
-
-                        // Vec3b color order: blue, green, red
-                        frame.at<cv::Vec3b>(y, x)[c] = color;
-                    }
-                }
-            }
-
-            if (!cv::imwrite(nameStr.str(), frame))
-                throw std::runtime_error("Unable to write image: "
-                                         + nameStr.str());
-        } else {
-            // Skip image data (to grab labels only)
-            images.seekg(3 * nbColumns * nbRows, images.cur);
-        }
+        // ... map the stimulus to its data in the images file
+        MappedData mappedData;
+        mappedData.file = images;
+        mappedData.offset = offset + 1 + coarseAndFine;
+        mMappedData[nameStr.str()] = mappedData;
 
         mStimuli.push_back(Stimulus(nameStr.str(), labelID(labelsName[label])));
         mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
     }
+}
 
-    if (images.eof())
-        throw std::runtime_error(
-            "End-of-file reached prematurely in data file: " + dataFile);
-    else if (!images.good())
-        throw std::runtime_error("Error while reading data file: " + dataFile);
-    else if (images.get() != std::fstream::traits_type::eof())
-        throw std::runtime_error("Data file size larger than expected: "
-                                 + dataFile);
+cv::Mat N2D2::CIFAR_Database::readData(StimulusID id,
+                                       const std::string& fileName) const
+{
+    const unsigned int nbRows = 32;
+    const unsigned int nbColumns = 32;
+
+    const std::unordered_map<std::string, MappedData>::const_iterator it
+        = mMappedData.find(fileName);
+
+    if (it == mMappedData.end())
+        return Database::readData(id, fileName);
+
+    // The red, green and blue planes are mapped without copy, and merged
+    // in the blue, green, red order
+    const MappedData& mappedData = (*it).second;
+    char* planes = mappedData.file->data() + mappedData.offset;
+
+    std::vector<cv::Mat> channels;
+
+    for (int c = 2; c >= 0; --c) {
+        channels.push_back(cv::Mat(nbRows, nbColumns, CV_8UC1,
+                                   planes + c * nbRows * nbColumns));
+    }
+
+    cv::Mat frame;
+    cv::merge(channels, frame);
+    return frame;
 }
 
 N2D2::CIFAR10_Database::CIFAR10_Database(double validation)
@@ -22,10 +22,15 @@
 #include "DataFile/DataFile.hpp"
 #include "utils/Registrar.hpp"
 
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <iterator>
 #include <regex>
 
 N2D2::DIR_Database::DIR_Database(bool loadDataInMemory)
-    : Database(loadDataInMemory)
+    : Database(loadDataInMemory),
+      mManifestPath(this, "ManifestPath", "")
 {
     // ctor
 }
@@ -59,44 +64,200 @@ void N2D2::DIR_Database::loadDir(const std::string& dirPath,
                                  int depth,
                                  const std::string& labelName,
                                  int labelDepth)
+{
+    loadDirs(std::vector<std::string>(1, dirPath),
+             depth,
+             std::vector<std::string>(1, labelName),
+             labelDepth);
+}
+
+void N2D2::DIR_Database::loadDirs(const std::vector<std::string>& dirPaths,
+                                  int depth,
+                                  const std::vector<std::string>& labelNames,
+                                  int labelDepth)
 {
     if (!((std::string)mDefaultLabel).empty())
         labelID(mDefaultLabel);
 
+    loadManifest();
+
+    // Scan the directories tree level by level, each directory in parallel
+    std::map<std::string, DirScan> scans;
+    std::vector<std::pair<std::string, int> > level;
+
+    for (std::vector<std::string>::const_iterator it = dirPaths.begin(),
+         itEnd = dirPaths.end(); it != itEnd; ++it)
+    {
+        level.push_back(std::make_pair(*it, depth));
+    }
+
+    // Directories modified less than this number of seconds before the scan
+    // are not cached, as a later change may not modify their mtime
+    const long long int manifestMinAge = 2;
+    const long long int scanTime = (long long int)time(NULL);
+    bool updateManifest = false;
+
+    while (!level.empty()) {
+        std::vector<DirScan> levelScans(level.size());
+        std::vector<bool> levelCached(level.size(), false);
+        std::vector<std::exception_ptr> levelErrors(level.size());
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < (int)level.size(); ++i) {
+            try {
+                const std::string& dirPath = level[i].first;
+                struct stat dirStat;
+
+                // Already scanned, only its sub-directories are loaded
+                if (scans.find(dirPath) != scans.end())
+                    continue;
+
+                if (!mManifestLoadedPath.empty()
+                    && stat(dirPath.c_str(), &dirStat) == 0)
+                {
+                    const std::map<std::string, DirScan>::const_iterator
+                        itManifest = mManifest.find(dirPath);
+
+                    if (itManifest != mManifest.end()
+                        && (*itManifest).second.mtime
+                            == (long long int)dirStat.st_mtime)
+                    {
+                        levelScans[i] = (*itManifest).second;
+                        levelCached[i] = true;
+                        continue;
+                    }
+                }
+
+                levelScans[i] = scanDir(dirPath);
+            }
+            catch (...) {
+                levelErrors[i] = std::current_exception();
+            }
+        }
+
+        std::vector<std::pair<std::string, int> > nextLevel;
+
+        for (unsigned int i = 0; i < level.size(); ++i) {
+            if (levelErrors[i])
+                std::rethrow_exception(levelErrors[i]);
+
+            const std::string& dirPath = level[i].first;
+
+            std::map<std::string, DirScan>::iterator itScan
+                = scans.find(dirPath);
+
+            if (itScan == scans.end()) {
+                if (!mManifestLoadedPath.empty() && !levelCached[i]
+                    && levelScans[i].mtime + manifestMinAge <= scanTime)
+                {
+                    mManifest[dirPath] = levelScans[i];
+                    updateManifest = true;
+                }
+
+                itScan = scans.insert(std::make_pair(dirPath,
+                                            std::move(levelScans[i]))).first;
+            }
+
+            const int dirDepth = level[i].second;
+
+            if (dirDepth != 0) {
+                const std::vector<std::string>& subDirs
+                    = (*itScan).second.subDirs;
+
+                for (std::vector<std::string>::const_iterator it
+                     = subDirs.begin(), itEnd = subDirs.end();
+                     it != itEnd; ++it)
+                {
+                    nextLevel.push_back(std::make_pair(*it, dirDepth - 1));
+                }
+            }
+        }
+
+        level.swap(nextLevel);
+    }
+
+    if (updateManifest)
+        saveManifest();
+
+    // Reserve once for all the scanned files, as an exact reserve in each
+    // registerDir() would reallocate for every directory
+    std::size_t nbFiles = 0;
+
+    for (std::map<std::string, DirScan>::const_iterator it = scans.begin(),
+         itEnd = scans.end(); it != itEnd; ++it)
+    {
+        nbFiles += (*it).second.files.size();
+    }
+
+    mStimuli.reserve(mStimuli.size() + nbFiles);
+    mStimuliSets(Unpartitioned).reserve(mStimuliSets(Unpartitioned).size()
+                                        + nbFiles);
+
+    // Register the stimuli in deterministic order
+    for (unsigned int i = 0; i < dirPaths.size(); ++i) {
+        registerDir(dirPaths[i],
+                    depth,
+                    (i < labelNames.size()) ? labelNames[i] : "",
+                    labelDepth,
+                    scans);
+    }
+}
+
+N2D2::DIR_Database::DirScan
+N2D2::DIR_Database::scanDir(const std::string& dirPath) const
+{
+    DirScan dirScan;
+    struct stat fileStat;
+
+    if (stat(dirPath.c_str(), &fileStat) == 0)
+        dirScan.mtime = (long long int)fileStat.st_mtime;
+
     DIR* pDir = opendir(dirPath.c_str());
 
     if (pDir == NULL)
         throw std::runtime_error("Couldn't open database directory: "
                                  + dirPath);
 
-    struct dirent* pFile;
-    struct stat fileStat;
-    std::vector<std::string> subDirs;
-    std::vector<std::string> files;
+    const std::string& multiChannelMatch
+        = getParameter<std::string>("MultiChannelMatch");
+    const std::vector<std::string>& multiChannelReplace
+        = getParameter<std::vector<std::string> >("MultiChannelReplace");
+    const std::regex regexp(multiChannelMatch);
 
-    std::cout << "Loading directory database \"" << dirPath << "\""
-              << std::endl;
+    struct dirent* pFile;
 
     while ((pFile = readdir(pDir))) {
         const std::string fileName(pFile->d_name);
         const std::string filePath(dirPath + "/" + fileName);
 
-        // Ignore file in case of stat failure
-        if (stat(filePath.c_str(), &fileStat) < 0)
-            continue;
         // Exclude current and parent directories
         if (!strcmp(pFile->d_name, ".") || !strcmp(pFile->d_name, ".."))
             continue;
 
+        bool isDir;
+
+#ifdef _DIRENT_HAVE_D_TYPE
+        // Avoid a stat() per file when the file type is known
+        if (pFile->d_type == DT_DIR || pFile->d_type == DT_REG)
+            isDir = (pFile->d_type == DT_DIR);
+        else
+#endif
+        {
+            // Ignore file in case of stat failure
+            if (stat(filePath.c_str(), &fileStat) < 0)
+                continue;
+
+            isDir = S_ISDIR(fileStat.st_mode);
+        }
+
         bool masked = false;
 
         for (std::vector<std::string>::const_iterator it = mIgnoreMasks.begin(),
              itEnd = mIgnoreMasks.end(); it != itEnd; ++it)
         {
             if (Utils::match((*it), filePath)) {
-                std::cout << Utils::cnotice << "Notice: path \"" << filePath
-                          << "\" ignored (matching mask: " << (*it) << ")."
-                          << Utils::cdef << std::endl;
+                dirScan.notices.push_back("Notice: path \"" + filePath
+                    + "\" ignored (matching mask: " + (*it) + ").");
                 masked = true;
             }
         }
@@ -104,8 +265,8 @@ void N2D2::DIR_Database::loadDir(const std::string& dirPath,
         if (masked)
             continue;
 
-        if (S_ISDIR(fileStat.st_mode))
-            subDirs.push_back(filePath);
+        if (isDir)
+            dirScan.subDirs.push_back(filePath);
         else {
             // Exclude files with wrong extension
             std::string fileExtension = Utils::fileExtension(fileName);
@@ -119,54 +280,67 @@ void N2D2::DIR_Database::loadDir(const std::string& dirPath,
                                                       fileExtension)
                                             != mValidExtensions.end()) {
                 if (!Registrar<DataFile>::exists(fileExtension)) {
-                    std::cout << Utils::cnotice << "Notice: file " << fileName
-                              << " does not appear to be a valid stimulus,"
-                                 " ignoring." << Utils::cdef << std::endl;
+                    dirScan.notices.push_back("Notice: file " + fileName
+                        + " does not appear to be a valid stimulus,"
+                          " ignoring.");
                     continue;
                 }
 
-                const std::string& multiChannelMatch
-                    = getParameter<std::string>("MultiChannelMatch");
-
                 if (!multiChannelMatch.empty()) {
-                    const std::regex regexp(multiChannelMatch);
-
                     if (!std::regex_match(filePath, regexp))
                         continue;
 
-                    const std::vector<std::string>& multiChannelReplace
-                        = getParameter<std::vector<std::string> >
-                            ("MultiChannelReplace");
-
                     for (size_t ch = 0; ch < multiChannelReplace.size(); ++ch) {
                         const std::string chFilePath
                             = std::regex_replace(filePath, regexp,
                                                 multiChannelReplace[ch]);
 
                         if (!std::ifstream(chFilePath).good()) {
-                            std::cout << Utils::cnotice
-                                << "Notice: missing channel #"
-                                << ch << " data for stimulus: " << filePath
-                                << Utils::cdef << std::endl;
+                            std::ostringstream notice;
+                            notice << "Notice: missing channel #" << ch
+                                << " data for stimulus: " << filePath;
+                            dirScan.notices.push_back(notice.str());
                         }
                     }
                 }
 
-                files.push_back(filePath);
+                dirScan.files.push_back(filePath);
             }
         }
     }
 
     closedir(pDir);
 
-    if (!files.empty()) {
-        // Load stimuli contained in this directory
-        std::sort(files.begin(), files.end());
+    std::sort(dirScan.files.begin(), dirScan.files.end());
+    std::sort(dirScan.subDirs.begin(), dirScan.subDirs.end());
+    return dirScan;
+}
+
+void N2D2::DIR_Database::registerDir(const std::string& dirPath,
+                                     int depth,
+                                     const std::string& labelName,
+                                     int labelDepth,
+                                     const std::map<std::string, DirScan>&
+                                        scans)
+{
+    const DirScan& dirScan = scans.at(dirPath);
 
+    std::cout << "Loading directory database \"" << dirPath << "\""
+              << std::endl;
+
+    for (std::vector<std::string>::const_iterator it
+         = dirScan.notices.begin(), itEnd = dirScan.notices.end();
+         it != itEnd; ++it)
+    {
+        std::cout << Utils::cnotice << (*it) << Utils::cdef << std::endl;
+    }
+
+    if (!dirScan.files.empty()) {
+        // Load stimuli contained in this directory
         const int dirLabelID = (labelDepth >= 0) ? labelID(labelName) : -1;
 
-        for (std::vector<std::string>::const_iterator it = files.begin(),
-                                                      itEnd = files.end();
+        for (std::vector<std::string>::const_iterator it
+             = dirScan.files.begin(), itEnd = dirScan.files.end();
              it != itEnd;
              ++it) {
             mStimuli.push_back(Stimulus(*it, dirLabelID));
@@ -176,25 +350,167 @@ void N2D2::DIR_Database::loadDir(const std::string& dirPath,
 
     if (depth != 0) {
         // Recursively load stimuli contained in the subdirectories
-        std::sort(subDirs.begin(), subDirs.end());
-
-        for (std::vector<std::string>::const_iterator it = subDirs.begin(),
-                                                      itEnd = subDirs.end();
+        for (std::vector<std::string>::const_iterator it
+             = dirScan.subDirs.begin(), itEnd = dirScan.subDirs.end();
              it != itEnd;
              ++it) {
             if (labelDepth > 0)
-                loadDir(*it,
-                        depth - 1,
-                        labelName + "/" + Utils::baseName(*it),
-                        labelDepth - 1);
+                registerDir(*it,
+                            depth - 1,
+                            labelName + "/" + Utils::baseName(*it),
+                            labelDepth - 1,
+                            scans);
             else
-                loadDir(*it, depth - 1, labelName, labelDepth);
+                registerDir(*it, depth - 1, labelName, labelDepth, scans);
         }
     }
 
     std::cout << "Found " << mStimuli.size() << " stimuli" << std::endl;
 }
 
+std::string N2D2::DIR_Database::getManifestOptions() const
+{
+    // Options affecting the content of a directory scan
+    std::ostringstream options;
+    options << "IgnoreMasks:";
+
+    for (std::vector<std::string>::const_iterator it = mIgnoreMasks.begin(),
+         itEnd = mIgnoreMasks.end(); it != itEnd; ++it)
+    {
+        options << " " << (*it);
+    }
+
+    options << " ValidExtensions:";
+
+    for (std::vector<std::string>::const_iterator it
+         = mValidExtensions.begin(), itEnd = mValidExtensions.end();
+         it != itEnd; ++it)
+    {
+        options << " " << (*it);
+    }
+
+    options << " MultiChannelMatch: " << getParameter("MultiChannelMatch")
+        << " MultiChannelReplace: " << getParameter("MultiChannelReplace");
+
+    return options.str();
+}
+
+void N2D2::DIR_Database::loadManifest()
+{
+    const std::string manifestPath = mManifestPath;
+
+    if (manifestPath == mManifestLoadedPath)
+        return;
+
+    mManifest.clear();
+    mManifestLoadedPath = manifestPath;
+
+    if (manifestPath.empty())
+        return;
+
+    std::ifstream manifest(manifestPath.c_str());
+
+    if (!manifest.good())
+        return;
+
+    std::string line;
+
+    // Discard the manifest if the scan options changed
+    if (!std::getline(manifest, line) || line != "N2D2 DIR_Database manifest"
+        || !std::getline(manifest, line) || line != getManifestOptions())
+    {
+        std::cout << Utils::cnotice << "Notice: discarding outdated manifest "
+            << manifestPath << Utils::cdef << std::endl;
+        return;
+    }
+
+    std::map<std::string, DirScan> entries;
+
+    // Directory entry: "<mtime> <nbFiles> <nbSubDirs> <nbNotices> <path>",
+    // followed by the files, sub-directories and notices, one per line
+    while (std::getline(manifest, line)) {
+        std::istringstream entry(line);
+        DirScan dirScan;
+        unsigned int nbFiles, nbSubDirs, nbNotices;
+        std::string dirPath;
+
+        if (!(entry >> dirScan.mtime >> nbFiles >> nbSubDirs >> nbNotices)
+            || entry.get() != ' ' || !std::getline(entry, dirPath))
+        {
+            break;
+        }
+
+        dirScan.files.resize(nbFiles);
+        dirScan.subDirs.resize(nbSubDirs);
+        dirScan.notices.resize(nbNotices);
+
+        for (unsigned int i = 0; i < nbFiles; ++i)
+            std::getline(manifest, dirScan.files[i]);
+
+        for (unsigned int i = 0; i < nbSubDirs; ++i)
+            std::getline(manifest, dirScan.subDirs[i]);
+
+        for (unsigned int i = 0; i < nbNotices; ++i)
+            std::getline(manifest, dirScan.notices[i]);
+
+        if (!manifest.good())
+            break;
+
+        entries[dirPath] = std::move(dirScan);
+    }
+
+    if (!manifest.eof()) {
+        std::cout << Utils::cnotice << "Notice: discarding corrupted manifest "
+            << manifestPath << Utils::cdef << std::endl;
+        return;
+    }
+
+    mManifest.swap(entries);
+}
+
+void N2D2::DIR_Database::saveManifest() const
+{
+    // Write a temporary file first, so that an interrupted write does not
+    // corrupt the manifest
+    const std::string tmpManifestPath = mManifestLoadedPath + ".tmp";
+    std::ofstream manifest(tmpManifestPath.c_str());
+
+    if (!manifest.good()) {
+        throw std::runtime_error("Could not create manifest file: "
+                                 + tmpManifestPath);
+    }
+
+    manifest << "N2D2 DIR_Database manifest\n"
+        << getManifestOptions() << "\n";
+
+    for (std::map<std::string, DirScan>::const_iterator it
+         = mManifest.begin(), itEnd = mManifest.end(); it != itEnd; ++it)
+    {
+        const DirScan& dirScan = (*it).second;
+
+        manifest << dirScan.mtime << " " << dirScan.files.size() << " "
+            << dirScan.subDirs.size() << " " << dirScan.notices.size() << " "
+            << (*it).first << "\n";
+
+        std::copy(dirScan.files.begin(), dirScan.files.end(),
+                  std::ostream_iterator<std::string>(manifest, "\n"));
+        std::copy(dirScan.subDirs.begin(), dirScan.subDirs.end(),
+                  std::ostream_iterator<std::string>(manifest, "\n"));
+        std::copy(dirScan.notices.begin(), dirScan.notices.end(),
+                  std::ostream_iterator<std::string>(manifest, "\n"));
+    }
+
+    manifest.close();
+
+    if (!manifest.good()
+        || std::rename(tmpManifestPath.c_str(),
+                       mManifestLoadedPath.c_str()) != 0)
+    {
+        throw std::runtime_error("Error writing manifest file: "
+                                 + mManifestLoadedPath);
+    }
+}
+
 N2D2::Database::StimulusID N2D2::DIR_Database::loadFile(
     const std::string& fileName)
 {
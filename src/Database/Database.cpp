@@ -42,9 +42,12 @@ N2D2::Database::Database(bool loadDataInMemory)
       mMultiChannelMatch(this, "MultiChannelMatch", ""),
       mMultiChannelReplace(this, "MultiChannelReplace",
                            std::vector<std::string>()),
+      mDataCacheSize(this, "DataCacheSize", 0U),
+      mReducedDecode(this, "ReducedDecode", false),
       mLoadDataInMemory(loadDataInMemory),
       mStimuliDepth(-1),
-      mStimuliTargetDepth(-1)
+      mStimuliTargetDepth(-1),
+      mDecodeMinSize(0, 0)
 {
     // ctor
 }
@@ -57,6 +60,8 @@ void N2D2::Database::loadROIs(const std::string& fileName,
                               const std::string& relPath,
                               bool noImageSize)
 {
+    invalidateLabelsIndex();
+
     // Create default label for no ROI
     if (!((std::string)mDefaultLabel).empty())
         labelID(mDefaultLabel);
@@ -115,6 +120,8 @@ void N2D2::Database::loadROIsDir(const std::string& dirName,
                                  const std::vector<std::string>& fileExt,
                                  int depth)
 {
+    invalidateLabelsIndex();
+
     DIR* pDir = opendir(dirName.c_str());
 
     if (pDir == NULL)
@@ -260,15 +267,7 @@ void N2D2::Database::logStats(const std::string& sizeFileName,
             const StimulusID id = mStimuliSets(*itSet)[i];
 
             // Read stimuli
-            std::string fileExtension = Utils::fileExtension(mStimuli[id].name);
-            std::transform(fileExtension.begin(),
-                           fileExtension.end(),
-                           fileExtension.begin(),
-                           ::tolower);
-
-            std::shared_ptr<DataFile> dataFile = Registrar
-                <DataFile>::create(fileExtension)();
-            cv::Mat stimulus = dataFile->read(mStimuli[id].name);
+            const cv::Mat stimulus = readData(id, mStimuli[id].name);
 
             // Stats
             if (stimulus.cols > (int)maxWidth) {
@@ -601,6 +600,8 @@ void N2D2::Database::plotStats(
 
 void N2D2::Database::extractROIs()
 {
+    invalidateLabelsIndex();
+
     for (int id = mStimuli.size() - 1; id >= 0; --id) {
         if (!mStimuli[id].ROIs.empty()) {
             std::vector<ROI*>::const_iterator it = mStimuli[id].ROIs.begin();
@@ -621,12 +622,16 @@ void N2D2::Database::extractROIs()
         } else
             removeStimulus(id);
     }
+
+    mDataCache.clear();
 }
 
 void N2D2::Database::filterROIs(const std::vector<int>& labels,
                                 bool filterKeep,
                                 bool removeStimuli)
 {
+    invalidateLabelsIndex();
+
     unsigned int nbRoi = 0;
     unsigned int nbRoiRemoved = 0;
     const unsigned int nbStimuli = mStimuli.size();
@@ -660,6 +665,8 @@ void N2D2::Database::filterROIs(const std::vector<int>& labels,
 
 void N2D2::Database::extractLabels(bool removeROIs)
 {
+    invalidateLabelsIndex();
+
     const int defaultLabel = getDefaultLabelID();
 
     for (int id = mStimuli.size() - 1; id >= 0; --id) {
@@ -696,6 +703,8 @@ void N2D2::Database::extractSlices(unsigned int width,
                                    bool randomShuffle,
                                    bool overlapping)
 {
+    invalidateLabelsIndex();
+
     const std::vector<StimuliSet> stimuliSets = getStimuliSets(setMask);
 
     // For progression visualization
@@ -867,6 +876,9 @@ void N2D2::Database::extractSlices(unsigned int width,
     std::cout << std::endl;
 
     assert(sliced == toSlice);
+
+    // The stimuli were replaced by their first slice
+    mDataCache.clear();
 }
 
 void N2D2::Database::load(const std::string& /*dataPath*/,
@@ -970,6 +982,8 @@ void N2D2::Database::save(const std::string& dataPath,
 }
 
 void N2D2::Database::append(const Database& database) {
+    invalidateLabelsIndex();
+
     const unsigned int offsetID = mStimuli.size();
     const unsigned int offsetLabelID = mLabelsName.size();
 
@@ -1021,6 +1035,8 @@ void N2D2::Database::append(const Database& database) {
 
 void N2D2::Database::partitionStimulus(StimulusID id, StimuliSet set)
 {
+    invalidateLabelsIndex();
+
     if (set == Unpartitioned)
         return;
 
@@ -1043,6 +1059,8 @@ void N2D2::Database::partitionStimulus(StimulusID id, StimuliSet set)
 
 void N2D2::Database::partitionStimuli(unsigned int nbStimuli, StimuliSet set)
 {
+    invalidateLabelsIndex();
+
     if (set == Unpartitioned)
         return;
 
@@ -1111,6 +1129,8 @@ N2D2::Database::partitionStimuli(double learn, double validation, double test)
 void N2D2::Database::partitionStimuliPerLabel(unsigned int nbStimuliPerLabel,
                                               StimuliSet set)
 {
+    invalidateLabelsIndex();
+
     if (set == Unpartitioned)
         return;
 
@@ -1281,6 +1301,8 @@ int N2D2::Database::addLabel(const std::string& labelName) {
 
 void N2D2::Database::removeStimulus(StimulusID id)
 {
+    invalidateLabelsIndex();
+
     std::vector<StimuliSet> stimuliSets;
     stimuliSets.push_back(Learn);
     stimuliSets.push_back(Validation);
@@ -1310,10 +1332,13 @@ void N2D2::Database::removeStimulus(StimulusID id)
                                  "the stimulus in any of the partition!");
 
     mStimuli.erase(mStimuli.begin() + id);
+    mDataCache.clear();
 }
 
 void N2D2::Database::removeStimuli(const std::vector<StimulusID>& ids)
 {
+    invalidateLabelsIndex();
+
     std::vector<StimulusID> sortedIds(ids);
     std::sort(sortedIds.begin(), sortedIds.end());
 
@@ -1336,6 +1361,7 @@ void N2D2::Database::removeStimuli(const std::vector<StimulusID>& ids)
     }
 
     mStimuli.swap(newStimuli);
+    mDataCache.clear();
 
     std::vector<StimuliSet> stimuliSets;
     stimuliSets.push_back(Learn);
@@ -1373,6 +1399,8 @@ void N2D2::Database::removeStimuli(const std::vector<StimulusID>& ids)
 
 void N2D2::Database::removeLabel(int label)
 {
+    invalidateLabelsIndex();
+
     for (int id = mStimuli.size() - 1; id >= 0; --id) {
         if (mStimuli[id].label == label)
             removeStimulus(id);
@@ -1385,6 +1413,8 @@ void N2D2::Database::removeLabel(int label)
 
 void N2D2::Database::removeLabels(const std::vector<int>& labels)
 {
+    invalidateLabelsIndex();
+
     std::vector<int> sortedLabels(labels);
     std::sort(sortedLabels.begin(), sortedLabels.end());
 
@@ -1464,6 +1494,8 @@ void N2D2::Database::sortAndDropLabels(unsigned int nbKeep,
                                        bool ascending,
                                        StimuliSetMask setMask)
 {
+    invalidateLabelsIndex();
+
     std::vector<unsigned int> nbStimuliWithLabel(mLabelsName.size(), 0);
 
     const std::vector<StimuliSet> stimuliSets = getStimuliSets(setMask);
@@ -1558,6 +1590,17 @@ N2D2::Database::getStimulusROIs(StimulusID id) const
                    std::back_inserter(stimulusROIs),
                    std::bind(&ROI::clone, std::placeholders::_1));
 
+    const unsigned int reduction = getStimulusReduction(id);
+
+    if (reduction > 1) {
+        for (std::vector<std::shared_ptr<ROI> >::iterator
+            itROIs = stimulusROIs.begin(), itROIsEnd = stimulusROIs.end();
+            itROIs != itROIsEnd; ++itROIs)
+        {
+            (*itROIs)->rescale(1.0 / reduction, 1.0 / reduction);
+        }
+    }
+
     if (mCompositeLabel == Auto
         && mStimuli[id].label >= 0
         && !stimulusROIs.empty())
@@ -1635,6 +1678,174 @@ unsigned int N2D2::Database::getNbROIsWithLabel(int label) const
     return nbROIs;
 }
 
+const std::vector<std::vector<unsigned int> >&
+N2D2::Database::getLabelsIndexes(StimuliSet set) const
+{
+    const std::vector<StimulusID>& stimuliSet = mStimuliSets(set);
+    LabelsIndex* labelsIndex;
+
+#pragma omp critical(Database__labelsIndex)
+    {
+        labelsIndex = &mLabelsIndex[set];
+
+        // Stimuli appended to the set or new labels since the index was built
+        if (!labelsIndex->valid
+            || labelsIndex->nbStimuli != stimuliSet.size()
+            || labelsIndex->indexes.size() != mLabelsName.size())
+        {
+            labelsIndex->indexes.assign(mLabelsName.size(),
+                                        std::vector<unsigned int>());
+
+            for (unsigned int index = 0; index < stimuliSet.size(); ++index) {
+                const Stimulus& stimulus = mStimuli[stimuliSet[index]];
+
+                if (stimulus.label >= 0)
+                    labelsIndex->indexes[stimulus.label].push_back(index);
+
+                for (std::vector<ROI*>::const_iterator itROIs
+                     = stimulus.ROIs.begin(),
+                     itROIsEnd = stimulus.ROIs.end();
+                     itROIs != itROIsEnd; ++itROIs)
+                {
+                    const int label = (*itROIs)->getLabel();
+
+                    // A stimulus is indexed only once per label
+                    if (label >= 0 && label != stimulus.label
+                        && (labelsIndex->indexes[label].empty()
+                            || labelsIndex->indexes[label].back() != index))
+                    {
+                        labelsIndex->indexes[label].push_back(index);
+                    }
+                }
+            }
+
+            labelsIndex->nbStimuli = stimuliSet.size();
+            labelsIndex->valid = true;
+            labelsIndex->cumWeightsValid = false;
+        }
+    }
+
+    return labelsIndex->indexes;
+}
+
+const std::vector<unsigned int>&
+N2D2::Database::getLabelIndexes(StimuliSet set, int label) const
+{
+    const std::vector<std::vector<unsigned int> >& labelsIndexes
+        = getLabelsIndexes(set);
+
+    if (label < 0 || label >= (int)labelsIndexes.size()) {
+        std::stringstream msg;
+        msg << "Database::getLabelIndexes(): label ID " << label
+            << " is out of range";
+
+        throw std::runtime_error(msg.str());
+    }
+
+    return labelsIndexes[label];
+}
+
+const std::vector<double>&
+N2D2::Database::getLabelsCumulativeWeights(StimuliSet set,
+    const std::vector<double>& labelsWeights) const
+{
+    // Rebuild the labels index first if needed
+    const std::vector<std::vector<unsigned int> >& labelsIndexes
+        = getLabelsIndexes(set);
+    LabelsIndex* labelsIndex;
+
+#pragma omp critical(Database__labelsIndex)
+    {
+        labelsIndex = &mLabelsIndex[set];
+
+        if (!labelsIndex->cumWeightsValid
+            || labelsIndex->cumWeightsFor != labelsWeights)
+        {
+            labelsIndex->cumWeights.resize(labelsIndexes.size());
+            double totalWeight = 0.0;
+
+            for (unsigned int label = 0; label < labelsIndexes.size();
+                ++label)
+            {
+                if (!labelsIndexes[label].empty()) {
+                    totalWeight += (label < labelsWeights.size())
+                        ? labelsWeights[label] : 1.0;
+                }
+
+                labelsIndex->cumWeights[label] = totalWeight;
+            }
+
+            labelsIndex->cumWeightsFor = labelsWeights;
+            labelsIndex->cumWeightsValid = true;
+        }
+    }
+
+    return labelsIndex->cumWeights;
+}
+
+std::vector<unsigned int>
+N2D2::Database::getEpochIndexes(StimuliSet set,
+                                unsigned int shardSize,
+                                unsigned int bufferSize) const
+{
+    const std::vector<StimulusID>& stimuliSet = mStimuliSets(set);
+
+    // Set indexes in StimulusID order
+    std::vector<unsigned int> indexes(stimuliSet.size());
+
+    for (unsigned int index = 0; index < indexes.size(); ++index)
+        indexes[index] = index;
+
+    std::sort(indexes.begin(), indexes.end(),
+              [&stimuliSet](unsigned int i, unsigned int j)
+                { return (stimuliSet[i] < stimuliSet[j]); });
+
+    // Shuffle the shards order
+    shardSize = std::max(1U, shardSize);
+    bufferSize = std::max(1U, bufferSize);
+
+    std::vector<unsigned int> shards((indexes.size() + shardSize - 1)
+                                     / shardSize);
+
+    for (unsigned int shard = 0; shard < shards.size(); ++shard)
+        shards[shard] = shard;
+
+    std::random_shuffle(shards.begin(), shards.end(), Random::randShuffle);
+
+    // Stream the shards through the shuffle buffer
+    std::vector<unsigned int> epochIndexes;
+    epochIndexes.reserve(indexes.size());
+
+    std::vector<unsigned int> buffer;
+    buffer.reserve(std::min(bufferSize, (unsigned int)indexes.size()));
+
+    for (std::vector<unsigned int>::const_iterator it = shards.begin(),
+         itEnd = shards.end(); it != itEnd; ++it)
+    {
+        const unsigned int shardBegin = (*it) * shardSize;
+        const unsigned int shardEnd = std::min(shardBegin + shardSize,
+                                               (unsigned int)indexes.size());
+
+        for (unsigned int i = shardBegin; i < shardEnd; ++i) {
+            if (buffer.size() < bufferSize)
+                buffer.push_back(indexes[i]);
+            else {
+                // Output a random stimulus of the buffer and replace it
+                unsigned int& bufferIndex
+                    = buffer[Random::randUniform(0, buffer.size() - 1)];
+                epochIndexes.push_back(bufferIndex);
+                bufferIndex = indexes[i];
+            }
+        }
+    }
+
+    // Flush the buffer
+    std::random_shuffle(buffer.begin(), buffer.end(), Random::randShuffle);
+    epochIndexes.insert(epochIndexes.end(), buffer.begin(), buffer.end());
+
+    return epochIndexes;
+}
+
 bool N2D2::Database::isLabel(const std::string& labelName) const
 {
     return (std::find(mLabelsName.begin(), mLabelsName.end(), labelName)
@@ -1711,11 +1922,38 @@ cv::Mat N2D2::Database::getStimulusData(StimulusID id)
                 mStimuliData.resize(mStimuli.size());
         }
 
-        if (mStimuliData[id].empty())
-            mStimuliData[id] = loadStimulusData(id);
+        cv::Mat data;
 
-        return mStimuliData[id];
-    } else
+#pragma omp critical(Database__getStimulusData)
+        data = mStimuliData[id];
+
+        if (data.empty()) {
+            // Load outside of the critical section, a concurrent loading of
+            // the same stimulus is discarded
+            data = loadStimulusData(id);
+
+#pragma omp critical(Database__getStimulusData)
+            {
+                if (mStimuliData[id].empty())
+                    mStimuliData[id] = data;
+                else
+                    data = mStimuliData[id];
+            }
+        }
+
+        return data;
+    }
+    else if (isDataCacheEnabled()) {
+        cv::Mat data;
+
+        if (!mDataCache.get(id, StimuliDataCache::Data, data)) {
+            data = loadStimulusData(id);
+            mDataCache.insert(id, StimuliDataCache::Data, data);
+        }
+
+        return data;
+    }
+    else
         return loadStimulusData(id);
 }
 
@@ -1730,11 +1968,38 @@ cv::Mat N2D2::Database::getStimulusLabelsData(StimulusID id)
                 mStimuliLabelsData.resize(mStimuli.size());
         }
 
-        if (mStimuliLabelsData[id].empty())
-            mStimuliLabelsData[id] = loadStimulusLabelsData(id);
+        cv::Mat data;
 
-        return mStimuliLabelsData[id];
-    } else
+#pragma omp critical(Database__getStimulusLabelsData)
+        data = mStimuliLabelsData[id];
+
+        if (data.empty()) {
+            // Load outside of the critical section, a concurrent loading of
+            // the same stimulus is discarded
+            data = loadStimulusLabelsData(id);
+
+#pragma omp critical(Database__getStimulusLabelsData)
+            {
+                if (mStimuliLabelsData[id].empty())
+                    mStimuliLabelsData[id] = data;
+                else
+                    data = mStimuliLabelsData[id];
+            }
+        }
+
+        return data;
+    }
+    else if (isDataCacheEnabled()) {
+        cv::Mat data;
+
+        if (!mDataCache.get(id, StimuliDataCache::LabelsData, data)) {
+            data = loadStimulusLabelsData(id);
+            mDataCache.insert(id, StimuliDataCache::LabelsData, data);
+        }
+
+        return data;
+    }
+    else
         return loadStimulusLabelsData(id);
 }
 
@@ -1752,14 +2017,128 @@ cv::Mat N2D2::Database::getStimulusTargetData(StimulusID id,
                 mStimuliTargetData.resize(mStimuli.size());
         }
 
-        if (mStimuliTargetData[id].empty())
-            mStimuliTargetData[id] = loadStimulusTargetData(id);
+        cv::Mat data;
 
-        return mStimuliTargetData[id];
-    } else
+#pragma omp critical(Database__getStimulusTargetData)
+        data = mStimuliTargetData[id];
+
+        if (data.empty()) {
+            // Load outside of the critical section, a concurrent loading of
+            // the same stimulus is discarded
+            data = loadStimulusTargetData(id);
+
+#pragma omp critical(Database__getStimulusTargetData)
+            {
+                if (mStimuliTargetData[id].empty())
+                    mStimuliTargetData[id] = data;
+                else
+                    data = mStimuliTargetData[id];
+            }
+        }
+
+        return data;
+    }
+    else if (isDataCacheEnabled()) {
+        cv::Mat data;
+
+        if (!mDataCache.get(id, StimuliDataCache::TargetData, data)) {
+            data = loadStimulusTargetData(id);
+            mDataCache.insert(id, StimuliDataCache::TargetData, data);
+        }
+
+        return data;
+    }
+    else
         return loadStimulusTargetData(id);
 }
 
+void N2D2::Database::setDecodeMinSize(const cv::Size& minSize)
+{
+    if (minSize.width == mDecodeMinSize.width
+        && minSize.height == mDecodeMinSize.height)
+    {
+        return;
+    }
+
+    mDecodeMinSize = minSize;
+
+    for (std::vector<Stimulus>::iterator it = mStimuli.begin(),
+         itEnd = mStimuli.end(); it != itEnd; ++it)
+    {
+        (*it).reduction = DataFile::Reduction(0U);
+    }
+
+    // The decoded data may not have the right size anymore
+    mStimuliData.clear();
+    mStimuliLabelsData.clear();
+    mDataCache.clear();
+}
+
+unsigned int N2D2::Database::getStimulusReduction(StimulusID id) const
+{
+    return getStimulusDecoding(id).factor;
+}
+
+N2D2::DataFile::Reduction
+N2D2::Database::getStimulusDecoding(StimulusID id) const
+{
+    assert(id < mStimuli.size());
+
+    if (!mReducedDecode
+        || mDecodeMinSize.width <= 0 || mDecodeMinSize.height <= 0)
+    {
+        return DataFile::Reduction();
+    }
+
+    // Slices and ROIs extracted from the stimulus are expressed in full
+    // resolution coordinates
+    if (mStimuli[id].slice != NULL
+        || (mCompositeLabel == Auto && mStimuli[id].label >= 0
+            && !mStimuli[id].ROIs.empty())
+        || !((std::string)mMultiChannelMatch).empty())
+    {
+        return DataFile::Reduction();
+    }
+
+    DataFile::Reduction reduction;
+
+#pragma omp critical(Database__getStimulusDecoding)
+    reduction = mStimuli[id].reduction;
+
+    if (reduction.factor == 0) {
+        std::string fileExtension = Utils::fileExtension(mStimuli[id].name);
+        std::transform(fileExtension.begin(),
+                       fileExtension.end(),
+                       fileExtension.begin(),
+                       ::tolower);
+
+        if (Registrar<DataFile>::exists(fileExtension)) {
+            std::shared_ptr<DataFile> dataFile = Registrar
+                <DataFile>::create(fileExtension)();
+            reduction = dataFile->getReduction(mStimuli[id].name,
+                                               mDecodeMinSize);
+        }
+        else
+            reduction = DataFile::Reduction();
+
+#pragma omp critical(Database__getStimulusDecoding)
+        mStimuli[id].reduction = reduction;
+    }
+
+    return reduction;
+}
+
+bool N2D2::Database::isDataCacheEnabled()
+{
+    const std::size_t capacity = (std::size_t)mDataCacheSize * 1024 * 1024;
+
+    // The budget may be changed with setParameter() at any time
+    if (mDataCache.getCapacity() != capacity)
+        mDataCache.setCapacity(capacity);
+
+    return (capacity > 0);
+}
+
 std::vector<N2D2::Database::StimuliSet>
 N2D2::Database::getStimuliSets(StimuliSetMask setMask) const
 {
@@ -1832,12 +2211,7 @@ int N2D2::Database::getStimuliDepth() {
             throw std::runtime_error("Can't get the stimuli depth of an empty database.");
         }
 
-        std::string fileExtension = Utils::fileExtension(mStimuli[0].name);
-        std::transform(fileExtension.begin(), fileExtension.end(),
-                       fileExtension.begin(), ::tolower);
-
-        auto dataFile = Registrar<DataFile>::create(fileExtension)();
-        mStimuliDepth = dataFile->read(mStimuli[0].name).depth();
+        mStimuliDepth = readData(0, mStimuli[0].name).depth();
 
         std::cout << Utils::cnotice << "Notice: stimuli depth is "
                     << Utils::cvMatDepthToString(mStimuliDepth)
@@ -1854,15 +2228,7 @@ cv::Mat N2D2::Database::loadStimulusData(StimulusID id)
     if (mStimuliDepth == -1) {
 #pragma omp critical(Database__loadStimulusData)
         if (mStimuliDepth == -1) {
-            std::string fileExtension = Utils::fileExtension(mStimuli[0].name);
-            std::transform(fileExtension.begin(),
-                           fileExtension.end(),
-                           fileExtension.begin(),
-                           ::tolower);
-
-            std::shared_ptr<DataFile> dataFile = Registrar
-                <DataFile>::create(fileExtension)();
-            mStimuliDepth = dataFile->read(mStimuli[0].name).depth();
+            mStimuliDepth = readData(0, mStimuli[0].name).depth();
 
             std::cout << Utils::cnotice << "Notice: stimuli depth is "
                       << Utils::cvMatDepthToString(mStimuliDepth)
@@ -1901,7 +2267,18 @@ cv::Mat N2D2::Database::loadStimulusLabelsData(StimulusID id) const
 
         // Composite stimulus
         // Construct the labels matrix with the ROIs
-        cv::Mat stimulus = dataFile->read(mStimuli[id].name);
+        const DataFile::Reduction decoding = getStimulusDecoding(id);
+        const unsigned int reduction = decoding.factor;
+        cv::Mat stimulus = (reduction > 1)
+            ? dataFile->readReduced(mStimuli[id].name, decoding)
+            : dataFile->read(mStimuli[id].name);
+
+        if (reduction > 1 && !labels.empty()) {
+            cv::Mat labelsReduced;
+            cv::resize(labels, labelsReduced, stimulus.size(), 0.0, 0.0,
+                       cv::INTER_NEAREST);
+            labels = labelsReduced;
+        }
 
         if (labels.empty()) {
             const int labelID = ((mCompositeLabel == Auto
@@ -1928,7 +2305,14 @@ cv::Mat N2D2::Database::loadStimulusLabelsData(StimulusID id) const
              ++it)
         {
             try {
-                (*it)->append(labels, mROIsMargin, defaultLabel);
+                if (reduction > 1) {
+                    std::shared_ptr<ROI> roi = (*it)->clone();
+                    roi->rescale(1.0 / reduction, 1.0 / reduction);
+                    roi->append(labels, mROIsMargin / reduction,
+                                defaultLabel);
+                }
+                else
+                    (*it)->append(labels, mROIsMargin, defaultLabel);
             }
             catch (const std::exception& e)
             {
@@ -1999,17 +2383,17 @@ cv::Mat N2D2::Database::loadData(
     int depth,
     const std::string fileName) const
 {
-    std::string fileExtension = Utils::fileExtension(fileName);
-    std::transform(fileExtension.begin(),
-                   fileExtension.end(),
-                   fileExtension.begin(),
-                   ::tolower);
-
-    std::shared_ptr<DataFile> dataFile = Registrar
-        <DataFile>::create(fileExtension)();
-    cv::Mat data = dataFile->read(fileName);
+    cv::Mat data = readData(id, fileName);
 
     if (!((std::string)mMultiChannelMatch).empty()) {
+        std::string fileExtension = Utils::fileExtension(fileName);
+        std::transform(fileExtension.begin(),
+                       fileExtension.end(),
+                       fileExtension.begin(),
+                       ::tolower);
+
+        std::shared_ptr<DataFile> dataFile = Registrar
+            <DataFile>::create(fileExtension)();
         const std::vector<std::string>& multiChannelReplace
             = mMultiChannelReplace.get<std::vector<std::string> >();
 
@@ -2049,8 +2433,6 @@ cv::Mat N2D2::Database::loadData(
 
         cv::merge(channels, data);
     }
-    else
-        data = dataFile->read(fileName);
 
     // Check stimulus depth
     if (data.depth() != depth) {
@@ -2101,6 +2483,30 @@ cv::Mat N2D2::Database::loadData(
     return data;
 }
 
+cv::Mat N2D2::Database::readData(StimulusID id,
+                                 const std::string& fileName) const
+{
+    std::string fileExtension = Utils::fileExtension(fileName);
+    std::transform(fileExtension.begin(),
+                   fileExtension.end(),
+                   fileExtension.begin(),
+                   ::tolower);
+
+    std::shared_ptr<DataFile> dataFile = Registrar
+        <DataFile>::create(fileExtension)();
+
+    // Only the stimulus itself may be decoded at reduced resolution (not the
+    // target data nor the additional channels)
+    if (id < mStimuli.size() && fileName == mStimuli[id].name) {
+        const DataFile::Reduction decoding = getStimulusDecoding(id);
+
+        if (decoding.factor > 1)
+            return dataFile->readReduced(fileName, decoding);
+    }
+
+    return dataFile->read(fileName);
+}
+
 std::vector<unsigned int>
 N2D2::Database::getLabelStimuliSetIndexes(int label, StimuliSet set) const
 {
@@ -2147,6 +2553,8 @@ void N2D2::Database::partitionIndexes(std::vector
                                       unsigned int nbStimuli,
                                       StimuliSet set)
 {
+    invalidateLabelsIndex();
+
     unsigned int maxStimuli = unpartitionedIndexes.size();
 
     if (nbStimuli > maxStimuli) {
@@ -2175,6 +2583,8 @@ void N2D2::Database::partitionIndexes(std::vector
 void N2D2::Database::removeIndexesFromSet(std::vector<unsigned int>& indexes,
                                           StimuliSet set)
 {
+    invalidateLabelsIndex();
+
     // Sort the indexes and then delete those elements from the vector from the
     // highest to the lowest.
     // That way, deleting the highest index on the list will not invalidate the
@@ -2188,6 +2598,16 @@ void N2D2::Database::removeIndexesFromSet(std::vector<unsigned int>& indexes,
     indexes.clear();
 }
 
+void N2D2::Database::invalidateLabelsIndex()
+{
+#pragma omp critical(Database__labelsIndex)
+    for (std::map<StimuliSet, LabelsIndex>::iterator it = mLabelsIndex.begin(),
+         itEnd = mLabelsIndex.end(); it != itEnd; ++it)
+    {
+        (*it).second.valid = false;
+    }
+}
+
 N2D2::Database::~Database()
 {
     for (std::vector<Stimulus>::iterator it = mStimuli.begin(),
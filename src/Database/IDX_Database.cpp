@@ -20,6 +20,8 @@
 
 #include "Database/IDX_Database.hpp"
 
+#include <cstring>
+
 N2D2::IDX_Database::IDX_Database(bool loadDataInMemory)
     : Database(loadDataInMemory)
 {
@@ -31,21 +33,27 @@ void N2D2::IDX_Database::load(const std::string& dataPath,
                               bool /*extractROIs*/)
 {
     // Images
-    std::ifstream images(dataPath.c_str(), std::fstream::binary);
-
-    if (!images.good())
+    if (!std::ifstream(dataPath.c_str()).good())
         throw std::runtime_error("Could not open images file: " + dataPath);
 
+    const std::shared_ptr<MemoryMappedFile> images
+        = std::make_shared<MemoryMappedFile>(dataPath);
+
     MagicNumber magicNumber;
     unsigned int nbImages;
     unsigned int nbRows;
     unsigned int nbColumns;
+    const std::size_t headerSize = sizeof(magicNumber) + sizeof(nbImages)
+                                   + sizeof(nbRows) + sizeof(nbColumns);
+
+    if (images->size() < headerSize)
+        throw std::runtime_error(
+            "End-of-file reached prematurely in data file: " + dataPath);
 
-    images.read(reinterpret_cast<char*>(&magicNumber.value),
-                sizeof(magicNumber));
-    images.read(reinterpret_cast<char*>(&nbImages), sizeof(nbImages));
-    images.read(reinterpret_cast<char*>(&nbRows), sizeof(nbRows));
-    images.read(reinterpret_cast<char*>(&nbColumns), sizeof(nbColumns));
+    std::memcpy(&magicNumber.value, images->data(), sizeof(magicNumber));
+    std::memcpy(&nbImages, images->data() + 4, sizeof(nbImages));
+    std::memcpy(&nbRows, images->data() + 8, sizeof(nbRows));
+    std::memcpy(&nbColumns, images->data() + 12, sizeof(nbColumns));
 
     if (!Utils::isBigEndian()) {
         Utils::swapEndian(magicNumber.value);
@@ -60,6 +68,15 @@ void N2D2::IDX_Database::load(const std::string& dataPath,
                                  + dataPath);
     }
 
+    const std::size_t imageSize = (std::size_t)nbRows * nbColumns;
+
+    if (images->size() < headerSize + nbImages * imageSize)
+        throw std::runtime_error(
+            "End-of-file reached prematurely in data file: " + dataPath);
+    else if (images->size() > headerSize + nbImages * imageSize)
+        throw std::runtime_error("Data file size larger than expected: "
+                                 + dataPath);
+
     // Labels
     std::ifstream labels(labelPath.c_str(), std::fstream::binary);
 
@@ -89,58 +106,57 @@ void N2D2::IDX_Database::load(const std::string& dataPath,
         throw std::runtime_error(
             "The number of images and the number of labels does not match.");
 
+    std::vector<unsigned char> labelsData(nbItemsLabels);
+
+    if (nbItemsLabels > 0)
+        labels.read(reinterpret_cast<char*>(&labelsData[0]), nbItemsLabels);
+
+    if (labels.eof())
+        throw std::runtime_error(
+            "End-of-file reached prematurely in data file: " + labelPath);
+    else if (!labels.good())
+        throw std::runtime_error("Error while reading data file: " + labelPath);
+    else if (labels.get() != std::fstream::traits_type::eof())
+        throw std::runtime_error("Data file size larger than expected: "
+                                 + labelPath);
+
+    mStimuli.reserve(mStimuli.size() + nbImages);
+    mMappedData.reserve(mMappedData.size() + nbImages);
+
     // For each image...
     for (unsigned int i = 0; i < nbImages; ++i) {
-        unsigned char buff;
-
         std::ostringstream nameStr;
         nameStr << dataPath << "[" << std::setfill('0') << std::setw(5) << i
                 << "].pgm";
 
-        // ... generate the stimuli
-        if (!std::ifstream(nameStr.str()).good()) {
-            cv::Mat frame(cv::Size(nbColumns, nbRows), CV_8UC1);
-
-            for (unsigned int y = 0; y < nbRows; ++y) {
-                for (unsigned int x = 0; x < nbColumns; ++x) {
-                    images.read(reinterpret_cast<char*>(&buff), sizeof(buff));
-                    frame.at<unsigned char>(y, x) = buff;
-                }
-            }
-
-            if (!cv::imwrite(nameStr.str(), frame))
-                throw std::runtime_error("Unable to write image: "
-                                         + nameStr.str());
-        } else {
-            // Skip image data (to grab labels only)
-            images.seekg(nbColumns * nbRows, images.cur);
-        }
+        // ... map the stimulus to its data in the images file
+        MappedData mappedData;
+        mappedData.file = images;
+        mappedData.offset = headerSize + i * imageSize;
+        mappedData.rows = nbRows;
+        mappedData.cols = nbColumns;
+        mMappedData[nameStr.str()] = mappedData;
 
         // ... attach the corresponding label
-        labels.read(reinterpret_cast<char*>(&buff), sizeof(buff));
-
         std::ostringstream labelStr;
-        labelStr << (unsigned int)buff;
+        labelStr << (unsigned int)labelsData[i];
 
         mStimuli.push_back(Stimulus(nameStr.str(), labelID(labelStr.str())));
         mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
     }
+}
 
-    if (images.eof())
-        throw std::runtime_error(
-            "End-of-file reached prematurely in data file: " + dataPath);
-    else if (!images.good())
-        throw std::runtime_error("Error while reading data file: " + dataPath);
-    else if (images.get() != std::fstream::traits_type::eof())
-        throw std::runtime_error("Data file size larger than expected: "
-                                 + dataPath);
+cv::Mat N2D2::IDX_Database::readData(StimulusID id,
+                                     const std::string& fileName) const
+{
+    const std::unordered_map<std::string, MappedData>::const_iterator it
+        = mMappedData.find(fileName);
 
-    if (labels.eof())
-        throw std::runtime_error(
-            "End-of-file reached prematurely in data file: " + labelPath);
-    else if (!labels.good())
-        throw std::runtime_error("Error while reading data file: " + labelPath);
-    else if (labels.get() != std::fstream::traits_type::eof())
-        throw std::runtime_error("Data file size larger than expected: "
-                                 + labelPath);
+    if (it == mMappedData.end())
+        return Database::readData(id, fileName);
+
+    // Zero-copy: the matrix points to the copy-on-write mapped file
+    const MappedData& mappedData = (*it).second;
+    return cv::Mat(mappedData.rows, mappedData.cols, CV_8UC1,
+                   mappedData.file->data() + mappedData.offset);
 }
@@ -65,9 +65,16 @@ void N2D2::ILSVRC2012_Database::loadImageNetStimuliPerDir(const std::string
                                  + labelNamePath);
 
     std::string classDir;
+    std::vector<std::string> classDirPaths;
+    std::vector<std::string> classDirs;
 
-    while (labels >> classDir)
-        loadDir(dirPath + "/" + classDir, 0, classDir, 0);
+    while (labels >> classDir) {
+        classDirPaths.push_back(dirPath + "/" + classDir);
+        classDirs.push_back(classDir);
+    }
+
+    // The class directories are scanned in parallel
+    loadDirs(classDirPaths, 0, classDirs, 0);
 }
 
 void N2D2::ILSVRC2012_Database::loadImageNetValidationStimuli(const std::string
@@ -0,0 +1,150 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Database/StimuliDataCache.hpp"
+
+N2D2::StimuliDataCache::StimuliDataCache(std::size_t capacity)
+    : mCapacity(capacity),
+      mNbHits(0),
+      mNbMisses(0),
+      mNbEvictions(0)
+{
+    // ctor
+}
+
+bool N2D2::StimuliDataCache::get(unsigned int id,
+                                 DataType type,
+                                 cv::Mat& data)
+{
+    Shard& shard = getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const std::unordered_map<Key, std::list<Entry>::iterator>::const_iterator
+        it = shard.index.find(getKey(id, type));
+
+    if (it == shard.index.end()) {
+        ++mNbMisses;
+        return false;
+    }
+
+    // Move the entry to the front of the LRU list
+    shard.entries.splice(shard.entries.begin(), shard.entries, (*it).second);
+    data = (*(*it).second).data;
+    ++mNbHits;
+    return true;
+}
+
+void N2D2::StimuliDataCache::insert(unsigned int id,
+                                    DataType type,
+                                    const cv::Mat& data)
+{
+    const std::size_t shardCapacity = mCapacity / NbShards;
+    const std::size_t size = getDataSize(data);
+
+    if (size > shardCapacity)
+        return;
+
+    const Key key = getKey(id, type);
+    Shard& shard = getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const std::unordered_map<Key, std::list<Entry>::iterator>::iterator
+        it = shard.index.find(key);
+
+    if (it != shard.index.end()) {
+        // Already inserted by another reader
+        shard.entries.splice(shard.entries.begin(), shard.entries,
+                             (*it).second);
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.data = data;
+    entry.size = size;
+
+    shard.entries.push_front(entry);
+    shard.index[key] = shard.entries.begin();
+    shard.size += size;
+
+    evict(shard, shardCapacity);
+}
+
+void N2D2::StimuliDataCache::setCapacity(std::size_t capacity)
+{
+    mCapacity = capacity;
+
+    for (unsigned int s = 0; s < NbShards; ++s) {
+        std::lock_guard<std::mutex> lock(mShards[s].mutex);
+        evict(mShards[s], capacity / NbShards);
+    }
+}
+
+void N2D2::StimuliDataCache::clear()
+{
+    for (unsigned int s = 0; s < NbShards; ++s) {
+        std::lock_guard<std::mutex> lock(mShards[s].mutex);
+        mShards[s].entries.clear();
+        mShards[s].index.clear();
+        mShards[s].size = 0;
+    }
+}
+
+void N2D2::StimuliDataCache::resetStats()
+{
+    mNbHits = 0;
+    mNbMisses = 0;
+    mNbEvictions = 0;
+}
+
+std::size_t N2D2::StimuliDataCache::getSize()
+{
+    std::size_t size = 0;
+
+    for (unsigned int s = 0; s < NbShards; ++s) {
+        std::lock_guard<std::mutex> lock(mShards[s].mutex);
+        size += mShards[s].size;
+    }
+
+    return size;
+}
+
+unsigned int N2D2::StimuliDataCache::getNbEntries()
+{
+    unsigned int nbEntries = 0;
+
+    for (unsigned int s = 0; s < NbShards; ++s) {
+        std::lock_guard<std::mutex> lock(mShards[s].mutex);
+        nbEntries += mShards[s].index.size();
+    }
+
+    return nbEntries;
+}
+
+void N2D2::StimuliDataCache::evict(Shard& shard, std::size_t shardCapacity)
+{
+    while (shard.size > shardCapacity) {
+        const Entry& entry = shard.entries.back();
+        shard.size -= entry.size;
+        shard.index.erase(entry.key);
+        shard.entries.pop_back();
+        ++mNbEvictions;
+    }
+}
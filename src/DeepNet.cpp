@@ -36,6 +36,8 @@
 #include "Cell/PaddingCell.hpp"
 #include "Cell/SoftmaxCell.hpp"
 #include "Cell/Cell_CSpike_Top.hpp"
+#include "utils/Random.hpp"
+#include "utils/TaskGraph.hpp"
 #include "utils/Utils.hpp"
 #include "Solver/Solver.hpp"
 
@@ -43,6 +45,7 @@ N2D2::DeepNet::DeepNet(Network& net)
     : mName(this, "Name", ""),
       mSignalsDiscretization(this, "SignalsDiscretization", 0U),
       mFreeParametersDiscretization(this, "FreeParametersDiscretization", 0U),
+      mConcurrentExecution(this, "ConcurrentExecution", false),
       mNet(net),
       mLayers(1, std::vector<std::string>(1, "env")),
       mFreeParametersDiscretized(false),
@@ -1808,6 +1811,73 @@ void N2D2::DeepNet::drawHistogram(std::string title,
 
 }
 
+void N2D2::DeepNet::setPartitioning(unsigned int nbPartitions)
+{
+    if (nbPartitions == 0) {
+        mNet.setPartitioning(0);
+        return;
+    }
+
+    std::shared_ptr<Environment> env = std::dynamic_pointer_cast
+        <Environment>(mStimuliProvider);
+
+    if (env) {
+        const std::vector<NodeEnv*> nodes = env->getNodes();
+
+        for (std::vector<NodeEnv*>::const_iterator it = nodes.begin(),
+             itEnd = nodes.end(); it != itEnd; ++it)
+        {
+            (*it)->setPartition(0);
+        }
+    }
+
+    std::vector<std::shared_ptr<Cell_Spike> > cells;
+
+    for (unsigned int layer = 1; layer < mLayers.size(); ++layer) {
+        for (std::vector<std::string>::const_iterator itCell
+             = mLayers[layer].begin(), itCellEnd = mLayers[layer].end();
+             itCell != itCellEnd; ++itCell)
+        {
+            std::shared_ptr<Cell_Spike> cellSpike = std::dynamic_pointer_cast
+                <Cell_Spike>(mCells.at(*itCell));
+
+            if (!cellSpike) {
+                throw std::runtime_error("DeepNet::setPartitioning(): cell "
+                                         + (*itCell) + " is not a spiking "
+                                         "cell.");
+            }
+
+            cellSpike->setPartition(layer % nbPartitions);
+            cells.push_back(cellSpike);
+        }
+    }
+
+    Time_T lookahead = 0;
+
+    for (std::vector<std::shared_ptr<Cell_Spike> >::const_iterator it
+         = cells.begin(), itEnd = cells.end(); it != itEnd; ++it)
+    {
+        if (!(*it)->isPartitionBoundary())
+            continue;
+
+        const Time_T delay = (*it)->getPartitionDelay();
+
+        if (delay == 0) {
+            throw std::runtime_error("DeepNet::setPartitioning(): cell "
+                                     + (*it)->getName() + " receives spikes "
+                                     "from another partition, but has no "
+                                     "minimum synaptic delay (see "
+                                     "IncomingDelay).");
+        }
+
+        if (lookahead == 0 || delay < lookahead)
+            lookahead = delay;
+    }
+
+    // Without spikes between the partitions, any lookahead is valid
+    mNet.setPartitioning(nbPartitions, (lookahead > 0) ? lookahead : TimeS);
+}
+
 void N2D2::DeepNet::logSpikeStats(const std::string& dirName,
                                   unsigned int nbPatterns) const
 {
@@ -1975,39 +2045,21 @@ void N2D2::DeepNet::learn(std::vector<std::pair<std::string, double> >* timings)
     }
 
     // Signal propagation
-    for (unsigned int l = 1; l < nbLayers; ++l) {
-        for (std::vector<std::string>::const_iterator itCell
-             = mLayers[l].begin(),
-             itCellEnd = mLayers[l].end();
-             itCell != itCellEnd;
-             ++itCell) {
-            std::shared_ptr<Cell_Frame_Top> cellFrame
-                = std::dynamic_pointer_cast<Cell_Frame_Top>(mCells[(*itCell)]);
+    runCells([this](const std::string& cellName) {
+        std::shared_ptr<Cell_Frame_Top> cellFrame
+            = std::dynamic_pointer_cast<Cell_Frame_Top>(
+                (*mCells.find(cellName)).second);
 
-            if (!cellFrame)
-                throw std::runtime_error(
-                    "DeepNet::learn(): learning requires Cell_Frame_Top cells");
+        if (!cellFrame)
+            throw std::runtime_error(
+                "DeepNet::learn(): learning requires Cell_Frame_Top cells");
 
-            if (mSignalsDiscretization > 0)
-                cellFrame->discretizeSignals(mSignalsDiscretization);
+        if (mSignalsDiscretization > 0)
+            cellFrame->discretizeSignals(mSignalsDiscretization);
 
-            //std::cout << "propagate " << mCells[(*itCell)]->getName()
-            //    << std::endl;
-            time1 = std::chrono::high_resolution_clock::now();
-            cellFrame->propagate();
-
-            if (timings != NULL) {
-#ifdef CUDA
-                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    (*itCell) + "[prop]",
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
-            }
-        }
-    }
+        //std::cout << "propagate " << cellName << std::endl;
+        cellFrame->propagate();
+    }, false, timings, "[prop]");
 
     // Targets processing
     for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
@@ -2043,31 +2095,11 @@ void N2D2::DeepNet::learn(std::vector<std::pair<std::string, double> >* timings)
     }
 
     // Error back-propagation
-    for (unsigned int l = nbLayers - 1; l > 0; --l) {
-        for (std::vector<std::string>::const_iterator itCell
-             = mLayers[l].begin(),
-             itCellEnd = mLayers[l].end();
-             itCell != itCellEnd;
-             ++itCell)
-        {
-            //std::cout << "back-propagate " << mCells[(*itCell)]->getName()
-            //    << std::endl;
-            time1 = std::chrono::high_resolution_clock::now();
-            std::dynamic_pointer_cast
-                <Cell_Frame_Top>(mCells[(*itCell)])->backPropagate();
-
-            if (timings != NULL) {
-#ifdef CUDA
-                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    (*itCell) + "[back-prop]",
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
-            }
-        }
-    }
+    runCells([this](const std::string& cellName) {
+        //std::cout << "back-propagate " << cellName << std::endl;
+        std::dynamic_pointer_cast<Cell_Frame_Top>(
+            (*mCells.find(cellName)).second)->backPropagate();
+    }, true, timings, "[back-prop]");
 
     // Weights update
     for (unsigned int l = 1; l < nbLayers; ++l) {
@@ -2100,8 +2132,6 @@ void N2D2::DeepNet::learn(std::vector<std::pair<std::string, double> >* timings)
 void N2D2::DeepNet::test(Database::StimuliSet set,
                          std::vector<std::pair<std::string, double> >* timings)
 {
-    const unsigned int nbLayers = mLayers.size();
-
     if (mFreeParametersDiscretization > 0 && !mFreeParametersDiscretized) {
         const std::string dirName = "weights_discretized";
         Utils::createDirectories(dirName);
@@ -2152,39 +2182,20 @@ void N2D2::DeepNet::test(Database::StimuliSet set,
     }
 
     // Signal propagation
-    for (unsigned int l = 1; l < nbLayers; ++l) {
-        for (std::vector<std::string>::const_iterator itCell
-             = mLayers[l].begin(),
-             itCellEnd = mLayers[l].end();
-             itCell != itCellEnd;
-             ++itCell) {
-            std::shared_ptr<Cell_Frame_Top> cellFrame
-                = std::dynamic_pointer_cast<Cell_Frame_Top>(mCells[(*itCell)]);
-
-            if (!cellFrame)
-                throw std::runtime_error(
-                    "DeepNet::test(): testing requires Cell_Frame_Top cells");
-
-            if (mSignalsDiscretization > 0)
-                cellFrame->discretizeSignals(mSignalsDiscretization);
+    runCells([this](const std::string& cellName) {
+        std::shared_ptr<Cell_Frame_Top> cellFrame
+            = std::dynamic_pointer_cast<Cell_Frame_Top>(
+                (*mCells.find(cellName)).second);
 
-            time1 = std::chrono::high_resolution_clock::now();
-            cellFrame->propagate(true);
+        if (!cellFrame)
+            throw std::runtime_error(
+                "DeepNet::test(): testing requires Cell_Frame_Top cells");
 
+        if (mSignalsDiscretization > 0)
+            cellFrame->discretizeSignals(mSignalsDiscretization);
 
-            if (timings != NULL) {
-#ifdef CUDA
-                if(cellFrame->isCuda())
-                    CHECK_CUDA_STATUS(cudaDeviceSynchronize());
-#endif
-                time2 = std::chrono::high_resolution_clock::now();
-                (*timings).push_back(std::make_pair(
-                    *itCell,
-                    std::chrono::duration_cast
-                    <std::chrono::duration<double> >(time2 - time1).count()));
-            }
-        }
-    }
+        cellFrame->propagate(true);
+    }, false, timings, "");
 
     for (std::vector<std::shared_ptr<Target> >::const_iterator itTargets
          = mTargets.begin(),
@@ -2219,6 +2230,131 @@ void N2D2::DeepNet::test(Database::StimuliSet set,
     }
 }
 
+void N2D2::DeepNet::runCells(
+    const std::function<void(const std::string&)>& func,
+    bool backward,
+    std::vector<std::pair<std::string, double> >* timings,
+    const std::string& suffix)
+{
+    const unsigned int nbLayers = mLayers.size();
+
+    // Cells in the sequential execution order
+    std::vector<std::string> cells;
+
+    for (unsigned int l = 1; l < nbLayers; ++l) {
+        const unsigned int layer = (backward) ? nbLayers - l : l;
+        cells.insert(cells.end(), mLayers[layer].begin(),
+                     mLayers[layer].end());
+    }
+
+    std::vector<double> durations(cells.size(), 0.0);
+
+    const std::function<void(unsigned int)> runCell
+        = [&func, &cells, &durations, timings, this](unsigned int index)
+    {
+        const std::chrono::high_resolution_clock::time_point time1
+            = std::chrono::high_resolution_clock::now();
+
+        func(cells[index]);
+
+        if (timings != NULL) {
+#ifdef CUDA
+            std::shared_ptr<Cell_Frame_Top> cellFrame
+                = std::dynamic_pointer_cast<Cell_Frame_Top>(
+                    (*mCells.find(cells[index])).second);
+
+            if (cellFrame && cellFrame->isCuda())
+                CHECK_CUDA_STATUS(cudaDeviceSynchronize());
+#endif
+            const std::chrono::high_resolution_clock::time_point time2
+                = std::chrono::high_resolution_clock::now();
+            durations[index] = std::chrono::duration_cast
+                <std::chrono::duration<double> >(time2 - time1).count();
+        }
+    };
+
+    bool concurrent = mConcurrentExecution;
+
+    for (std::vector<std::string>::const_iterator it = cells.begin(),
+         itEnd = cells.end(); it != itEnd && concurrent; ++it)
+    {
+        std::shared_ptr<Cell_Frame_Top> cellFrame
+            = std::dynamic_pointer_cast<Cell_Frame_Top>(
+                (*mCells.find(*it)).second);
+
+        // The CUDA cells are already asynchronous on the device
+        if (!cellFrame || cellFrame->isCuda())
+            concurrent = false;
+    }
+
+    if (concurrent) {
+        std::map<std::string, unsigned int> indexes;
+
+        for (unsigned int i = 0, size = cells.size(); i < size; ++i)
+            indexes.insert(std::make_pair(cells[i], i));
+
+        // In both directions, the edges go from a cell to a cell following it
+        // in the sequential order: the graph is acyclic.
+        TaskGraph graph(cells.size());
+        std::map<unsigned int, std::vector<unsigned int> > children;
+
+        for (std::multimap<std::string, std::string>::const_iterator it
+             = mParentLayers.begin(), itEnd = mParentLayers.end();
+             it != itEnd; ++it)
+        {
+            const std::map<std::string, unsigned int>::const_iterator
+                itParent = indexes.find((*it).second);
+            const std::map<std::string, unsigned int>::const_iterator
+                itChild = indexes.find((*it).first);
+
+            if (itParent == indexes.end() || itChild == indexes.end())
+                continue;
+
+            if (backward) {
+                graph.addEdge((*itChild).second, (*itParent).second);
+                children[(*itParent).second].push_back((*itChild).second);
+            }
+            else
+                graph.addEdge((*itParent).second, (*itChild).second);
+        }
+
+        // The children of a cell accumulate their input gradient in the same
+        // output gradient tensor of the cell: they are back-propagated one
+        // after the other, in the sequential order.
+        for (std::map<unsigned int, std::vector<unsigned int> >::iterator it
+             = children.begin(), itEnd = children.end(); it != itEnd; ++it)
+        {
+            std::vector<unsigned int>& siblings = (*it).second;
+            std::sort(siblings.begin(), siblings.end());
+
+            for (unsigned int i = 1, size = siblings.size(); i < size; ++i) {
+                if (siblings[i - 1] != siblings[i])
+                    graph.addEdge(siblings[i - 1], siblings[i]);
+            }
+        }
+
+        // Each cell draws its random numbers from its own stream, making the
+        // result independent of the scheduling
+        const unsigned int seed = Random::mtRand();
+
+        graph.run([&runCell, seed](unsigned int index) {
+            Random::ThreadStream stream(seed, index);
+            runCell(index);
+        });
+    }
+    else {
+        for (unsigned int i = 0, size = cells.size(); i < size; ++i)
+            runCell(i);
+    }
+
+    if (timings != NULL) {
+        for (unsigned int i = 0, size = cells.size(); i < size; ++i) {
+            (*timings).push_back(std::make_pair(cells[i] + suffix,
+                                                durations[i]));
+        }
+    }
+}
+
 void N2D2::DeepNet::cTicks(Time_T start,
                            Time_T stop,
                            Time_T timestep,
@@ -33,6 +33,7 @@ N2D2::Environment::Environment(Network& network,
                                unsigned int batchSize,
                                bool compositeStimuli)
     : StimuliProvider(database, size, batchSize, compositeStimuli),
+      mStreamInputs(this, "StreamInputs", false),
       mNetwork(network),
       mNodes(mData.dims(), (NodeEnv*)NULL)
 
@@ -137,6 +138,15 @@ void N2D2::Environment::propagate(Time_T start, Time_T end)
                                                 itEnd = mNodes.end();
             it != itEnd;
             ++it) {
+                // In the partitioned mode, the spikes of each node are
+                // generated from its own random stream
+                Random::ThreadStream random(mNetwork.getNodeRandom(**it));
+
+                if (mStreamInputs) {
+                    (*it)->streamSpikes(this, mData(it - itBegin), start, end);
+                    continue;
+                }
+
                 std::pair<Time_T, int> event = std::make_pair(start, 0);
 
                 do {
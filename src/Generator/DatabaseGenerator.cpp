@@ -44,6 +44,7 @@ N2D2::DatabaseGenerator::generate(IniParser& iniConfig,
             iniConfig.getProperty<std::string>("LabelPath", ""));
 
         database = std::make_shared<Database>();
+        database->setParameters(iniConfig.getSection(section, true));
         database->load("", labelPath);
     }
 
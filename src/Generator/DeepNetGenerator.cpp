@@ -161,6 +161,8 @@ N2D2::DeepNetGenerator::generateFromINI(Network& network,
     deepNet->setParameter("FreeParametersDiscretization",
         iniConfig.getProperty
         <unsigned int>("FreeParametersDiscretization", 0U));
+    deepNet->setParameter("ConcurrentExecution",
+        iniConfig.getProperty<bool>("ConcurrentExecution", false));
 
     if (iniConfig.isSection("database"))
         deepNet->setDatabase(
@@ -396,14 +398,18 @@ N2D2::DeepNetGenerator::generateFromINI(Network& network,
                 if (cellCSpike) {
                     std::shared_ptr<CMonitor> monitor;
     #ifdef CUDA
-                    if (cellCSpike->isCuda()) {
-                        monitor = std::make_shared<CMonitor_CUDA>();
-                    }
-                    else {
-    #endif
-                        monitor = std::make_shared<CMonitor>();
-    #ifdef CUDA
+                    // In CUDA builds, CMonitor only monitors CudaTensor
+                    // outputs: the CPU CSpike model cannot be monitored
+                    if (!cellCSpike->isCuda()) {
+                        throw std::runtime_error("DeepNetGenerator::generate():"
+                            " the CPU CSpike model of cell " + cell->getName()
+                            + " is not supported in CUDA builds, use the"
+                            " CSpike_CUDA model instead");
                     }
+
+                    monitor = std::make_shared<CMonitor_CUDA>();
+    #else
+                    monitor = std::make_shared<CMonitor>();
     #endif
                     monitor->add(cellCSpike->getOutputs());
                     deepNet->addCMonitor((*it), monitor);
@@ -25,6 +25,13 @@
 #include "SpikeEvent.hpp"
 #include "Xcell.hpp"
 
+namespace {
+    // Partition processed by the current thread during a synchronization
+    // window of the partitioned mode (-1 otherwise)
+    int _currentPartition = -1;
+#pragma omp threadprivate(_currentPartition)
+}
+
 namespace N2D2 {
 const Time_T TimeFs = 1;
 const Time_T TimePs = 1000 * TimeFs;
@@ -87,12 +94,93 @@ N2D2::NetworkObserver::~NetworkObserver()
     mNet.removeObserver(this);
 }
 
-N2D2::Network::Network(unsigned int seed)
-    : mInitialized(false),
+N2D2::Time_T N2D2::SpikeEventTimestamp::operator()(const SpikeEvent* event)
+    const
+{
+    return event->getTimestamp();
+}
+
+bool N2D2::Network::eventsEmpty() const
+{
+    return (mEventsScheduler == WheelScheduler) ? mEventsWheel.empty()
+                                                : mEvents.empty();
+}
+
+N2D2::SpikeEvent* N2D2::Network::eventsTop()
+{
+    return (mEventsScheduler == WheelScheduler) ? mEventsWheel.top()
+                                                : mEvents.top();
+}
+
+void N2D2::Network::eventsPop()
+{
+    if (mEventsScheduler == WheelScheduler)
+        mEventsWheel.pop();
+    else
+        mEvents.pop();
+}
+
+void N2D2::Network::eventsPush(SpikeEvent* event)
+{
+    if (mEventsScheduler == WheelScheduler)
+        mEventsWheel.push(event);
+    else
+        mEvents.push(event);
+}
+
+bool N2D2::Network::eventsEmpty(const Partition& partition) const
+{
+    return (mEventsScheduler == WheelScheduler) ? partition.eventsWheel.empty()
+                                                : partition.events.empty();
+}
+
+N2D2::SpikeEvent* N2D2::Network::eventsTop(Partition& partition)
+{
+    return (mEventsScheduler == WheelScheduler) ? partition.eventsWheel.top()
+                                                : partition.events.top();
+}
+
+void N2D2::Network::eventsPop(Partition& partition)
+{
+    if (mEventsScheduler == WheelScheduler)
+        partition.eventsWheel.pop();
+    else
+        partition.events.pop();
+}
+
+void N2D2::Network::eventsPush(Partition& partition, SpikeEvent* event)
+{
+    if (mEventsScheduler == WheelScheduler)
+        partition.eventsWheel.push(event);
+    else
+        partition.events.push(event);
+}
+
+N2D2::Network::Partition::Partition(Time_T wheelResolution,
+                                    unsigned int wheelNbSlots)
+    : eventsWheel(wheelResolution, wheelNbSlots),
+      lastEvent(0),
+      stopRequested(false),
+      stop(0),
+      discard(false)
+{
+    // ctor
+}
+
+N2D2::Network::Network(unsigned int seed,
+                       EventsScheduler scheduler,
+                       Time_T wheelResolution,
+                       unsigned int wheelNbSlots)
+    : mNbNodes(0),
+      mEventsScheduler(scheduler),
+      mEventsWheel(wheelResolution, wheelNbSlots),
+      mInitialized(false),
       mFirstEvent(0),
       mLastEvent(0),
       mStop(0),
       mDiscard(false),
+      mLookahead(0),
+      mWindowEnd(0),
       mStartTime(std::chrono::high_resolution_clock::now())
 {
 // ctor
@@ -124,6 +212,7 @@ N2D2::Network::Network(unsigned int seed)
     if (seed == 0)
         seed = mStartTime.time_since_epoch().count();
 
+    mSeed = seed;
     Random::mtSeed(seed);
 
     std::ofstream seedFile("seed.dat");
@@ -154,17 +243,20 @@ bool N2D2::Network::run(Time_T stop, bool clearActivity)
     SpikeEvent* event;
     bool stopped = false;
 
-    if (!mEvents.empty())
-        mFirstEvent = mEvents.top()->getTimestamp();
+    if (!eventsEmpty())
+        mFirstEvent = eventsTop()->getTimestamp();
 
     mStop = stop;
     mDiscard = false;
 
-    while (!mEvents.empty()) {
-        event = mEvents.top();
+    if (!mPartitions.empty())
+        stopped = runPartitioned();
+
+    while (!eventsEmpty()) {
+        event = eventsTop();
 
         if (event->isDiscarded()) {
-            mEvents.pop();
+            eventsPop();
             mEventsPool.push(event);
             continue;
         }
@@ -196,15 +288,24 @@ bool N2D2::Network::run(Time_T stop, bool clearActivity)
         // courant, celui-ci pourrait se retrouver en haut de la
         // queue si bien que si on faisait dans ce cas le pop() après le
         // release(), on risque de supprimer le mauvais évènement.
-        mEvents.pop();
+        eventsPop();
         mLastEvent = event->release();
         mEventsPool.push(event);
     }
 
     if (mDiscard) {
-        while (!mEvents.empty()) {
-            mEventsPool.push(mEvents.top());
-            mEvents.pop();
+        while (!eventsEmpty()) {
+            mEventsPool.push(eventsTop());
+            eventsPop();
+        }
+
+        for (std::vector<Partition>::iterator it = mPartitions.begin(),
+             itEnd = mPartitions.end(); it != itEnd; ++it)
+        {
+            while (!eventsEmpty(*it)) {
+                (*it).eventsPool.push(eventsTop(*it));
+                eventsPop(*it);
+            }
         }
     }
 
@@ -218,6 +319,279 @@ bool N2D2::Network::run(Time_T stop, bool clearActivity)
     return stopped;
 }
 
+bool N2D2::Network::runPartitioned()
+{
+    const int nbPartitions = mPartitions.size();
+    bool firstWindow = true;
+
+    updateNodesRandom();
+
+    for (int p = 0; p < nbPartitions; ++p)
+        mPartitions[p].lastEvent = mLastEvent;
+
+    while (true) {
+        // Start of the next window: earliest pending event of all the
+        // partitions
+        bool pending = false;
+        Time_T windowStart = 0;
+
+        for (int p = 0; p < nbPartitions; ++p) {
+            Partition& partition = mPartitions[p];
+
+            while (!eventsEmpty(partition)
+                   && eventsTop(partition)->isDiscarded())
+            {
+                partition.eventsPool.push(eventsTop(partition));
+                eventsPop(partition);
+            }
+
+            if (!eventsEmpty(partition)) {
+                const Time_T timestamp = eventsTop(partition)->getTimestamp();
+
+                if (!pending || timestamp < windowStart)
+                    windowStart = timestamp;
+
+                pending = true;
+            }
+        }
+
+        if (!pending)
+            return false;
+
+        if (firstWindow) {
+            mFirstEvent = windowStart;
+            firstWindow = false;
+        }
+
+        // A stop requested during the last window can be earlier than the
+        // last event of the other partitions: it is checked first.
+        if (mStop > 0 && windowStart >= mStop)
+            return true;
+
+        // Safety check
+        if (windowStart < mLastEvent) {
+            std::ostringstream errorMsg;
+            errorMsg
+                << "Cannot go back in time! I want to deal with event at time "
+                << windowStart << " whereas last event was at " << mLastEvent;
+            throw std::runtime_error(errorMsg.str());
+        }
+
+        mWindowEnd = windowStart + mLookahead;
+
+        if (mStop > 0 && mWindowEnd > mStop)
+            mWindowEnd = mStop;
+
+#pragma omp parallel for schedule(dynamic) if (nbPartitions > 1)
+        for (int p = 0; p < nbPartitions; ++p)
+            runPartition(p);
+
+        for (int p = 0; p < nbPartitions; ++p) {
+            if (mPartitions[p].exception) {
+                const std::exception_ptr exception = mPartitions[p].exception;
+                mPartitions[p].exception = std::exception_ptr();
+                std::rethrow_exception(exception);
+            }
+        }
+
+        // Deliver the mailboxes, in a fixed order
+        for (int p = 0; p < nbPartitions; ++p) {
+            Partition& partition = mPartitions[p];
+
+            for (int dest = 0; dest < nbPartitions; ++dest) {
+                std::vector<SpikeEvent*>& mailbox = partition.mailboxes[dest];
+
+                for (std::vector<SpikeEvent*>::const_iterator it
+                     = mailbox.begin(), itEnd = mailbox.end(); it != itEnd;
+                     ++it)
+                {
+                    eventsPush(mPartitions[dest], (*it));
+                }
+
+                mailbox.clear();
+            }
+
+            if (partition.lastEvent > mLastEvent)
+                mLastEvent = partition.lastEvent;
+
+            for (std::unordered_map<NodeId_T, NodeEvents_T>::iterator it
+                 = partition.spikeRecording.begin(),
+                 itEnd = partition.spikeRecording.end(); it != itEnd; ++it)
+            {
+                NodeEvents_T& record = mSpikeRecording[(*it).first];
+                record.insert(record.end(),
+                              (*it).second.begin(), (*it).second.end());
+            }
+
+            partition.spikeRecording.clear();
+        }
+
+        // Stop requests of the window. The partition that called stop()
+        // applied it immediately, the others stop at the end of the window.
+        bool stopRequested = false;
+        Time_T stop = 0;
+
+        for (int p = 0; p < nbPartitions; ++p) {
+            Partition& partition = mPartitions[p];
+
+            if (partition.stopRequested) {
+                if (!stopRequested || (partition.stop > 0
+                                       && (stop == 0 || partition.stop < stop)))
+                {
+                    stop = partition.stop;
+                }
+
+                stopRequested = true;
+                mDiscard = mDiscard || partition.discard;
+                partition.stopRequested = false;
+                partition.discard = false;
+            }
+        }
+
+        if (stopRequested)
+            mStop = stop;
+    }
+}
+
+void N2D2::Network::runPartition(unsigned int p)
+{
+    Partition& partition = mPartitions[p];
+    _currentPartition = p;
+
+    try {
+        while (!eventsEmpty(partition)) {
+            SpikeEvent* event = eventsTop(partition);
+
+            if (event->isDiscarded()) {
+                eventsPop(partition);
+                partition.eventsPool.push(event);
+                continue;
+            }
+
+            if (event->getTimestamp() >= mWindowEnd
+                || (partition.stopRequested && partition.stop > 0
+                    && event->getTimestamp() >= partition.stop))
+            {
+                break;
+            }
+
+            // Safety check
+            if (event->getTimestamp() < partition.lastEvent) {
+                std::ostringstream errorMsg;
+                errorMsg << "Cannot go back in time! I want to deal with event"
+                            " at time " << event->getTimestamp()
+                         << " whereas last event was at "
+                         << partition.lastEvent << ", type is "
+                         << event->getType() << " (partition " << p << ")";
+                throw std::runtime_error(errorMsg.str());
+            }
+
+            eventsPop(partition);
+
+            // The random numbers drawn by the node come from its own stream,
+            // so that they do not depend on the processing order of the
+            // other partitions
+            Random::ThreadStream random(
+                &mNodesRandom[event->getNode()->getNetworkIndex()]);
+            partition.lastEvent = event->release();
+            partition.eventsPool.push(event);
+        }
+    }
+    catch (...) {
+        partition.exception = std::current_exception();
+    }
+
+    _currentPartition = -1;
+}
+
+void N2D2::Network::stop(Time_T stop, bool discard)
+{
+    if (_currentPartition >= 0) {
+        // Called by a node during a window of the partitioned mode
+        Partition& partition = mPartitions[_currentPartition];
+        partition.stopRequested = true;
+        partition.stop = stop;
+        partition.discard = discard;
+    }
+    else {
+        mStop = stop;
+        mDiscard = discard;
+    }
+}
+
+void N2D2::Network::setPartitioning(unsigned int nbPartitions,
+                                    Time_T lookahead)
+{
+    if (nbPartitions > 0 && lookahead == 0) {
+        throw std::domain_error("Network::setPartitioning(): lookahead must "
+                                "be > 0");
+    }
+
+    bool pending = !eventsEmpty();
+
+    for (std::vector<Partition>::const_iterator it = mPartitions.begin(),
+         itEnd = mPartitions.end(); it != itEnd; ++it)
+    {
+        pending = pending || !eventsEmpty(*it);
+    }
+
+    if (pending) {
+        throw std::runtime_error("Network::setPartitioning(): cannot change "
+                                 "the partitioning with pending events");
+    }
+
+    for (std::vector<Partition>::iterator it = mPartitions.begin(),
+         itEnd = mPartitions.end(); it != itEnd; ++it)
+    {
+        while (!(*it).eventsPool.empty()) {
+            delete (*it).eventsPool.top();
+            (*it).eventsPool.pop();
+        }
+    }
+
+    mPartitions.clear();
+    mLookahead = lookahead;
+
+    if (nbPartitions > 0) {
+        mPartitions.reserve(nbPartitions);
+
+        for (unsigned int p = 0; p < nbPartitions; ++p) {
+            mPartitions.push_back(Partition(mEventsWheel.getResolution(),
+                                            mEventsWheel.getNbSlots()));
+            mPartitions.back().mailboxes.resize(nbPartitions);
+        }
+    }
+}
+
+N2D2::Random::Stream* N2D2::Network::getNodeRandom(const Node& node)
+{
+    if (mPartitions.empty())
+        return NULL;
+
+    updateNodesRandom();
+    return &mNodesRandom[node.getNetworkIndex()];
+}
+
+void N2D2::Network::updateNodesRandom()
+{
+    mNodesRandom.reserve(mNbNodes);
+
+    for (unsigned int index = mNodesRandom.size(); index < mNbNodes; ++index)
+        mNodesRandom.push_back(Random::Stream(mSeed, index));
+}
+
+void N2D2::Network::recordPartitionSpike(NodeId_T nodeId,
+                                         Time_T timestamp,
+                                         EventType_T type)
+{
+    std::unordered_map<NodeId_T, NodeEvents_T>& spikeRecording
+        = (_currentPartition >= 0)
+            ? mPartitions[_currentPartition].spikeRecording
+            : mSpikeRecording;
+
+    spikeRecording[nodeId].push_back(std::make_pair(timestamp, type));
+}
+
 void N2D2::Network::reset(Time_T timestamp)
 {
     mFirstEvent = timestamp;
@@ -273,6 +647,9 @@ N2D2::SpikeEvent* N2D2::Network::newEvent(Node* origin,
 {
     SpikeEvent* event;
 
+    if (!mPartitions.empty())
+        return newPartitionEvent(origin, destination, timestamp, type);
+
     if (mEventsPool.empty())
         event = new SpikeEvent(origin, destination, timestamp, type);
     else {
@@ -281,7 +658,62 @@ N2D2::SpikeEvent* N2D2::Network::newEvent(Node* origin,
         event->initialize(origin, destination, timestamp, type);
     }
 
-    mEvents.push(event);
+    eventsPush(event);
+    return event;
+}
+
+N2D2::SpikeEvent* N2D2::Network::newPartitionEvent(Node* origin,
+                                                   Node* destination,
+                                                   Time_T timestamp,
+                                                   EventType_T type)
+{
+    // The event is processed by the partition of the node that handles it
+    const unsigned int dest = (destination != NULL)
+        ? destination->getPartition() : origin->getPartition();
+
+    if (dest >= mPartitions.size()) {
+        std::ostringstream errorMsg;
+        errorMsg << "Network::newEvent(): node partition (" << dest
+                 << ") out of range (" << mPartitions.size()
+                 << " partitions)";
+        throw std::runtime_error(errorMsg.str());
+    }
+
+    Partition& partition = (_currentPartition >= 0)
+        ? mPartitions[_currentPartition] : mPartitions[dest];
+    SpikeEvent* event;
+
+    if (partition.eventsPool.empty())
+        event = new SpikeEvent(origin, destination, timestamp, type);
+    else {
+        event = partition.eventsPool.top();
+        partition.eventsPool.pop();
+        event->initialize(origin, destination, timestamp, type);
+    }
+
+    event->setTieKey();
+
+    if (_currentPartition < 0 || (unsigned int)_currentPartition == dest)
+        eventsPush(mPartitions[dest], event);
+    else {
+        if (timestamp < mWindowEnd) {
+            partition.eventsPool.push(event);
+
+            std::ostringstream errorMsg;
+            errorMsg << "Network::newEvent(): event at time " << timestamp
+                     << " for partition " << dest << " from partition "
+                     << _currentPartition << " is within the current "
+                     "synchronization window (ending at " << mWindowEnd
+                     << "), the lookahead (" << mLookahead
+                     << ") is too large";
+            throw std::runtime_error(errorMsg.str());
+        }
+
+        // The mailbox is only written by the current partition during the
+        // window, and read after the end of the window.
+        partition.mailboxes[dest].push_back(event);
+    }
+
     return event;
 }
 
@@ -293,6 +725,15 @@ N2D2::Network::~Network()
         mEventsPool.pop();
     }
 
+    for (std::vector<Partition>::iterator it = mPartitions.begin(),
+         itEnd = mPartitions.end(); it != itEnd; ++it)
+    {
+        while (!(*it).eventsPool.empty()) {
+            delete (*it).eventsPool.top();
+            (*it).eventsPool.pop();
+        }
+    }
+
     const double timeElapsed
         = std::chrono::duration_cast<std::chrono::duration<double> >(
             std::chrono::high_resolution_clock::now() - mStartTime).count();
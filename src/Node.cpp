@@ -31,7 +31,9 @@ N2D2::Node::Node(Network& net)
       mScale(1.0),
       mOrientation(0.0),
       mLayer(0),
-      mArea(0, 0, 0, 0)
+      mPartition(0),
+      mArea(0, 0, 0, 0),
+      mNetworkIndex(net.newNodeIndex())
 {
     // ctor
 }
@@ -20,13 +20,19 @@
 */
 
 #include "NodeEnv.hpp"
+#include "SpikeGenerator.hpp"
 
 N2D2::NodeEnv::NodeEnv(Network& net,
                        double scale,
                        double orientation,
                        unsigned int x,
                        unsigned int y)
-    : Node(net)
+    : Node(net),
+      mStreamGenerator(NULL),
+      mStreamValue(0.0),
+      mStreamStart(0),
+      mStreamEnd(0),
+      mStreamEvent(0, 0)
 {
     // ctor
     mScale = scale;
@@ -36,3 +42,40 @@ N2D2::NodeEnv::NodeEnv(Network& net,
     mArea.width = 1;
     mArea.height = 1;
 }
+
+void N2D2::NodeEnv::streamSpikes(const SpikeGenerator* generator,
+                                 double value,
+                                 Time_T start,
+                                 Time_T end)
+{
+    mStreamGenerator = generator;
+    mStreamValue = value;
+    mStreamStart = start;
+    mStreamEnd = end;
+    mStreamEvent = std::make_pair(start, 0);
+
+    nextStreamSpike();
+}
+
+void N2D2::NodeEnv::emitSpike(Time_T timestamp, EventType_T type)
+{
+    // A spike of a previous stream (still pending when the current stream
+    // started) is emitted, but does not generate the next spike
+    if (mStreamGenerator != NULL && timestamp == mStreamEvent.first)
+        nextStreamSpike();
+
+    Node::emitSpike(timestamp, type);
+}
+
+void N2D2::NodeEnv::nextStreamSpike()
+{
+    mStreamGenerator->nextEvent(mStreamEvent, mStreamValue,
+                                mStreamStart, mStreamEnd);
+
+    if (mStreamEvent.second != 0) {
+        mNet.newEvent(this, NULL, mStreamEvent.first,
+                      (mStreamEvent.second < 0) ? 1 : 0);
+    }
+    else
+        mStreamGenerator = NULL;
+}
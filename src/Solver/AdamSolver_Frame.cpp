@@ -25,6 +25,7 @@ template <>
 N2D2::Registrar<N2D2::AdamSolver>
 N2D2::AdamSolver_Frame<half_float::half>::mRegistrar(
     {"Frame",
+     "Frame_INT8",
      "Transcode"},
     N2D2::AdamSolver_Frame<half_float::half>::create,
     N2D2::Registrar<N2D2::AdamSolver>::Type<half_float::half>());
@@ -33,6 +34,7 @@ template <>
 N2D2::Registrar<N2D2::AdamSolver>
 N2D2::AdamSolver_Frame<float>::mRegistrar(
     {"Frame",
+     "Frame_INT8",
      "Transcode"},
     N2D2::AdamSolver_Frame<float>::create,
     N2D2::Registrar<N2D2::AdamSolver>::Type<float>());
@@ -41,6 +43,7 @@ template <>
 N2D2::Registrar<N2D2::AdamSolver>
 N2D2::AdamSolver_Frame<double>::mRegistrar(
     {"Frame",
+     "Frame_INT8",
      "Transcode"},
     N2D2::AdamSolver_Frame<double>::create,
     N2D2::Registrar<N2D2::AdamSolver>::Type<double>());
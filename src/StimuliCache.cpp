@@ -0,0 +1,403 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "StimuliCache.hpp"
+#include "utils/BinaryCvMat.hpp"
+
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <sstream>
+#include <stdint.h>
+
+namespace {
+    // Index entry: stimulus ID, shard, offset and size of the record
+    struct IndexEntry {
+        uint32_t id;
+        uint32_t shard;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    // Alignment of the records in the shards and of the matrices data in
+    // the records
+    const unsigned int RECORD_ALIGN = 16;
+
+    // BinaryCvMat header: rows, cols and type
+    const unsigned int MAT_HEADER_SIZE = 3 * sizeof(int);
+
+    unsigned int getMatPadding(std::size_t pos)
+    {
+        // Padding before a BinaryCvMat record, for its data to be aligned
+        return (RECORD_ALIGN - (pos + MAT_HEADER_SIZE) % RECORD_ALIGN)
+            % RECORD_ALIGN;
+    }
+
+    unsigned long long int getFileSize(const std::string& fileName)
+    {
+        std::ifstream is(fileName.c_str(), std::ios::binary | std::ios::ate);
+        return (is.good()) ? (unsigned long long int)is.tellg() : 0;
+    }
+}
+
+const std::size_t N2D2::StimuliCache::DefaultMaxShardSize = (1ULL << 30);
+
+N2D2::StimuliCache::StimuliCache(const std::string& path,
+                                 std::size_t maxShardSize)
+    : mPath(path),
+      mMaxShardSize(maxShardSize)
+{
+    // ctor
+}
+
+std::shared_ptr<N2D2::StimuliCache>
+N2D2::StimuliCache::open(const std::string& path)
+{
+    static std::map<std::string, std::weak_ptr<StimuliCache> > caches;
+    std::shared_ptr<StimuliCache> cache;
+
+#pragma omp critical(StimuliCache__open)
+    {
+        cache = caches[path].lock();
+
+        if (!cache) {
+            cache = std::make_shared<StimuliCache>(path);
+            caches[path] = cache;
+        }
+    }
+
+    return cache;
+}
+
+bool N2D2::StimuliCache::isCached(Database::StimulusID id,
+                                  Database::StimuliSet set)
+{
+    bool cached = false;
+    std::exception_ptr error;
+
+#pragma omp critical(StimuliCache)
+    try {
+        const SetCache& setCache = getSetCache(set);
+        cached = (id < setCache.cached.size() && setCache.cached[id]);
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return cached;
+}
+
+bool N2D2::StimuliCache::load(Database::StimulusID id,
+                              Database::StimuliSet set,
+                              std::vector<cv::Mat>& data,
+                              std::vector<cv::Mat>& labels,
+                              std::shared_ptr<MemoryMappedFile>& mapping)
+{
+    bool cached = false;
+    Location location;
+    std::exception_ptr error;
+
+#pragma omp critical(StimuliCache)
+    try {
+        SetCache& setCache = getSetCache(set);
+        cached = (id < setCache.cached.size() && setCache.cached[id]);
+
+        if (cached) {
+            location = setCache.locations[id];
+            std::shared_ptr<MemoryMappedFile>& shard
+                = setCache.shards[location.shard];
+
+            // The current shard is re-mapped when it grew past the mapping
+            if (!shard || shard->size() < location.offset + location.size) {
+                shard = std::make_shared<MemoryMappedFile>(
+                    getShardFileName(set, location.shard));
+            }
+
+            mapping = shard;
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    if (!cached)
+        return false;
+
+    if (mapping->size() < location.offset + location.size) {
+        throw std::runtime_error("StimuliCache::load(): truncated shard: "
+                                 + mapping->getFileName());
+    }
+
+    const char* record = mapping->data() + location.offset;
+    std::size_t pos = 0;
+
+    uint32_t nbData, nbLabels;
+    std::memcpy(&nbData, record, sizeof(nbData));
+    std::memcpy(&nbLabels, record + sizeof(nbData), sizeof(nbLabels));
+    pos += sizeof(nbData) + sizeof(nbLabels);
+
+    data.clear();
+    labels.clear();
+
+    for (unsigned int i = 0; i < nbData + nbLabels; ++i) {
+        pos += getMatPadding(pos);
+
+        if (pos + MAT_HEADER_SIZE > location.size) {
+            throw std::runtime_error("StimuliCache::load(): corrupted record"
+                                     " in shard: " + mapping->getFileName());
+        }
+
+        int rows, cols, type;
+        std::memcpy(&rows, record + pos, sizeof(rows));
+        std::memcpy(&cols, record + pos + sizeof(rows), sizeof(cols));
+        std::memcpy(&type, record + pos + sizeof(rows) + sizeof(cols),
+                    sizeof(type));
+        pos += MAT_HEADER_SIZE;
+
+        // Zero-copy: the matrix points to the mapped record
+        const cv::Mat mat(rows, cols, type, const_cast<char*>(record + pos));
+        pos += mat.elemSize() * rows * cols;
+
+        if (pos > location.size) {
+            throw std::runtime_error("StimuliCache::load(): corrupted record"
+                                     " in shard: " + mapping->getFileName());
+        }
+
+        if (i < nbData)
+            data.push_back(mat);
+        else
+            labels.push_back(mat);
+    }
+
+    return true;
+}
+
+void N2D2::StimuliCache::save(Database::StimulusID id,
+                              Database::StimuliSet set,
+                              const std::vector<cv::Mat>& data,
+                              const std::vector<cv::Mat>& labels)
+{
+    // Serialize the record
+    std::ostringstream record(std::ios::binary);
+
+    const uint32_t nbData = data.size();
+    const uint32_t nbLabels = labels.size();
+    record.write(reinterpret_cast<const char*>(&nbData), sizeof(nbData));
+    record.write(reinterpret_cast<const char*>(&nbLabels), sizeof(nbLabels));
+
+    const char padding[RECORD_ALIGN] = {0};
+
+    for (unsigned int i = 0; i < nbData + nbLabels; ++i) {
+        record.write(padding, getMatPadding((std::size_t)record.tellp()));
+        BinaryCvMat::write(record, (i < nbData) ? data[i]
+                                                : labels[i - nbData]);
+    }
+
+    const std::string recordStr = record.str();
+    std::exception_ptr error;
+
+#pragma omp critical(StimuliCache)
+    try {
+        SetCache& setCache = getSetCache(set);
+
+        if (!(id < setCache.cached.size() && setCache.cached[id])) {
+            unsigned long long int offset = RECORD_ALIGN
+                * ((setCache.shardSize + RECORD_ALIGN - 1) / RECORD_ALIGN);
+
+            if (setCache.shardSize > 0
+                && offset + recordStr.size() > mMaxShardSize)
+            {
+                // Start a new shard. A file with the same name may remain
+                // from an interrupted run: it is not referenced by the index
+                // and is overwritten.
+                setCache.shards.push_back(std::shared_ptr<MemoryMappedFile>());
+                setCache.shard.close();
+                setCache.shard.open(getShardFileName(set,
+                                        setCache.shards.size() - 1).c_str(),
+                                    std::ios::binary | std::ios::trunc);
+                setCache.shardSize = 0;
+                offset = 0;
+            }
+
+            setCache.shard.write(padding, offset - setCache.shardSize);
+            setCache.shard.write(recordStr.data(), recordStr.size());
+            setCache.shard.flush();
+
+            if (!setCache.shard.good()) {
+                throw std::runtime_error("StimuliCache::save(): error writing"
+                    " shard: " + getShardFileName(set,
+                                                  setCache.shards.size() - 1));
+            }
+
+            setCache.shardSize = offset + recordStr.size();
+
+            // The index entry is written once the record is complete
+            IndexEntry entry;
+            entry.id = id;
+            entry.shard = setCache.shards.size() - 1;
+            entry.offset = offset;
+            entry.size = recordStr.size();
+
+            setCache.index.write(reinterpret_cast<const char*>(&entry),
+                                 sizeof(entry));
+            setCache.index.flush();
+
+            if (!setCache.index.good()) {
+                throw std::runtime_error("StimuliCache::save(): error writing"
+                                         " index: " + getIndexFileName(set));
+            }
+
+            if (id >= setCache.cached.size()) {
+                setCache.cached.resize(id + 1, false);
+                setCache.locations.resize(id + 1);
+            }
+
+            Location location;
+            location.shard = entry.shard;
+            location.offset = entry.offset;
+            location.size = entry.size;
+
+            setCache.locations[id] = location;
+            setCache.cached[id] = true;
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+N2D2::StimuliCache::SetCache&
+N2D2::StimuliCache::getSetCache(Database::StimuliSet set)
+{
+    SetCache& setCache = mSets[set];
+
+    if (setCache.initialized)
+        return setCache;
+
+    // Load the index
+    const std::string indexFileName = getIndexFileName(set);
+    std::vector<IndexEntry> entries;
+    bool rewrite = false;
+
+    std::ifstream indexFile(indexFileName.c_str(), std::ios::binary);
+    IndexEntry entry;
+
+    while (indexFile.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+        entries.push_back(entry);
+
+    // Incomplete last entry, in case of interrupted write
+    if (indexFile.gcount() > 0)
+        rewrite = true;
+
+    indexFile.close();
+
+    std::vector<unsigned long long int> shardsSize;
+
+    for (std::vector<IndexEntry>::iterator it = entries.begin();
+         it != entries.end(); )
+    {
+        while ((*it).shard >= shardsSize.size()) {
+            shardsSize.push_back(getFileSize(getShardFileName(set,
+                                                    shardsSize.size())));
+        }
+
+        if ((*it).offset + (*it).size > shardsSize[(*it).shard]) {
+            // Truncated shard: drop the record
+            it = entries.erase(it);
+            rewrite = true;
+            continue;
+        }
+
+        if ((*it).id >= setCache.cached.size()) {
+            setCache.cached.resize((*it).id + 1, false);
+            setCache.locations.resize((*it).id + 1);
+        }
+
+        Location location;
+        location.shard = (*it).shard;
+        location.offset = (*it).offset;
+        location.size = (*it).size;
+
+        setCache.locations[(*it).id] = location;
+        setCache.cached[(*it).id] = true;
+        ++it;
+    }
+
+    if (shardsSize.empty())
+        shardsSize.push_back(getFileSize(getShardFileName(set, 0)));
+
+    if (rewrite) {
+        std::ofstream index(indexFileName.c_str(),
+                            std::ios::binary | std::ios::trunc);
+
+        for (std::vector<IndexEntry>::const_iterator it = entries.begin(),
+             itEnd = entries.end(); it != itEnd; ++it)
+        {
+            index.write(reinterpret_cast<const char*>(&(*it)), sizeof(*it));
+        }
+
+        if (!index.good()) {
+            throw std::runtime_error("StimuliCache::getSetCache(): error"
+                                     " writing index: " + indexFileName);
+        }
+    }
+
+    // Open the last shard and the index for appending
+    setCache.shards.resize(shardsSize.size());
+    setCache.shardSize = shardsSize.back();
+    setCache.shard.open(getShardFileName(set, shardsSize.size() - 1).c_str(),
+                        std::ios::binary | std::ios::app);
+    setCache.index.open(indexFileName.c_str(),
+                        std::ios::binary | std::ios::app);
+
+    if (!setCache.shard.good() || !setCache.index.good()) {
+        throw std::runtime_error("StimuliCache::getSetCache(): could not open"
+                                 " cache files in: " + mPath);
+    }
+
+    setCache.initialized = true;
+    return setCache;
+}
+
+std::string N2D2::StimuliCache::getShardFileName(Database::StimuliSet set,
+                                                 unsigned int shard) const
+{
+    std::stringstream fileName;
+    fileName << mPath << "/shard_" << set << "_" << std::setfill('0')
+             << std::setw(4) << shard << ".bin";
+    return fileName.str();
+}
+
+std::string N2D2::StimuliCache::getIndexFileName(Database::StimuliSet set)
+    const
+{
+    std::stringstream fileName;
+    fileName << mPath << "/index_" << set << ".bin";
+    return fileName.str();
+}
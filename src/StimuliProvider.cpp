@@ -18,6 +18,7 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include "StimuliCache.hpp"
 #include "StimuliProvider.hpp"
 #include "Solver/SGDSolver_Kernels.hpp"
 #include "Transformation/RangeAffineTransformation.hpp"
@@ -25,6 +26,12 @@
 #include "utils/Gnuplot.hpp"
 #include "utils/GraphViz.hpp"
 
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 N2D2::StimuliProvider::StimuliProvider(Database& database,
                                        const std::vector<size_t>& size,
                                        unsigned int batchSize,
@@ -34,6 +41,15 @@ N2D2::StimuliProvider::StimuliProvider(Database& database,
       mQuantizationLevels(this, "QuantizationLevels", 0U),
       mQuantizationMin(this, "QuantizationMin", 0.0),
       mQuantizationMax(this, "QuantizationMax", 1.0),
+      mPackedCache(this, "PackedCache", false),
+      mPrefetchDepth(this, "PrefetchDepth", 0U),
+      mPrefetchThreads(this, "PrefetchThreads", 0U),
+      mFuseTransformations(this, "FuseTransformations", false),
+      mProfileTransformations(this, "ProfileTransformations", false),
+      mSampling(this, "Sampling", Uniform),
+      mLabelsWeights(this, "LabelsWeights", std::vector<double>()),
+      mEpochShardSize(this, "EpochShardSize", 1024U),
+      mEpochBufferSize(this, "EpochBufferSize", 8192U),
       mDatabase(database),
       mSize(size),
       mBatchSize(batchSize),
@@ -81,11 +97,23 @@ N2D2::StimuliProvider::StimuliProvider(StimuliProvider&& other)
       mQuantizationLevels(this, "QuantizationLevels", other.mQuantizationLevels),
       mQuantizationMin(this, "QuantizationMin", other.mQuantizationMin),
       mQuantizationMax(this, "QuantizationMax", other.mQuantizationMax),
+      mPackedCache(this, "PackedCache", other.mPackedCache),
+      mPrefetchDepth(this, "PrefetchDepth", other.mPrefetchDepth),
+      mPrefetchThreads(this, "PrefetchThreads", other.mPrefetchThreads),
+      mFuseTransformations(this, "FuseTransformations",
+                           other.mFuseTransformations),
+      mProfileTransformations(this, "ProfileTransformations",
+                              other.mProfileTransformations),
+      mSampling(this, "Sampling", other.mSampling),
+      mLabelsWeights(this, "LabelsWeights", other.mLabelsWeights),
+      mEpochShardSize(this, "EpochShardSize", other.mEpochShardSize),
+      mEpochBufferSize(this, "EpochBufferSize", other.mEpochBufferSize),
       mDatabase(other.mDatabase),
       mSize(std::move(other.mSize)),
       mBatchSize(other.mBatchSize),
       mCompositeStimuli(other.mCompositeStimuli),
       mCachePath(std::move(other.mCachePath)),
+      mStimuliCache(std::move(other.mStimuliCache)),
       mTransformations(other.mTransformations),
       mChannelsTransformations(std::move(other.mChannelsTransformations)),
       mBatch(std::move(other.mBatch)),
@@ -98,7 +126,9 @@ N2D2::StimuliProvider::StimuliProvider(StimuliProvider&& other)
       mFutureTargetData(other.mFutureTargetData),
       mLabelsROI(std::move(other.mLabelsROI)),
       mFutureLabelsROI(std::move(other.mFutureLabelsROI)),
-      mFuture(other.mFuture)
+      mFuture(other.mFuture),
+      mProfiles(std::move(other.mProfiles)),
+      mEpochs(std::move(other.mEpochs))
 {
 }
 
@@ -108,6 +138,15 @@ N2D2::StimuliProvider N2D2::StimuliProvider::cloneParameters() const {
     sp.mQuantizationLevels = mQuantizationLevels;
     sp.mQuantizationMin = mQuantizationMin;
     sp.mQuantizationMax = mQuantizationMax;
+    sp.mPackedCache = mPackedCache;
+    sp.mPrefetchDepth = mPrefetchDepth;
+    sp.mPrefetchThreads = mPrefetchThreads;
+    sp.mFuseTransformations = mFuseTransformations;
+    sp.mProfileTransformations = mProfileTransformations;
+    sp.mSampling = mSampling;
+    sp.mLabelsWeights = mLabelsWeights;
+    sp.mEpochShardSize = mEpochShardSize;
+    sp.mEpochBufferSize = mEpochBufferSize;
     sp.mCachePath = mCachePath;
     sp.mTransformations = mTransformations;
     sp.mChannelsTransformations = mChannelsTransformations;
@@ -158,6 +197,8 @@ void N2D2::StimuliProvider::addTransformation(const CompositeTransformation
         mTransformations(*it).cacheable.push_back(transformation);
         mTransformations(*it).cacheable.setStimuliProvider(this);
     }
+
+    updateDecodeMinSize();
 }
 
 void N2D2::StimuliProvider::addOnTheFlyTransformation(
@@ -593,6 +634,60 @@ void N2D2::StimuliProvider::logTransformations(const std::string& fileName)
     graph.render(fileName);
 }
 
+N2D2::TransformationsProfile
+N2D2::StimuliProvider::getTransformationsProfile() const
+{
+    TransformationsProfile profile;
+
+#pragma omp critical(StimuliProvider__profile)
+    for (std::map<std::thread::id, TransformationsProfile>::const_iterator it
+         = mProfiles.begin(), itEnd = mProfiles.end(); it != itEnd; ++it)
+    {
+        profile.merge((*it).second);
+    }
+
+    return profile;
+}
+
+void N2D2::StimuliProvider::logTransformationsProfile(
+    const std::string& fileName) const
+{
+    std::ofstream profileFile(fileName.c_str());
+
+    if (!profileFile.good()) {
+        throw std::runtime_error("Could not create transformations profile "
+                                 "file: " + fileName);
+    }
+
+    TransformationsProfile::logHeader(profileFile, "Thread,");
+
+    TransformationsProfile profile;
+
+#pragma omp critical(StimuliProvider__profile)
+    {
+        unsigned int thread = 0;
+
+        for (std::map<std::thread::id, TransformationsProfile>::const_iterator
+             it = mProfiles.begin(), itEnd = mProfiles.end(); it != itEnd;
+             ++it, ++thread)
+        {
+            std::ostringstream prefix;
+            prefix << thread << ",";
+
+            (*it).second.log(profileFile, prefix.str());
+            profile.merge((*it).second);
+        }
+    }
+
+    profile.log(profileFile, "All,");
+}
+
+void N2D2::StimuliProvider::clearTransformationsProfile()
+{
+#pragma omp critical(StimuliProvider__profile)
+    mProfiles.clear();
+}
+
 void N2D2::StimuliProvider::future()
 {
     mFuture = true;
@@ -610,6 +705,280 @@ void N2D2::StimuliProvider::synchronize()
     }
 }
 
+void N2D2::StimuliProvider::startPrefetch(Database::StimuliSet set)
+{
+    stopPrefetch();
+
+    if (mPrefetchDepth == 0)
+        return;
+
+    if (mBatchSize == 0) {
+        throw std::runtime_error("StimuliProvider::startPrefetch(): batch size"
+                                 " must be > 0");
+    }
+
+    mPrefetch.reset(new PrefetchQueue());
+    mPrefetch->set = set;
+    mPrefetch->depth = mPrefetchDepth;
+    // The producer uses its own random streams, seeded here, to be
+    // reproducible regardless of the thread scheduling
+    mPrefetch->seed = Random::mtRand();
+    mPrefetch->stop = false;
+    mPrefetch->paused = false;
+    mPrefetch->busy = false;
+    mPrefetch->nbBatches = 0;
+    mPrefetch->cumOccupancy = 0;
+    mPrefetch->consumerStallTime = 0.0;
+    mPrefetch->producerStallTime = 0.0;
+
+    for (unsigned int k = 0; k < mPrefetch->depth; ++k) {
+        std::unique_ptr<BatchData> slot(new BatchData());
+        slot->batch.resize(mBatchSize);
+#ifdef CUDA
+        slot->data.hostBased() = true;
+        slot->targetData.hostBased() = true;
+#endif
+        slot->data.resize(mData.dims());
+        slot->labelsData.resize(mLabelsData.dims());
+
+        if (!mTargetData.empty())
+            slot->targetData.resize(mTargetData.dims());
+
+        slot->labelsROI.resize(mBatchSize);
+        mPrefetch->free.push_back(std::move(slot));
+    }
+
+    mPrefetch->producer
+        = std::thread(&StimuliProvider::prefetchProducer, this);
+}
+
+void N2D2::StimuliProvider::stopPrefetch()
+{
+    if (!mPrefetch)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mPrefetch->mutex);
+        mPrefetch->stop = true;
+    }
+
+    mPrefetch->cond.notify_all();
+
+    if (mPrefetch->producer.joinable())
+        mPrefetch->producer.join();
+
+    mPrefetch.reset();
+}
+
+void N2D2::StimuliProvider::pausePrefetch()
+{
+    if (!mPrefetch)
+        return;
+
+    std::unique_lock<std::mutex> lock(mPrefetch->mutex);
+    mPrefetch->paused = true;
+    mPrefetch->cond.wait(lock, [this]() { return !mPrefetch->busy; });
+}
+
+void N2D2::StimuliProvider::resumePrefetch()
+{
+    if (!mPrefetch)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mPrefetch->mutex);
+        mPrefetch->paused = false;
+    }
+
+    mPrefetch->cond.notify_all();
+}
+
+N2D2::StimuliProvider::PrefetchStats
+N2D2::StimuliProvider::getPrefetchStats() const
+{
+    PrefetchStats stats;
+    stats.depth = 0;
+    stats.nbBatches = 0;
+    stats.avgOccupancy = 0.0;
+    stats.consumerStallTime = 0.0;
+    stats.producerStallTime = 0.0;
+
+    if (mPrefetch) {
+        std::lock_guard<std::mutex> lock(mPrefetch->mutex);
+
+        stats.depth = mPrefetch->depth;
+        stats.nbBatches = mPrefetch->nbBatches;
+        stats.avgOccupancy = (mPrefetch->nbBatches > 0)
+            ? mPrefetch->cumOccupancy / (double)mPrefetch->nbBatches : 0.0;
+        stats.consumerStallTime = mPrefetch->consumerStallTime;
+        stats.producerStallTime = mPrefetch->producerStallTime;
+    }
+
+    return stats;
+}
+
+void N2D2::StimuliProvider::prefetchProducer()
+{
+#ifdef _OPENMP
+    // Dedicated decoding threads pool: the OpenMP threads team of the
+    // producer thread
+    if (mPrefetchThreads > 0)
+        omp_set_num_threads(mPrefetchThreads);
+#endif
+
+    const Database::StimuliSet set = mPrefetch->set;
+
+    for (unsigned int k = 0; ; ++k) {
+        std::unique_ptr<BatchData> slot;
+
+        {
+            std::unique_lock<std::mutex> lock(mPrefetch->mutex);
+            const std::chrono::high_resolution_clock::time_point startTime
+                = std::chrono::high_resolution_clock::now();
+
+            mPrefetch->cond.wait(lock, [this]() {
+                return (mPrefetch->stop
+                        || (!mPrefetch->paused && !mPrefetch->free.empty()));
+            });
+
+            mPrefetch->producerStallTime += std::chrono::duration_cast
+                <std::chrono::duration<double> >(
+                    std::chrono::high_resolution_clock::now() - startTime)
+                        .count();
+
+            if (mPrefetch->stop)
+                return;
+
+            slot = std::move(mPrefetch->free.front());
+            mPrefetch->free.pop_front();
+            mPrefetch->busy = true;
+        }
+
+        try {
+            Random::ThreadStream batchStream(mPrefetch->seed, k);
+
+            for (unsigned int batchPos = 0; batchPos < mBatchSize; ++batchPos)
+                slot->batch[batchPos] = getRandomID(set);
+
+            const unsigned int seed = Random::mtRand();
+            unsigned int exceptCatch = 0;
+
+#pragma omp parallel for schedule(dynamic) if (mBatchSize > 1)
+            for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos) {
+                try {
+                    Random::ThreadStream stream(seed, batchPos);
+                    readStimulusData(slot->batch[batchPos], set, batchPos,
+                                     slot->data, slot->labelsData,
+                                     slot->targetData,
+                                     slot->labelsROI[batchPos]);
+                }
+                catch (const std::exception& e)
+                {
+                    #pragma omp critical(StimuliProvider__readRandomBatch)
+                    {
+                        std::cout << Utils::cwarning << e.what()
+                            << Utils::cdef << std::endl;
+                        ++exceptCatch;
+                    }
+                }
+            }
+
+            if (exceptCatch > 0) {
+                std::cout << "Retry without multi-threading..." << std::endl;
+
+                for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos)
+                {
+                    Random::ThreadStream stream(seed, batchPos);
+                    readStimulusData(slot->batch[batchPos], set, batchPos,
+                                     slot->data, slot->labelsData,
+                                     slot->targetData,
+                                     slot->labelsROI[batchPos]);
+                }
+            }
+        }
+        catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mPrefetch->mutex);
+                mPrefetch->error = std::current_exception();
+                mPrefetch->busy = false;
+            }
+
+            mPrefetch->cond.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mPrefetch->mutex);
+            mPrefetch->ready.push_back(std::move(slot));
+            mPrefetch->busy = false;
+        }
+
+        mPrefetch->cond.notify_all();
+    }
+}
+
+void N2D2::StimuliProvider::checkPrefetchPaused(const std::string& method)
+    const
+{
+    // The paused flag is only changed by the consumer thread
+    if (mPrefetch && !mPrefetch->paused) {
+        throw std::runtime_error("StimuliProvider::" + method + "(): cannot"
+                                 " read while prefetching, call"
+                                 " pausePrefetch() first");
+    }
+}
+
+void N2D2::StimuliProvider::readPrefetchedBatch()
+{
+    std::unique_ptr<BatchData> slot;
+
+    {
+        std::unique_lock<std::mutex> lock(mPrefetch->mutex);
+        const std::chrono::high_resolution_clock::time_point startTime
+            = std::chrono::high_resolution_clock::now();
+
+        // Occupancy of the queue when the batch is requested
+        mPrefetch->cumOccupancy += mPrefetch->ready.size();
+
+        mPrefetch->cond.wait(lock, [this]() {
+            return (!mPrefetch->ready.empty() || mPrefetch->error);
+        });
+
+        mPrefetch->consumerStallTime += std::chrono::duration_cast
+            <std::chrono::duration<double> >(
+                std::chrono::high_resolution_clock::now() - startTime).count();
+
+        if (mPrefetch->ready.empty())
+            std::rethrow_exception(mPrefetch->error);
+
+        slot = std::move(mPrefetch->ready.front());
+        mPrefetch->ready.pop_front();
+        ++mPrefetch->nbBatches;
+    }
+
+    // Zero-copy: swap the assembled batch with the consumer buffers, which
+    // are recycled by the producer
+    std::vector<int>& batchRef = (mFuture) ? mFutureBatch : mBatch;
+    TensorData_T& dataRef = (mFuture) ? mFutureData : mData;
+    Tensor<int>& labelsRef = (mFuture) ? mFutureLabelsData : mLabelsData;
+    TensorData_T& targetDataRef = (mFuture) ? mFutureTargetData : mTargetData;
+    std::vector<std::vector<std::shared_ptr<ROI> > >& labelsROIRef
+        = (mFuture) ? mFutureLabelsROI : mLabelsROI;
+
+    batchRef.swap(slot->batch);
+    dataRef.swap(slot->data);
+    labelsRef.swap(slot->labelsData);
+    targetDataRef.swap(slot->targetData);
+    labelsROIRef.swap(slot->labelsROI);
+
+    {
+        std::lock_guard<std::mutex> lock(mPrefetch->mutex);
+        mPrefetch->free.push_back(std::move(slot));
+    }
+
+    mPrefetch->cond.notify_all();
+}
+
 unsigned int N2D2::StimuliProvider::getRandomIndex(Database::StimuliSet set)
 {
     return Random::randUniform(0, mDatabase.getNbStimuli(set) - 1);
@@ -618,39 +987,115 @@ unsigned int N2D2::StimuliProvider::getRandomIndex(Database::StimuliSet set)
 N2D2::Database::StimulusID
 N2D2::StimuliProvider::getRandomID(Database::StimuliSet set)
 {
-    return mDatabase.getStimulusID(set, getRandomIndex(set));
+    if (mSampling == Uniform)
+        return mDatabase.getStimulusID(set, getRandomIndex(set));
+    else if (mSampling == EpochShuffle) {
+        const unsigned int nbStimuli = mDatabase.getNbStimuli(set);
+
+        if (nbStimuli == 0) {
+            std::stringstream msg;
+            msg << "StimuliProvider::getRandomID(): no stimulus to draw in"
+                " the " << set << " set";
+
+            throw std::runtime_error(msg.str());
+        }
+
+        unsigned int index;
+
+#pragma omp critical(StimuliProvider__epoch)
+        {
+            std::pair<std::vector<unsigned int>, unsigned int>& epoch
+                = mEpochs[set];
+
+            // Start a new epoch
+            if (epoch.second >= epoch.first.size()
+                || epoch.first.size() != nbStimuli)
+            {
+                epoch.first = mDatabase.getEpochIndexes(set, mEpochShardSize,
+                                                        mEpochBufferSize);
+                epoch.second = 0;
+            }
+
+            index = epoch.first[epoch.second];
+            ++epoch.second;
+        }
+
+        return mDatabase.getStimulusID(set, index);
+    }
+
+    // Draw a label among the labels with stimuli in the set, then a stimulus
+    // of this label
+    const std::vector<std::vector<unsigned int> >& labelsIndexes
+        = mDatabase.getLabelsIndexes(set);
+    const std::vector<double>& labelsWeights = mLabelsWeights;
+    const std::vector<double>& cumWeights
+        = mDatabase.getLabelsCumulativeWeights(set, (mSampling == LabelWeighted)
+                                                ? labelsWeights
+                                                : std::vector<double>());
+    const double totalWeight = (!cumWeights.empty()) ? cumWeights.back()
+                                                     : 0.0;
+
+    if (!(totalWeight > 0.0)) {
+        std::stringstream msg;
+        msg << "StimuliProvider::getRandomID(): no labeled stimulus to draw"
+            " in the " << set << " set";
+
+        throw std::runtime_error(msg.str());
+    }
+
+    const unsigned int label = std::upper_bound(cumWeights.begin(),
+        cumWeights.end(),
+        Random::randUniform(0.0, totalWeight, Random::RightHalfOpenInterval))
+            - cumWeights.begin();
+    const std::vector<unsigned int>& labelIndexes
+        = labelsIndexes[std::min(label, (unsigned int)cumWeights.size() - 1)];
+
+    return mDatabase.getStimulusID(set,
+        labelIndexes[Random::randUniform(0, labelIndexes.size() - 1)]);
 }
 
 N2D2::Database::StimulusID
 N2D2::StimuliProvider::getRandomIDWithLabel(Database::StimuliSet set, int label)
 {
-    std::vector<Database::StimulusID> partitionWithLabel;
+    const std::vector<unsigned int>& labelIndexes
+        = mDatabase.getLabelIndexes(set, label);
 
-    for (unsigned int index = 0; index < mDatabase.getNbStimuli(set); ++index) {
-        if (mDatabase.getStimulusLabel(set, index) == label
-            || mDatabase.getNbROIsWithLabel(label) > 0)
-        {
-            partitionWithLabel.push_back(mDatabase.getStimulusID(set, index));
-        }
+    if (labelIndexes.empty()) {
+        std::stringstream msg;
+        msg << "StimuliProvider::getRandomIDWithLabel(): no stimulus with"
+            " label " << label << " in the " << set << " set";
+
+        throw std::runtime_error(msg.str());
     }
 
-    const unsigned int randomIdx
-        = Random::randUniform(0, partitionWithLabel.size() - 1);
-    return partitionWithLabel[randomIdx];
+    return mDatabase.getStimulusID(set,
+        labelIndexes[Random::randUniform(0, labelIndexes.size() - 1)]);
 }
 
 void N2D2::StimuliProvider::readRandomBatch(Database::StimuliSet set)
 {
+    if (isPrefetching(set)) {
+        readPrefetchedBatch();
+        return;
+    }
+
+    // Before the parallel loop, where the exception cannot propagate
+    checkPrefetchPaused("readRandomBatch");
+
     std::vector<int>& batchRef = (mFuture) ? mFutureBatch : mBatch;
 
     for (unsigned int batchPos = 0; batchPos < mBatchSize; ++batchPos)
         batchRef[batchPos] = getRandomID(set);
 
+    // Each stimulus uses its own random stream for the transformations,
+    // which does not depend on the thread scheduling
+    const unsigned int seed = Random::mtRand();
     unsigned int exceptCatch = 0;
 
 #pragma omp parallel for schedule(dynamic) if (mBatchSize > 1)
     for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos) {
         try {
+            Random::ThreadStream stream(seed, batchPos);
             readStimulus(batchRef[batchPos], set, batchPos);
         }
         catch (const std::exception& e)
@@ -667,8 +1112,10 @@ void N2D2::StimuliProvider::readRandomBatch(Database::StimuliSet set)
     if (exceptCatch > 0) {
         std::cout << "Retry without multi-threading..." << std::endl;
 
-        for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos)
+        for (int batchPos = 0; batchPos < (int)mBatchSize; ++batchPos) {
+            Random::ThreadStream stream(seed, batchPos);
             readStimulus(batchRef[batchPos], set, batchPos);
+        }
     }
 }
 
@@ -693,6 +1140,8 @@ void N2D2::StimuliProvider::readBatch(Database::StimuliSet set,
         throw std::runtime_error(msg.str());
     }
 
+    checkPrefetchPaused("readBatch");
+
     const unsigned int batchSize
         = std::min(mBatchSize, mDatabase.getNbStimuli(set) - startIndex);
     std::vector<int>& batchRef = (mFuture) ? mFutureBatch : mBatch;
@@ -701,9 +1150,13 @@ void N2D2::StimuliProvider::readBatch(Database::StimuliSet set,
         batchRef[batchPos]
             = mDatabase.getStimulusID(set, startIndex + batchPos);
 
+    const unsigned int seed = Random::mtRand();
+
 #pragma omp parallel for schedule(dynamic) if (batchSize > 1)
-    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos)
+    for (int batchPos = 0; batchPos < (int)batchSize; ++batchPos) {
+        Random::ThreadStream stream(seed, batchPos);
         readStimulus(batchRef[batchPos], set, batchPos);
+    }
 
     std::fill(batchRef.begin() + batchSize, batchRef.end(), -1);
 }
@@ -729,6 +1182,25 @@ void N2D2::StimuliProvider::readStimulusBatch(Database::StimulusID id,
 void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
                                          Database::StimuliSet set,
                                          unsigned int batchPos)
+{
+    checkPrefetchPaused("readStimulus");
+
+    readStimulusData(id, set, batchPos,
+                     (mFuture) ? mFutureData : mData,
+                     (mFuture) ? mFutureLabelsData : mLabelsData,
+                     (mFuture) ? mFutureTargetData : mTargetData,
+                     (mFuture) ? mFutureLabelsROI[batchPos]
+                               : mLabelsROI[batchPos]);
+}
+
+void N2D2::StimuliProvider::readStimulusData(
+    Database::StimulusID id,
+    Database::StimuliSet set,
+    unsigned int batchPos,
+    TensorData_T& dataRef,
+    Tensor<int>& labelsRef,
+    TensorData_T& targetDataRef,
+    std::vector<std::shared_ptr<ROI> >& labelsROI)
 {
     std::stringstream dataCacheFile, labelsCacheFile, validCacheFile;
     dataCacheFile << mCachePath << "/" << std::setfill('0') << std::setw(7)
@@ -738,19 +1210,62 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
     validCacheFile << mCachePath << "/" << std::setfill('0') << std::setw(7)
                     << id << "_" << set << ".valid";
 
-    std::vector<std::shared_ptr<ROI> >& labelsROI
-        = (mFuture) ? mFutureLabelsROI[batchPos] : mLabelsROI[batchPos];
+    // Profile of the stages and transformations for this stimulus, merged
+    // at the end into the profile of the current thread
+    TransformationsProfile stimulusProfile;
+    TransformationsProfile* profile = (mProfileTransformations)
+        ? &stimulusProfile : NULL;
+    std::chrono::high_resolution_clock::time_point stageTime
+        = std::chrono::high_resolution_clock::now();
+
+    auto profileStage = [&](const std::string& stage,
+                            const std::string& name,
+                            unsigned long long int nbBytes)
+    {
+        if (profile != NULL) {
+            const std::chrono::high_resolution_clock::time_point curTime
+                = std::chrono::high_resolution_clock::now();
+            profile->add(stage, name,
+                std::chrono::duration_cast<std::chrono::duration<double> >(
+                    curTime - stageTime).count(), nbBytes);
+            stageTime = curTime;
+        }
+    };
+
     labelsROI = mDatabase.getStimulusROIs(id);
 
     std::vector<cv::Mat> rawChannelsData;
     std::vector<cv::Mat> rawChannelsLabels;
 
+    // Keeps the packed cache records mapped while they are in use
+    std::shared_ptr<MemoryMappedFile> cacheMapping;
+    bool cached = false;
+
     // 1. Cached data
-    if (!mCachePath.empty() && std::ifstream(validCacheFile.str()).good()) {
+    if (!mCachePath.empty() && mPackedCache) {
+        cached = getStimuliCache()->load(id, set, rawChannelsData,
+                                         rawChannelsLabels, cacheMapping);
+
+        if (cached && !mTransformations(set).onTheFly.empty()) {
+            // The matrices are read-only views of the mapped cache, which
+            // may be modified in place by the on-the-fly transformations
+            rawChannelsData[0] = rawChannelsData[0].clone();
+            rawChannelsLabels[0] = rawChannelsLabels[0].clone();
+        }
+    }
+    else if (!mCachePath.empty()
+             && std::ifstream(validCacheFile.str()).good())
+    {
         // Cache present, load the pre-processed data
         rawChannelsData = loadDataCache(dataCacheFile.str());
         rawChannelsLabels = loadDataCache(labelsCacheFile.str());
-    } else {
+        cached = true;
+    }
+
+    if (cached)
+        profileStage("Load", "Cache", getNbBytes(rawChannelsData)
+                                      + getNbBytes(rawChannelsLabels));
+    else {
         // Cache not present, load the raw stimuli from the database
         cv::Mat rawData
             = mDatabase.getStimulusData(id)
@@ -759,9 +1274,15 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
             = mDatabase.getStimulusLabelsData(id)
                   .clone(); // make sure the database image will not be altered
 
+        profileStage("Load", "Database",
+                     getNbBytes(std::vector<cv::Mat>(1, rawData))
+                     + getNbBytes(std::vector<cv::Mat>(1, rawLabels)));
+
         // Apply global cacheable transformation
-        mTransformations(set)
-            .cacheable.apply(rawData, rawLabels, labelsROI, id);
+        applyTransformations(mTransformations(set).cacheable,
+                             mFuseTransformations,
+                             rawData, rawLabels, labelsROI, id,
+                             profile, "Cacheable");
 
         if (mTransformations(set).onTheFly.empty()
             && !mChannelsTransformations.empty()) {
@@ -774,7 +1295,11 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
                  ++it) {
                 cv::Mat channelData = rawData.clone();
                 cv::Mat channelLabels = rawLabels.clone();
-                (*it)(set).cacheable.apply(channelData, channelLabels, id);
+                std::vector<std::shared_ptr<ROI> > channelLabelsROI;
+                applyTransformations((*it)(set).cacheable, false,
+                                     channelData, channelLabels,
+                                     channelLabelsROI, id,
+                                     profile, "Cacheable");
                 rawChannelsData.push_back(channelData);
                 rawChannelsLabels.push_back(channelLabels);
             }
@@ -783,53 +1308,65 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
             rawChannelsLabels.push_back(rawLabels);
         }
 
+        profileStage("Cacheable", "*", getNbBytes(rawChannelsData)
+                                       + getNbBytes(rawChannelsLabels));
+
         // Save the pre-processed data
-        if (!mCachePath.empty()) {
+        if (!mCachePath.empty() && mPackedCache) {
+            getStimuliCache()->save(id, set, rawChannelsData,
+                                    rawChannelsLabels);
+        }
+        else if (!mCachePath.empty()) {
             saveDataCache(dataCacheFile.str(), rawChannelsData);
             saveDataCache(labelsCacheFile.str(), rawChannelsLabels);
             std::ofstream(validCacheFile.str());
         }
+
+        if (!mCachePath.empty()) {
+            profileStage("CacheSave", "*", getNbBytes(rawChannelsData)
+                                           + getNbBytes(rawChannelsLabels));
+        }
     }
 
     // 2. On-the-fly processing
-    if (!mTransformations(set).onTheFly.empty())
-        mTransformations(set).onTheFly.apply(
-            rawChannelsData[0], rawChannelsLabels[0], labelsROI, id);
-
-    Tensor<Float_T> data = (mChannelsTransformations.empty())
-                       ? Tensor<Float_T>(rawChannelsData[0], mDataSignedMapping)
-                       : Tensor<Float_T>(std::vector<size_t>(mSize.size(), 0));
-    Tensor<int> labels = (mChannelsTransformations.empty())
-                        ? Tensor<int>(rawChannelsLabels[0])
-                        : Tensor<int>(std::vector<size_t>(mSize.size(), 0));
-    Tensor<Float_T> targetData = (!mTargetSize.empty())
-        ? Tensor<Float_T>(mDatabase.getStimulusTargetData(id,
-                                                          rawChannelsData[0],
-                                                          rawChannelsLabels[0],
-                                                          labelsROI)
-            .clone(), mDataSignedMapping)  // make sure the database image will not be altered
-        : Tensor<Float_T>();
-
-    if (data.nbDims() < mSize.size()) {
-        // rawChannelsData[0] can be 2D or 3D
-        std::vector<size_t> dataSize(data.dims());
-        dataSize.resize(mSize.size(), 1);
-        data.reshape(dataSize);
+    if (!mTransformations(set).onTheFly.empty()) {
+        applyTransformations(mTransformations(set).onTheFly,
+                             mFuseTransformations,
+                             rawChannelsData[0], rawChannelsLabels[0],
+                             labelsROI, id, profile, "OnTheFly");
+
+        profileStage("OnTheFly", "*",
+                     getNbBytes(std::vector<cv::Mat>(1, rawChannelsData[0]))
+                     + getNbBytes(std::vector<cv::Mat>(1,
+                                                       rawChannelsLabels[0])));
     }
 
-    if (labels.nbDims() < mSize.size()) {
-        std::vector<size_t> labelsSize(labels.dims());
-        labelsSize.resize(mSize.size(), 1);
-        labels.reshape(labelsSize);
-    }
+    // Dimensions of the tensor converted from a cv::Mat, with at least
+    // nbDims dimensions (rawChannelsData[0] can be 2D or 3D)
+    auto matDims = [](const cv::Mat& mat, size_t nbDims)
+    {
+        std::vector<size_t> dims;
+        dims.push_back(mat.cols);
+        dims.push_back(mat.rows);
 
-    if (targetData.nbDims() < mTargetSize.size()) {
-        std::vector<size_t> targetDataSize(targetData.dims());
-        targetDataSize.resize(mTargetSize.size(), 1);
-        targetData.reshape(targetDataSize);
-    }
+        if (mat.channels() > 1)
+            dims.push_back(mat.channels());
+
+        if (dims.size() < nbDims)
+            dims.resize(nbDims, 1);
+
+        return dims;
+    };
+
+    const cv::Mat targetDataMat = (!mTargetSize.empty())
+        ? mDatabase.getStimulusTargetData(id, rawChannelsData[0],
+                                          rawChannelsLabels[0], labelsROI)
+        : cv::Mat();
 
     // 2.1 Process channels
+    std::vector<cv::Mat> channelsData;
+    std::vector<cv::Mat> channelsLabels;
+
     if (!mChannelsTransformations.empty()) {
         for (std::vector<TransformationsSets>::iterator it
              = mChannelsTransformations.begin(),
@@ -837,104 +1374,221 @@ void N2D2::StimuliProvider::readStimulus(Database::StimulusID id,
              itEnd = mChannelsTransformations.end();
              it != itEnd;
              ++it) {
-            cv::Mat channelDataMat((rawChannelsData.size() > 1)
-                                    ? rawChannelsData[it - itBegin].clone()
-                                    : rawChannelsData[0].clone());
-            cv::Mat channelLabelsMat
-                = ((rawChannelsLabels.size() > 1)
-                       ? rawChannelsLabels[it - itBegin].clone()
-                       : rawChannelsLabels[0].clone());
-
-            if (!mTransformations(set).onTheFly.empty())
-                (*it)(set).cacheable.apply(channelDataMat, channelLabelsMat, id);
-
-            (*it)(set).onTheFly.apply(channelDataMat, channelLabelsMat, id);
-
-            Tensor<Float_T> channelData(channelDataMat, mDataSignedMapping);
-            Tensor<int> channelLabels(channelLabelsMat);
-
-            if (channelData.nbDims() < mSize.size() - 1) {
-                std::vector<size_t> dataSize(channelData.dims());
-                dataSize.resize(mSize.size() - 1, 1);
-                channelData.reshape(dataSize);
+            const bool perChannel = (rawChannelsData.size() > 1);
+            const unsigned int channel = (perChannel) ? (it - itBegin) : 0;
+
+            // The raw data can be transformed in place, without clone, if it
+            // is not a view of the mapped cache and if it is not shared with
+            // the next channels or the target data
+            const bool inPlace = (!cacheMapping
+                && (perChannel || (it + 1 == itEnd && targetDataMat.empty())));
+
+            cv::Mat channelDataMat = (inPlace)
+                ? rawChannelsData[channel]
+                : rawChannelsData[channel].clone();
+            cv::Mat channelLabelsMat = (inPlace)
+                ? rawChannelsLabels[channel]
+                : rawChannelsLabels[channel].clone();
+
+            std::vector<std::shared_ptr<ROI> > channelLabelsROI;
+
+            if (!mTransformations(set).onTheFly.empty()) {
+                applyTransformations((*it)(set).cacheable, false,
+                                     channelDataMat, channelLabelsMat,
+                                     channelLabelsROI, id,
+                                     profile, "Channels");
             }
 
-            if (channelLabels.nbDims() < mSize.size() - 1) {
-                std::vector<size_t> labelsSize(channelLabels.dims());
-                labelsSize.resize(mSize.size() - 1, 1);
-                channelLabels.reshape(labelsSize);
-            }
+            applyTransformations((*it)(set).onTheFly, false,
+                                 channelDataMat, channelLabelsMat,
+                                 channelLabelsROI, id, profile, "Channels");
 
-            data.push_back(channelData);
-            labels.push_back(channelLabels);
+            channelsData.push_back(channelDataMat);
+            channelsLabels.push_back(channelLabelsMat);
         }
-    }
 
-    TensorData_T& dataRef = (mFuture) ? mFutureData : mData;
-    Tensor<int>& labelsRef = (mFuture) ? mFutureLabelsData : mLabelsData;
-    TensorData_T& targetDataRef = (mFuture) ? mFutureTargetData : mTargetData;
+        profileStage("Channels", "*", getNbBytes(channelsData)
+                                      + getNbBytes(channelsLabels));
+    }
+    else {
+        channelsData.push_back(rawChannelsData[0]);
+        channelsLabels.push_back(rawChannelsLabels[0]);
+    }
 
     if (mBatchSize > 0) {
+        // Convert the transformed data directly into its batch slot: the
+        // float conversion and the signed mapping are fused into this write
         TensorData_T dataRefPos = dataRef[batchPos];
         Tensor<int> labelsRefPos = labelsRef[batchPos];
 
-        if (data.dims() != dataRefPos.dims()) {
-            std::stringstream msg;
-            msg << "StimuliProvider::readStimulus(): expected data size is "
-                << dataRefPos.dims() << ", but size after transformations is "
-                << data.dims() << " for stimulus: "
-                << mDatabase.getStimulusName(id);
+        for (unsigned int channel = 0; channel < channelsData.size();
+            ++channel)
+        {
+            std::vector<size_t> dataSize;
+            std::vector<size_t> labelsSize;
+
+            if (mChannelsTransformations.empty()) {
+                dataSize = matDims(channelsData[channel], mSize.size());
+                labelsSize = matDims(channelsLabels[channel], mSize.size());
+            }
+            else {
+                dataSize = matDims(channelsData[channel], mSize.size() - 1);
+                dataSize.push_back(channelsData.size());
+                labelsSize = matDims(channelsLabels[channel],
+                                     mSize.size() - 1);
+                labelsSize.push_back(channelsLabels.size());
+            }
+
+            if (dataSize != dataRefPos.dims()) {
+                std::stringstream msg;
+                msg << "StimuliProvider::readStimulus(): expected data size is "
+                    << dataRefPos.dims() << ", but size after transformations "
+                    "is " << dataSize << " for stimulus: "
+                    << mDatabase.getStimulusName(id);
 
 #pragma omp critical
-            throw std::runtime_error(msg.str());
+                throw std::runtime_error(msg.str());
+            }
+
+            if (labelsSize != labelsRefPos.dims()) {
+                std::stringstream msg;
+                msg << "StimuliProvider::readStimulus(): expected labels size "
+                    "is " << labelsRefPos.dims() << ", but size after "
+                    "transformations is " << labelsSize << " for stimulus: "
+                    << mDatabase.getStimulusName(id);
+
+#pragma omp critical
+                throw std::runtime_error(msg.str());
+            }
+
+            if (mChannelsTransformations.empty()) {
+                dataRefPos.convertFrom(channelsData[channel],
+                                       mDataSignedMapping);
+                labelsRefPos.convertFrom(channelsLabels[channel]);
+            }
+            else {
+                Tensor<Float_T> dataRefChannel = dataRefPos[channel];
+                Tensor<int> labelsRefChannel = labelsRefPos[channel];
+
+                dataRefChannel.convertFrom(channelsData[channel],
+                                           mDataSignedMapping);
+                labelsRefChannel.convertFrom(channelsLabels[channel]);
+            }
         }
 
         if (mQuantizationLevels > 0) {
-            quantize(data,
-                     data,
+            quantize(dataRefPos,
+                     dataRefPos,
                      (Float_T)mQuantizationMin,
                      (Float_T)mQuantizationMax,
                      mQuantizationLevels,
                      true);
         }
 
-        dataRefPos = data;
-
-        if (labels.dims() != labelsRefPos.dims()) {
-            std::stringstream msg;
-            msg << "StimuliProvider::readStimulus(): expected labels size is "
-                << labelsRefPos.dims() << ", but size after transformations is "
-                << labels.dims() << " for stimulus: "
-                << mDatabase.getStimulusName(id);
-
-#pragma omp critical
-            throw std::runtime_error(msg.str());
-        }
-
-        labelsRefPos = labels;
-
         if (!targetDataRef.empty()) {
             TensorData_T targetDataRefPos = targetDataRef[batchPos];
+            const std::vector<size_t> targetDataSize
+                = matDims(targetDataMat, mTargetSize.size());
 
-            if (targetData.dims() != targetDataRefPos.dims()) {
+            if (targetDataSize != targetDataRefPos.dims()) {
                 std::stringstream msg;
                 msg << "StimuliProvider::readStimulus(): expected target data "
                     "size is " << targetDataRefPos.dims() << ", but size is "
-                    << targetData.dims() << " for stimulus: "
+                    << targetDataSize << " for stimulus: "
                     << mDatabase.getStimulusName(id);
 
 #pragma omp critical
                 throw std::runtime_error(msg.str());
             }
 
-            targetDataRefPos = targetData;
+            targetDataRefPos.convertFrom(targetDataMat, mDataSignedMapping);
         }
+
+        profileStage("Tensor", "BatchWrite",
+                     (dataRefPos.size() + ((!targetDataRef.empty())
+                        ? targetDataMat.total() * targetDataMat.channels()
+                        : 0)) * sizeof(Float_T)
+                     + labelsRefPos.size() * sizeof(int));
     } else {
+        Tensor<Float_T> data = (mChannelsTransformations.empty())
+            ? Tensor<Float_T>(channelsData[0], mDataSignedMapping)
+            : Tensor<Float_T>(std::vector<size_t>(mSize.size(), 0));
+        Tensor<int> labels = (mChannelsTransformations.empty())
+            ? Tensor<int>(channelsLabels[0])
+            : Tensor<int>(std::vector<size_t>(mSize.size(), 0));
+
+        if (mChannelsTransformations.empty()) {
+            data.reshape(matDims(channelsData[0], mSize.size()));
+            labels.reshape(matDims(channelsLabels[0], mSize.size()));
+        }
+        else {
+            for (unsigned int channel = 0; channel < channelsData.size();
+                ++channel)
+            {
+                Tensor<Float_T> channelData(channelsData[channel],
+                                            mDataSignedMapping);
+                Tensor<int> channelLabels(channelsLabels[channel]);
+
+                channelData.reshape(matDims(channelsData[channel],
+                                            mSize.size() - 1));
+                channelLabels.reshape(matDims(channelsLabels[channel],
+                                              mSize.size() - 1));
+
+                data.push_back(channelData);
+                labels.push_back(channelLabels);
+            }
+        }
+
         dataRef.clear();
         dataRef.push_back(data);
         labelsRef.clear();
         labelsRef.push_back(labels);
+
+        profileStage("Tensor", "Conversion",
+                     data.size() * sizeof(Float_T)
+                     + labels.size() * sizeof(int));
+    }
+
+    if (profile != NULL) {
+#pragma omp critical(StimuliProvider__profile)
+        mProfiles[std::this_thread::get_id()].merge(*profile);
+    }
+}
+
+void N2D2::StimuliProvider::applyTransformations(
+    CompositeTransformation& transformations,
+    bool fused,
+    cv::Mat& frame,
+    cv::Mat& labels,
+    std::vector<std::shared_ptr<ROI> >& labelsROI,
+    int id,
+    TransformationsProfile* profile,
+    const std::string& stage) const
+{
+    if (fused) {
+        transformations.applyFused(frame, labels, labelsROI, id,
+                                   profile, stage);
+    }
+    else if (profile != NULL) {
+        transformations.apply(frame, labels, labelsROI, id,
+                              *profile, stage);
     }
+    else
+        transformations.apply(frame, labels, labelsROI, id);
+}
+
+unsigned long long int N2D2::StimuliProvider::getNbBytes(
+    const std::vector<cv::Mat>& mats)
+{
+    unsigned long long int nbBytes = 0;
+
+    for (std::vector<cv::Mat>::const_iterator it = mats.begin(),
+         itEnd = mats.end(); it != itEnd; ++it)
+    {
+        nbBytes += (*it).total() * (*it).elemSize();
+    }
+
+    return nbBytes;
 }
 
 N2D2::Database::StimulusID N2D2::StimuliProvider::readStimulusBatch(
@@ -1818,3 +2472,45 @@ void N2D2::StimuliProvider::saveDataCache(const std::string& fileName,
          ++it)
         BinaryCvMat::write(os, *it);
 }
+
+std::shared_ptr<N2D2::StimuliCache> N2D2::StimuliProvider::getStimuliCache()
+{
+    std::shared_ptr<StimuliCache> cache;
+
+#pragma omp critical(StimuliProvider__getStimuliCache)
+    {
+        if (!mStimuliCache || mStimuliCache->getPath() != mCachePath)
+            mStimuliCache = StimuliCache::open(mCachePath);
+
+        cache = mStimuliCache;
+    }
+
+    return cache;
+}
+
+void N2D2::StimuliProvider::updateDecodeMinSize()
+{
+    // The stimuli are decoded once for all the sets: the minimum size is the
+    // largest one needed by the cacheable transformations of the sets
+    const Database::StimuliSet sets[] = {Database::Learn,
+                                         Database::Validation,
+                                         Database::Test};
+    cv::Size minSize(0, 0);
+
+    for (unsigned int i = 0; i < sizeof(sets) / sizeof(sets[0]); ++i) {
+        unsigned int width, height;
+        std::tie(width, height)
+            = mTransformations(sets[i]).cacheable.getMinInputsSize();
+
+        if (width == 0 || height == 0) {
+            // Full resolution needed
+            minSize = cv::Size(0, 0);
+            break;
+        }
+
+        minSize.width = std::max(minSize.width, (int)width);
+        minSize.height = std::max(minSize.height, (int)height);
+    }
+
+    mDatabase.setDecodeMinSize(minSize);
+}
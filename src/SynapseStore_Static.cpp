@@ -0,0 +1,144 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "SynapseStore_Static.hpp"
+
+N2D2::SynapseStore_Static::SynapseStore_Static(bool bipolar, bool stats)
+    : mBipolar(bipolar), mStats(stats)
+{
+    // ctor
+}
+
+void N2D2::SynapseStore_Static::reserve(size_t size)
+{
+    mWeights.reserve(size);
+
+    if (mStats)
+        mReadEvents.reserve(size);
+}
+
+void N2D2::SynapseStore_Static::push_back(const Synapse_Static& synapse)
+{
+    if (synapse.bipolar != mBipolar) {
+        throw std::domain_error("SynapseStore_Static::push_back(): the synapse"
+                                " bipolarity does not match the store one");
+    }
+
+    if (synapse.delay > 0 || !mDelays.empty()) {
+        // The delays of the previous synapses are all 0 on the first delay
+        mDelays.resize(mWeights.size(), 0);
+        mDelays.push_back(synapse.delay);
+    }
+
+    mWeights.push_back(synapse.weight);
+
+    if (mStats)
+        mReadEvents.push_back(synapse.statsReadEvents);
+}
+
+N2D2::Time_T N2D2::SynapseStore_Static::getMinDelay() const
+{
+    return (mDelays.empty())
+        ? 0 : *std::min_element(mDelays.begin(), mDelays.end());
+}
+
+void N2D2::SynapseStore_Static::clear()
+{
+    mWeights.clear();
+    mDelays.clear();
+    mReadEvents.clear();
+}
+
+void N2D2::SynapseStore_Static::setRelativeWeight(size_t index,
+                                                  double relWeight)
+{
+    if (Synapse_Static::getCheckWeightRange()
+        && (((mBipolar && relWeight < -1.0) || (!mBipolar && relWeight < 0.0))
+            || relWeight > 1.0))
+    {
+        std::ostringstream msgStr;
+        msgStr << "Relative weight (" << relWeight << ") is out of range"
+            " (must be in [0,1] or [-1,1] range)";
+
+        throw std::domain_error(msgStr.str());
+    }
+
+    mWeights[index] = relWeight;
+}
+
+void N2D2::SynapseStore_Static::save(std::ofstream& dataFile) const
+{
+    for (size_t index = 0, size = mWeights.size(); index < size; ++index) {
+        const Time_T delay = getDelay(index);
+
+        dataFile.write(reinterpret_cast<const char*>(&delay), sizeof(delay));
+        dataFile.write(reinterpret_cast<const char*>(&mWeights[index]),
+                       sizeof(mWeights[index]));
+    }
+
+    if (!dataFile.good())
+        throw std::runtime_error(
+            "SynapseStore_Static::save(): error writing data");
+}
+
+void N2D2::SynapseStore_Static::load(std::ifstream& dataFile)
+{
+    for (size_t index = 0, size = mWeights.size(); index < size; ++index) {
+        Time_T delay;
+
+        dataFile.read(reinterpret_cast<char*>(&delay), sizeof(delay));
+        dataFile.read(reinterpret_cast<char*>(&mWeights[index]),
+                      sizeof(mWeights[index]));
+
+        if (delay > 0 && mDelays.empty())
+            mDelays.resize(mWeights.size(), 0);
+
+        if (!mDelays.empty())
+            mDelays[index] = delay;
+    }
+
+    if (!dataFile.good())
+        throw std::runtime_error(
+            "SynapseStore_Static::load(): error reading data");
+}
+
+void N2D2::SynapseStore_Static::getStats(size_t index,
+                                         Synapse::Stats* statsObj) const
+{
+    const unsigned long long int readEvents = (mStats) ? mReadEvents[index]
+                                                       : 0;
+
+    ++statsObj->nbSynapses;
+    statsObj->readEvents += readEvents;
+    statsObj->maxReadEvents = std::max(statsObj->maxReadEvents, readEvents);
+}
+
+void N2D2::SynapseStore_Static::logStats(size_t index,
+                                         std::ofstream& dataFile,
+                                         const std::string& suffix) const
+{
+    dataFile << "R " << ((mStats) ? mReadEvents[index] : 0) << " " << suffix
+             << "\n";
+}
+
+void N2D2::SynapseStore_Static::clearStats()
+{
+    std::fill(mReadEvents.begin(), mReadEvents.end(), 0);
+}
@@ -20,8 +20,102 @@
 
 #include "Transformation/CompositeTransformation.hpp"
 
+#include <chrono>
+
+namespace {
+    unsigned long long int getNbBytes(const cv::Mat& frame,
+                                      const cv::Mat& labels)
+    {
+        return frame.total() * frame.elemSize()
+            + labels.total() * labels.elemSize();
+    }
+
+    double getElapsedTime(
+        const std::chrono::high_resolution_clock::time_point& startTime)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<double> >(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+    }
+}
+
 const char* N2D2::CompositeTransformation::Type = "Composite";
 
+void N2D2::CompositeTransformation::apply(cv::Mat& frame,
+                                          cv::Mat& labels,
+                                          std::vector
+                                          <std::shared_ptr<ROI> >& labelsROI,
+                                          int id,
+                                          TransformationsProfile& profile,
+                                          const std::string& stage)
+{
+    for (std::vector<std::shared_ptr<Transformation> >::const_iterator it
+         = mTransformationSet.begin(),
+         itEnd = mTransformationSet.end();
+         it != itEnd;
+         ++it)
+    {
+        const unsigned long long int nbBytes = getNbBytes(frame, labels);
+        const std::chrono::high_resolution_clock::time_point startTime
+            = std::chrono::high_resolution_clock::now();
+
+        (*it)->apply(frame, labels, labelsROI, id);
+
+        profile.add(stage, (*it)->getType(), getElapsedTime(startTime),
+                    nbBytes);
+    }
+}
+
+void N2D2::CompositeTransformation::applyFused(cv::Mat& frame,
+                                               cv::Mat& labels,
+                                               std::vector
+                                               <std::shared_ptr<ROI> >&
+                                                    labelsROI,
+                                               int id,
+                                               TransformationsProfile* profile,
+                                               const std::string& stage)
+{
+    unsigned int k = 0;
+
+    while (k < mTransformationSet.size()) {
+        const unsigned long long int nbBytes
+            = (profile != NULL) ? getNbBytes(frame, labels) : 0;
+        const std::chrono::high_resolution_clock::time_point startTime
+            = std::chrono::high_resolution_clock::now();
+
+        const unsigned int nbWarps = getNbFusableWarps(k, frame, labels);
+        unsigned int nbFused = 1;
+
+        // A single warp is left to the transformation itself
+        if (nbWarps > 1) {
+            applyWarps(k, nbWarps, frame, labels, labelsROI);
+            nbFused = nbWarps;
+        }
+        else {
+            const unsigned int nbPointWise = getNbFusablePointWise(k, frame);
+
+            if (nbPointWise > 0) {
+                applyPointWise(k, nbPointWise, frame, id);
+                nbFused = nbPointWise;
+            }
+            else
+                mTransformationSet[k]->apply(frame, labels, labelsROI, id);
+        }
+
+        if (profile != NULL) {
+            // A fused run is named after its transformations, e.g.
+            // "Rescale+Flip"
+            std::string name = mTransformationSet[k]->getType();
+
+            for (unsigned int i = k + 1; i < k + nbFused; ++i)
+                name += std::string("+") + mTransformationSet[i]->getType();
+
+            profile->add(stage, name, getElapsedTime(startTime), nbBytes);
+        }
+
+        k += nbFused;
+    }
+}
+
 std::pair<unsigned int, unsigned int>
 N2D2::CompositeTransformation::getOutputsSize(unsigned int width,
                                               unsigned int height) const
@@ -38,6 +132,15 @@ N2D2::CompositeTransformation::getOutputsSize(unsigned int width,
     return std::make_pair(width, height);
 }
 
+std::pair<unsigned int, unsigned int>
+N2D2::CompositeTransformation::getMinInputsSize() const
+{
+    // Only the first transformation sees the input
+    return (!mTransformationSet.empty())
+        ? mTransformationSet.front()->getMinInputsSize()
+        : std::make_pair(0U, 0U);
+}
+
 int N2D2::CompositeTransformation::getOutputsDepth(int depth) const
 {
     for (std::vector<std::shared_ptr<Transformation> >::const_iterator it
@@ -64,3 +167,198 @@ void N2D2::CompositeTransformation::iterTransformations(
         func(*(*it));
     }
 }
+
+unsigned int
+N2D2::CompositeTransformation::getNbFusableWarps(unsigned int first,
+                                                 const cv::Mat& frame,
+                                                 const cv::Mat& labels) const
+{
+    // Frame types supported by cv::warpAffine()
+    const int depth = frame.depth();
+
+    if (frame.empty() || frame.channels() > 4
+        || (depth != CV_8U && depth != CV_16U && depth != CV_16S
+            && depth != CV_32F && depth != CV_64F))
+    {
+        return 0;
+    }
+
+    // The labels are warped with the frame
+    if ((labels.rows > 1 || labels.cols > 1)
+        && (labels.rows != frame.rows || labels.cols != frame.cols
+            || labels.type() != CV_32SC1))
+    {
+        return 0;
+    }
+
+    // A single border per warp
+    bool border = false;
+    unsigned int k = first;
+
+    for (; k < mTransformationSet.size(); ++k) {
+        if (!mTransformationSet[k]->isAffineWarp())
+            break;
+
+        int borderType;
+        cv::Scalar borderValue;
+
+        if (mTransformationSet[k]->getWarpBorder(borderType, borderValue)) {
+            if (border)
+                break;
+
+            border = true;
+        }
+    }
+
+    return (k - first);
+}
+
+unsigned int N2D2::CompositeTransformation::getNbFusablePointWise(
+    unsigned int first,
+    const cv::Mat& frame) const
+{
+    // Look-up tables only apply to 8 bits frames
+    if (frame.empty() || frame.depth() != CV_8U)
+        return 0;
+
+    unsigned int k = first;
+
+    for (; k < mTransformationSet.size(); ++k) {
+        if (!mTransformationSet[k]->isPointWise())
+            break;
+    }
+
+    return (k - first);
+}
+
+void N2D2::CompositeTransformation::applyWarps(unsigned int first,
+                                               unsigned int nbWarps,
+                                               cv::Mat& frame,
+                                               cv::Mat& labels,
+                                               std::vector
+                                               <std::shared_ptr<ROI> >&
+                                                    labelsROI)
+{
+    // Without padding, the borders are replicated, as with cv::resize()
+    int borderType = cv::BORDER_REPLICATE;
+    cv::Scalar borderValue;
+    bool border = false;
+
+    cv::Size size(frame.cols, frame.rows);
+    bool empty = false;
+
+    // Compose the 2x3 warps, starting from identity
+    double m[6] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0};
+
+    for (unsigned int k = first; k < first + nbWarps; ++k) {
+        if (mTransformationSet[k]->getWarpBorder(borderType, borderValue))
+            border = true;
+
+        const cv::Mat warp
+            = mTransformationSet[k]->getAffineWarp(size, labelsROI);
+        const double* w0 = warp.ptr<double>(0);
+        const double* w1 = warp.ptr<double>(1);
+
+        const double c[6] = {
+            w0[0] * m[0] + w0[1] * m[3],
+            w0[0] * m[1] + w0[1] * m[4],
+            w0[0] * m[2] + w0[1] * m[5] + w0[2],
+            w1[0] * m[0] + w1[1] * m[3],
+            w1[0] * m[1] + w1[1] * m[4],
+            w1[0] * m[2] + w1[1] * m[5] + w1[2]};
+        std::copy(c, c + 6, m);
+
+        if (size.width <= 0 || size.height <= 0)
+            empty = true;
+    }
+
+    const bool warpLabels = (labels.rows > 1 || labels.cols > 1);
+
+    if (empty) {
+        frame = cv::Mat();
+
+        if (warpLabels)
+            labels = cv::Mat();
+
+        return;
+    }
+
+    cv::Mat matrix(2, 3, CV_64F);
+    std::copy(m, m + 6, matrix.ptr<double>(0));
+
+    cv::Mat frameWarped;
+    cv::warpAffine(frame, frameWarped, matrix, size, cv::INTER_LINEAR,
+                   borderType, borderValue);
+    frame = frameWarped;
+
+    if (!warpLabels)
+        return;
+
+    // Nearest neighbor, with the inverse mapping. The padded labels are -1.
+    const double det = m[0] * m[4] - m[1] * m[3];
+    const double inv[6] = {
+        m[4] / det, -m[1] / det, (m[1] * m[5] - m[4] * m[2]) / det,
+        -m[3] / det, m[0] / det, (m[3] * m[2] - m[0] * m[5]) / det};
+
+    cv::Mat labelsWarped(size, CV_32SC1);
+
+    for (int y = 0; y < size.height; ++y) {
+        int* rowPtr = labelsWarped.ptr<int>(y);
+
+        for (int x = 0; x < size.width; ++x) {
+            int srcX = (int)std::floor(inv[0] * x + inv[1] * y + inv[2] + 0.5);
+            int srcY = (int)std::floor(inv[3] * x + inv[4] * y + inv[5] + 0.5);
+
+            if (srcX < 0 || srcX >= labels.cols
+                || srcY < 0 || srcY >= labels.rows)
+            {
+                if (border) {
+                    rowPtr[x] = -1;
+                    continue;
+                }
+
+                srcX = std::max(0, std::min(labels.cols - 1, srcX));
+                srcY = std::max(0, std::min(labels.rows - 1, srcY));
+            }
+
+            rowPtr[x] = labels.at<int>(srcY, srcX);
+        }
+    }
+
+    labels = labelsWarped;
+}
+
+void N2D2::CompositeTransformation::applyPointWise(unsigned int first,
+                                                   unsigned int nbPointWise,
+                                                   cv::Mat& frame,
+                                                   int id)
+{
+    // The look-up table is obtained by applying the transformations to a
+    // ramp of all the 8 bits values, which samples the random parameters
+    // once, as for the frame
+    const int nbChannels = frame.channels();
+    cv::Mat lut(1, 256, CV_MAKETYPE(frame.depth(), nbChannels));
+    unsigned char* lutPtr = lut.ptr<unsigned char>(0);
+
+    for (int value = 0; value < 256; ++value) {
+        for (int ch = 0; ch < nbChannels; ++ch)
+            lutPtr[value * nbChannels + ch] = value;
+    }
+
+    cv::Mat emptyLabels;
+    std::vector<std::shared_ptr<ROI> > emptyLabelsROI;
+
+    for (unsigned int k = first; k < first + nbPointWise; ++k)
+        mTransformationSet[k]->apply(lut, emptyLabels, emptyLabelsROI, id);
+
+    if (lut.rows != 1 || lut.cols != 256
+        || (lut.channels() != 1 && lut.channels() != nbChannels))
+    {
+        throw std::runtime_error("CompositeTransformation::applyPointWise(): "
+                                 "the transformations are not point-wise");
+    }
+
+    cv::Mat frameLut;
+    cv::LUT(frame, (lut.isContinuous()) ? lut : lut.clone(), frameLut);
+    frame = frameLut;
+}
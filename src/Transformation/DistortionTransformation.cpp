@@ -28,7 +28,8 @@ N2D2::DistortionTransformation::DistortionTransformation()
       mElasticScaling(this, "ElasticScaling", 0.0),
       mScaling(this, "Scaling", 0.0),
       mRotation(this, "Rotation", 0.0),
-      mIgnoreMissingData(this, "IgnoreMissingData", true)
+      mIgnoreMissingData(this, "IgnoreMissingData", true),
+      mElasticFieldsPool(this, "ElasticFieldsPool", 0U)
 {
     // ctor
 }
@@ -41,7 +42,8 @@ N2D2::DistortionTransformation::DistortionTransformation(
       mElasticScaling(this, "ElasticScaling", trans.mElasticScaling),
       mScaling(this, "Scaling", trans.mScaling),
       mRotation(this, "Rotation", trans.mRotation),
-      mIgnoreMissingData(this, "IgnoreMissingData", trans.mIgnoreMissingData)
+      mIgnoreMissingData(this, "IgnoreMissingData", trans.mIgnoreMissingData),
+      mElasticFieldsPool(this, "ElasticFieldsPool", trans.mElasticFieldsPool)
 {
     // copy-ctor
 }
@@ -55,36 +57,21 @@ N2D2::DistortionTransformation::apply(cv::Mat& frame,
 {
     const unsigned int sizeX = frame.cols;
     const unsigned int sizeY = frame.rows;
-    // const unsigned int size = sizeX*sizeY;
-    const unsigned int gaussianSizeX = mElasticGaussianSize;
-    const unsigned int gaussianSizeY = mElasticGaussianSize;
 
-    // Elastic scaling init
-    Matrix<double> uniformX;
-    Matrix<double> uniformY;
+    DistortionMap_T distortionMap;
+    distortionMap.first.resize(sizeY, sizeX, 0.0f);
+    distortionMap.second.resize(sizeY, sizeX, 0.0f);
 
+    // Elastic scaling init
     if (mElasticScaling > 0.0) {
-        uniformX.resize(sizeY, sizeX);
-        uniformY.resize(sizeY, sizeX);
-
-        for (unsigned int index = 0, size = uniformX.size(); index < size;
-             ++index) {
-            uniformX(index) = Random::randUniform(-1.0, 1.0);
-            uniformY(index) = Random::randUniform(-1.0, 1.0);
-        }
-
-        if (mKernel.empty()) {
-#pragma omp critical(DistortionTransformation__apply)
-            if (mKernel.empty())
-                mKernel = GaussianKernel
-                    <double>(gaussianSizeX, gaussianSizeY, mElasticSigma);
-        }
+        if (mElasticFieldsPool > 0)
+            getPooledElasticField(distortionMap);
+        else
+            getElasticField(distortionMap);
     }
 
     const int centerX = sizeX / 2;
     const int centerY = sizeY / 2;
-    const int kCenterX = gaussianSizeX / 2;
-    const int kCenterY = gaussianSizeY / 2;
 
     // Scaling init
     const double scaleX = (mScaling / 100.0) * Random::randUniform(-1.0, 1.0);
@@ -96,63 +83,32 @@ N2D2::DistortionTransformation::apply(cv::Mat& frame,
     const double rotateCos = std::cos(rotate);
     const double rotateSin = std::sin(rotate);
 
-    Matrix<double> dispX(sizeY, sizeX);
-    Matrix<double> dispY(sizeY, sizeX);
-    /*
-    #if defined(_OPENMP) && _OPENMP >= 200805
-        #pragma omp parallel for collapse(2) if (size > 256)
-    #else
-        #pragma omp parallel for if (sizeY > 16 && size > 256)
-    #endif
-    */
+    const double elasticScaling = mElasticScaling;
+    const double scaling = mScaling;
+    const double rotation = mRotation;
+    Matrix<float>& dispX = distortionMap.first;
+    Matrix<float>& dispY = distortionMap.second;
+
+#pragma omp parallel for if (sizeY > 16 && sizeX * sizeY > 256)
     for (int y = 0; y < (int)sizeY; ++y) { // rows
         for (unsigned int x = 0; x < sizeX; ++x) { // columns
             // Elastic scaling
             double vX = 0.0;
             double vY = 0.0;
 
-            if (mElasticScaling > 0.0) {
-                for (unsigned int kx = 0; kx < gaussianSizeX;
-                     ++kx) { // kernel columns
-                    const unsigned int fkx
-                        = gaussianSizeX - 1
-                          - (int)kx; // column index of flipped kernel
-
-                    assert(fkx < gaussianSizeX);
-
-                    for (unsigned int ky = 0; ky < gaussianSizeY;
-                         ++ky) { // kernel rows
-                        const unsigned int fky
-                            = gaussianSizeY - 1
-                              - (int)ky; // row index of flipped kernel
-
-                        assert(fky < gaussianSizeY);
-
-                        // index of input signal, used for checking boundary
-                        const int mx = x + (kx - kCenterX);
-                        const int my = y + (ky - kCenterY);
-
-                        // ignore input samples which are out of bound
-                        if (mx >= 0 && mx < (int)sizeX && my >= 0
-                            && my < (int)sizeY) {
-                            vX += uniformX(my, mx) * mKernel(fky, fkx);
-                            vY += uniformY(my, mx) * mKernel(fky, fkx);
-                        }
-                    }
-                }
-
-                vX *= mElasticScaling;
-                vY *= mElasticScaling;
+            if (elasticScaling > 0.0) {
+                vX = elasticScaling * dispX(y, x);
+                vY = elasticScaling * dispY(y, x);
             }
 
             // Scaling
-            if (mScaling > 0.0) {
+            if (scaling > 0.0) {
                 vX += scaleX * ((int)x - centerX);
                 vY += scaleY * ((int)y - centerY);
             }
 
             // Rotation
-            if (mRotation > 0.0) {
+            if (rotation > 0.0) {
                 vX += ((int)x - centerX) * (rotateCos - 1.0)
                       + ((int)y - centerY) * rotateSin;
                 vY += ((int)y - centerY) * (rotateCos - 1.0)
@@ -164,14 +120,186 @@ N2D2::DistortionTransformation::apply(cv::Mat& frame,
         }
     }
 
-    const DistortionMap_T distortionMap = std::make_pair(dispX, dispY);
-
     applyDistortion(frame, distortionMap, false);
 
     if (labels.rows > 1 || labels.cols > 1)
         applyDistortion(labels, distortionMap, true);
 }
 
+void N2D2::DistortionTransformation::getElasticField(DistortionMap_T& field)
+    const
+{
+    // Uniform random field, drawn from a local stream to avoid the
+    // synchronization on the global generator for each value
+    Random::Stream stream(Random::mtRand());
+    stream.fillUniform(field.first.begin(), field.first.end(), -1.0, 1.0);
+    stream.fillUniform(field.second.begin(), field.second.end(), -1.0, 1.0);
+
+    smoothField(field.first, false);
+    smoothField(field.second, false);
+}
+
+void N2D2::DistortionTransformation::getPooledElasticField(
+    DistortionMap_T& field)
+{
+    const unsigned int sizeX = field.first.cols();
+    const unsigned int sizeY = field.first.rows();
+    const unsigned int size = std::max(std::max(sizeX, sizeY),
+                                       (unsigned int)mElasticGaussianSize);
+
+    std::shared_ptr<const ElasticFieldsPool> pool;
+
+#pragma omp critical(DistortionTransformation__apply)
+    {
+        if (!mFieldsPool
+            || mFieldsPool->fields.size() != mElasticFieldsPool
+            || mFieldsPool->size < size
+            || mFieldsPool->gaussianSize != mElasticGaussianSize
+            || mFieldsPool->sigma != mElasticSigma)
+        {
+            // Square periodic fields, so that any shift of a field has the
+            // same statistics
+            std::shared_ptr<ElasticFieldsPool> newPool
+                = std::make_shared<ElasticFieldsPool>();
+            newPool->size = size;
+            newPool->gaussianSize = mElasticGaussianSize;
+            newPool->sigma = mElasticSigma;
+            newPool->fields.resize(mElasticFieldsPool);
+
+            for (std::vector<DistortionMap_T>::iterator it
+                 = newPool->fields.begin(), itEnd = newPool->fields.end();
+                 it != itEnd; ++it)
+            {
+                Random::Stream stream(Random::mtRand());
+
+                (*it).first.resize(size, size);
+                (*it).second.resize(size, size);
+                stream.fillUniform((*it).first.begin(), (*it).first.end(),
+                                   -1.0, 1.0);
+                stream.fillUniform((*it).second.begin(), (*it).second.end(),
+                                   -1.0, 1.0);
+
+                smoothField((*it).first, true);
+                smoothField((*it).second, true);
+            }
+
+            mFieldsPool = newPool;
+        }
+
+        pool = mFieldsPool;
+    }
+
+    // Random field, shift and rotation/mirroring (dihedral group)
+    const DistortionMap_T& poolField
+        = pool->fields[Random::randUniform(0, (int)pool->fields.size() - 1)];
+    const int poolSize = pool->size;
+    const int offsetX = Random::randUniform(0, poolSize - 1);
+    const int offsetY = Random::randUniform(0, poolSize - 1);
+    const int symmetry = Random::randUniform(0, 7);
+    const bool flipX = (symmetry & 1);
+    const bool flipY = (symmetry & 2);
+    const bool swapXY = (symmetry & 4);
+
+#pragma omp parallel for if (sizeY > 16 && sizeX * sizeY > 256)
+    for (int y = 0; y < (int)sizeY; ++y) {
+        for (int x = 0; x < (int)sizeX; ++x) {
+            int px = (swapXY) ? y : x;
+            int py = (swapXY) ? x : y;
+
+            if (flipX)
+                px = poolSize - 1 - px;
+
+            if (flipY)
+                py = poolSize - 1 - py;
+
+            px = (px + offsetX) % poolSize;
+            py = (py + offsetY) % poolSize;
+
+            // The displacement vector follows the coordinates transformation
+            float vX = poolField.first(py, px);
+            float vY = poolField.second(py, px);
+
+            if (flipX)
+                vX = -vX;
+
+            if (flipY)
+                vY = -vY;
+
+            field.first(y, x) = (swapXY) ? vY : vX;
+            field.second(y, x) = (swapXY) ? vX : vY;
+        }
+    }
+}
+
+void N2D2::DistortionTransformation::smoothField(Matrix<float>& field,
+                                                 bool periodic) const
+{
+    if (field.empty())
+        return;
+
+    // The 2D Gaussian kernel is separable: w(x,y) = vnorm * g(x) * g(y)
+    const unsigned int gaussianSize = mElasticGaussianSize;
+    const double x0 = (gaussianSize - 1.0) / 2.0;
+    const double sigma_2 = mElasticSigma * mElasticSigma;
+    const int kCenter = gaussianSize / 2;
+
+    std::vector<float> kernel(gaussianSize);
+
+    for (unsigned int k = 0; k < gaussianSize; ++k)
+        kernel[k] = std::exp(-(k - x0) * (k - x0) / (2.0 * sigma_2));
+
+    const float vnorm = 1.0 / (2.0 * M_PI * sigma_2);
+
+    const int rows = field.rows();
+    const int cols = field.cols();
+    Matrix<float> smoothX(rows, cols);
+
+    // Rows (the input samples which are out of bound are ignored, unless the
+    // field is periodic)
+#pragma omp parallel for if (rows > 16 && rows * cols > 256)
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            float v = 0.0f;
+
+            for (int k = 0; k < (int)gaussianSize; ++k) {
+                int mx = x + (k - kCenter);
+
+                if (periodic)
+                    mx = ((mx % cols) + cols) % cols;
+                else if (mx < 0 || mx >= cols)
+                    continue;
+
+                v += field(y, mx) * kernel[k];
+            }
+
+            smoothX(y, x) = v;
+        }
+    }
+
+    // Columns, accumulated row by row
+#pragma omp parallel for if (rows > 16 && rows * cols > 256)
+    for (int y = 0; y < rows; ++y) {
+        std::vector<float> v(cols, 0.0f);
+
+        for (int k = 0; k < (int)gaussianSize; ++k) {
+            int my = y + (k - kCenter);
+
+            if (periodic)
+                my = ((my % rows) + rows) % rows;
+            else if (my < 0 || my >= rows)
+                continue;
+
+            const float* rowPtr = &smoothX(my, 0);
+
+            for (int x = 0; x < cols; ++x)
+                v[x] += rowPtr[x] * kernel[k];
+        }
+
+        for (int x = 0; x < cols; ++x)
+            field(y, x) = vnorm * v[x];
+    }
+}
+
 void N2D2::DistortionTransformation::applyDistortion(cv::Mat& mat,
                                                      const DistortionMap_T
                                                      & distortionMap,
@@ -101,6 +101,32 @@ void N2D2::FlipTransformation::reverse(cv::Mat& frame,
                             mVerticalFlip));
 }
 
+cv::Mat N2D2::FlipTransformation::getAffineWarp(
+    cv::Size& size,
+    std::vector<std::shared_ptr<ROI> >& labelsROI)
+{
+    const bool frameHorizontalFlip
+        = (mRandomHorizontalFlip) ? Random::randUniform(0, 1) : mHorizontalFlip;
+    const bool frameVerticalFlip
+        = (mRandomVerticalFlip) ? Random::randUniform(0, 1) : mVerticalFlip;
+
+    std::for_each(labelsROI.begin(),
+                  labelsROI.end(),
+                  std::bind(&ROI::flip,
+                            std::placeholders::_1,
+                            size.width,
+                            size.height,
+                            frameHorizontalFlip,
+                            frameVerticalFlip));
+
+    cv::Mat warp(2, 3, CV_64F, cv::Scalar(0.0));
+    warp.at<double>(0, 0) = (frameHorizontalFlip) ? -1.0 : 1.0;
+    warp.at<double>(0, 2) = (frameHorizontalFlip) ? size.width - 1.0 : 0.0;
+    warp.at<double>(1, 1) = (frameVerticalFlip) ? -1.0 : 1.0;
+    warp.at<double>(1, 2) = (frameVerticalFlip) ? size.height - 1.0 : 0.0;
+    return warp;
+}
+
 void N2D2::FlipTransformation::flip(cv::Mat& mat, int flipCode) const
 {
     if (flipCode != 2) {
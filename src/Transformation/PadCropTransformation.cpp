@@ -99,6 +99,41 @@ void N2D2::PadCropTransformation::reverse(cv::Mat& frame,
             labelsROI);
 }
 
+bool N2D2::PadCropTransformation::getWarpBorder(int& borderType,
+                                                cv::Scalar& borderValue) const
+{
+    std::vector<double> bgColorValue = mBorderValue;
+    bgColorValue.resize(4, 0.0);
+
+    borderType = (int)mBorderType;
+    borderValue = cv::Scalar(bgColorValue[0], bgColorValue[1],
+                             bgColorValue[2], bgColorValue[3]);
+    return true;
+}
+
+cv::Mat N2D2::PadCropTransformation::getAffineWarp(
+    cv::Size& size,
+    std::vector<std::shared_ptr<ROI> >& labelsROI)
+{
+    const int width = (mAdditiveWH) ? size.width + mWidth : mWidth;
+    const int height = (mAdditiveWH) ? size.height + mHeight : mHeight;
+
+    // Same offsets as padCrop()
+    const int top = std::ceil((height - size.height) / 2.0);
+    const int left = std::ceil((width - size.width) / 2.0);
+
+    padCropLabelsROI(labelsROI, -left, -top, width, height);
+
+    cv::Mat warp(2, 3, CV_64F, cv::Scalar(0.0));
+    warp.at<double>(0, 0) = 1.0;
+    warp.at<double>(0, 2) = left;
+    warp.at<double>(1, 1) = 1.0;
+    warp.at<double>(1, 2) = top;
+
+    size = cv::Size(width, height);
+    return warp;
+}
+
 void
 N2D2::PadCropTransformation::padCrop(cv::Mat& mat,
                                      unsigned int matWidth,
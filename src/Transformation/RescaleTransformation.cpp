@@ -88,6 +88,34 @@ void N2D2::RescaleTransformation::reverse(cv::Mat& frame,
         std::bind(&ROI::rescale, std::placeholders::_1, xRatio, yRatio));
 }
 
+cv::Mat N2D2::RescaleTransformation::getAffineWarp(
+    cv::Size& size,
+    std::vector<std::shared_ptr<ROI> >& labelsROI)
+{
+    double xRatio, yRatio;
+    const cv::Size resizedSize = getResizedSize(size, xRatio, yRatio);
+
+    std::for_each(
+        labelsROI.begin(),
+        labelsROI.end(),
+        std::bind(&ROI::rescale, std::placeholders::_1, xRatio, yRatio));
+
+    // Same pixel centers mapping as cv::resize()
+    const double xScale = (size.width > 0)
+        ? resizedSize.width / (double)size.width : 0.0;
+    const double yScale = (size.height > 0)
+        ? resizedSize.height / (double)size.height : 0.0;
+
+    cv::Mat warp(2, 3, CV_64F, cv::Scalar(0.0));
+    warp.at<double>(0, 0) = xScale;
+    warp.at<double>(0, 2) = 0.5 * (xScale - 1.0);
+    warp.at<double>(1, 1) = yScale;
+    warp.at<double>(1, 2) = 0.5 * (yScale - 1.0);
+
+    size = resizedSize;
+    return warp;
+}
+
 void
 N2D2::RescaleTransformation::resize(cv::Mat& mat,
                                     int interpolation,
@@ -96,24 +124,12 @@ N2D2::RescaleTransformation::resize(cv::Mat& mat,
 {
     cv::Mat matResized;
 
-    double xRatio = mWidth / (double)mat.cols;
-    double yRatio = mHeight / (double)mat.rows;
-
-    if (mKeepAspectRatio) {
-        const double ratio = (mResizeToFit) ? std::min(xRatio, yRatio)
-                                            : std::max(xRatio, yRatio);
-        xRatio = yRatio = ratio;
+    double xRatio, yRatio;
+    const cv::Size size = getResizedSize(cv::Size(mat.cols, mat.rows),
+                                         xRatio, yRatio);
 
-        if (ratio * mat.cols >= 1.0 && ratio * mat.rows >= 1.0)
-            cv::resize(mat,
-                       matResized,
-                       cv::Size(ratio * mat.cols, ratio * mat.rows),
-                       0,
-                       0,
-                       interpolation);
-    } else
-        cv::resize(
-            mat, matResized, cv::Size(mWidth, mHeight), 0, 0, interpolation);
+    if (size.width > 0 && size.height > 0)
+        cv::resize(mat, matResized, size, 0, 0, interpolation);
 
     std::for_each(
         labelsROI.begin(),
@@ -122,3 +138,24 @@ N2D2::RescaleTransformation::resize(cv::Mat& mat,
 
     mat = matResized;
 }
+
+cv::Size N2D2::RescaleTransformation::getResizedSize(const cv::Size& size,
+                                                     double& xRatio,
+                                                     double& yRatio) const
+{
+    xRatio = mWidth / (double)size.width;
+    yRatio = mHeight / (double)size.height;
+
+    if (mKeepAspectRatio) {
+        const double ratio = (mResizeToFit) ? std::min(xRatio, yRatio)
+                                            : std::max(xRatio, yRatio);
+        xRatio = yRatio = ratio;
+
+        // Empty output if the image is too small
+        return (ratio * size.width >= 1.0 && ratio * size.height >= 1.0)
+            ? cv::Size(ratio * size.width, ratio * size.height)
+            : cv::Size(0, 0);
+    }
+    else
+        return cv::Size(mWidth, mHeight);
+}
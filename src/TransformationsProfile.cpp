@@ -0,0 +1,70 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "TransformationsProfile.hpp"
+
+#include <ostream>
+
+void N2D2::TransformationsProfile::add(const std::string& stage,
+                                       const std::string& name,
+                                       double time,
+                                       unsigned long long int nbBytes)
+{
+    Entry& entry = mEntries[std::make_pair(stage, name)];
+    ++entry.nbCalls;
+    entry.time += time;
+    entry.nbBytes += nbBytes;
+}
+
+void N2D2::TransformationsProfile::merge(const TransformationsProfile& profile)
+{
+    for (std::map<Key_T, Entry>::const_iterator it = profile.mEntries.begin(),
+         itEnd = profile.mEntries.end(); it != itEnd; ++it)
+    {
+        Entry& entry = mEntries[(*it).first];
+        entry.nbCalls += (*it).second.nbCalls;
+        entry.time += (*it).second.time;
+        entry.nbBytes += (*it).second.nbBytes;
+    }
+}
+
+void N2D2::TransformationsProfile::log(std::ostream& os,
+                                       const std::string& prefix) const
+{
+    for (std::map<Key_T, Entry>::const_iterator it = mEntries.begin(),
+         itEnd = mEntries.end(); it != itEnd; ++it)
+    {
+        const Entry& entry = (*it).second;
+
+        os << prefix << (*it).first.first << "," << (*it).first.second << ","
+            << entry.nbCalls << "," << entry.time << "," << entry.nbBytes
+            << "," << ((entry.nbCalls > 0) ? entry.time / entry.nbCalls : 0.0)
+            << "," << ((entry.time > 0.0)
+                        ? entry.nbBytes / entry.time / 1024.0 / 1024.0 : 0.0)
+            << "\n";
+    }
+}
+
+void N2D2::TransformationsProfile::logHeader(std::ostream& os,
+                                             const std::string& prefix)
+{
+    os << prefix << "Stage,Name,Calls,Time(s),Bytes,TimePerCall(s),"
+        "Throughput(MB/s)\n";
+}
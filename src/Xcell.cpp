@@ -383,6 +383,20 @@ void N2D2::Xcell::setActivityRecording(bool activityRecording)
                             activityRecording));
 }
 
+void N2D2::Xcell::setPartition(unsigned int partition)
+{
+    std::for_each(mNeurons.begin(),
+                  mNeurons.end(),
+                  std::bind(&NodeNeuron::setPartition,
+                            std::placeholders::_1,
+                            partition));
+    std::for_each(mSyncs.begin(),
+                  mSyncs.end(),
+                  std::bind(&NodeSync::setPartition,
+                            std::placeholders::_1,
+                            partition));
+}
+
 std::string N2D2::Xcell::getNeuronsParameter(const std::string& name) const
 {
     const std::string value = mNeurons.front()->getParameter(name);
@@ -199,42 +199,8 @@ N2D2::Tensor<T>::Tensor(const cv::Mat& mat, bool signedMapping)
     if (mat.channels() > 1)
         mDims.push_back(mat.channels());
 
-    (*mData)().reserve(computeSize());
-
-    std::vector<cv::Mat> channels;
-    cv::split(mat, channels);
-
-    for (std::vector<cv::Mat>::const_iterator itChannel = channels.begin();
-         itChannel != channels.end();
-         ++itChannel)
-    {
-        switch ((*itChannel).depth()) {
-        case CV_8U:
-            convert<unsigned char>(*itChannel, (*mData)(), signedMapping);
-            break;
-        case CV_8S:
-            convert<char>(*itChannel, (*mData)());
-            break;
-        case CV_16U:
-            convert<unsigned short>(*itChannel, (*mData)(), signedMapping);
-            break;
-        case CV_16S:
-            convert<short>(*itChannel, (*mData)());
-            break;
-        case CV_32S:
-            convert<int>(*itChannel, (*mData)());
-            break;
-        case CV_32F:
-            convert<float>(*itChannel, (*mData)());
-            break;
-        case CV_64F:
-            convert<double>(*itChannel, (*mData)());
-            break;
-        default:
-            throw std::runtime_error(
-                "Cannot convert cv::Mat to Tensor: incompatible types.");
-        }
-    }
+    (*mData)().resize(computeSize());
+    convertFrom(mat, signedMapping);
 
     assert((*mData)().size() == static_cast<std::size_t>(mat.rows * mat.cols * mat.channels()));
     assert((*mData)().size() == size());
@@ -300,6 +266,46 @@ void N2D2::Tensor<T>::fill(const T& value)
               (*mData)().begin() + mDataOffset + size(), value);
 }
 
+template <class T>
+void N2D2::Tensor<T>::convertFrom(const cv::Mat& mat, bool signedMapping)
+{
+    if ((size_t)mat.rows * mat.cols * mat.channels() != size()) {
+        std::stringstream errorStr;
+        errorStr << "Tensor<T>::convertFrom(): cv::Mat size ("
+            << mat.cols << "x" << mat.rows << "x" << mat.channels()
+            << ") does not match tensor dimension " << mDims << std::endl;
+
+        throw std::runtime_error(errorStr.str());
+    }
+
+    switch (mat.depth()) {
+    case CV_8U:
+        convert<unsigned char, T>(mat, begin(), signedMapping);
+        break;
+    case CV_8S:
+        convert<char, T>(mat, begin());
+        break;
+    case CV_16U:
+        convert<unsigned short, T>(mat, begin(), signedMapping);
+        break;
+    case CV_16S:
+        convert<short, T>(mat, begin());
+        break;
+    case CV_32S:
+        convert<int, T>(mat, begin());
+        break;
+    case CV_32F:
+        convert<float, T>(mat, begin());
+        break;
+    case CV_64F:
+        convert<double, T>(mat, begin());
+        break;
+    default:
+        throw std::runtime_error(
+            "Cannot convert cv::Mat to Tensor: incompatible types.");
+    }
+}
+
 template <class T>
 void N2D2::Tensor<T>::push_back(const T& value)
 {
@@ -768,6 +774,30 @@ template <class CV_T, class U,
                                   !std::is_same<U, bool>::value>::type*>
 void N2D2::Tensor<T>::convert(const cv::Mat& mat, std::vector<U>& data,
                               bool signedMapping)
+{
+    const std::size_t offset = data.size();
+    data.resize(offset + mat.total() * mat.channels());
+
+    convert<CV_T, U>(mat, data.begin() + offset, signedMapping);
+}
+
+template <class T>
+template <class CV_T, class U,
+          typename std::enable_if<!(std::is_arithmetic<U>::value &&
+                                    !std::is_same<U, bool>::value)>::type*>
+void N2D2::Tensor<T>::convert(const cv::Mat& /*mat*/, std::vector<U>& /*data*/,
+                              bool /*signedMapping*/)
+{
+    throw std::runtime_error("Can't convert from or to a non arithmetic Tensor.");
+}
+
+template <class T>
+template <class CV_T, class U,
+          typename std::enable_if<std::is_arithmetic<U>::value &&
+                                  !std::is_same<U, bool>::value>::type*>
+void N2D2::Tensor<T>::convert(const cv::Mat& mat,
+                              typename std::vector<U>::iterator data,
+                              bool signedMapping)
 {
     const CV_T srcRange = (std::numeric_limits<CV_T>::is_integer)
                               ? ((signedMapping)
@@ -779,43 +809,45 @@ void N2D2::Tensor<T>::convert(const cv::Mat& mat, std::vector<U>& data,
     const T dstRange = (std::numeric_limits<T>::is_integer)
                            ? std::numeric_limits<T>::max()
                            : T(1.0);
-
-    // We know dstRange and srcRange are positive. Convert them to unsigned to avoid
-    // a potential 'comparison between signed and unsigned integer expressions" warning.
-    if (static_cast<typename try_make_unsigned<CV_T>::type>(srcRange) ==
-        static_cast<typename try_make_unsigned<U>::type>(dstRange))
-    {
-        if (mat.isContinuous())
-            data.insert(data.end(), (CV_T*) mat.datastart, (CV_T*) mat.dataend);
-        else {
-            for (int i = 0; i < mat.rows; ++i) {
-                data.insert(data.end(),
-                            mat.ptr<CV_T>(i), mat.ptr<CV_T>(i) + mat.cols);
-            }
-        }
-    }
-    else {
+    const bool sameRange
+        = (static_cast<typename try_make_unsigned<CV_T>::type>(srcRange) ==
+            static_cast<typename try_make_unsigned<U>::type>(dstRange));
+    const int nbChannels = mat.channels();
+
+    // Same layout as Tensor(const cv::Mat&): the channels are stored in the
+    // last dimension, which avoids the cv::split() of the interleaved data
+    for (int ch = 0; ch < nbChannels; ++ch) {
         for (int i = 0; i < mat.rows; ++i) {
-            const CV_T* rowPtr = mat.ptr<CV_T>(i);
+            const CV_T* rowPtr = mat.ptr<CV_T>(i) + ch;
 
-            for (int j = 0; j < mat.cols; ++j) {
-                if (std::numeric_limits<CV_T>::is_integer && signedMapping) {
-                    data.push_back(static_cast<T>(
+            if (sameRange) {
+                if (nbChannels == 1)
+                    data = std::copy(rowPtr, rowPtr + mat.cols, data);
+                else {
+                    for (int j = 0; j < mat.cols; ++j, ++data)
+                        *data = static_cast<U>(rowPtr[j * nbChannels]);
+                }
+            }
+            else if (std::numeric_limits<CV_T>::is_integer && signedMapping) {
+                for (int j = 0; j < mat.cols; ++j, ++data) {
+                    *data = static_cast<T>(
                         ((std::numeric_limits<CV_T>::is_integer
                           && std::numeric_limits<T>::is_integer)
                              ? static_cast<long long int>(dstRange)
                              : static_cast<double>(dstRange))
-                            * (rowPtr[j] + std::numeric_limits<
+                            * (rowPtr[j * nbChannels] + std::numeric_limits<
                                   typename try_make_signed<CV_T>::type>::min())
-                            / srcRange));
+                            / srcRange);
                 }
-                else {
-                    data.push_back(static_cast<T>(
+            }
+            else {
+                for (int j = 0; j < mat.cols; ++j, ++data) {
+                    *data = static_cast<T>(
                         ((std::numeric_limits<CV_T>::is_integer
                           && std::numeric_limits<T>::is_integer)
                              ? static_cast<long long int>(dstRange)
                              : static_cast<double>(dstRange))
-                            * rowPtr[j] / srcRange));
+                            * rowPtr[j * nbChannels] / srcRange);
                 }
             }
         }
@@ -826,7 +858,8 @@ template <class T>
 template <class CV_T, class U,
           typename std::enable_if<!(std::is_arithmetic<U>::value &&
                                     !std::is_same<U, bool>::value)>::type*>
-void N2D2::Tensor<T>::convert(const cv::Mat& /*mat*/, std::vector<U>& /*data*/,
+void N2D2::Tensor<T>::convert(const cv::Mat& /*mat*/,
+                              typename std::vector<U>::iterator /*data*/,
                               bool /*signedMapping*/)
 {
     throw std::runtime_error("Can't convert from or to a non arithmetic Tensor.");
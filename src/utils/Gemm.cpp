@@ -0,0 +1,705 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__))                                 \
+    && (defined(__x86_64__) || defined(__i386__))
+#define N2D2_GEMM_INT8_DISPATCH 1
+#else
+#define N2D2_GEMM_INT8_DISPATCH 0
+#endif
+
+#if defined(__F16C__) || N2D2_GEMM_INT8_DISPATCH
+#include <immintrin.h>
+#endif
+
+#include "utils/Gemm.hpp"
+
+namespace {
+    // Register block computed by the micro-kernel: MR rows x NR columns of C
+    const unsigned int MR = 4;
+    const unsigned int NR = 8;
+    // Cache blocks: a KC x NR panel of op(B) stays in L1, a MC x KC block of
+    // op(A) in L2 and a KC x NC block of op(B) in L3
+    const unsigned int MC = 128;
+    const unsigned int KC = 256;
+    const unsigned int NC = 1024;
+
+    // Pack a mc x kc block of op(A) in MR-row panels, k-major inside a panel.
+    // Rows beyond mc are zero-filled.
+    template <class T>
+    void packA(N2D2::Gemm::Transpose transA,
+               unsigned int mc,
+               unsigned int kc,
+               const T* A,
+               unsigned int lda,
+               T* packed)
+    {
+        for (unsigned int i0 = 0; i0 < mc; i0 += MR) {
+            const unsigned int mr = std::min(MR, mc - i0);
+
+            for (unsigned int k = 0; k < kc; ++k) {
+                for (unsigned int i = 0; i < MR; ++i) {
+                    if (i < mr) {
+                        *packed = (transA == N2D2::Gemm::NoTrans)
+                            ? A[(i0 + i) * lda + k]
+                            : A[k * lda + i0 + i];
+                    }
+                    else
+                        *packed = T(0.0);
+
+                    ++packed;
+                }
+            }
+        }
+    }
+
+    // Pack a kc x nc block of op(B) in NR-column panels, k-major inside a
+    // panel. Columns beyond nc are zero-filled.
+    template <class T>
+    void packB(N2D2::Gemm::Transpose transB,
+               unsigned int kc,
+               unsigned int nc,
+               const T* B,
+               unsigned int ldb,
+               T* packed)
+    {
+        for (unsigned int j0 = 0; j0 < nc; j0 += NR) {
+            const unsigned int nr = std::min(NR, nc - j0);
+
+            for (unsigned int k = 0; k < kc; ++k) {
+                if (transB == N2D2::Gemm::NoTrans && nr == NR) {
+                    std::copy(B + k * ldb + j0, B + k * ldb + j0 + NR, packed);
+                    packed += NR;
+                    continue;
+                }
+
+                for (unsigned int j = 0; j < NR; ++j) {
+                    if (j < nr) {
+                        *packed = (transB == N2D2::Gemm::NoTrans)
+                            ? B[k * ldb + j0 + j]
+                            : B[(j0 + j) * ldb + k];
+                    }
+                    else
+                        *packed = T(0.0);
+
+                    ++packed;
+                }
+            }
+        }
+    }
+
+    // C[0:mr, 0:nr] += alpha * a * b, with a a packed MR x kc panel and b a
+    // packed kc x NR panel
+    template <class T>
+    void microKernel(unsigned int kc,
+                     const T& alpha,
+                     const T* a,
+                     const T* b,
+                     T* C,
+                     unsigned int ldc,
+                     unsigned int mr,
+                     unsigned int nr)
+    {
+        T acc[MR * NR];
+        std::fill(acc, acc + MR * NR, T(0.0));
+
+        for (unsigned int k = 0; k < kc; ++k) {
+            for (unsigned int i = 0; i < MR; ++i) {
+                const T ai = a[i];
+
+                for (unsigned int j = 0; j < NR; ++j)
+                    acc[i * NR + j] += ai * b[j];
+            }
+
+            a += MR;
+            b += NR;
+        }
+
+        for (unsigned int i = 0; i < mr; ++i) {
+            for (unsigned int j = 0; j < nr; ++j)
+                C[i * ldc + j] += alpha * acc[i * NR + j];
+        }
+    }
+}
+
+namespace {
+    // Bulk conversion between half and float, with the F16C instructions
+    // when available. Conversions to half round to nearest.
+    void halfToFloat(const half_float::half* src, unsigned int n, float* dst)
+    {
+        unsigned int i = 0;
+
+#ifdef __F16C__
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + i))));
+        }
+#endif
+
+        for (; i < n; ++i)
+            dst[i] = (float)src[i];
+    }
+
+    void floatToHalf(const float* src, unsigned int n, half_float::half* dst)
+    {
+        unsigned int i = 0;
+
+#ifdef __F16C__
+        for (; i + 8 <= n; i += 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                _MM_FROUND_TO_NEAREST_INT));
+        }
+#endif
+
+        for (; i < n; ++i) {
+            dst[i] = half_float::half_cast<half_float::half,
+                                           std::round_to_nearest>(src[i]);
+        }
+    }
+
+    // Convert a block of nbRows rows of rowSize elements, with a row stride
+    // of ld, to a dense float matrix
+    void halfToFloat(const half_float::half* src,
+                     unsigned int nbRows,
+                     unsigned int rowSize,
+                     unsigned int ld,
+                     float* dst)
+    {
+        for (unsigned int i = 0; i < nbRows; ++i)
+            halfToFloat(src + i * ld, rowSize, dst + i * rowSize);
+    }
+}
+
+namespace {
+    // Block of rows of A reused across the columns of C by gemmInt8(), and
+    // number of rows of B processed at once by the dot product kernel
+    const unsigned int MC_INT8 = 64;
+    const unsigned int NR_INT8 = 4;
+
+    // Accumulate the dot products of the row a with the NB rows of B to
+    // C[0 .. NB - 1], from k = k0.
+    template <unsigned int NB>
+    void dotInt8Scalar(unsigned int k0,
+                       unsigned int K,
+                       const int8_t* a,
+                       const uint8_t* B,
+                       unsigned int ldb,
+                       int32_t* C)
+    {
+        int32_t acc[NB] = {0};
+
+        for (unsigned int k = k0; k < K; ++k) {
+            for (unsigned int j = 0; j < NB; ++j)
+                acc[j] += (int32_t)a[k] * (int32_t)B[j * ldb + k];
+        }
+
+        for (unsigned int j = 0; j < NB; ++j)
+            C[j] += acc[j];
+    }
+
+    template <unsigned int NB>
+    void dotInt8(unsigned int K,
+                 const int8_t* a,
+                 const uint8_t* B,
+                 unsigned int ldb,
+                 int32_t* C)
+    {
+        dotInt8Scalar<NB>(0, K, a, B, ldb, C);
+    }
+
+#if N2D2_GEMM_INT8_DISPATCH
+    // The SIMD kernels are compiled for their own target and selected at
+    // runtime, so that they are available without -march=native.
+    __attribute__((target("avx2")))
+    inline int32_t horizontalSum(__m256i v)
+    {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                                    _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+
+    // Widen to 16 bits and use vpmaddwd, which sums pairs of products in
+    // 32 bits (vpmaddubsw would saturate in 16 bits)
+    template <unsigned int NB>
+    __attribute__((target("avx2")))
+    void dotInt8Avx2(unsigned int K,
+                     const int8_t* a,
+                     const uint8_t* B,
+                     unsigned int ldb,
+                     int32_t* C)
+    {
+        __m256i vacc[NB];
+        unsigned int k = 0;
+
+        for (unsigned int j = 0; j < NB; ++j)
+            vacc[j] = _mm256_setzero_si256();
+
+        for (; k + 16 <= K; k += 16) {
+            const __m256i va = _mm256_cvtepi8_epi16(_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(a + k)));
+
+            for (unsigned int j = 0; j < NB; ++j) {
+                const __m256i vb = _mm256_cvtepu8_epi16(_mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(B + j * ldb + k)));
+                vacc[j] = _mm256_add_epi32(vacc[j],
+                                           _mm256_madd_epi16(va, vb));
+            }
+        }
+
+        for (unsigned int j = 0; j < NB; ++j)
+            C[j] += horizontalSum(vacc[j]);
+
+        dotInt8Scalar<NB>(k, K, a, B, ldb, C);
+    }
+
+    // vpdpbusd: 4 u8 x s8 products summed per 32 bits lane, without
+    // intermediate saturation
+    template <unsigned int NB>
+    __attribute__((target("avx2,avx512vnni,avx512vl")))
+    void dotInt8Vnni(unsigned int K,
+                     const int8_t* a,
+                     const uint8_t* B,
+                     unsigned int ldb,
+                     int32_t* C)
+    {
+        __m256i vacc[NB];
+        unsigned int k = 0;
+
+        for (unsigned int j = 0; j < NB; ++j)
+            vacc[j] = _mm256_setzero_si256();
+
+        for (; k + 32 <= K; k += 32) {
+            const __m256i va = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(a + k));
+
+            for (unsigned int j = 0; j < NB; ++j) {
+                vacc[j] = _mm256_dpbusd_epi32(vacc[j], _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(B + j * ldb + k)), va);
+            }
+        }
+
+        for (unsigned int j = 0; j < NB; ++j)
+            C[j] += horizontalSum(vacc[j]);
+
+        dotInt8Scalar<NB>(k, K, a, B, ldb, C);
+    }
+#endif
+
+    typedef void (*DotInt8Kernel)(unsigned int K,
+                                  const int8_t* a,
+                                  const uint8_t* B,
+                                  unsigned int ldb,
+                                  int32_t* C);
+
+    // Dot product kernels (NR_INT8 rows and 1 row of B) for the instruction
+    // sets of the CPU, detected once
+    struct DotInt8Kernels {
+        DotInt8Kernels()
+            : dotNR(&dotInt8<NR_INT8>),
+              dot1(&dotInt8<1>),
+              accelerated(false)
+        {
+#if N2D2_GEMM_INT8_DISPATCH
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512vnni")
+                && __builtin_cpu_supports("avx512vl"))
+            {
+                dotNR = &dotInt8Vnni<NR_INT8>;
+                dot1 = &dotInt8Vnni<1>;
+                accelerated = true;
+            }
+            else if (__builtin_cpu_supports("avx2")) {
+                dotNR = &dotInt8Avx2<NR_INT8>;
+                dot1 = &dotInt8Avx2<1>;
+                accelerated = true;
+            }
+#endif
+        }
+
+        DotInt8Kernel dotNR;
+        DotInt8Kernel dot1;
+        bool accelerated;
+    };
+
+    const DotInt8Kernels& getDotInt8Kernels()
+    {
+        static const DotInt8Kernels kernels;
+        return kernels;
+    }
+}
+
+std::size_t N2D2::Gemm::workspaceSize()
+{
+    return (MC * KC + KC * NC);
+}
+
+template <class T>
+void N2D2::Gemm::gemm(Transpose transA,
+                      Transpose transB,
+                      unsigned int M,
+                      unsigned int N,
+                      unsigned int K,
+                      const T& alpha,
+                      const T* A,
+                      unsigned int lda,
+                      const T* B,
+                      unsigned int ldb,
+                      const T& beta,
+                      T* C,
+                      unsigned int ldc,
+                      std::vector<T>& workspace)
+{
+    // C = beta * C first, the products are then accumulated in C block by
+    // block. With K <= KC, this leads to the same rounding as
+    // C = alpha * sum + beta * C.
+    if (beta != T(1.0)) {
+        for (unsigned int i = 0; i < M; ++i) {
+            T* rowC = C + i * ldc;
+
+            if (beta == T(0.0))
+                std::fill(rowC, rowC + N, T(0.0));
+            else {
+                for (unsigned int j = 0; j < N; ++j)
+                    rowC[j] *= beta;
+            }
+        }
+    }
+
+    if (K == 0 || alpha == T(0.0))
+        return;
+
+    if (workspace.size() < workspaceSize())
+        workspace.resize(workspaceSize());
+
+    T* packedA = &workspace[0];
+    T* packedB = &workspace[MC * KC];
+
+    for (unsigned int jc = 0; jc < N; jc += NC) {
+        const unsigned int nc = std::min(NC, N - jc);
+
+        for (unsigned int pc = 0; pc < K; pc += KC) {
+            const unsigned int kc = std::min(KC, K - pc);
+
+            packB(transB, kc, nc,
+                  (transB == NoTrans) ? B + pc * ldb + jc : B + jc * ldb + pc,
+                  ldb, packedB);
+
+            for (unsigned int ic = 0; ic < M; ic += MC) {
+                const unsigned int mc = std::min(MC, M - ic);
+
+                packA(transA, mc, kc,
+                      (transA == NoTrans) ? A + ic * lda + pc
+                                          : A + pc * lda + ic,
+                      lda, packedA);
+
+                for (unsigned int jr = 0; jr < nc; jr += NR) {
+                    for (unsigned int ir = 0; ir < mc; ir += MR) {
+                        microKernel(kc,
+                                    alpha,
+                                    packedA + ir * kc,
+                                    packedB + jr * kc,
+                                    C + (ic + ir) * ldc + jc + jr,
+                                    ldc,
+                                    std::min(MR, mc - ir),
+                                    std::min(NR, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <>
+void N2D2::Gemm::gemm<half_float::half>(Transpose transA,
+                                        Transpose transB,
+                                        unsigned int M,
+                                        unsigned int N,
+                                        unsigned int K,
+                                        const half_float::half& alpha,
+                                        const half_float::half* A,
+                                        unsigned int lda,
+                                        const half_float::half* B,
+                                        unsigned int ldb,
+                                        const half_float::half& beta,
+                                        half_float::half* C,
+                                        unsigned int ldc,
+                                        std::vector<half_float::half>&
+                                            /*workspace*/)
+{
+    // Mixed precision: the operands are converted to float by blocks and
+    // the products are accumulated in float over the whole K dimension. C is
+    // rounded to half only once.
+    const float alphaF = (float)alpha;
+    const float betaF = (float)beta;
+
+    std::vector<float> blockA((std::size_t)M * std::min(K, KC));
+    std::vector<float> blockB((std::size_t)std::min(K, KC) * std::min(N, NC));
+    std::vector<float> blockC((std::size_t)M * std::min(N, NC));
+    std::vector<float> workspaceF;
+
+    for (unsigned int jc = 0; jc < N; jc += NC) {
+        const unsigned int nc = std::min(NC, N - jc);
+
+        if (betaF != 0.0f)
+            halfToFloat(C + jc, M, nc, ldc, &blockC[0]);
+
+        gemm<float>(NoTrans, NoTrans, M, nc, 0, 0.0f, NULL, 0, NULL, 0,
+                    betaF, &blockC[0], nc, workspaceF);
+
+        for (unsigned int pc = 0; pc < K && alphaF != 0.0f; pc += KC) {
+            const unsigned int kc = std::min(KC, K - pc);
+
+            // op(A) block: M x kc, op(B) block: kc x nc, stored as is
+            if (transA == NoTrans)
+                halfToFloat(A + pc, M, kc, lda, &blockA[0]);
+            else
+                halfToFloat(A + pc * lda, kc, M, lda, &blockA[0]);
+
+            if (transB == NoTrans)
+                halfToFloat(B + pc * ldb + jc, kc, nc, ldb, &blockB[0]);
+            else
+                halfToFloat(B + jc * ldb + pc, nc, kc, ldb, &blockB[0]);
+
+            gemm<float>(transA, transB, M, nc, kc,
+                        alphaF,
+                        &blockA[0], (transA == NoTrans) ? kc : M,
+                        &blockB[0], (transB == NoTrans) ? nc : kc,
+                        1.0f, &blockC[0], nc,
+                        workspaceF);
+        }
+
+        for (unsigned int i = 0; i < M; ++i)
+            floatToHalf(&blockC[i * nc], nc, C + i * ldc + jc);
+    }
+}
+
+template <class T>
+void N2D2::Gemm::gemmParallel(Transpose transA,
+                              Transpose transB,
+                              unsigned int M,
+                              unsigned int N,
+                              unsigned int K,
+                              const T& alpha,
+                              const T* A,
+                              unsigned int lda,
+                              const T* B,
+                              unsigned int ldb,
+                              const T& beta,
+                              T* C,
+                              unsigned int ldc,
+                              std::vector<std::vector<T> >& workspaces)
+{
+#ifdef _OPENMP
+    const unsigned int nbThreads = omp_get_max_threads();
+#else
+    const unsigned int nbThreads = 1;
+#endif
+
+    if (workspaces.size() < nbThreads)
+        workspaces.resize(nbThreads);
+
+    // Split the largest dimension of C, in multiples of the register block
+    const bool splitN = (N >= M);
+    const unsigned int size = (splitN) ? N : M;
+    const unsigned int block = (splitN) ? NR : MR;
+    const unsigned int chunk = block * ((size + nbThreads * block - 1)
+                                        / (nbThreads * block));
+    const int nbChunks = (size + chunk - 1) / chunk;
+
+#pragma omp parallel for if (nbChunks > 1 && (double)M * N * K > 65536.0)
+    for (int chunkIdx = 0; chunkIdx < nbChunks; ++chunkIdx) {
+        const unsigned int i0 = chunkIdx * chunk;
+        const unsigned int nbI = std::min(chunk, size - i0);
+#ifdef _OPENMP
+        std::vector<T>& workspace = workspaces[omp_get_thread_num()];
+#else
+        std::vector<T>& workspace = workspaces[0];
+#endif
+
+        if (splitN) {
+            gemm(transA, transB, M, nbI, K, alpha,
+                 A, lda,
+                 (transB == NoTrans) ? B + i0 : B + i0 * ldb, ldb,
+                 beta, C + i0, ldc, workspace);
+        }
+        else {
+            gemm(transA, transB, nbI, N, K, alpha,
+                 (transA == NoTrans) ? A + i0 * lda : A + i0, lda,
+                 B, ldb,
+                 beta, C + i0 * ldc, ldc, workspace);
+        }
+    }
+}
+
+void N2D2::Gemm::gemmInt8(unsigned int M,
+                          unsigned int N,
+                          unsigned int K,
+                          const int8_t* A,
+                          unsigned int lda,
+                          const uint8_t* B,
+                          unsigned int ldb,
+                          int32_t* C,
+                          unsigned int ldc)
+{
+    const DotInt8Kernels& kernels = getDotInt8Kernels();
+
+    for (unsigned int i0 = 0; i0 < M; i0 += MC_INT8) {
+        const unsigned int mc = std::min(MC_INT8, M - i0);
+        unsigned int j = 0;
+
+        for (; j + NR_INT8 <= N; j += NR_INT8) {
+            for (unsigned int i = i0; i < i0 + mc; ++i) {
+                (*kernels.dotNR)(K, A + i * lda, B + j * ldb, ldb,
+                                 C + i * ldc + j);
+            }
+        }
+
+        for (; j < N; ++j) {
+            for (unsigned int i = i0; i < i0 + mc; ++i) {
+                (*kernels.dot1)(K, A + i * lda, B + j * ldb, ldb,
+                                C + i * ldc + j);
+            }
+        }
+    }
+}
+
+bool N2D2::Gemm::gemmInt8Accelerated()
+{
+    return getDotInt8Kernels().accelerated;
+}
+
+void N2D2::Gemm::gemmInt8Parallel(unsigned int M,
+                                  unsigned int N,
+                                  unsigned int K,
+                                  const int8_t* A,
+                                  unsigned int lda,
+                                  const uint8_t* B,
+                                  unsigned int ldb,
+                                  int32_t* C,
+                                  unsigned int ldc)
+{
+#ifdef _OPENMP
+    const unsigned int nbThreads = omp_get_max_threads();
+#else
+    const unsigned int nbThreads = 1;
+#endif
+
+    // Split the largest dimension of C, in multiples of the row blocks
+    const bool splitN = (N >= M);
+    const unsigned int size = (splitN) ? N : M;
+    const unsigned int block = (splitN) ? NR_INT8 : MC_INT8;
+    const unsigned int chunk = block * ((size + nbThreads * block - 1)
+                                        / (nbThreads * block));
+    const int nbChunks = (size + chunk - 1) / chunk;
+
+#pragma omp parallel for if (nbChunks > 1 && (double)M * N * K > 65536.0)
+    for (int chunkIdx = 0; chunkIdx < nbChunks; ++chunkIdx) {
+        const unsigned int i0 = chunkIdx * chunk;
+        const unsigned int nbI = std::min(chunk, size - i0);
+
+        if (splitN)
+            gemmInt8(M, nbI, K, A, lda, B + i0 * ldb, ldb, C + i0, ldc);
+        else
+            gemmInt8(nbI, N, K, A + i0 * lda, lda, B, ldb, C + i0 * ldc, ldc);
+    }
+}
+
+namespace N2D2 {
+    template void Gemm::gemm<float>(Transpose transA,
+                                    Transpose transB,
+                                    unsigned int M,
+                                    unsigned int N,
+                                    unsigned int K,
+                                    const float& alpha,
+                                    const float* A,
+                                    unsigned int lda,
+                                    const float* B,
+                                    unsigned int ldb,
+                                    const float& beta,
+                                    float* C,
+                                    unsigned int ldc,
+                                    std::vector<float>& workspace);
+    template void Gemm::gemm<double>(Transpose transA,
+                                     Transpose transB,
+                                     unsigned int M,
+                                     unsigned int N,
+                                     unsigned int K,
+                                     const double& alpha,
+                                     const double* A,
+                                     unsigned int lda,
+                                     const double* B,
+                                     unsigned int ldb,
+                                     const double& beta,
+                                     double* C,
+                                     unsigned int ldc,
+                                     std::vector<double>& workspace);
+    template void Gemm::gemmParallel<half_float::half>(Transpose transA,
+        Transpose transB,
+        unsigned int M,
+        unsigned int N,
+        unsigned int K,
+        const half_float::half& alpha,
+        const half_float::half* A,
+        unsigned int lda,
+        const half_float::half* B,
+        unsigned int ldb,
+        const half_float::half& beta,
+        half_float::half* C,
+        unsigned int ldc,
+        std::vector<std::vector<half_float::half> >& workspaces);
+    template void Gemm::gemmParallel<float>(Transpose transA,
+        Transpose transB,
+        unsigned int M,
+        unsigned int N,
+        unsigned int K,
+        const float& alpha,
+        const float* A,
+        unsigned int lda,
+        const float* B,
+        unsigned int ldb,
+        const float& beta,
+        float* C,
+        unsigned int ldc,
+        std::vector<std::vector<float> >& workspaces);
+    template void Gemm::gemmParallel<double>(Transpose transA,
+        Transpose transB,
+        unsigned int M,
+        unsigned int N,
+        unsigned int K,
+        const double& alpha,
+        const double* A,
+        unsigned int lda,
+        const double* B,
+        unsigned int ldb,
+        const double& beta,
+        double* C,
+        unsigned int ldc,
+        std::vector<std::vector<double> >& workspaces);
+}
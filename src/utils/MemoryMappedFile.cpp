@@ -0,0 +1,101 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/MemoryMappedFile.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+N2D2::MemoryMappedFile::MemoryMappedFile(const std::string& fileName)
+    : mFileName(fileName),
+      mData(NULL),
+      mSize(0)
+{
+#ifndef WIN32
+    const int fd = open(fileName.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        throw std::runtime_error("MemoryMappedFile::MemoryMappedFile(): could"
+                                 " not open file: " + fileName);
+    }
+
+    struct stat fileStat;
+
+    if (fstat(fd, &fileStat) != 0) {
+        close(fd);
+        throw std::runtime_error("MemoryMappedFile::MemoryMappedFile(): could"
+                                 " not stat file: " + fileName);
+    }
+
+    mSize = fileStat.st_size;
+
+    if (mSize > 0) {
+        // Private writable mapping: the cv::Mat built over it by the
+        // databases can be written in place without a fault, and without
+        // changing the file
+        void* data = mmap(NULL, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                          fd, 0);
+
+        if (data == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("MemoryMappedFile::MemoryMappedFile():"
+                                     " could not map file: " + fileName);
+        }
+
+        mData = static_cast<char*>(data);
+    }
+
+    // The mapping remains valid after closing the file descriptor
+    close(fd);
+#else
+    std::ifstream is(fileName.c_str(), std::ios::binary | std::ios::ate);
+
+    if (!is.good()) {
+        throw std::runtime_error("MemoryMappedFile::MemoryMappedFile(): could"
+                                 " not open file: " + fileName);
+    }
+
+    mSize = is.tellg();
+    mBuffer.resize(mSize);
+    is.seekg(0);
+
+    if (mSize > 0 && !is.read(&mBuffer[0], mSize)) {
+        throw std::runtime_error("MemoryMappedFile::MemoryMappedFile(): could"
+                                 " not read file: " + fileName);
+    }
+
+    mData = (mSize > 0) ? &mBuffer[0] : NULL;
+#endif
+}
+
+N2D2::MemoryMappedFile::~MemoryMappedFile()
+{
+#ifndef WIN32
+    if (mData != NULL)
+        munmap(mData, mSize);
+#endif
+}
@@ -27,6 +27,19 @@ unsigned int N2D2::Random::_mt[624];
 unsigned int N2D2::Random::_mt_index = 0;
 unsigned int N2D2::Random::_mt_init = false;
 
+namespace {
+    // Stream used by the current thread in place of the global generator,
+    // set by Random::ThreadStream
+    N2D2::Random::Stream* _threadStream = NULL;
+#pragma omp threadprivate(_threadStream)
+
+    // Second deviate of the Box-Muller transform in randNormal(), for the
+    // global generator
+    bool _availableDeviate = false;
+    double _storedDeviate = 0.0;
+#pragma omp threadprivate(_availableDeviate, _storedDeviate)
+}
+
 // Initialize the generator from a seed
 void N2D2::Random::mtSeed(unsigned int seed)
 {
@@ -45,6 +58,9 @@ void N2D2::Random::mtSeed(unsigned int seed)
 // Extract a tempered pseudorandom number based on the index-th value,
 unsigned int N2D2::Random::mtRand()
 {
+    if (_threadStream != NULL)
+        return _threadStream->rand();
+
     unsigned int y;
 
 #pragma omp critical(Random__mtRand)
@@ -80,9 +96,6 @@ unsigned int N2D2::Random::mtRand()
 
 double N2D2::Random::randNormal(double mean, double stdDev)
 {
-    static bool availableDeviate = false;
-    static double storedDeviate;
-
     if (stdDev < 0.0)
         throw std::domain_error(
             "Random::randNormal(): standard deviation must be >= 0.");
@@ -90,9 +103,12 @@ double N2D2::Random::randNormal(double mean, double stdDev)
     if (stdDev == 0.0)
         return mean;
 
-    if (availableDeviate) {
-        availableDeviate = false;
-        return (mean + stdDev * storedDeviate);
+    if (_threadStream != NULL)
+        return _threadStream->randNormal(mean, stdDev);
+
+    if (_availableDeviate) {
+        _availableDeviate = false;
+        return (mean + stdDev * _storedDeviate);
     } else {
         const double u1
             = randUniform(0.0, 1.0, LeftHalfOpenInterval); // u1 range is (0,1]
@@ -102,8 +118,8 @@ double N2D2::Random::randNormal(double mean, double stdDev)
         const double r = std::sqrt(-2.0 * std::log(u1));
         const double theta = 2.0 * M_PI * u2;
 
-        storedDeviate = r * std::sin(theta);
-        availableDeviate = true;
+        _storedDeviate = r * std::sin(theta);
+        _availableDeviate = true;
 
         return (mean + stdDev * (r * std::cos(theta)));
     }
@@ -173,3 +189,139 @@ bool N2D2::Random::randBernoulli(double p)
     // return 0 if x is in [p,1[ (p = 1 => return always 1)
     return (Random::randUniform(0.0, 1.0, Random::RightHalfOpenInterval) < p);
 }
+
+N2D2::Random::Stream::Stream(unsigned int seed, unsigned int stream)
+    : mIndex(4),
+      mAvailableDeviate(false),
+      mStoredDeviate(0.0)
+{
+    mKey[0] = seed;
+    mKey[1] = stream;
+    std::fill(mCounter, mCounter + 4, 0U);
+}
+
+void N2D2::Random::Stream::generate()
+{
+    const unsigned long long M0 = 0xD2511F53;
+    const unsigned long long M1 = 0xCD9E8D57;
+    const unsigned int W0 = 0x9E3779B9;
+    const unsigned int W1 = 0xBB67AE85;
+
+    unsigned int ctr[4] = {mCounter[0], mCounter[1], mCounter[2], mCounter[3]};
+    unsigned int key[2] = {mKey[0], mKey[1]};
+
+    for (unsigned int round = 0; round < 10; ++round) {
+        if (round > 0) {
+            key[0] += W0;
+            key[1] += W1;
+        }
+
+        const unsigned long long prod0 = M0 * ctr[0];
+        const unsigned long long prod1 = M1 * ctr[2];
+
+        const unsigned int c0 = (unsigned int)(prod1 >> 32) ^ ctr[1] ^ key[0];
+        const unsigned int c2 = (unsigned int)(prod0 >> 32) ^ ctr[3] ^ key[1];
+        ctr[1] = (unsigned int)prod1;
+        ctr[3] = (unsigned int)prod0;
+        ctr[0] = c0;
+        ctr[2] = c2;
+    }
+
+    std::copy(ctr, ctr + 4, mBuffer);
+
+    // Increment the 128-bit counter
+    for (unsigned int i = 0; i < 4; ++i) {
+        if (++mCounter[i] != 0)
+            break;
+    }
+}
+
+unsigned int N2D2::Random::Stream::rand()
+{
+    if (mIndex == 4) {
+        generate();
+        mIndex = 0;
+    }
+
+    return mBuffer[mIndex++];
+}
+
+double N2D2::Random::Stream::randUniform(double vmin,
+                                         double vmax,
+                                         Endpoints endpoints)
+{
+    if (vmax < vmin)
+        throw std::domain_error("Random::Stream::randUniform(): vmax must be"
+                                " >= vmin.");
+
+    if (endpoints == ClosedInterval) // [vmin,vmax]
+        return vmin + (double)rand() / MT_RAND_MAX * (vmax - vmin);
+    else if (endpoints == LeftHalfOpenInterval) // ]vmin,vmax] = (vmin,vmax]
+        return vmin + ((double)rand() + 1.0) / (MT_RAND_MAX + 1.0)
+                      * (vmax - vmin);
+    else if (endpoints == RightHalfOpenInterval) // [vmin,vmax[ = [vmin,vmax)
+        return vmin + (double)rand() / (MT_RAND_MAX + 1.0) * (vmax - vmin);
+    else // ]vmin,vmax[ = (vmin,vmax)
+        return vmin + ((double)rand() + 0.5) / (MT_RAND_MAX + 1.0)
+                      * (vmax - vmin);
+}
+
+int N2D2::Random::Stream::randUniform(int vmin, int vmax)
+{
+    if (vmax < vmin)
+        throw std::domain_error("Random::Stream::randUniform(): vmax must be"
+                                " >= vmin.");
+
+    return vmin + (int)((double)rand() / (MT_RAND_MAX + 1.0)
+                        * (vmax - vmin + 1.0));
+}
+
+double N2D2::Random::Stream::randNormal(double mean, double stdDev)
+{
+    if (stdDev < 0.0)
+        throw std::domain_error("Random::Stream::randNormal(): standard"
+                                " deviation must be >= 0.");
+
+    if (mAvailableDeviate) {
+        mAvailableDeviate = false;
+        return (mean + stdDev * mStoredDeviate);
+    }
+
+    const double u1 = randUniform(0.0, 1.0, LeftHalfOpenInterval);
+    const double u2 = randUniform(0.0, 1.0, LeftHalfOpenInterval);
+
+    const double r = std::sqrt(-2.0 * std::log(u1));
+    const double theta = 2.0 * M_PI * u2;
+
+    mStoredDeviate = r * std::sin(theta);
+    mAvailableDeviate = true;
+
+    return (mean + stdDev * (r * std::cos(theta)));
+}
+
+bool N2D2::Random::Stream::randBernoulli(double p)
+{
+    return (randUniform(0.0, 1.0, RightHalfOpenInterval) < p);
+}
+
+N2D2::Random::ThreadStream::ThreadStream(unsigned int seed,
+                                         unsigned int stream)
+    : mStream(new Stream(seed, stream)),
+      mPrevious(_threadStream)
+{
+    _threadStream = mStream;
+}
+
+N2D2::Random::ThreadStream::ThreadStream(Stream* stream)
+    : mStream(NULL),
+      mPrevious(_threadStream)
+{
+    if (stream != NULL)
+        _threadStream = stream;
+}
+
+N2D2::Random::ThreadStream::~ThreadStream()
+{
+    _threadStream = mPrevious;
+    delete mStream;
+}
@@ -0,0 +1,156 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/TaskGraph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+N2D2::TaskGraph::TaskGraph(unsigned int nbNodes)
+    : mSuccessors(nbNodes),
+      mNbPredecessors(nbNodes, 0U)
+{
+    // ctor
+}
+
+unsigned int N2D2::TaskGraph::addNode()
+{
+    mSuccessors.push_back(std::vector<unsigned int>());
+    mNbPredecessors.push_back(0U);
+    return mSuccessors.size() - 1;
+}
+
+void N2D2::TaskGraph::addEdge(unsigned int from, unsigned int to)
+{
+    if (from >= mSuccessors.size() || to >= mSuccessors.size())
+        throw std::out_of_range("TaskGraph::addEdge(): node out of range");
+
+    if (from == to)
+        throw std::runtime_error("TaskGraph::addEdge(): a node cannot depend"
+                                 " on itself");
+
+    if (std::find(mSuccessors[from].begin(), mSuccessors[from].end(), to)
+        == mSuccessors[from].end())
+    {
+        mSuccessors[from].push_back(to);
+        ++mNbPredecessors[to];
+    }
+}
+
+void N2D2::TaskGraph::run(const std::function<void(unsigned int)>& func) const
+{
+    const unsigned int nbNodes = mSuccessors.size();
+
+    State state;
+    state.func = &func;
+    state.nbPredecessors = mNbPredecessors;
+    state.nbRunning = 0;
+
+#ifdef _OPENMP
+    state.nbThreads = omp_get_max_threads();
+
+    // Allow the nested parallel regions of the tasks
+    const int maxActiveLevels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(maxActiveLevels,
+                                       omp_get_level() + 2));
+#else
+    state.nbThreads = 1;
+#endif
+
+    State* statePtr = &state;
+
+#pragma omp parallel if (nbNodes > 1)
+#pragma omp single
+    {
+        for (unsigned int node = 0; node < nbNodes; ++node) {
+            if (mNbPredecessors[node] == 0) {
+#pragma omp task firstprivate(node, statePtr)
+                runNode(node, statePtr);
+            }
+        }
+    }
+
+#ifdef _OPENMP
+    omp_set_max_active_levels(maxActiveLevels);
+#endif
+
+    if (state.exception)
+        std::rethrow_exception(state.exception);
+
+    for (unsigned int node = 0; node < nbNodes; ++node) {
+        if (state.nbPredecessors[node] > 0)
+            throw std::runtime_error("TaskGraph::run(): the graph is not"
+                                     " acyclic");
+    }
+}
+
+void N2D2::TaskGraph::runNode(unsigned int node, State* state) const
+{
+    unsigned int nbRunning;
+
+#pragma omp atomic capture
+    nbRunning = ++state->nbRunning;
+
+#ifdef _OPENMP
+    omp_set_num_threads(std::max(1U, state->nbThreads / nbRunning));
+#endif
+
+    bool success = true;
+
+    try {
+        (*state->func)(node);
+    }
+    catch (...) {
+#pragma omp critical(TaskGraph__runNode)
+        {
+            if (!state->exception)
+                state->exception = std::current_exception();
+        }
+
+        success = false;
+    }
+
+#pragma omp atomic
+    --state->nbRunning;
+
+    if (!success)
+        return;
+
+    for (std::vector<unsigned int>::const_iterator it
+         = mSuccessors[node].begin(), itEnd = mSuccessors[node].end();
+         it != itEnd;
+         ++it)
+    {
+        const unsigned int successor = (*it);
+        unsigned int nbPredecessors;
+
+#pragma omp atomic capture
+        nbPredecessors = --state->nbPredecessors[successor];
+
+        if (nbPredecessors == 0) {
+#pragma omp task firstprivate(successor, state)
+            runNode(successor, state);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "CEnvironment.hpp"
+#include "DeepNet.hpp"
+#include "Environment.hpp"
+#include "Network.hpp"
+#include "Cell/ConvCell_CSpike.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(ConvCell_CSpike,
+             tick,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int strideDims,
+              int paddingDims),
+             std::make_tuple(3U, 3U, 1U, 0),
+             std::make_tuple(3U, 3U, 1U, 1),
+             std::make_tuple(3U, 3U, 2U, 1),
+             std::make_tuple(5U, 3U, 2U, 2),
+             std::make_tuple(1U, 1U, 1U, 0))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbTicks = 1000;
+    const unsigned int channelsWidth = 8;
+    const unsigned int channelsHeight = 7;
+    const unsigned int nbChannels = 2;
+    const unsigned int nbOutputs = 3;
+    const unsigned int batchSize = 2;
+
+    Network net;
+    DeepNet dn(net);
+    CEnvironment env(EmptyDatabase,
+                     {channelsWidth, channelsHeight, nbChannels},
+                     batchSize);
+    env.setParameter("NoConversion", true);
+
+    ConvCell_CSpike conv1(dn, "conv1",
+                          std::vector<unsigned int>({kernelWidth,
+                                                     kernelHeight}),
+                          nbOutputs,
+                          std::vector<unsigned int>({1U, 1U}),
+                          std::vector<unsigned int>({strideDims, strideDims}),
+                          std::vector<int>({paddingDims, paddingDims}));
+    conv1.addInput(env);
+    conv1.initialize();
+
+    Tensor<Float_T>& data = env.getData();
+
+    for (unsigned int index = 0; index < data.size(); ++index)
+        data(index) = Random::randUniform(0.0, 0.5);
+
+    env.reset(0);
+    conv1.reset(0);
+
+    for (unsigned int t = 1; t <= nbTicks; ++t) {
+        env.tick(t * TimeNs, 0, nbTicks * TimeNs);
+        conv1.tick(t * TimeNs);
+    }
+
+    // Each output spike rate is the frame-based convolution output, within
+    // one spike
+    const Tensor<Float_T>& activity = conv1.getOutputsActivity();
+
+    ASSERT_EQUALS(activity.dimX(), conv1.getOutputsWidth());
+    ASSERT_EQUALS(activity.dimY(), conv1.getOutputsHeight());
+    ASSERT_EQUALS(activity.dimZ(), nbOutputs);
+    ASSERT_EQUALS(activity.dimB(), batchSize);
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            Tensor<Float_T> bias;
+            conv1.getBias(output, bias);
+
+            for (unsigned int oy = 0; oy < activity.dimY(); ++oy) {
+                for (unsigned int ox = 0; ox < activity.dimX(); ++ox) {
+                    double value = bias(0);
+
+                    for (unsigned int channel = 0; channel < nbChannels;
+                         ++channel)
+                    {
+                        Tensor<Float_T> kernel;
+                        conv1.getWeight(output, channel, kernel);
+
+                        for (unsigned int sy = 0; sy < kernelHeight; ++sy) {
+                            for (unsigned int sx = 0; sx < kernelWidth; ++sx)
+                            {
+                                const int ix = (int)(ox * strideDims + sx)
+                                    - paddingDims;
+                                const int iy = (int)(oy * strideDims + sy)
+                                    - paddingDims;
+
+                                if (ix >= 0 && ix < (int)channelsWidth
+                                    && iy >= 0 && iy < (int)channelsHeight)
+                                {
+                                    value += kernel(sx, sy)
+                                        * data(ix, iy, channel, batchPos);
+                                }
+                            }
+                        }
+                    }
+
+                    ASSERT_EQUALS_DELTA(
+                        activity(ox, oy, output, batchPos) / nbTicks,
+                        value,
+                        2.0 / nbTicks);
+                }
+            }
+        }
+    }
+}
+
+TEST(ConvCell_CSpike, reset)
+{
+    Network net;
+    DeepNet dn(net);
+    CEnvironment env(EmptyDatabase, {8U, 8U, 1U}, 1);
+    env.setParameter("NoConversion", true);
+
+    ConvCell_CSpike conv1(dn, "conv1",
+                          std::vector<unsigned int>({3U, 3U}),
+                          4U);
+    conv1.setParameter("NoBias", true);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    env.getData().fill(1.0);
+    env.reset(0);
+    conv1.reset(0);
+
+    for (unsigned int t = 1; t <= 10; ++t) {
+        env.tick(t * TimeNs, 0, 10 * TimeNs);
+        conv1.tick(t * TimeNs);
+    }
+
+    env.reset(0);
+    conv1.reset(0);
+
+    const Tensor<Float_T>& activity = conv1.getOutputsActivity();
+    const Tensor<Float_T>& outputs = conv1.getOutputs();
+
+    for (unsigned int index = 0; index < activity.size(); ++index) {
+        ASSERT_EQUALS(activity(index), 0.0);
+        ASSERT_EQUALS(outputs(index), 0.0);
+    }
+}
+
+RUN_TESTS()
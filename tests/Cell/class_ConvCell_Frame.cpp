@@ -1440,6 +1440,241 @@ TEST_DATASET(ConvCell_Frame_double,
     }
 }
 
+TEST_DATASET(ConvCell_Frame_double,
+             gemm_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight,
+              unsigned int nbChannels,
+              unsigned int nbOutputs),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, 24U, 24U, 3U, 8U),
+             std::make_tuple(2U, 5U, 1U, 1U, 0U, 0U, 24U, 32U, 4U, 5U),
+             std::make_tuple(3U, 3U, 2U, 2U, 0U, 0U, 32U, 24U, 2U, 7U),
+             std::make_tuple(3U, 3U, 1U, 3U, 2U, 2U, 24U, 24U, 5U, 3U),
+             std::make_tuple(5U, 5U, 3U, 2U, 2U, 1U, 17U, 13U, 16U, 9U),
+             std::make_tuple(1U, 1U, 1U, 1U, 0U, 0U, 7U, 7U, 20U, 30U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int batchSize = 3;
+    const unsigned int outputsWidth = (channelsWidth + 2 * paddingX
+                                       - kernelWidth + strideX) / strideX;
+    const unsigned int outputsHeight = (channelsHeight + 2 * paddingY
+                                        - kernelHeight + strideY) / strideY;
+
+    const ConvCell_Frame_Kernels::Descriptor directDesc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}),
+        ConvCell_Frame_Kernels::Direct);
+    const ConvCell_Frame_Kernels::Descriptor gemmDesc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}),
+        ConvCell_Frame_Kernels::GEMM);
+
+    Tensor<double> inputs({channelsWidth, channelsHeight, nbChannels,
+                           batchSize});
+    Tensor<double> sharedSynapses({kernelWidth, kernelHeight, nbChannels,
+                                   nbOutputs});
+    Tensor<double> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                               batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < sharedSynapses.size(); ++index)
+        sharedSynapses(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    const double alpha = 1.0;
+    const double beta = 0.5;
+
+    // forward
+    Tensor<double> directOutputs({outputsWidth, outputsHeight, nbOutputs,
+                                  batchSize}, 1.0);
+    Tensor<double> gemmOutputs({outputsWidth, outputsHeight, nbOutputs,
+                                batchSize}, 1.0);
+
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        directDesc, &beta, directOutputs);
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        gemmDesc, &beta, gemmOutputs);
+
+    for (unsigned int index = 0; index < directOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(gemmOutputs(index), directOutputs(index),
+                            1.0e-12);
+    }
+
+    // backwardData
+    Tensor<double> directDiffOutputs(inputs.dims(), 1.0);
+    Tensor<double> gemmDiffOutputs(inputs.dims(), 1.0);
+
+    ConvCell_Frame_Kernels::backwardData<double>(&alpha, sharedSynapses,
+        diffInputs, directDesc, &beta, directDiffOutputs);
+    ConvCell_Frame_Kernels::backwardData<double>(&alpha, sharedSynapses,
+        diffInputs, gemmDesc, &beta, gemmDiffOutputs);
+
+    for (unsigned int index = 0; index < directDiffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(gemmDiffOutputs(index), directDiffOutputs(index),
+                            1.0e-12);
+    }
+
+    // backwardFilter
+    Tensor<double> directDiffSynapses(sharedSynapses.dims(), 1.0);
+    Tensor<double> gemmDiffSynapses(sharedSynapses.dims(), 1.0);
+
+    ConvCell_Frame_Kernels::backwardFilter<double>(&alpha, inputs, diffInputs,
+        directDesc, &beta, directDiffSynapses);
+    ConvCell_Frame_Kernels::backwardFilter<double>(&alpha, inputs, diffInputs,
+        gemmDesc, &beta, gemmDiffSynapses);
+
+    for (unsigned int index = 0; index < directDiffSynapses.size(); ++index) {
+        ASSERT_EQUALS_DELTA(gemmDiffSynapses(index),
+                            directDiffSynapses(index), 1.0e-12);
+    }
+}
+
+TEST_DATASET(ConvCell_Frame_double,
+             winograd_check,
+             (ConvCell_Frame_Kernels::Algorithm algorithm,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              unsigned int channelsWidth,
+              unsigned int channelsHeight,
+              unsigned int nbChannels,
+              unsigned int nbOutputs),
+             std::make_tuple(ConvCell_Frame_Kernels::Winograd2x2,
+                             1U, 1U, 24U, 24U, 3U, 8U),
+             std::make_tuple(ConvCell_Frame_Kernels::Winograd2x2,
+                             0U, 2U, 13U, 7U, 5U, 3U),
+             std::make_tuple(ConvCell_Frame_Kernels::Winograd4x4,
+                             1U, 1U, 24U, 24U, 3U, 8U),
+             std::make_tuple(ConvCell_Frame_Kernels::Winograd4x4,
+                             2U, 0U, 11U, 17U, 4U, 6U))
+{
+    Random::mtSeed(0);
+
+    const unsigned int batchSize = 3;
+    const unsigned int outputsWidth = channelsWidth + 2 * paddingX - 2;
+    const unsigned int outputsHeight = channelsHeight + 2 * paddingY - 2;
+
+    const ConvCell_Frame_Kernels::Descriptor directDesc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}),
+        ConvCell_Frame_Kernels::Direct);
+    const ConvCell_Frame_Kernels::Descriptor winogradDesc(
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<unsigned int>({1U, 1U}),
+        std::vector<int>({(int)paddingX, (int)paddingY}),
+        std::vector<unsigned int>({1U, 1U}),
+        algorithm);
+
+    Tensor<double> inputs({channelsWidth, channelsHeight, nbChannels,
+                           batchSize});
+    Tensor<double> sharedSynapses({3, 3, nbChannels, nbOutputs});
+    Tensor<double> diffInputs({outputsWidth, outputsHeight, nbOutputs,
+                               batchSize});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < sharedSynapses.size(); ++index)
+        sharedSynapses(index) = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int index = 0; index < diffInputs.size(); ++index)
+        diffInputs(index) = Random::randUniform(-1.0, 1.0);
+
+    const double alpha = 1.0;
+    const double beta = 0.5;
+
+    ConvCell_Frame_Kernels::Workspace<double> workspace;
+    ConvCell_Frame_Kernels::WinogradFilters<double> winogradFilters;
+
+    // forward
+    Tensor<double> directOutputs({outputsWidth, outputsHeight, nbOutputs,
+                                  batchSize}, 1.0);
+    Tensor<double> winogradOutputs({outputsWidth, outputsHeight, nbOutputs,
+                                    batchSize}, 1.0);
+
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        directDesc, &beta, directOutputs);
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        winogradDesc, &beta, winogradOutputs, Tensor<bool>(), &workspace,
+        &winogradFilters);
+
+    ASSERT_EQUALS(winogradFilters.valid, true);
+
+    for (unsigned int index = 0; index < directOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(winogradOutputs(index), directOutputs(index),
+                            1.0e-12);
+    }
+
+    // backwardData
+    Tensor<double> directDiffOutputs(inputs.dims(), 1.0);
+    Tensor<double> winogradDiffOutputs(inputs.dims(), 1.0);
+
+    ConvCell_Frame_Kernels::backwardData<double>(&alpha, sharedSynapses,
+        diffInputs, directDesc, &beta, directDiffOutputs);
+    ConvCell_Frame_Kernels::backwardData<double>(&alpha, sharedSynapses,
+        diffInputs, winogradDesc, &beta, winogradDiffOutputs, Tensor<bool>(),
+        &workspace, &winogradFilters);
+
+    for (unsigned int index = 0; index < directDiffOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(winogradDiffOutputs(index),
+                            directDiffOutputs(index), 1.0e-12);
+    }
+
+    // The transformed filters must be recomputed once invalidated
+    for (unsigned int index = 0; index < sharedSynapses.size(); ++index)
+        sharedSynapses(index) = Random::randUniform(-1.0, 1.0);
+
+    winogradFilters.valid = false;
+
+    directOutputs.fill(0.0);
+    winogradOutputs.fill(0.0);
+
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        directDesc, &beta, directOutputs);
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        winogradDesc, &beta, winogradOutputs, Tensor<bool>(), &workspace,
+        &winogradFilters);
+
+    for (unsigned int index = 0; index < directOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(winogradOutputs(index), directOutputs(index),
+                            1.0e-12);
+    }
+
+    // ... and also when the filters are modified without invalidation (for
+    // example shared with another cell)
+    sharedSynapses(sharedSynapses.size() / 2) += 1.0;
+
+    directOutputs.fill(0.0);
+    winogradOutputs.fill(0.0);
+
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        directDesc, &beta, directOutputs);
+    ConvCell_Frame_Kernels::forward<double>(&alpha, inputs, sharedSynapses,
+        winogradDesc, &beta, winogradOutputs, Tensor<bool>(), &workspace,
+        &winogradFilters);
+
+    for (unsigned int index = 0; index < directOutputs.size(); ++index) {
+        ASSERT_EQUALS_DELTA(winogradOutputs(index), directOutputs(index),
+                            1.0e-12);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // half
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,243 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/ConvCell_Frame_INT8.hpp"
+#include "DeepNet.hpp"
+#include "Filler/UniformFiller.hpp"
+#include "Network.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class ConvCell_Frame_INT8_Test : public ConvCell_Frame_INT8 {
+public:
+    ConvCell_Frame_INT8_Test(const DeepNet& deepNet,
+                             const std::string& name,
+                             const std::vector<unsigned int>& kernelDims,
+                             unsigned int nbOutputs,
+                             const std::vector<unsigned int>& strideDims,
+                             const std::vector<int>& paddingDims)
+        : Cell(deepNet, name, nbOutputs),
+          ConvCell(deepNet, name,
+                   kernelDims,
+                   nbOutputs,
+                   std::vector<unsigned int>(2, 1U),
+                   strideDims,
+                   paddingDims,
+                   std::vector<unsigned int>(2, 1U)),
+          ConvCell_Frame_INT8(deepNet, name,
+                              kernelDims,
+                              nbOutputs,
+                              std::vector<unsigned int>(2, 1U),
+                              strideDims,
+                              paddingDims,
+                              std::vector<unsigned int>(2, 1U),
+                              std::shared_ptr<Activation>()) {};
+
+    friend class UnitTest_ConvCell_Frame_INT8_propagate_check;
+    friend class UnitTest_ConvCell_Frame_INT8_propagate_fallback;
+    friend class UnitTest_ConvCell_Frame_INT8_propagate_cache;
+};
+
+TEST_DATASET(ConvCell_Frame_INT8,
+             propagate_check,
+             (unsigned int kernelWidth,
+              unsigned int kernelHeight,
+              unsigned int strideX,
+              unsigned int strideY,
+              unsigned int paddingX,
+              unsigned int paddingY,
+              bool signedInputs,
+              bool sparseMap),
+             std::make_tuple(3U, 3U, 1U, 1U, 0U, 0U, false, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, false, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, true, false),
+             std::make_tuple(3U, 3U, 1U, 1U, 1U, 1U, false, true),
+             std::make_tuple(2U, 5U, 2U, 2U, 0U, 0U, false, false),
+             std::make_tuple(2U, 5U, 1U, 3U, 1U, 3U, true, true),
+             std::make_tuple(1U, 1U, 1U, 1U, 0U, 0U, true, false),
+             std::make_tuple(5U, 5U, 2U, 1U, 2U, 2U, false, false))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbOutputs = 6;
+
+    Network net;
+    DeepNet dn(net);
+
+    ConvCell_Frame_INT8_Test conv1(dn, "conv1",
+        std::vector<unsigned int>({kernelWidth, kernelHeight}),
+        nbOutputs,
+        std::vector<unsigned int>({strideX, strideY}),
+        std::vector<int>({(int)paddingX, (int)paddingY}));
+    conv1.setWeightsFiller(
+        std::make_shared<UniformFiller<float> >(-128.0, 127.0));
+    conv1.setBiasFiller(
+        std::make_shared<UniformFiller<float> >(-1000.0, 1000.0));
+
+    Tensor<float> inputs({13, 11, 4, 3});
+    Tensor<float> diffOutputs({13, 11, 4, 3});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index) {
+        inputs(index) = (signedInputs) ? Random::randUniform(-128, 127)
+                                       : Random::randUniform(0, 255);
+    }
+
+    conv1.addInput(inputs, diffOutputs);
+    conv1.initialize();
+
+    if (sparseMap) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int channel = 0; channel < inputs.dimZ(); ++channel)
+                conv1.mMapping(output, channel) = ((output + channel) % 3 != 0);
+        }
+    }
+
+    // Integer free parameters, as after DeepNetQuantization
+    conv1.processFreeParameters([](Float_T p) { return std::round(p); });
+    conv1.setQuantized(8);
+
+    ASSERT_TRUE(conv1.propagateInt8());
+    const Tensor<float> outputsInt8 = tensor_cast<float>(conv1.getOutputs());
+
+    conv1.ConvCell_Frame<float>::propagate(true);
+    const Tensor<float>& outputs = tensor_cast<float>(conv1.getOutputs());
+
+    ASSERT_EQUALS(outputsInt8.size(), outputs.size());
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        ASSERT_EQUALS(outputsInt8(index), outputs(index));
+}
+
+TEST(ConvCell_Frame_INT8,
+     propagate_fallback)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    ConvCell_Frame_INT8_Test conv1(dn, "conv1",
+        std::vector<unsigned int>({3, 3}),
+        4,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}));
+    conv1.setWeightsFiller(
+        std::make_shared<UniformFiller<float> >(-100.0, 100.0));
+
+    Tensor<float> inputs({8, 8, 2, 2});
+    Tensor<float> diffOutputs({8, 8, 2, 2});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(0, 255);
+
+    conv1.addInput(inputs, diffOutputs);
+    conv1.initialize();
+
+    // Not quantized
+    ASSERT_TRUE(!conv1.propagateInt8());
+
+    // Non integer weights
+    conv1.setQuantized(8);
+    ASSERT_TRUE(!conv1.propagateInt8());
+
+    conv1.processFreeParameters([](Float_T p) { return std::round(p); });
+    ASSERT_TRUE(conv1.propagateInt8());
+
+    // Inputs out of the 8 bits range
+    inputs(0) = 256.0;
+    ASSERT_TRUE(!conv1.propagateInt8());
+
+    // Non integer inputs
+    inputs(0) = 0.5;
+    ASSERT_TRUE(!conv1.propagateInt8());
+
+    inputs(0) = 255.0;
+    ASSERT_TRUE(conv1.propagateInt8());
+
+    // More than 8 bits
+    conv1.setQuantized(16);
+    ASSERT_TRUE(!conv1.propagateInt8());
+}
+
+TEST(ConvCell_Frame_INT8,
+     propagate_cache)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    ConvCell_Frame_INT8_Test conv1(dn, "conv1",
+        std::vector<unsigned int>({3, 3}),
+        4,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1}));
+    conv1.setWeightsFiller(
+        std::make_shared<UniformFiller<float> >(-100.0, 100.0));
+    conv1.setBiasFiller(
+        std::make_shared<UniformFiller<float> >(-1000.0, 1000.0));
+
+    Tensor<float> inputs({8, 8, 2, 2});
+    Tensor<float> diffOutputs({8, 8, 2, 2});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(0, 255);
+
+    conv1.addInput(inputs, diffOutputs);
+    conv1.initialize();
+
+    conv1.processFreeParameters([](Float_T p) { return std::round(p); });
+    conv1.setQuantized(8);
+    ASSERT_TRUE(conv1.propagateInt8());
+
+    // The cached integer weights must follow each modification of the
+    // free parameters
+    for (unsigned int step = 0; step < 3; ++step) {
+        if (step == 0) {
+            conv1.processFreeParameters(
+                [](Float_T p) { return std::round(p / 2.0); });
+        }
+        else if (step == 1) {
+            Interface<float>* sharedSynapses
+                = dynamic_cast<Interface<float>*>(conv1.getWeights());
+            (*sharedSynapses)[0](0) = -(*sharedSynapses)[0](0);
+        }
+        else {
+            std::shared_ptr<Tensor<float> > biases
+                = std::dynamic_pointer_cast<Tensor<float> >(conv1.getBiases());
+            (*biases)(0) += 1.0;
+        }
+
+        ASSERT_TRUE(conv1.propagateInt8());
+        const Tensor<float> outputsInt8
+            = tensor_cast<float>(conv1.getOutputs());
+
+        conv1.ConvCell_Frame<float>::propagate(true);
+        const Tensor<float>& outputs = tensor_cast<float>(conv1.getOutputs());
+
+        for (unsigned int index = 0; index < outputs.size(); ++index)
+            ASSERT_EQUALS(outputsInt8(index), outputs(index));
+    }
+}
+
+RUN_TESTS()
@@ -0,0 +1,299 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "DeepNet.hpp"
+#include "Environment.hpp"
+#include "Network.hpp"
+#include "Cell/ConvCell_Spike.hpp"
+#include "Cell/NodeIn.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class ConvCell_Spike_Test : public ConvCell_Spike {
+public:
+    ConvCell_Spike_Test(Network& net,
+                        const DeepNet& deepNet,
+                        const std::string& name,
+                        const std::vector<unsigned int>& kernelDims,
+                        unsigned int nbOutputs)
+        : Cell(deepNet, name, nbOutputs),
+          ConvCell(deepNet, name, kernelDims, nbOutputs),
+          ConvCell_Spike(net, deepNet, name, kernelDims, nbOutputs) {};
+
+    /// Draw the synapses as the Tensor-backed storage did, with one
+    /// Synapse_Static object per synapse
+    Tensor<Synapse*> newSynapses() const
+    {
+        Tensor<Synapse*> synapses({mKernelDims[0], mKernelDims[1],
+                                   getNbChannels(), getNbOutputs()});
+
+        for (size_t index = 0; index < synapses.size(); ++index)
+            synapses(index) = newSynapse();
+
+        return synapses;
+    }
+
+    friend class UnitTest_ConvCell_Spike_initialize;
+    friend class UnitTest_ConvCell_Spike_setWeight;
+    friend class UnitTest_ConvCell_Spike_saveFreeParameters__loadFreeParameters;
+    friend class UnitTest_ConvCell_Spike_incomingSpike;
+};
+
+static void deleteSynapses(Tensor<Synapse*>& synapses)
+{
+    for (size_t index = 0; index < synapses.size(); ++index)
+        delete synapses(index);
+}
+
+TEST(ConvCell_Spike, initialize)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {5, 4, 2});
+
+    ConvCell_Spike_Test conv1(net, dn, "conv1",
+                              std::vector<unsigned int>({3, 2}), 3U);
+    conv1.addInput(env);
+
+    Random::mtSeed(0);
+    conv1.initialize();
+
+    Random::mtSeed(0);
+    Tensor<Synapse*> synapses = conv1.newSynapses();
+
+    ASSERT_EQUALS(conv1.mSharedSynapses.size(), 0U);
+    ASSERT_EQUALS(conv1.mPackedSynapses.size(), synapses.size());
+
+    // Same synapses, in the same order, as the Tensor-backed storage
+    for (unsigned int output = 0; output < 3U; ++output) {
+        for (unsigned int channel = 0; channel < 2U; ++channel) {
+            for (unsigned int sy = 0; sy < 2U; ++sy) {
+                for (unsigned int sx = 0; sx < 3U; ++sx) {
+                    const Synapse_Static* synapse
+                        = static_cast<Synapse_Static*>(
+                            synapses(sx, sy, channel, output));
+
+                    ASSERT_EQUALS(conv1.mPackedSynapses.getWeight(
+                        conv1.synapseIndex(sx, sy, channel, output)),
+                        synapse->weight);
+                    ASSERT_EQUALS(conv1.mPackedSynapses.getDelay(
+                        conv1.synapseIndex(sx, sy, channel, output)),
+                        synapse->delay);
+                }
+            }
+        }
+    }
+
+    deleteSynapses(synapses);
+}
+
+TEST(ConvCell_Spike, setWeight)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {5, 4, 2});
+
+    ConvCell_Spike_Test conv1(net, dn, "conv1",
+                              std::vector<unsigned int>({3, 2}), 3U);
+    conv1.addInput(env);
+    conv1.initialize();
+
+    Tensor<Float_T> weights({3U, 2U, 2U, 3U});
+
+    for (unsigned int output = 0; output < 3U; ++output) {
+        for (unsigned int channel = 0; channel < 2U; ++channel) {
+            Tensor<Float_T> kernel = weights[output][channel];
+
+            for (unsigned int index = 0; index < kernel.size(); ++index)
+                kernel(index) = Random::randUniform(-1.0, 1.0);
+
+            conv1.setWeight(output, channel, kernel);
+        }
+    }
+
+    for (unsigned int output = 0; output < 3U; ++output) {
+        for (unsigned int channel = 0; channel < 2U; ++channel) {
+            Tensor<Float_T> kernel;
+            conv1.getWeight(output, channel, kernel);
+
+            ASSERT_EQUALS(kernel.dimX(), 3U);
+            ASSERT_EQUALS(kernel.dimY(), 2U);
+
+            for (unsigned int sy = 0; sy < 2U; ++sy) {
+                for (unsigned int sx = 0; sx < 3U; ++sx) {
+                    ASSERT_EQUALS(kernel(sx, sy),
+                                  weights(sx, sy, channel, output));
+                    ASSERT_EQUALS_DELTA(conv1.mPackedSynapses.getWeight(
+                        conv1.synapseIndex(sx, sy, channel, output)),
+                        weights(sx, sy, channel, output),
+                        1.0e-6);
+                }
+            }
+        }
+    }
+}
+
+TEST(ConvCell_Spike, saveFreeParameters__loadFreeParameters)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {5, 4, 2});
+
+    ConvCell_Spike_Test conv1(net, dn, "conv1",
+                              std::vector<unsigned int>({3, 2}), 3U);
+    conv1.addInput(env);
+    Random::mtSeed(0);
+    conv1.initialize();
+
+    ConvCell_Spike_Test conv2(net, dn, "conv2",
+                              std::vector<unsigned int>({3, 2}), 3U);
+    conv2.addInput(env);
+    Random::mtSeed(1);
+    conv2.initialize();
+
+    Utils::createDirectories("Spike");
+    conv1.saveFreeParameters("Spike/conv1.syn");
+    conv2.loadFreeParameters("Spike/conv1.syn");
+
+    for (unsigned int output = 0; output < 3U; ++output) {
+        for (unsigned int channel = 0; channel < 2U; ++channel) {
+            Tensor<Float_T> kernel1;
+            Tensor<Float_T> kernel2;
+            conv1.getWeight(output, channel, kernel1);
+            conv2.getWeight(output, channel, kernel2);
+
+            for (unsigned int index = 0; index < kernel1.size(); ++index) {
+                ASSERT_EQUALS(kernel2(index), kernel1(index));
+            }
+        }
+    }
+
+    // A synaptic file saved by the Tensor-backed storage still loads
+    Random::mtSeed(1);
+    Tensor<Synapse*> synapses = conv1.newSynapses();
+
+    std::ofstream syn("Spike/conv1_synapses.syn", std::ios::binary);
+
+    for (size_t index = 0; index < synapses.size(); ++index)
+        synapses(index)->saveInternal(syn);
+
+    syn.close();
+
+    conv2.loadFreeParameters("Spike/conv1_synapses.syn");
+
+    for (size_t index = 0; index < synapses.size(); ++index) {
+        ASSERT_EQUALS(conv2.mPackedSynapses.getWeight(index),
+                      static_cast<Synapse_Static*>(synapses(index))->weight);
+    }
+
+    deleteSynapses(synapses);
+}
+
+TEST_DATASET(ConvCell_Spike,
+             incomingSpike,
+             (double threshold, bool delays),
+             std::make_tuple(1.0e9, true),
+             std::make_tuple(1.0e9, false),
+             std::make_tuple(0.5, false))
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {5, 4, 2});
+
+    ConvCell_Spike_Test conv1(net, dn, "conv1",
+                              std::vector<unsigned int>({3, 2}), 3U);
+    conv1.setParameter("Threshold", threshold);
+    conv1.setParameter<Weight_T>("WeightsRelInit", 0.0, 0.5);
+
+    if (!delays)
+        conv1.setParameter<Time_T>("IncomingDelay", 0, 0.0);
+
+    conv1.addInput(env);
+
+    Random::mtSeed(0);
+    conv1.initialize();
+    conv1.notify(0, NetworkObserver::Initialize);
+
+    Random::mtSeed(0);
+    Tensor<Synapse*> synapses = conv1.newSynapses();
+
+    // Integration as computed with the Tensor-backed storage
+    const unsigned int outputsWidth = conv1.getOutputsWidth();
+    const unsigned int outputsHeight = conv1.getOutputsHeight();
+    Tensor<double> integration({outputsWidth, outputsHeight, 3U}, 0.0);
+
+    ASSERT_EQUALS(outputsWidth, 3U);
+    ASSERT_EQUALS(outputsHeight, 3U);
+
+    for (unsigned int t = 1; t <= 1000; ++t) {
+        NodeIn* origin
+            = conv1.mInputs[Random::randUniform(0, conv1.mInputs.size() - 1)];
+        const bool negative = (Random::randUniform() < 0.2);
+
+        conv1.propagateSpike(origin, t * TimeNs, negative);
+
+        const Area& area = origin->getArea();
+
+        for (unsigned int output = 0; output < 3U; ++output) {
+            for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+                for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+                    // Stride of 1 and no padding
+                    if (area.x < ox || area.x >= ox + 3U
+                        || area.y < oy || area.y >= oy + 2U)
+                    {
+                        continue;
+                    }
+
+                    const double weight = static_cast<Synapse_Static*>(
+                        synapses(area.x - ox, area.y - oy,
+                                 origin->getChannel(), output))->weight;
+                    double& value = integration(ox, oy, output);
+                    value += (negative) ? -weight : weight;
+
+                    if (value >= threshold)
+                        value -= threshold;
+                    else if (-value >= threshold)
+                        value += threshold;
+                }
+            }
+        }
+    }
+
+    // Process the delayed synaptic events
+    net.run();
+
+    for (unsigned int output = 0; output < 3U; ++output) {
+        for (unsigned int oy = 0; oy < outputsHeight; ++oy) {
+            for (unsigned int ox = 0; ox < outputsWidth; ++ox) {
+                ASSERT_EQUALS_DELTA(conv1.mOutputsIntegration(ox, oy,
+                                                              output, 0),
+                                    integration(ox, oy, output),
+                                    1.0e-9);
+            }
+        }
+    }
+
+    deleteSynapses(synapses);
+}
+
+RUN_TESTS()
@@ -0,0 +1,159 @@
+/*
+    (C) Copyright 2014 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/FMPCell_Frame.hpp"
+#include "DeepNet.hpp"
+#include "Network.hpp"
+#include "utils/UnitTest.hpp"
+#include "utils/Random.hpp"
+
+using namespace N2D2;
+
+class FMPCell_Frame_Test : public FMPCell_Frame {
+public:
+    FMPCell_Frame_Test(const DeepNet& deepNet,
+                       const std::string& name,
+                       double scalingRatio,
+                       unsigned int nbOutputs)
+        : Cell(deepNet, name, nbOutputs),
+          FMPCell(deepNet, name, scalingRatio, nbOutputs),
+          FMPCell_Frame(deepNet, name, scalingRatio, nbOutputs) {};
+
+    friend class UnitTest_FMPCell_Frame_backPropagate;
+};
+
+TEST_DATASET(FMPCell_Frame,
+             backPropagate,
+             (unsigned int nbChannels,
+              unsigned int nbOutputs,
+              unsigned int batchSize,
+              bool overlapping,
+              bool accumulate),
+             std::make_tuple(1U, 1U, 1U, true, false),
+             std::make_tuple(3U, 3U, 2U, true, false),
+             std::make_tuple(3U, 2U, 5U, false, false),
+             std::make_tuple(4U, 6U, 8U, true, true),
+             std::make_tuple(2U, 3U, 3U, false, true))
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    const unsigned int inputWidth = 11;
+    const unsigned int inputHeight = 9;
+
+    Tensor<Float_T> inputs({inputWidth, inputHeight, nbChannels, batchSize});
+    Tensor<Float_T> diffOutputs({inputWidth, inputHeight, nbChannels,
+                                 batchSize});
+
+    for (unsigned int i = 0; i < inputs.size(); ++i) {
+        inputs(i) = Random::randNormal();
+        diffOutputs(i) = Random::randNormal();
+    }
+
+    const Tensor<Float_T> prevDiffOutputs = diffOutputs.clone();
+
+    if (accumulate)
+        diffOutputs.setValid();
+
+    FMPCell_Frame_Test fmp1(dn, "fmp1", 1.5, nbOutputs);
+    fmp1.setParameter("Overlapping", overlapping);
+    fmp1.addInput(inputs, diffOutputs);
+    fmp1.initialize();
+
+    fmp1.propagate();
+
+    for (unsigned int i = 0; i < fmp1.mDiffInputs.size(); ++i)
+        fmp1.mDiffInputs(i) = Random::randNormal();
+
+    fmp1.mDiffInputs.setValid();
+    fmp1.backPropagate();
+
+    // Brute-force scan of the pooling regions, with the same grid
+    Tensor<Float_T> expected({inputWidth, inputHeight, nbChannels, batchSize},
+                             0.0);
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            for (unsigned int oy = 0; oy < fmp1.getOutputsHeight(); ++oy) {
+                for (unsigned int ox = 0; ox < fmp1.getOutputsWidth(); ++ox)
+                {
+                    unsigned int ixStart, ixStop;
+                    unsigned int iyStart, iyStop;
+                    fmp1.getRegion(fmp1.mGridX, inputWidth, ox,
+                                   ixStart, ixStop);
+                    fmp1.getRegion(fmp1.mGridY, inputHeight, oy,
+                                   iyStart, iyStop);
+
+                    Float_T poolValue
+                        = -std::numeric_limits<Float_T>::infinity();
+                    unsigned int channelMax = 0;
+                    unsigned int ixMax = 0;
+                    unsigned int iyMax = 0;
+
+                    for (unsigned int channel = 0; channel < nbChannels;
+                         ++channel)
+                    {
+                        for (unsigned int iy = iyStart; iy <= iyStop; ++iy) {
+                            for (unsigned int ix = ixStart; ix <= ixStop;
+                                 ++ix)
+                            {
+                                if (inputs(ix, iy, channel, batchPos)
+                                    > poolValue)
+                                {
+                                    poolValue
+                                        = inputs(ix, iy, channel, batchPos);
+                                    channelMax = channel;
+                                    ixMax = ix;
+                                    iyMax = iy;
+                                }
+                            }
+                        }
+                    }
+
+                    expected(ixMax, iyMax, channelMax, batchPos)
+                        += fmp1.mDiffInputs(ox, oy, output, batchPos);
+                }
+            }
+        }
+    }
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int channel = 0; channel < nbChannels; ++channel) {
+            for (unsigned int iy = 0; iy < inputHeight; ++iy) {
+                for (unsigned int ix = 0; ix < inputWidth; ++ix) {
+                    const Float_T value = expected(ix, iy, channel, batchPos)
+                        + ((accumulate)
+                            ? prevDiffOutputs(ix, iy, channel, batchPos)
+                            : 0.0);
+
+                    ASSERT_EQUALS_DELTA(
+                        diffOutputs(ix, iy, channel, batchPos), value,
+                        1.0e-6);
+                }
+            }
+        }
+    }
+}
+
+RUN_TESTS()
@@ -0,0 +1,146 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "CEnvironment.hpp"
+#include "DeepNet.hpp"
+#include "Environment.hpp"
+#include "Network.hpp"
+#include "Cell/FcCell_CSpike.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(FcCell_CSpike,
+             tick,
+             (unsigned int nbOutputs, double leak),
+             std::make_tuple(1U, 0.0),
+             std::make_tuple(10U, 0.0),
+             std::make_tuple(10U, 1000.0))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbTicks = 1000;
+    const unsigned int channelsWidth = 5;
+    const unsigned int channelsHeight = 4;
+    const unsigned int nbChannels = 3;
+    const unsigned int batchSize = 3;
+
+    Network net;
+    DeepNet dn(net);
+    CEnvironment env(EmptyDatabase,
+                     {channelsWidth, channelsHeight, nbChannels},
+                     batchSize);
+    env.setParameter("NoConversion", true);
+
+    FcCell_CSpike fc1(dn, "fc1", nbOutputs);
+    fc1.setParameter("Leak", (Time_T)(leak * TimeNs));
+    fc1.addInput(env);
+    fc1.initialize();
+
+    Tensor<Float_T>& data = env.getData();
+
+    for (unsigned int index = 0; index < data.size(); ++index)
+        data(index) = Random::randUniform(0.0, 0.2);
+
+    env.reset(0);
+    fc1.reset(0);
+
+    for (unsigned int t = 1; t <= nbTicks; ++t) {
+        env.tick(t * TimeNs, 0, nbTicks * TimeNs);
+        fc1.tick(t * TimeNs);
+    }
+
+    const Tensor<Float_T>& activity = fc1.getOutputsActivity();
+    const unsigned int inputsSize = fc1.getInputsSize();
+
+    ASSERT_EQUALS(activity.dimZ(), nbOutputs);
+    ASSERT_EQUALS(activity.dimB(), batchSize);
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbOutputs; ++output) {
+            Tensor<Float_T> bias;
+            fc1.getBias(output, bias);
+
+            double value = bias(0);
+
+            for (unsigned int channel = 0; channel < inputsSize; ++channel) {
+                Tensor<Float_T> weight;
+                fc1.getWeight(output, channel, weight);
+
+                value += weight(0) * data(channel + inputsSize * batchPos);
+            }
+
+            if (leak > 0.0) {
+                // With the leak, the integration cannot exceed
+                // value / (1 - exp(-1/leak)) in magnitude: the neuron fires
+                // less than without the leak
+                ASSERT_TRUE(std::fabs(activity(0, 0, output, batchPos))
+                            <= std::fabs(value) * nbTicks + 1.0);
+            }
+            else {
+                // The spike rate is the frame-based output, within one spike
+                ASSERT_EQUALS_DELTA(activity(0, 0, output, batchPos) / nbTicks,
+                                    value,
+                                    2.0 / nbTicks);
+            }
+        }
+    }
+}
+
+TEST(FcCell_CSpike, saveFreeParameters__loadFreeParameters)
+{
+    Network net;
+    DeepNet dn(net);
+    CEnvironment env(EmptyDatabase, {4U, 4U, 2U}, 1);
+
+    FcCell_CSpike fc1(dn, "fc1", 5U);
+    fc1.addInput(env);
+    fc1.initialize();
+
+    FcCell_CSpike fc2(dn, "fc2", 5U);
+    fc2.addInput(env);
+    fc2.initialize();
+
+    Utils::createDirectories("CSpike");
+    fc1.saveFreeParameters("CSpike/fc1.syntxt");
+    fc2.loadFreeParameters("CSpike/fc1.syntxt");
+
+    for (unsigned int output = 0; output < 5U; ++output) {
+        Tensor<Float_T> bias1;
+        Tensor<Float_T> bias2;
+        fc1.getBias(output, bias1);
+        fc2.getBias(output, bias2);
+
+        ASSERT_EQUALS(bias2(0), bias1(0));
+
+        for (unsigned int channel = 0; channel < 32U; ++channel) {
+            Tensor<Float_T> weight1;
+            Tensor<Float_T> weight2;
+            fc1.getWeight(output, channel, weight1);
+            fc2.getWeight(output, channel, weight2);
+
+            ASSERT_EQUALS(weight2(0), weight1(0));
+        }
+    }
+}
+
+RUN_TESTS()
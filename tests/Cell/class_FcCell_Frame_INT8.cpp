@@ -0,0 +1,191 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Cell/FcCell_Frame_INT8.hpp"
+#include "DeepNet.hpp"
+#include "Filler/UniformFiller.hpp"
+#include "Network.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class FcCell_Frame_INT8_Test : public FcCell_Frame_INT8 {
+public:
+    FcCell_Frame_INT8_Test(const DeepNet& deepNet,
+                           const std::string& name,
+                           unsigned int nbOutputs)
+        : Cell(deepNet, name, nbOutputs),
+          FcCell(deepNet, name, nbOutputs),
+          FcCell_Frame_INT8(deepNet, name, nbOutputs,
+                            std::shared_ptr<Activation>()) {};
+
+    friend class UnitTest_FcCell_Frame_INT8_propagate_check;
+    friend class UnitTest_FcCell_Frame_INT8_propagate_fallback;
+    friend class UnitTest_FcCell_Frame_INT8_propagate_cache;
+};
+
+TEST_DATASET(FcCell_Frame_INT8,
+             propagate_check,
+             (unsigned int nbOutputs,
+              unsigned int batchSize,
+              bool signedInputs,
+              bool twoInputs),
+             std::make_tuple(1U, 1U, false, false),
+             std::make_tuple(10U, 1U, true, false),
+             std::make_tuple(10U, 5U, false, true),
+             std::make_tuple(130U, 3U, true, false),
+             std::make_tuple(70U, 64U, false, false),
+             std::make_tuple(33U, 7U, true, true))
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    FcCell_Frame_INT8_Test fc1(dn, "fc1", nbOutputs);
+    fc1.setWeightsFiller(
+        std::make_shared<UniformFiller<float> >(-128.0, 127.0));
+    fc1.setBiasFiller(
+        std::make_shared<UniformFiller<float> >(-1000.0, 1000.0));
+
+    Tensor<float> inputsA({7, 5, 3, batchSize});
+    Tensor<float> inputsB({7, 5, 2, batchSize});
+    Tensor<float> diffOutputsA({7, 5, 3, batchSize});
+    Tensor<float> diffOutputsB({7, 5, 2, batchSize});
+
+    for (unsigned int index = 0; index < inputsA.size(); ++index) {
+        inputsA(index) = (signedInputs) ? Random::randUniform(-128, 127)
+                                        : Random::randUniform(0, 255);
+    }
+
+    for (unsigned int index = 0; index < inputsB.size(); ++index)
+        inputsB(index) = Random::randUniform(0, 255);
+
+    fc1.addInput(inputsA, diffOutputsA);
+
+    if (twoInputs)
+        fc1.addInput(inputsB, diffOutputsB);
+
+    fc1.initialize();
+
+    // Integer free parameters, as after DeepNetQuantization
+    fc1.processFreeParameters([](Float_T p) { return std::round(p); });
+    fc1.setQuantized(8);
+
+    ASSERT_TRUE(fc1.propagateInt8());
+    const Tensor<float> outputsInt8 = tensor_cast<float>(fc1.getOutputs());
+
+    fc1.FcCell_Frame<float>::propagate(true);
+    const Tensor<float>& outputs = tensor_cast<float>(fc1.getOutputs());
+
+    ASSERT_EQUALS(outputsInt8.size(), outputs.size());
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        ASSERT_EQUALS(outputsInt8(index), outputs(index));
+}
+
+TEST(FcCell_Frame_INT8,
+     propagate_fallback)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    FcCell_Frame_INT8_Test fc1(dn, "fc1", 8);
+    fc1.setWeightsFiller(
+        std::make_shared<UniformFiller<float> >(-100.0, 100.0));
+
+    Tensor<float> inputs({4, 4, 2, 3});
+    Tensor<float> diffOutputs({4, 4, 2, 3});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-128, 127);
+
+    fc1.addInput(inputs, diffOutputs);
+    fc1.initialize();
+
+    // Not quantized
+    ASSERT_TRUE(!fc1.propagateInt8());
+
+    // Non integer weights
+    fc1.setQuantized(8);
+    ASSERT_TRUE(!fc1.propagateInt8());
+
+    fc1.processFreeParameters([](Float_T p) { return std::round(p); });
+    ASSERT_TRUE(fc1.propagateInt8());
+
+    // Inputs out of the 8 bits range
+    inputs(0) = -129.0;
+    ASSERT_TRUE(!fc1.propagateInt8());
+
+    inputs(0) = -128.0;
+    ASSERT_TRUE(fc1.propagateInt8());
+
+    // Weights out of the 8 bits range
+    fc1.processFreeParameters([](Float_T p) { return 2.0 * p; },
+                              Cell::Multiplicative);
+    ASSERT_TRUE(!fc1.propagateInt8());
+}
+
+TEST(FcCell_Frame_INT8,
+     propagate_cache)
+{
+    Random::mtSeed(0);
+
+    Network net;
+    DeepNet dn(net);
+
+    FcCell_Frame_INT8_Test fc1(dn, "fc1", 8);
+    fc1.setWeightsFiller(
+        std::make_shared<UniformFiller<float> >(-100.0, 100.0));
+    fc1.setBiasFiller(
+        std::make_shared<UniformFiller<float> >(-1000.0, 1000.0));
+
+    Tensor<float> inputs({4, 4, 2, 3});
+    Tensor<float> diffOutputs({4, 4, 2, 3});
+
+    for (unsigned int index = 0; index < inputs.size(); ++index)
+        inputs(index) = Random::randUniform(-128, 127);
+
+    fc1.addInput(inputs, diffOutputs);
+    fc1.initialize();
+
+    fc1.processFreeParameters([](Float_T p) { return std::round(p); });
+    fc1.setQuantized(8);
+    ASSERT_TRUE(fc1.propagateInt8());
+
+    // The cached integer weights must follow each modification of the
+    // free parameters
+    fc1.processFreeParameters([](Float_T p) { return std::round(p / 2.0); });
+
+    ASSERT_TRUE(fc1.propagateInt8());
+    const Tensor<float> outputsInt8 = tensor_cast<float>(fc1.getOutputs());
+
+    fc1.FcCell_Frame<float>::propagate(true);
+    const Tensor<float>& outputs = tensor_cast<float>(fc1.getOutputs());
+
+    for (unsigned int index = 0; index < outputs.size(); ++index)
+        ASSERT_EQUALS(outputsInt8(index), outputs(index));
+}
+
+RUN_TESTS()
@@ -0,0 +1,332 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "DeepNet.hpp"
+#include "Environment.hpp"
+#include "Network.hpp"
+#include "NodeEnv.hpp"
+#include "Cell/FcCell_Spike.hpp"
+#include "Cell/NodeIn.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+class FcCell_Spike_Test : public FcCell_Spike {
+public:
+    FcCell_Spike_Test(Network& net,
+                      const DeepNet& deepNet,
+                      const std::string& name,
+                      unsigned int nbOutputs)
+        : Cell(deepNet, name, nbOutputs),
+          FcCell(deepNet, name, nbOutputs),
+          FcCell_Spike(net, deepNet, name, nbOutputs) {};
+
+    /// Draw the synapses as the Tensor-backed storage did, with one
+    /// Synapse_Static object per synapse
+    Tensor<Synapse*> newSynapses() const
+    {
+        std::vector<size_t> synapsesDims = mInputsDims;
+        synapsesDims.push_back(getNbOutputs());
+
+        Tensor<Synapse*> synapses(synapsesDims);
+
+        for (size_t index = 0; index < synapses.size(); ++index)
+            synapses(index) = newSynapse();
+
+        return synapses;
+    }
+
+    friend class UnitTest_FcCell_Spike_initialize;
+    friend class UnitTest_FcCell_Spike_setWeight;
+    friend class UnitTest_FcCell_Spike_saveFreeParameters__loadFreeParameters;
+    friend class UnitTest_FcCell_Spike_incomingSpike;
+    friend class UnitTest_FcCell_Spike_incomingSpike__partitioned;
+};
+
+static void deleteSynapses(Tensor<Synapse*>& synapses)
+{
+    for (size_t index = 0; index < synapses.size(); ++index)
+        delete synapses(index);
+}
+
+TEST(FcCell_Spike, initialize)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {4, 3, 2});
+
+    FcCell_Spike_Test fc1(net, dn, "fc1", 5U);
+    fc1.addInput(env);
+
+    Random::mtSeed(0);
+    fc1.initialize();
+
+    Random::mtSeed(0);
+    Tensor<Synapse*> synapses = fc1.newSynapses();
+
+    ASSERT_EQUALS(fc1.mSynapses.size(), 0U);
+    ASSERT_EQUALS(fc1.mPackedSynapses.size(), synapses.size());
+
+    // Same synapses, in the same order, as the Tensor-backed storage
+    for (unsigned int output = 0; output < 5U; ++output) {
+        for (unsigned int channel = 0; channel < 2U; ++channel) {
+            for (unsigned int y = 0; y < 3U; ++y) {
+                for (unsigned int x = 0; x < 4U; ++x) {
+                    const Synapse_Static* synapse
+                        = static_cast<Synapse_Static*>(
+                            synapses(x, y, channel, output));
+
+                    ASSERT_EQUALS(fc1.mPackedSynapses.getWeight(
+                        fc1.synapseIndex(x, y, channel, output)),
+                        synapse->weight);
+                    ASSERT_EQUALS(fc1.mPackedSynapses.getDelay(
+                        fc1.synapseIndex(x, y, channel, output)),
+                        synapse->delay);
+                }
+            }
+        }
+    }
+
+    deleteSynapses(synapses);
+}
+
+TEST(FcCell_Spike, setWeight)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {4, 3, 2});
+
+    FcCell_Spike_Test fc1(net, dn, "fc1", 5U);
+    fc1.addInput(env);
+    fc1.initialize();
+
+    const unsigned int inputsSize = fc1.getInputsSize();
+    Tensor<Float_T> weights({inputsSize, 5U});
+
+    for (unsigned int output = 0; output < 5U; ++output) {
+        for (unsigned int channel = 0; channel < inputsSize; ++channel) {
+            weights(channel, output) = Random::randUniform(-1.0, 1.0);
+            fc1.setWeight(output, channel,
+                          Tensor<Float_T>({1}, weights(channel, output)));
+        }
+    }
+
+    for (unsigned int output = 0; output < 5U; ++output) {
+        for (unsigned int channel = 0; channel < inputsSize; ++channel) {
+            Tensor<Float_T> weight;
+            fc1.getWeight(output, channel, weight);
+
+            ASSERT_EQUALS(weight(0), weights(channel, output));
+            ASSERT_EQUALS_DELTA(fc1.mPackedSynapses.getWeight(
+                                    channel + inputsSize * output),
+                                weights(channel, output),
+                                1.0e-6);
+        }
+    }
+}
+
+TEST(FcCell_Spike, saveFreeParameters__loadFreeParameters)
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {4, 3, 2});
+
+    FcCell_Spike_Test fc1(net, dn, "fc1", 5U);
+    fc1.addInput(env);
+    Random::mtSeed(0);
+    fc1.initialize();
+
+    FcCell_Spike_Test fc2(net, dn, "fc2", 5U);
+    fc2.addInput(env);
+    Random::mtSeed(1);
+    fc2.initialize();
+
+    Utils::createDirectories("Spike");
+    fc1.saveFreeParameters("Spike/fc1.syn");
+    fc2.loadFreeParameters("Spike/fc1.syn");
+
+    const unsigned int inputsSize = fc1.getInputsSize();
+
+    for (unsigned int output = 0; output < 5U; ++output) {
+        for (unsigned int channel = 0; channel < inputsSize; ++channel) {
+            Tensor<Float_T> weight1;
+            Tensor<Float_T> weight2;
+            fc1.getWeight(output, channel, weight1);
+            fc2.getWeight(output, channel, weight2);
+
+            ASSERT_EQUALS(weight2(0), weight1(0));
+        }
+    }
+
+    // A synaptic file saved by the Tensor-backed storage still loads
+    Random::mtSeed(1);
+    Tensor<Synapse*> synapses = fc1.newSynapses();
+
+    std::ofstream syn("Spike/fc1_synapses.syn", std::ios::binary);
+
+    for (size_t index = 0; index < synapses.size(); ++index)
+        synapses(index)->saveInternal(syn);
+
+    syn.close();
+
+    fc2.loadFreeParameters("Spike/fc1_synapses.syn");
+
+    for (size_t index = 0; index < synapses.size(); ++index) {
+        ASSERT_EQUALS(fc2.mPackedSynapses.getWeight(index),
+                      static_cast<Synapse_Static*>(synapses(index))->weight);
+    }
+
+    deleteSynapses(synapses);
+}
+
+TEST_DATASET(FcCell_Spike,
+             incomingSpike,
+             (double threshold, bool delays),
+             std::make_tuple(1.0e9, true),
+             std::make_tuple(1.0e9, false),
+             std::make_tuple(0.5, false))
+{
+    Network net;
+    DeepNet dn(net);
+    Environment env(net, EmptyDatabase, {4, 3, 2});
+
+    FcCell_Spike_Test fc1(net, dn, "fc1", 5U);
+    fc1.setParameter("Threshold", threshold);
+    fc1.setParameter<Weight_T>("WeightsRelInit", 0.0, 0.5);
+
+    if (!delays)
+        fc1.setParameter<Time_T>("IncomingDelay", 0, 0.0);
+
+    fc1.addInput(env);
+
+    Random::mtSeed(0);
+    fc1.initialize();
+    fc1.notify(0, NetworkObserver::Initialize);
+
+    Random::mtSeed(0);
+    Tensor<Synapse*> synapses = fc1.newSynapses();
+
+    // Integration and number of activations as computed with the
+    // Tensor-backed storage
+    std::vector<double> integration(5U, 0.0);
+    std::vector<int> nbActivations(5U, 0);
+
+    for (unsigned int t = 1; t <= 1000; ++t) {
+        NodeIn* origin
+            = fc1.mInputs[Random::randUniform(0, fc1.mInputs.size() - 1)];
+        const bool negative = (Random::randUniform() < 0.2);
+
+        fc1.propagateSpike(origin, t * TimeNs, negative);
+
+        const Area& area = origin->getArea();
+
+        for (unsigned int output = 0; output < 5U; ++output) {
+            const double weight = static_cast<Synapse_Static*>(
+                synapses(area.x, area.y, origin->getChannel(), output))->weight;
+            integration[output] += (negative) ? -weight : weight;
+
+            if (integration[output] >= threshold) {
+                integration[output] -= threshold;
+                ++nbActivations[output];
+            }
+            else if (-integration[output] >= threshold) {
+                integration[output] += threshold;
+                --nbActivations[output];
+            }
+        }
+    }
+
+    // Process the delayed synaptic events
+    net.run();
+
+    for (unsigned int output = 0; output < 5U; ++output) {
+        ASSERT_EQUALS_DELTA(fc1.mOutputsIntegration[output],
+                            integration[output],
+                            1.0e-9);
+        ASSERT_EQUALS(fc1.mNbActivations[output], nbActivations[output]);
+    }
+
+    deleteSynapses(synapses);
+}
+
+TEST_DATASET(FcCell_Spike,
+             incomingSpike__partitioned,
+             (double threshold),
+             std::make_tuple(1.0e9),
+             std::make_tuple(0.5))
+{
+    // Same integration when the environment is in another partition, whose
+    // spikes are delayed by the minimum synaptic delay of the cell
+    std::vector<double> integration[2];
+    std::vector<int> nbActivations[2];
+
+    for (unsigned int partitioned = 0; partitioned < 2; ++partitioned) {
+        Network net(1);
+        DeepNet dn(net);
+        Environment env(net, EmptyDatabase, {4, 3, 2});
+
+        FcCell_Spike_Test fc1(net, dn, "fc1", 5U);
+        fc1.setParameter("Threshold", threshold);
+        fc1.setParameter<Weight_T>("WeightsRelInit", 0.0, 0.5);
+        fc1.addInput(env);
+        fc1.initialize();
+        fc1.notify(0, NetworkObserver::Initialize);
+
+        if (partitioned) {
+            fc1.setPartition(1);
+
+            ASSERT_TRUE(fc1.isPartitionBoundary());
+            ASSERT_EQUALS(fc1.getPartitionDelay(), fc1.getMinDelay());
+            ASSERT_TRUE(fc1.getPartitionDelay() > 0);
+
+            net.setPartitioning(2, fc1.getPartitionDelay());
+        }
+        else
+            ASSERT_TRUE(!fc1.isPartitionBoundary());
+
+        const std::vector<NodeEnv*> nodes = env.getNodes();
+
+        for (unsigned int t = 1; t <= 1000; ++t) {
+            NodeEnv* node = nodes[Random::randUniform(0, nodes.size() - 1)];
+            const bool negative = (Random::randUniform() < 0.2);
+
+            node->incomingSpike(NULL, t * TimeNs, negative);
+        }
+
+        net.run();
+
+        for (unsigned int output = 0; output < 5U; ++output) {
+            integration[partitioned].push_back(
+                fc1.mOutputsIntegration[output]);
+            nbActivations[partitioned].push_back(fc1.mNbActivations[output]);
+        }
+    }
+
+    for (unsigned int output = 0; output < 5U; ++output) {
+        ASSERT_EQUALS_DELTA(integration[1][output],
+                            integration[0][output],
+                            1.0e-9);
+        ASSERT_EQUALS(nbActivations[1][output], nbActivations[0][output]);
+    }
+}
+
+RUN_TESTS()
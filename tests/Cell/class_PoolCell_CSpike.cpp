@@ -0,0 +1,123 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "CEnvironment.hpp"
+#include "DeepNet.hpp"
+#include "Environment.hpp"
+#include "Network.hpp"
+#include "Cell/PoolCell_CSpike.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(PoolCell_CSpike,
+             tick,
+             (unsigned int poolDims,
+              unsigned int strideDims,
+              PoolCell::Pooling pooling),
+             std::make_tuple(2U, 2U, PoolCell::Max),
+             std::make_tuple(3U, 2U, PoolCell::Max),
+             std::make_tuple(2U, 2U, PoolCell::Average),
+             std::make_tuple(3U, 1U, PoolCell::Average))
+{
+    Random::mtSeed(0);
+
+    const unsigned int nbTicks = 1000;
+    const unsigned int channelsWidth = 8;
+    const unsigned int channelsHeight = 6;
+    const unsigned int nbChannels = 2;
+    const unsigned int batchSize = 2;
+
+    Network net;
+    DeepNet dn(net);
+    CEnvironment env(EmptyDatabase,
+                     {channelsWidth, channelsHeight, nbChannels},
+                     batchSize);
+    env.setParameter("NoConversion", true);
+
+    // One-to-one mapping between the input and output channels
+    Tensor<bool> mapping({nbChannels, nbChannels}, false);
+
+    for (unsigned int channel = 0; channel < nbChannels; ++channel)
+        mapping(channel, channel) = true;
+
+    PoolCell_CSpike pool1(dn, "pool1",
+                          std::vector<unsigned int>({poolDims, poolDims}),
+                          nbChannels,
+                          std::vector<unsigned int>({strideDims, strideDims}),
+                          std::vector<unsigned int>({0U, 0U}),
+                          pooling);
+    pool1.addInput(env, 0, 0, 0, 0, mapping);
+    pool1.initialize();
+
+    Tensor<Float_T>& data = env.getData();
+
+    for (unsigned int index = 0; index < data.size(); ++index)
+        data(index) = Random::randUniform(0.0, 1.0);
+
+    env.reset(0);
+    pool1.reset(0);
+
+    for (unsigned int t = 1; t <= nbTicks; ++t) {
+        env.tick(t * TimeNs, 0, nbTicks * TimeNs);
+        pool1.tick(t * TimeNs);
+    }
+
+    // The output activity follows the max. (or average) input activity,
+    // within one spike
+    const Tensor<Float_T>& activity = pool1.getOutputsActivity();
+
+    ASSERT_EQUALS(activity.dimX(), pool1.getOutputsWidth());
+    ASSERT_EQUALS(activity.dimY(), pool1.getOutputsHeight());
+
+    for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+        for (unsigned int output = 0; output < nbChannels; ++output) {
+            for (unsigned int oy = 0; oy < activity.dimY(); ++oy) {
+                for (unsigned int ox = 0; ox < activity.dimX(); ++ox) {
+                    double value = 0.0;
+
+                    for (unsigned int sy = 0; sy < poolDims; ++sy) {
+                        for (unsigned int sx = 0; sx < poolDims; ++sx) {
+                            const double input
+                                = data(ox * strideDims + sx,
+                                       oy * strideDims + sy,
+                                       output,
+                                       batchPos);
+
+                            if (pooling == PoolCell::Max)
+                                value = std::max(value, input);
+                            else
+                                value += input / (poolDims * poolDims);
+                        }
+                    }
+
+                    ASSERT_EQUALS_DELTA(
+                        activity(ox, oy, output, batchPos) / nbTicks,
+                        value,
+                        2.0 / nbTicks);
+                }
+            }
+        }
+    }
+}
+
+RUN_TESTS()
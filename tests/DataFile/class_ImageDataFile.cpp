@@ -0,0 +1,170 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include "N2D2.hpp"
+
+#include "DataFile/ImageDataFile.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+// JPEG file with only the markers preceding the frame header
+std::string ImageDataFile_jpegHeader(unsigned int width,
+                                     unsigned int height,
+                                     unsigned int precision = 8,
+                                     unsigned int nbComponents = 3,
+                                     unsigned char sof = 0xC0)
+{
+    std::string header;
+    // SOI
+    header += "\xFF\xD8";
+    // APP0 (JFIF)
+    header += std::string("\xFF\xE0\x00\x10JFIF\x00\x01\x01\x00\x00\x01"
+                          "\x00\x01\x00\x00", 18);
+    // DHT, to be skipped
+    header += std::string("\xFF\xC4\x00\x04\x00\x00", 6);
+    // Fill bytes before SOF
+    header += "\xFF\xFF";
+    header += (char)sof;
+    header += (char)0x00;
+    header += (char)(8 + 3 * nbComponents);
+    header += (char)precision;
+    header += (char)(height >> 8);
+    header += (char)(height & 0xFF);
+    header += (char)(width >> 8);
+    header += (char)(width & 0xFF);
+    header += (char)nbComponents;
+
+    for (unsigned int c = 0; c < nbComponents; ++c)
+        header += std::string("\x01\x11\x00", 3);
+
+    return header;
+}
+
+TEST_DATASET(ImageDataFile,
+             getReduction,
+             (unsigned int width,
+              unsigned int height,
+              unsigned int minWidth,
+              unsigned int minHeight,
+              unsigned int reduction),
+             std::make_tuple(4000U, 3000U, 512U, 512U, 4U),
+             std::make_tuple(4000U, 3000U, 500U, 375U, 8U),
+             std::make_tuple(4000U, 3000U, 501U, 375U, 4U),
+             std::make_tuple(4001U, 3001U, 501U, 376U, 8U),
+             std::make_tuple(4000U, 3000U, 1000U, 1000U, 2U),
+             std::make_tuple(4000U, 3000U, 2000U, 1600U, 1U),
+             std::make_tuple(640U, 480U, 1024U, 1024U, 1U),
+             std::make_tuple(640U, 480U, 0U, 0U, 1U))
+{
+    UnitTest::FileWriteContent("ImageDataFile_getReduction.jpg",
+                               ImageDataFile_jpegHeader(width, height));
+
+    ImageDataFile dataFile;
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction.jpg",
+                                        cv::Size(minWidth, minHeight)).factor,
+                  reduction);
+}
+
+TEST(ImageDataFile, getReduction_unsupported)
+{
+    ImageDataFile dataFile;
+    const cv::Size minSize(100, 100);
+
+    // Progressive JPEG
+    UnitTest::FileWriteContent("ImageDataFile_getReduction_2.jpg",
+        ImageDataFile_jpegHeader(800, 800, 8, 3, 0xC2));
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction_2.jpg",
+                                        minSize).factor, 8U);
+
+    // Grayscale JPEG
+    UnitTest::FileWriteContent("ImageDataFile_getReduction_1.jpg",
+        ImageDataFile_jpegHeader(800, 800, 8, 1));
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction_1.jpg",
+                                        minSize).factor, 8U);
+
+    // 12 bits JPEG
+    UnitTest::FileWriteContent("ImageDataFile_getReduction_12b.jpg",
+        ImageDataFile_jpegHeader(800, 800, 12, 3));
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction_12b.jpg",
+                                        minSize).factor, 1U);
+
+    // CMYK JPEG
+    UnitTest::FileWriteContent("ImageDataFile_getReduction_4.jpg",
+        ImageDataFile_jpegHeader(800, 800, 8, 4));
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction_4.jpg",
+                                        minSize).factor, 1U);
+
+    // Not a JPEG file
+    UnitTest::FileWriteContent("ImageDataFile_getReduction.png",
+                               "\x89PNG\r\n\x1A\n");
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction.png",
+                                        minSize).factor, 1U);
+
+    // Truncated before the frame header
+    UnitTest::FileWriteContent("ImageDataFile_getReduction_trunc.jpg",
+        ImageDataFile_jpegHeader(800, 800).substr(0, 24));
+    ASSERT_EQUALS(dataFile.getReduction("ImageDataFile_getReduction_trunc.jpg",
+                                        minSize).factor, 1U);
+
+    ASSERT_THROW(dataFile.readReduced("ImageDataFile_getReduction.png",
+                                      DataFile::Reduction(3)),
+                 std::runtime_error);
+}
+
+TEST(ImageDataFile, readReduced)
+{
+    cv::Mat img(480, 640, CV_8UC3);
+
+    for (int i = 0; i < img.rows; ++i) {
+        for (int j = 0; j < img.cols; ++j) {
+            img.at<cv::Vec3b>(i, j) = cv::Vec3b(i / 2, j / 3, 128);
+        }
+    }
+
+    ImageDataFile dataFile;
+    dataFile.write("ImageDataFile_readReduced.jpg", img);
+
+    const DataFile::Reduction reduction
+        = dataFile.getReduction("ImageDataFile_readReduced.jpg",
+                                cv::Size(150, 100));
+    ASSERT_EQUALS(reduction.factor, 4U);
+
+    const cv::Mat data = dataFile.readReduced("ImageDataFile_readReduced.jpg",
+                                              reduction);
+    ASSERT_EQUALS(data.cols, 160);
+    ASSERT_EQUALS(data.rows, 120);
+    ASSERT_EQUALS(data.channels(), 3);
+    ASSERT_EQUALS(data.depth(), CV_8U);
+
+    // Compare to the full resolution decoding, rescaled
+    const cv::Mat full = dataFile.read("ImageDataFile_readReduced.jpg");
+    cv::Mat fullRescaled;
+    cv::resize(full, fullRescaled, data.size(), 0.0, 0.0, cv::INTER_AREA);
+
+    cv::Mat diff;
+    cv::absdiff(data, fullRescaled, diff);
+    double maxDiff;
+    cv::minMaxLoc(diff.reshape(1), NULL, &maxDiff);
+    ASSERT_TRUE(maxDiff < 16.0);
+}
+
+RUN_TESTS()
@@ -73,4 +73,58 @@ TEST_DATASET(CIFAR100_Database,
     ASSERT_EQUALS(db.getNbLabels(), 100U);
 }
 
+TEST(CIFAR10_Database, loadCIFAR)
+{
+    const unsigned int nbImages = 2;
+    const unsigned int size = 32 * 32;
+
+    Utils::createDirectories("CIFAR_Database");
+
+    std::ofstream labels("CIFAR_Database/batches.meta.txt");
+    labels << "airplane\nautomobile\nbird\n";
+    labels.close();
+
+    std::ofstream images("CIFAR_Database/data_batch.bin", std::fstream::binary);
+
+    for (unsigned int i = 0; i < nbImages; ++i) {
+        images.put((char)(2 - i));
+
+        // Red, green and blue planes
+        for (unsigned int c = 0; c < 3; ++c) {
+            for (unsigned int k = 0; k < size; ++k)
+                images.put((char)((10 * i + c + k) % 256));
+        }
+    }
+
+    images.close();
+
+    CIFAR10_Database db;
+    db.loadCIFAR("CIFAR_Database/data_batch.bin",
+                 "CIFAR_Database/batches.meta.txt");
+
+    ASSERT_EQUALS(db.getNbStimuli(), nbImages);
+    ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(0)), "bird");
+    ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(1)), "automobile");
+
+    for (unsigned int id = 0; id < nbImages; ++id) {
+        const cv::Mat data = db.getStimulusData(id);
+
+        ASSERT_EQUALS(data.channels(), 3);
+        ASSERT_EQUALS(data.rows, 32);
+        ASSERT_EQUALS(data.cols, 32);
+
+        for (unsigned int k = 0; k < size; k += 37) {
+            const cv::Vec3b color = data.at<cv::Vec3b>(k / 32, k % 32);
+
+            // Vec3b color order: blue, green, red
+            ASSERT_EQUALS((int)color[2], (int)((10 * id + k) % 256));
+            ASSERT_EQUALS((int)color[1], (int)((10 * id + 1 + k) % 256));
+            ASSERT_EQUALS((int)color[0], (int)((10 * id + 2 + k) % 256));
+        }
+
+        // No intermediate image file
+        ASSERT_TRUE(!std::ifstream(db.getStimulusName(id).c_str()).good());
+    }
+}
+
 RUN_TESTS()
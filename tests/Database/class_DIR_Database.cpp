@@ -23,8 +23,33 @@
 #include "Database/DIR_Database.hpp"
 #include "utils/UnitTest.hpp"
 
+#include <cstdio>
+#include <utime.h>
+
 using namespace N2D2;
 
+namespace {
+void setModificationTime(const std::string& path, time_t mtime)
+{
+    struct utimbuf times;
+    times.actime = mtime;
+    times.modtime = mtime;
+    utime(path.c_str(), &times);
+}
+
+std::vector<std::string> getStimuliNames(const Database& db)
+{
+    std::vector<std::string> names;
+
+    for (unsigned int id = 0; id < db.getNbStimuli(); ++id) {
+        names.push_back(db.getStimulusName(id) + " "
+                        + db.getLabelName(db.getStimulusLabel(id)));
+    }
+
+    return names;
+}
+}
+
 TEST(DIR_Database, load)
 {
     REQUIRED(UnitTest::DirExists(N2D2_DATA("lfw")));
@@ -58,4 +83,100 @@ TEST(DIR_Database, load)
     ASSERT_EQUALS(db.getStimulusLabel(nbStimuli - 1), db.getLabelID("/Zydrunas_Ilgauskas"));
 }
 
+TEST(DIR_Database, loadDirs)
+{
+    const std::string root = "DIR_Database_loadDirs";
+
+    Utils::createDirectories(root + "/a");
+    Utils::createDirectories(root + "/b/c");
+    Utils::createDirectories(root + "/d");
+    UnitTest::FileWriteContent(root + "/a/x.png", "");
+    UnitTest::FileWriteContent(root + "/a/y.png", "");
+    UnitTest::FileWriteContent(root + "/b/z.png", "");
+    UnitTest::FileWriteContent(root + "/b/c/w.png", "");
+    UnitTest::FileWriteContent(root + "/d/v.png", "");
+    UnitTest::FileWriteContent(root + "/d/u.png", "");
+
+    DIR_Database db;
+    db.loadDir(root, -1, "", 1);
+
+    ASSERT_EQUALS(db.getNbStimuli(), 6U);
+    ASSERT_EQUALS(db.getStimulusName(0), root + "/a/x.png");
+    ASSERT_EQUALS(db.getStimulusName(1), root + "/a/y.png");
+    ASSERT_EQUALS(db.getStimulusName(2), root + "/b/z.png");
+    ASSERT_EQUALS(db.getStimulusName(3), root + "/b/c/w.png");
+    ASSERT_EQUALS(db.getStimulusName(4), root + "/d/u.png");
+    ASSERT_EQUALS(db.getStimulusName(5), root + "/d/v.png");
+    ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(3)), "/b");
+    ASSERT_EQUALS(db.getLabelID("/a"), 0);
+    ASSERT_EQUALS(db.getLabelID("/b"), 1);
+    ASSERT_EQUALS(db.getLabelID("/d"), 2);
+
+    // Same order as successive loadDir() calls
+    DIR_Database dbSeq;
+    dbSeq.loadDir(root + "/d", 0, "d", 0);
+    dbSeq.loadDir(root + "/a", 0, "a", 0);
+
+    DIR_Database dbPar;
+    dbPar.loadDirs({root + "/d", root + "/a"}, 0, {"d", "a"}, 0);
+
+    ASSERT_TRUE(getStimuliNames(dbPar) == getStimuliNames(dbSeq));
+    ASSERT_EQUALS(dbPar.getLabelID("d"), 0);
+}
+
+TEST(DIR_Database, loadDir__manifest)
+{
+    const std::string root = "DIR_Database_manifest";
+    const std::string manifest = root + ".manifest";
+
+    Utils::createDirectories(root + "/a");
+    Utils::createDirectories(root + "/b");
+    UnitTest::FileWriteContent(root + "/a/x.png", "");
+    UnitTest::FileWriteContent(root + "/b/y.png", "");
+    UnitTest::FileRemove(root + "/b/z.png");
+    UnitTest::FileRemove(manifest);
+
+    // Recently modified directories are not cached
+    const time_t oldTime = time(NULL) - 3600;
+    setModificationTime(root, oldTime);
+    setModificationTime(root + "/a", oldTime);
+    setModificationTime(root + "/b", oldTime);
+
+    DIR_Database db1;
+    db1.setParameter("ManifestPath", manifest);
+    db1.loadDir(root, 1, "", 1);
+
+    ASSERT_EQUALS(db1.getNbStimuli(), 2U);
+    ASSERT_TRUE(UnitTest::FileExists(manifest));
+
+    // The manifest is used while the directories are unchanged
+    UnitTest::FileRemove(root + "/a/x.png");
+    setModificationTime(root + "/a", oldTime);
+
+    DIR_Database db2;
+    db2.setParameter("ManifestPath", manifest);
+    db2.loadDir(root, 1, "", 1);
+
+    ASSERT_TRUE(getStimuliNames(db2) == getStimuliNames(db1));
+
+    // A modified directory is scanned again
+    UnitTest::FileWriteContent(root + "/b/z.png", "");
+
+    DIR_Database db3;
+    db3.setParameter("ManifestPath", manifest);
+    db3.loadDir(root, 1, "", 1);
+
+    ASSERT_EQUALS(db3.getNbStimuli(), 3U);
+    ASSERT_EQUALS(db3.getStimulusName(0), root + "/a/x.png");
+    ASSERT_EQUALS(db3.getStimulusName(1), root + "/b/y.png");
+    ASSERT_EQUALS(db3.getStimulusName(2), root + "/b/z.png");
+
+    // Without manifest
+    DIR_Database db4;
+    db4.loadDir(root, 1, "", 1);
+
+    ASSERT_EQUALS(db4.getNbStimuli(), 2U);
+    ASSERT_EQUALS(db4.getStimulusName(0), root + "/b/y.png");
+}
+
 RUN_TESTS()
@@ -21,6 +21,7 @@
 #include "N2D2.hpp"
 
 #include "Database/Database.hpp"
+#include "ROI/RectangularROI.hpp"
 #include "utils/UnitTest.hpp"
 #include "utils/Utils.hpp"
 
@@ -428,4 +429,203 @@ TEST_DATASET(Database,
 }
 
 
+class Database_ReducedDecode : public Database {
+public:
+    void addStimulus(const std::string& name, int label, ROI* roi = NULL)
+    {
+        mStimuli.push_back(Stimulus(name, label,
+            (roi != NULL) ? std::vector<ROI*>(1, roi) : std::vector<ROI*>()));
+        mStimuliSets(Unpartitioned).push_back(mStimuli.size() - 1);
+    }
+};
+
+TEST(Database, getLabelsIndexes)
+{
+    Random::mtSeed(0);
+
+    Database_Test db(100, 5);
+    db.load("");
+    db.partitionStimuli(50, Database::Learn);
+
+    const std::vector<std::vector<unsigned int> >& labelsIndexes
+        = db.getLabelsIndexes(Database::Learn);
+
+    ASSERT_EQUALS(labelsIndexes.size(), 5U);
+
+    unsigned int nbIndexes = 0;
+
+    for (unsigned int label = 0; label < labelsIndexes.size(); ++label) {
+        for (unsigned int i = 0; i < labelsIndexes[label].size(); ++i) {
+            ASSERT_EQUALS(db.getStimulusLabel(Database::Learn,
+                                              labelsIndexes[label][i]),
+                          (int)label);
+        }
+
+        nbIndexes += labelsIndexes[label].size();
+    }
+
+    ASSERT_EQUALS(nbIndexes, 50U);
+
+    // The index is rebuilt after a partitioning change
+    db.partitionStimuli(50, Database::Learn);
+
+    ASSERT_EQUALS(db.getLabelIndexes(Database::Learn, 0).size(), 20U);
+    ASSERT_EQUALS(db.getLabelIndexes(Database::Unpartitioned, 0).size(), 0U);
+
+    // ... after the removal of a stimulus
+    db.removeStimulus(db.getStimulusID(Database::Learn,
+                                    db.getLabelIndexes(Database::Learn, 1)[0]));
+
+    ASSERT_EQUALS(db.getLabelIndexes(Database::Learn, 1).size(), 19U);
+
+    // ... and after a change of ROIs
+    db.setStimulusROIs(db.getStimulusID(Database::Learn,
+                                    db.getLabelIndexes(Database::Learn, 2)[0]),
+        std::vector<ROI*>(1, new RectangularROI<int>(3, cv::Point(0, 0), 10,
+                                                     10)));
+
+    ASSERT_EQUALS(db.getLabelIndexes(Database::Learn, 2).size(), 20U);
+    ASSERT_EQUALS(db.getLabelIndexes(Database::Learn, 3).size(), 21U);
+    ASSERT_THROW(db.getLabelIndexes(Database::Learn, 5), std::runtime_error);
+}
+
+TEST(Database, getLabelsCumulativeWeights)
+{
+    Random::mtSeed(0);
+
+    Database_Test db(100, 5);
+    db.load("");
+    db.partitionStimuli(50, Database::Learn);
+
+    const std::vector<double>& cumWeights
+        = db.getLabelsCumulativeWeights(Database::Learn);
+
+    ASSERT_EQUALS(cumWeights.size(), 5U);
+
+    for (unsigned int label = 0; label < cumWeights.size(); ++label) {
+        ASSERT_EQUALS(cumWeights[label], label + 1.0);
+    }
+
+    // The cumulative weights are rebuilt for other labels weights
+    std::vector<double> labelsWeights;
+    labelsWeights.push_back(2.0);
+    labelsWeights.push_back(1.0);
+    labelsWeights.push_back(0.5);
+
+    const std::vector<double>& cumLabelsWeights
+        = db.getLabelsCumulativeWeights(Database::Learn, labelsWeights);
+
+    ASSERT_EQUALS(cumLabelsWeights.size(), 5U);
+    ASSERT_EQUALS(cumLabelsWeights[0], 2.0);
+    ASSERT_EQUALS(cumLabelsWeights[1], 3.0);
+    ASSERT_EQUALS(cumLabelsWeights[2], 3.5);
+    ASSERT_EQUALS(cumLabelsWeights[3], 4.5);
+    ASSERT_EQUALS(cumLabelsWeights[4], 5.5);
+
+    // ... and with the labels index, when a label has no stimulus left
+    while (!db.getLabelIndexes(Database::Learn, 1).empty()) {
+        db.removeStimulus(db.getStimulusID(Database::Learn,
+                                    db.getLabelIndexes(Database::Learn, 1)[0]));
+    }
+
+    const std::vector<double>& cumWeightsRemoved
+        = db.getLabelsCumulativeWeights(Database::Learn);
+
+    ASSERT_EQUALS(cumWeightsRemoved.size(), 5U);
+    ASSERT_EQUALS(cumWeightsRemoved[0], 1.0);
+    ASSERT_EQUALS(cumWeightsRemoved[1], 1.0);
+    ASSERT_EQUALS(cumWeightsRemoved[2], 2.0);
+    ASSERT_EQUALS(cumWeightsRemoved[3], 3.0);
+    ASSERT_EQUALS(cumWeightsRemoved[4], 4.0);
+}
+
+TEST_DATASET(Database,
+             getEpochIndexes,
+             (unsigned int shardSize, unsigned int bufferSize),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(10U, 1U),
+             std::make_tuple(7U, 1U),
+             std::make_tuple(10U, 25U),
+             std::make_tuple(7U, 100U),
+             std::make_tuple(1000U, 10U))
+{
+    Random::mtSeed(0);
+
+    Database_Test db(100, 5);
+    db.load("");
+    db.partitionStimuli(100, Database::Learn);
+
+    const std::vector<unsigned int> indexes
+        = db.getEpochIndexes(Database::Learn, shardSize, bufferSize);
+
+    ASSERT_EQUALS(indexes.size(), 100U);
+
+    // The epoch is a permutation of the set
+    std::vector<unsigned int> sortedIndexes(indexes);
+    std::sort(sortedIndexes.begin(), sortedIndexes.end());
+
+    for (unsigned int i = 0; i < sortedIndexes.size(); ++i)
+        ASSERT_EQUALS(sortedIndexes[i], i);
+
+    if (bufferSize == 1) {
+        // Without shuffle buffer, the shards are read sequentially
+        for (unsigned int i = 1; i < indexes.size(); ++i) {
+            const Database::StimulusID id
+                = db.getStimulusID(Database::Learn, indexes[i]);
+
+            if (id % shardSize != 0) {
+                ASSERT_EQUALS(db.getStimulusID(Database::Learn,
+                                               indexes[i - 1]), id - 1);
+            }
+        }
+    }
+
+    ASSERT_TRUE(db.getEpochIndexes(Database::Learn, shardSize, bufferSize)
+                != indexes);
+}
+
+TEST(Database, getStimulusReduction)
+{
+    // 4000x3000 JPEG file header (SOI and SOF0 markers)
+    const std::string jpegHeader("\xFF\xD8\xFF\xC0\x00\x11\x08\x0B\xB8"
+                                 "\x0F\xA0\x03\x01\x11\x00\x02\x11\x00"
+                                 "\x03\x11\x00", 21);
+    UnitTest::FileWriteContent("Database_getStimulusReduction.jpg",
+                               jpegHeader);
+    UnitTest::FileWriteContent("Database_getStimulusReduction.png",
+                               "\x89PNG\r\n\x1A\n");
+
+    Database_ReducedDecode db;
+    const int label = db.addLabel("label");
+    db.addStimulus("Database_getStimulusReduction.jpg", -1,
+        new RectangularROI<int>(label, cv::Point(400, 300), 400, 300));
+    db.addStimulus("Database_getStimulusReduction.jpg", label,
+        new RectangularROI<int>(label, cv::Point(400, 300), 400, 300));
+    db.addStimulus("Database_getStimulusReduction.png", label);
+
+    db.setDecodeMinSize(cv::Size(512, 512));
+    ASSERT_EQUALS(db.getStimulusReduction(0), 1U);
+
+    db.setParameter("ReducedDecode", true);
+    ASSERT_EQUALS(db.getStimulusReduction(0), 4U);
+    // Non-composite stimulus, extracted from its ROI
+    ASSERT_EQUALS(db.getStimulusReduction(1), 1U);
+    ASSERT_EQUALS(db.getStimulusReduction(2), 1U);
+
+    const std::vector<std::shared_ptr<ROI> > ROIs = db.getStimulusROIs(0);
+    ASSERT_EQUALS(ROIs.size(), 1U);
+    ASSERT_EQUALS(ROIs[0]->getBoundingRect().x, 100);
+    ASSERT_EQUALS(ROIs[0]->getBoundingRect().y, 75);
+    ASSERT_EQUALS(ROIs[0]->getBoundingRect().width, 100);
+    ASSERT_EQUALS(ROIs[0]->getBoundingRect().height, 75);
+
+    // The file header is parsed once per stimulus
+    UnitTest::FileWriteContent("Database_getStimulusReduction.jpg", "");
+    ASSERT_EQUALS(db.getStimulusReduction(0), 4U);
+
+    db.setDecodeMinSize(cv::Size(0, 0));
+    ASSERT_EQUALS(db.getStimulusReduction(0), 1U);
+    ASSERT_EQUALS(db.getStimulusROIs(0)[0]->getBoundingRect().x, 400);
+}
+
 RUN_TESTS()
@@ -0,0 +1,188 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "Database/IDX_Database.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+namespace {
+void writeBigEndian(std::ofstream& file, unsigned int value)
+{
+    const unsigned char bytes[4] = {(unsigned char)(value >> 24),
+                                    (unsigned char)(value >> 16),
+                                    (unsigned char)(value >> 8),
+                                    (unsigned char)value};
+    file.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+}
+
+TEST(IDX_Database, load)
+{
+    const unsigned int nbImages = 3;
+    const unsigned int nbRows = 4;
+    const unsigned int nbColumns = 5;
+
+    Utils::createDirectories("IDX_Database");
+
+    std::ofstream images("IDX_Database/images-idx3-ubyte",
+                         std::fstream::binary);
+    writeBigEndian(images, 0x00000803);
+    writeBigEndian(images, nbImages);
+    writeBigEndian(images, nbRows);
+    writeBigEndian(images, nbColumns);
+
+    for (unsigned int i = 0; i < nbImages * nbRows * nbColumns; ++i)
+        images.put((char)i);
+
+    images.close();
+
+    std::ofstream labels("IDX_Database/labels-idx1-ubyte",
+                         std::fstream::binary);
+    writeBigEndian(labels, 0x00000801);
+    writeBigEndian(labels, nbImages);
+    labels.put(7);
+    labels.put(1);
+    labels.put(7);
+    labels.close();
+
+    IDX_Database db;
+    db.load("IDX_Database/images-idx3-ubyte", "IDX_Database/labels-idx1-ubyte");
+
+    ASSERT_EQUALS(db.getNbStimuli(), nbImages);
+    ASSERT_EQUALS(db.getNbLabels(), 2U);
+    ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(0)), "7");
+    ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(1)), "1");
+    ASSERT_EQUALS(db.getLabelName(db.getStimulusLabel(2)), "7");
+
+    for (unsigned int id = 0; id < nbImages; ++id) {
+        const cv::Mat data = db.getStimulusData(id);
+
+        ASSERT_EQUALS(data.channels(), 1);
+        ASSERT_EQUALS(data.depth(), CV_8U);
+        ASSERT_EQUALS(data.rows, (int)nbRows);
+        ASSERT_EQUALS(data.cols, (int)nbColumns);
+
+        for (unsigned int y = 0; y < nbRows; ++y) {
+            for (unsigned int x = 0; x < nbColumns; ++x) {
+                ASSERT_EQUALS((int)data.at<unsigned char>(y, x),
+                              (int)(id * nbRows * nbColumns
+                                    + y * nbColumns + x));
+            }
+        }
+
+        // No intermediate image file
+        ASSERT_TRUE(!std::ifstream(db.getStimulusName(id).c_str()).good());
+    }
+
+    // The data can be written in place, without changing the file
+    cv::Mat data = db.getStimulusData(1);
+    data.at<unsigned char>(0, 0) = 255;
+
+    std::ifstream imagesData("IDX_Database/images-idx3-ubyte",
+                             std::fstream::binary);
+    imagesData.seekg(16 + nbRows * nbColumns);
+
+    ASSERT_EQUALS(imagesData.get(), (int)(nbRows * nbColumns));
+}
+
+TEST(IDX_Database, load_truncated)
+{
+    Utils::createDirectories("IDX_Database");
+
+    std::ofstream images("IDX_Database/truncated-idx3-ubyte",
+                         std::fstream::binary);
+    writeBigEndian(images, 0x00000803);
+    writeBigEndian(images, 2);
+    writeBigEndian(images, 2);
+    writeBigEndian(images, 2);
+
+    for (unsigned int i = 0; i < 7; ++i)
+        images.put((char)i);
+
+    images.close();
+
+    std::ofstream labels("IDX_Database/truncated-idx1-ubyte",
+                         std::fstream::binary);
+    writeBigEndian(labels, 0x00000801);
+    writeBigEndian(labels, 2);
+    labels.put(0);
+    labels.put(1);
+    labels.close();
+
+    IDX_Database db;
+
+    ASSERT_THROW(db.load("IDX_Database/truncated-idx3-ubyte",
+                         "IDX_Database/truncated-idx1-ubyte"),
+                 std::runtime_error);
+}
+
+TEST(IDX_Database, getStimuliDepth_logStats)
+{
+    Random::mtSeed(0);
+    Utils::createDirectories("IDX_Database");
+
+    std::ofstream images("IDX_Database/stats-idx3-ubyte",
+                         std::fstream::binary);
+    writeBigEndian(images, 0x00000803);
+    writeBigEndian(images, 3);
+    writeBigEndian(images, 4);
+    writeBigEndian(images, 5);
+
+    for (unsigned int i = 0; i < 3 * 4 * 5; ++i)
+        images.put((char)i);
+
+    images.close();
+
+    std::ofstream labels("IDX_Database/stats-idx1-ubyte",
+                         std::fstream::binary);
+    writeBigEndian(labels, 0x00000801);
+    writeBigEndian(labels, 3);
+    labels.put(7);
+    labels.put(1);
+    labels.put(7);
+    labels.close();
+
+    IDX_Database db;
+    db.load("IDX_Database/stats-idx3-ubyte", "IDX_Database/stats-idx1-ubyte");
+
+    // Both read the records in the mapped file, as there is no image file
+    ASSERT_EQUALS(db.getStimuliDepth(), CV_8U);
+
+    db.partitionStimuli(1.0, 0.0, 0.0);
+
+    db.logStats("IDX_Database/stats_size.dat", "IDX_Database/stats_label.dat");
+
+    std::ifstream sizeData("IDX_Database/stats_size.dat");
+    ASSERT_TRUE(sizeData.good());
+
+    std::string line;
+    std::getline(sizeData, line); // date & time
+
+    unsigned int width, height, count;
+    ASSERT_TRUE((bool)(sizeData >> width >> height >> count));
+    ASSERT_EQUALS(width, 5U);
+    ASSERT_EQUALS(height, 4U);
+    ASSERT_EQUALS(count, 3U);
+}
+
+RUN_TESTS()
@@ -0,0 +1,164 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+
+#include "Database/StimuliDataCache.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST(StimuliDataCache, StimuliDataCache)
+{
+    StimuliDataCache cache;
+    cv::Mat data(8, 8, CV_8UC1, cv::Scalar(1));
+    cv::Mat cached;
+
+    ASSERT_EQUALS(cache.getCapacity(), 0U);
+
+    // Disabled cache
+    cache.insert(0, StimuliDataCache::Data, data);
+    ASSERT_TRUE(!cache.get(0, StimuliDataCache::Data, cached));
+    ASSERT_EQUALS(cache.getNbEntries(), 0U);
+    ASSERT_EQUALS(cache.getNbMisses(), 1U);
+}
+
+TEST(StimuliDataCache, get)
+{
+    StimuliDataCache cache(StimuliDataCache::NbShards * 1024);
+    cv::Mat data(8, 8, CV_8UC1, cv::Scalar(1));
+    cv::Mat labels(8, 8, CV_32SC1, cv::Scalar(2));
+    cv::Mat cached;
+
+    ASSERT_TRUE(!cache.get(0, StimuliDataCache::Data, cached));
+
+    cache.insert(0, StimuliDataCache::Data, data);
+    cache.insert(0, StimuliDataCache::LabelsData, labels);
+
+    ASSERT_EQUALS(cache.getNbEntries(), 2U);
+    ASSERT_EQUALS(cache.getSize(), 64U + 256U);
+
+    ASSERT_TRUE(cache.get(0, StimuliDataCache::Data, cached));
+    ASSERT_TRUE(cached.data == data.data);
+    ASSERT_TRUE(cache.get(0, StimuliDataCache::LabelsData, cached));
+    ASSERT_TRUE(cached.data == labels.data);
+    ASSERT_TRUE(!cache.get(0, StimuliDataCache::TargetData, cached));
+    ASSERT_TRUE(!cache.get(StimuliDataCache::NbShards,
+                           StimuliDataCache::Data, cached));
+
+    ASSERT_EQUALS(cache.getNbHits(), 2U);
+    ASSERT_EQUALS(cache.getNbMisses(), 3U);
+    ASSERT_EQUALS(cache.getNbEvictions(), 0U);
+
+    cache.clear();
+    ASSERT_EQUALS(cache.getNbEntries(), 0U);
+    ASSERT_EQUALS(cache.getSize(), 0U);
+    ASSERT_TRUE(!cache.get(0, StimuliDataCache::Data, cached));
+
+    cache.resetStats();
+    ASSERT_EQUALS(cache.getNbHits(), 0U);
+    ASSERT_EQUALS(cache.getNbMisses(), 0U);
+}
+
+TEST(StimuliDataCache, evict)
+{
+    // 4 matrices of 256 bytes per shard
+    StimuliDataCache cache(StimuliDataCache::NbShards * 1024);
+    const unsigned int nbShards = StimuliDataCache::NbShards;
+    cv::Mat cached;
+
+    // Stimuli 0, nbShards, 2*nbShards... belong to the same shard
+    for (unsigned int i = 0; i < 4; ++i) {
+        cache.insert(i * nbShards, StimuliDataCache::Data,
+                     cv::Mat(16, 16, CV_8UC1, cv::Scalar(i)));
+    }
+
+    ASSERT_EQUALS(cache.getNbEntries(), 4U);
+    ASSERT_EQUALS(cache.getNbEvictions(), 0U);
+
+    // Stimulus 0 becomes the most recently used
+    ASSERT_TRUE(cache.get(0, StimuliDataCache::Data, cached));
+
+    cache.insert(4 * nbShards, StimuliDataCache::Data,
+                 cv::Mat(16, 16, CV_8UC1, cv::Scalar(4)));
+
+    ASSERT_EQUALS(cache.getNbEntries(), 4U);
+    ASSERT_EQUALS(cache.getNbEvictions(), 1U);
+    ASSERT_TRUE(cache.get(0, StimuliDataCache::Data, cached));
+    ASSERT_EQUALS((int)cached.at<unsigned char>(0, 0), 0);
+    ASSERT_TRUE(!cache.get(nbShards, StimuliDataCache::Data, cached));
+    ASSERT_TRUE(cache.get(4 * nbShards, StimuliDataCache::Data, cached));
+
+    // The other shards are not affected
+    cache.insert(1, StimuliDataCache::Data,
+                 cv::Mat(16, 16, CV_8UC1, cv::Scalar(5)));
+    ASSERT_EQUALS(cache.getNbEntries(), 5U);
+    ASSERT_EQUALS(cache.getNbEvictions(), 1U);
+
+    // Too large for a shard
+    cache.insert(2, StimuliDataCache::Data,
+                 cv::Mat(32, 33, CV_8UC1, cv::Scalar(6)));
+    ASSERT_TRUE(!cache.get(2, StimuliDataCache::Data, cached));
+
+    // Reduce the budget to 1 matrix per shard
+    cache.setCapacity(nbShards * 256);
+    ASSERT_EQUALS(cache.getCapacity(), nbShards * 256U);
+    ASSERT_EQUALS(cache.getNbEntries(), 2U);
+    ASSERT_EQUALS(cache.getNbEvictions(), 4U);
+    ASSERT_TRUE(cache.get(4 * nbShards, StimuliDataCache::Data, cached));
+    ASSERT_TRUE(cache.get(1, StimuliDataCache::Data, cached));
+}
+
+TEST_DATASET(StimuliDataCache,
+             insert_concurrent,
+             (unsigned int capacity),
+             std::make_tuple(0U),
+             std::make_tuple(StimuliDataCache::NbShards * 4 * 256U),
+             std::make_tuple(StimuliDataCache::NbShards * 64 * 256U))
+{
+    StimuliDataCache cache(capacity);
+    const int nbStimuli = 256;
+    const int nbReads = 4096;
+    int nbErrors = 0;
+
+#pragma omp parallel for reduction(+:nbErrors)
+    for (int i = 0; i < nbReads; ++i) {
+        const unsigned int id = (i * 7919) % nbStimuli;
+        cv::Mat data;
+
+        if (!cache.get(id, StimuliDataCache::Data, data)) {
+            data = cv::Mat(16, 16, CV_8UC1, cv::Scalar(id % 256));
+            cache.insert(id, StimuliDataCache::Data, data);
+        }
+
+        if ((unsigned int)data.at<unsigned char>(0, 0) != id % 256)
+            ++nbErrors;
+    }
+
+    ASSERT_EQUALS(nbErrors, 0);
+    ASSERT_EQUALS(cache.getNbHits() + cache.getNbMisses(),
+                  (unsigned long long int)nbReads);
+    ASSERT_TRUE(cache.getSize() <= capacity);
+    ASSERT_EQUALS(cache.getSize(), cache.getNbEntries() * 256U);
+
+    if (capacity >= nbStimuli * 256U)
+        ASSERT_EQUALS(cache.getNbEvictions(), 0U);
+}
+
+RUN_TESTS()
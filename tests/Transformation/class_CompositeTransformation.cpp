@@ -22,6 +22,9 @@
 #include "Transformation/ChannelExtractionTransformation.hpp"
 #include "Transformation/CompositeTransformation.hpp"
 #include "Transformation/FlipTransformation.hpp"
+#include "Transformation/PadCropTransformation.hpp"
+#include "Transformation/RandomAffineTransformation.hpp"
+#include "Transformation/RangeAffineTransformation.hpp"
 #include "Transformation/RescaleTransformation.hpp"
 #include "utils/UnitTest.hpp"
 #include "utils/Utils.hpp"
@@ -126,4 +129,204 @@ TEST(CompositeTransformation, apply__random)
                                  + fileName.str());
 }
 
+namespace {
+// Test frame, labels and ROIs
+void CompositeTransformation_initStimulus(
+    cv::Mat& frame,
+    cv::Mat& labels,
+    std::vector<std::shared_ptr<ROI> >& labelsROI)
+{
+    frame.create(23, 37, CV_8UC3);
+    labels.create(23, 37, CV_32SC1);
+
+    for (int y = 0; y < frame.rows; ++y) {
+        for (int x = 0; x < frame.cols; ++x) {
+            for (int ch = 0; ch < 3; ++ch) {
+                frame.ptr<unsigned char>(y)[3 * x + ch]
+                    = (7 * x + 13 * y + 50 * ch) % 256;
+            }
+
+            labels.at<int>(y, x) = (x / 5) + 10 * (y / 4);
+        }
+    }
+
+    labelsROI.clear();
+    labelsROI.push_back(std::make_shared<RectangularROI<int> >(
+        1, cv::Point(5, 3), 20, 10));
+    labelsROI.push_back(std::make_shared<RectangularROI<int> >(
+        2, cv::Point(20, 12), 15, 9));
+}
+
+int CompositeTransformation_maxDiff(const cv::Mat& mat1, const cv::Mat& mat2)
+{
+    if (mat1.rows != mat2.rows || mat1.cols != mat2.cols
+        || mat1.type() != mat2.type())
+    {
+        return -1;
+    }
+
+    const int nbValues = mat1.cols * mat1.channels();
+    int maxDiff = 0;
+
+    for (int y = 0; y < mat1.rows; ++y) {
+        for (int i = 0; i < nbValues; ++i) {
+            const int diff = (mat1.depth() == CV_32S)
+                ? mat1.ptr<int>(y)[i] - mat2.ptr<int>(y)[i]
+                : mat1.ptr<unsigned char>(y)[i]
+                    - mat2.ptr<unsigned char>(y)[i];
+            maxDiff = std::max(maxDiff, std::abs(diff));
+        }
+    }
+
+    return maxDiff;
+}
+
+bool CompositeTransformation_sameROIs(
+    const std::vector<std::shared_ptr<ROI> >& labelsROI1,
+    const std::vector<std::shared_ptr<ROI> >& labelsROI2)
+{
+    if (labelsROI1.size() != labelsROI2.size())
+        return false;
+
+    for (unsigned int i = 0; i < labelsROI1.size(); ++i) {
+        const cv::Rect rect1 = labelsROI1[i]->getBoundingRect();
+        const cv::Rect rect2 = labelsROI2[i]->getBoundingRect();
+
+        if (labelsROI1[i]->getLabel() != labelsROI2[i]->getLabel()
+            || rect1.x != rect2.x || rect1.y != rect2.y
+            || rect1.width != rect2.width || rect1.height != rect2.height)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+}
+
+TEST_DATASET(CompositeTransformation,
+             applyFused__padCrop_flip,
+             (int width, int height, bool horizontalFlip, bool verticalFlip),
+             std::make_tuple(37, 23, true, false),
+             std::make_tuple(48, 32, true, false),
+             std::make_tuple(48, 32, false, true),
+             std::make_tuple(30, 32, true, true),
+             std::make_tuple(20, 16, false, false))
+{
+    PadCropTransformation padCrop(width, height);
+    padCrop.setParameter("BorderType", PadCropTransformation::ConstantBorder);
+    padCrop.setParameter("BorderValue", std::vector<double>(3, 255.0));
+
+    CompositeTransformation trans;
+    trans.push_back(padCrop);
+    trans.push_back(FlipTransformation(horizontalFlip, verticalFlip));
+
+    cv::Mat frame, labels;
+    std::vector<std::shared_ptr<ROI> > labelsROI;
+    CompositeTransformation_initStimulus(frame, labels, labelsROI);
+    trans.apply(frame, labels, labelsROI);
+
+    cv::Mat frameFused, labelsFused;
+    std::vector<std::shared_ptr<ROI> > labelsROIFused;
+    CompositeTransformation_initStimulus(frameFused, labelsFused,
+                                         labelsROIFused);
+    trans.applyFused(frameFused, labelsFused, labelsROIFused);
+
+    // Integer translations and flips: the fused warp is exact
+    ASSERT_EQUALS(frameFused.cols, width);
+    ASSERT_EQUALS(frameFused.rows, height);
+    ASSERT_EQUALS(CompositeTransformation_maxDiff(frameFused, frame), 0);
+    ASSERT_EQUALS(CompositeTransformation_maxDiff(labelsFused, labels), 0);
+    ASSERT_TRUE(CompositeTransformation_sameROIs(labelsROIFused, labelsROI));
+}
+
+TEST_DATASET(CompositeTransformation,
+             applyFused__rescale_flip,
+             (bool keepAspectRatio),
+             std::make_tuple(false),
+             std::make_tuple(true))
+{
+    RescaleTransformation rescale(74, 46);
+    rescale.setParameter("KeepAspectRatio", keepAspectRatio);
+
+    FlipTransformation flip;
+    flip.setParameter("RandomHorizontalFlip", true);
+    flip.setParameter("RandomVerticalFlip", true);
+
+    CompositeTransformation trans;
+    trans.push_back(rescale);
+    trans.push_back(flip);
+
+    for (unsigned int i = 0; i < 4; ++i) {
+        cv::Mat frame, labels;
+        std::vector<std::shared_ptr<ROI> > labelsROI;
+        CompositeTransformation_initStimulus(frame, labels, labelsROI);
+        Random::mtSeed(i);
+        trans.apply(frame, labels, labelsROI);
+
+        cv::Mat frameFused, labelsFused;
+        std::vector<std::shared_ptr<ROI> > labelsROIFused;
+        CompositeTransformation_initStimulus(frameFused, labelsFused,
+                                             labelsROIFused);
+        Random::mtSeed(i);
+        trans.applyFused(frameFused, labelsFused, labelsROIFused);
+
+        // Same sampling positions, up to the interpolation rounding
+        ASSERT_EQUALS(frameFused.cols, 74);
+        ASSERT_EQUALS(frameFused.rows, 46);
+        ASSERT_TRUE(CompositeTransformation_maxDiff(frameFused, frame) >= 0);
+        ASSERT_TRUE(CompositeTransformation_maxDiff(frameFused, frame) <= 1);
+        ASSERT_EQUALS(CompositeTransformation_maxDiff(labelsFused, labels), 0);
+        ASSERT_TRUE(CompositeTransformation_sameROIs(labelsROIFused,
+                                                     labelsROI));
+    }
+}
+
+TEST(CompositeTransformation, applyFused__pointWise)
+{
+    CompositeTransformation trans;
+    trans.push_back(RandomAffineTransformation(0.5, 0.1));
+    trans.push_back(RandomAffineTransformation(
+        std::vector<std::pair<double, double> >(),
+        std::vector<std::pair<double, double> >(),
+        std::vector<std::pair<double, double> >(1, std::make_pair(0.5, 2.0))));
+    trans.push_back(RangeAffineTransformation(
+        RangeAffineTransformation::Minus, 128.0,
+        RangeAffineTransformation::Divides, 255.0));
+    trans.push_back(FlipTransformation(true, false));
+
+    for (unsigned int i = 0; i < 4; ++i) {
+        cv::Mat frame, labels;
+        std::vector<std::shared_ptr<ROI> > labelsROI;
+        CompositeTransformation_initStimulus(frame, labels, labelsROI);
+        Random::mtSeed(i);
+        trans.apply(frame, labels, labelsROI);
+
+        cv::Mat frameFused, labelsFused;
+        std::vector<std::shared_ptr<ROI> > labelsROIFused;
+        CompositeTransformation_initStimulus(frameFused, labelsFused,
+                                             labelsROIFused);
+        Random::mtSeed(i);
+        trans.applyFused(frameFused, labelsFused, labelsROIFused);
+
+        // The look-up table gives the same result
+        ASSERT_EQUALS(frameFused.type(), frame.type());
+        ASSERT_EQUALS(frameFused.cols, frame.cols);
+        ASSERT_EQUALS(frameFused.rows, frame.rows);
+
+        const int nbValues = frame.cols * frame.channels();
+
+        for (int y = 0; y < frame.rows; ++y) {
+            for (int x = 0; x < nbValues; ++x) {
+                ASSERT_EQUALS(frameFused.ptr<Float_T>(y)[x],
+                              frame.ptr<Float_T>(y)[x]);
+            }
+        }
+
+        ASSERT_EQUALS(CompositeTransformation_maxDiff(labelsFused, labels), 0);
+        ASSERT_TRUE(CompositeTransformation_sameROIs(labelsROIFused,
+                                                     labelsROI));
+    }
+}
+
 RUN_TESTS()
@@ -94,6 +94,66 @@ TEST_DATASET(DistortionTransformation,
     ASSERT_EQUALS(img.rows, labels.rows);
 }
 
+TEST_DATASET(DistortionTransformation,
+             apply__elasticFieldsPool,
+             (unsigned int nbFields),
+             std::make_tuple(0U),
+             std::make_tuple(4U))
+{
+    Random::mtSeed(0);
+
+    DistortionTransformation trans;
+    trans.setParameter("ElasticGaussianSize", 21U);
+    trans.setParameter("ElasticSigma", 6.0);
+    trans.setParameter("ElasticScaling", 20.0);
+    trans.setParameter("Scaling", 10.0);
+    trans.setParameter("Rotation", 10.0);
+    trans.setParameter("ElasticFieldsPool", nbFields);
+
+    cv::Mat ramp(48, 64, CV_32FC1);
+
+    for (int y = 0; y < ramp.rows; ++y) {
+        for (int x = 0; x < ramp.cols; ++x)
+            ramp.at<float>(y, x) = x + 100.0f * y;
+    }
+
+    for (unsigned int i = 0; i < 3; ++i) {
+        cv::Mat img(48, 64, CV_32FC1, cv::Scalar(0.5));
+        cv::Mat labels(48, 64, CV_32SC1, cv::Scalar(3));
+
+        trans.apply(img, labels);
+
+        ASSERT_EQUALS(img.cols, 64);
+        ASSERT_EQUALS(img.rows, 48);
+        ASSERT_EQUALS(labels.cols, 64);
+        ASSERT_EQUALS(labels.rows, 48);
+
+        for (int y = 0; y < img.rows; ++y) {
+            for (int x = 0; x < img.cols; ++x) {
+                ASSERT_EQUALS_DELTA(img.at<float>(y, x), 0.5f, 1.0e-6);
+                ASSERT_TRUE(labels.at<int>(y, x) == 3
+                            || labels.at<int>(y, x) == -1);
+            }
+        }
+
+        // Same seed, same distortion
+        DistortionTransformation trans1(trans);
+        DistortionTransformation trans2(trans);
+        cv::Mat img1 = ramp.clone();
+        cv::Mat img2 = ramp.clone();
+
+        Random::mtSeed(i);
+        trans1.apply(img1);
+        Random::mtSeed(i);
+        trans2.apply(img2);
+
+        for (int y = 0; y < ramp.rows; ++y) {
+            for (int x = 0; x < ramp.cols; ++x)
+                ASSERT_EQUALS(img1.at<float>(y, x), img2.at<float>(y, x));
+        }
+    }
+}
+
 TEST(DistortionTransformation, benchmark)
 {
     Random::mtSeed(0);
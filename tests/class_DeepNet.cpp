@@ -30,6 +30,9 @@
 #include "DeepNet.hpp"
 #include "Network.hpp"
 #include "Cell/FcCell_Frame.hpp"
+#include "Cell/FcCell_Spike.hpp"
+#include "Cell/NodeOut.hpp"
+#include "NodeEnv.hpp"
 #include "utils/UnitTest.hpp"
 
 using namespace N2D2;
@@ -146,6 +149,64 @@ TEST(DeepNet, setEnvironment)
     ASSERT_EQUALS(deepNet.getStimuliProvider(), env);
 }
 
+TEST(DeepNet, setPartitioning)
+{
+    Network net;
+    DeepNet deepNet(net);
+
+    std::shared_ptr<Environment> env(new Environment(net, EmptyDatabase,
+                                                     {4, 3, 1}));
+    deepNet.setStimuliProvider(env);
+
+    std::shared_ptr<FcCell_Spike> fc1(new FcCell_Spike(net, deepNet, "fc1",
+                                                       6));
+    std::shared_ptr<FcCell_Spike> fc2(new FcCell_Spike(net, deepNet, "fc2",
+                                                       2));
+    fc1->setParameter<Time_T>("IncomingDelay", 5 * TimePs, 0.0);
+    fc2->setParameter<Time_T>("IncomingDelay", 3 * TimePs, 0.0);
+    fc1->addInput(*env);
+    fc2->addInput(fc1.get());
+
+    deepNet.addCell(fc1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(fc2, std::vector<std::shared_ptr<Cell> >(1, fc1));
+
+    fc1->initialize();
+    fc2->initialize();
+
+    deepNet.setPartitioning(2);
+
+    ASSERT_EQUALS(net.getNbPartitions(), 2U);
+    ASSERT_EQUALS(env->getNodes()[0]->getPartition(), 0U);
+    ASSERT_EQUALS(fc1->getOutput(0)->getPartition(), 1U);
+    ASSERT_EQUALS(fc2->getOutput(0)->getPartition(), 0U);
+    ASSERT_TRUE(fc1->isPartitionBoundary());
+    ASSERT_TRUE(fc2->isPartitionBoundary());
+    ASSERT_EQUALS(net.getLookahead(), 3 * TimePs);
+
+    // No spikes between the partitions
+    deepNet.setPartitioning(1);
+
+    ASSERT_EQUALS(net.getNbPartitions(), 1U);
+    ASSERT_TRUE(!fc1->isPartitionBoundary());
+    ASSERT_TRUE(!fc2->isPartitionBoundary());
+    ASSERT_EQUALS(net.getLookahead(), TimeS);
+
+    deepNet.setPartitioning(0);
+
+    ASSERT_EQUALS(net.getNbPartitions(), 0U);
+
+    // A cell without synaptic delays cannot receive spikes from another
+    // partition
+    std::shared_ptr<FcCell_Spike> fc3(new FcCell_Spike(net, deepNet, "fc3",
+                                                       2));
+    fc3->setParameter<Time_T>("IncomingDelay", 0, 0.0);
+    fc3->addInput(fc2.get());
+    deepNet.addCell(fc3, std::vector<std::shared_ptr<Cell> >(1, fc2));
+    fc3->initialize();
+
+    ASSERT_THROW(deepNet.setPartitioning(2), std::runtime_error);
+}
+
 TEST(DeepNet, fuseBatchNormWithConv)
 {
     REQUIRED(UnitTest::DirExists(N2D2_DATA("mnist")));
@@ -238,4 +299,208 @@ TEST(DeepNet, fuseBatchNormWithConv)
     }
 }
 
+TEST_DATASET(DeepNet,
+             test_concurrentExecution,
+             (unsigned int batchSize),
+             std::make_tuple(1U),
+             std::make_tuple(4U))
+{
+    Network net;
+    DeepNet deepNet(net);
+    Database database;
+    StimuliProvider sp(database, {8, 8, 1}, batchSize);
+
+    for (unsigned int i = 0; i < sp.getData().size(); ++i)
+        sp.getData()(i) = Random::randUniform(-1.0, 1.0);
+
+    // Two parallel branches, joined by a Fc cell
+    std::shared_ptr<ConvCell_Frame<Float_T> > conv1(
+        new ConvCell_Frame<Float_T>(deepNet, "conv1",
+        std::vector<unsigned int>({3, 3}), 4,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1})));
+    std::shared_ptr<ConvCell_Frame<Float_T> > conv2a(
+        new ConvCell_Frame<Float_T>(deepNet, "conv2a",
+        std::vector<unsigned int>({3, 3}), 6,
+        std::vector<unsigned int>({1, 1}),
+        std::vector<unsigned int>({1, 1}),
+        std::vector<int>({1, 1})));
+    std::shared_ptr<ConvCell_Frame<Float_T> > conv2b(
+        new ConvCell_Frame<Float_T>(deepNet, "conv2b",
+        std::vector<unsigned int>({1, 1}), 3));
+    std::shared_ptr<FcCell_Frame<Float_T> > fc(
+        new FcCell_Frame<Float_T>(deepNet, "fc", 5));
+
+    deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+    deepNet.addCell(conv2a, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(conv2b, std::vector<std::shared_ptr<Cell> >(1, conv1));
+    deepNet.addCell(fc, {conv2a, conv2b});
+
+    conv1->addInput(sp);
+    conv2a->addInput(conv1.get());
+    conv2b->addInput(conv1.get());
+    fc->addInput(conv2a.get());
+    fc->addInput(conv2b.get());
+
+    conv1->initialize();
+    conv2a->initialize();
+    conv2b->initialize();
+    fc->initialize();
+
+    std::vector<std::pair<std::string, double> > timings;
+
+    deepNet.test(Database::Test, &timings);
+    const Tensor<Float_T> outputsRef
+        = tensor_cast<Float_T>(fc->getOutputs()).clone();
+
+    ASSERT_EQUALS(timings.size(), 4U);
+
+    deepNet.setParameter("ConcurrentExecution", true);
+    deepNet.test(Database::Test, &timings);
+    const Tensor<Float_T>& outputs = tensor_cast<Float_T>(fc->getOutputs());
+
+    // Timings are reported in the sequential order
+    ASSERT_EQUALS(timings.size(), 4U);
+    ASSERT_EQUALS(timings[0].first, "conv1");
+    ASSERT_EQUALS(timings[1].first, "conv2a");
+    ASSERT_EQUALS(timings[2].first, "conv2b");
+    ASSERT_EQUALS(timings[3].first, "fc");
+
+    ASSERT_EQUALS(outputs.size(), outputsRef.size());
+
+    for (unsigned int i = 0; i < outputs.size(); ++i)
+        ASSERT_EQUALS(outputs(i), outputsRef(i));
+}
+
+// Fc cell whose outputs gradient is provided directly, without target
+class FcCell_Frame_Gradient : public FcCell_Frame<Float_T> {
+public:
+    FcCell_Frame_Gradient(const DeepNet& deepNet,
+                          const std::string& name,
+                          unsigned int nbOutputs)
+        : Cell(deepNet, name, nbOutputs),
+          FcCell(deepNet, name, nbOutputs),
+          FcCell_Frame<Float_T>(deepNet, name, nbOutputs) {};
+
+    void propagate(bool inference = false)
+    {
+        FcCell_Frame<Float_T>::propagate(inference);
+
+        for (unsigned int i = 0; i < mDiffInputs.size(); ++i)
+            mDiffInputs(i) = gradient[i];
+
+        mDiffInputs.setValid();
+    }
+
+    std::vector<Float_T> gradient;
+};
+
+TEST_DATASET(DeepNet,
+             learn_concurrentExecution,
+             (unsigned int batchSize),
+             std::make_tuple(1U),
+             std::make_tuple(4U))
+{
+    std::vector<Float_T> outputsRef;
+    std::vector<Float_T> weightsRef;
+
+    for (unsigned int concurrent = 0; concurrent < 2; ++concurrent) {
+        Network net(1);
+        DeepNet deepNet(net);
+        Database database;
+        StimuliProvider sp(database, {8, 8, 1}, batchSize);
+
+        for (unsigned int i = 0; i < sp.getData().size(); ++i)
+            sp.getData()(i) = Random::randUniform(-1.0, 1.0);
+
+        // Two parallel branches, joined by a Fc cell. The gradients of both
+        // branches are accumulated into the outputs gradient of conv1.
+        std::shared_ptr<ConvCell_Frame<Float_T> > conv1(
+            new ConvCell_Frame<Float_T>(deepNet, "conv1",
+            std::vector<unsigned int>({3, 3}), 4,
+            std::vector<unsigned int>({1, 1}),
+            std::vector<unsigned int>({1, 1}),
+            std::vector<int>({1, 1})));
+        std::shared_ptr<ConvCell_Frame<Float_T> > conv2a(
+            new ConvCell_Frame<Float_T>(deepNet, "conv2a",
+            std::vector<unsigned int>({3, 3}), 6,
+            std::vector<unsigned int>({1, 1}),
+            std::vector<unsigned int>({1, 1}),
+            std::vector<int>({1, 1})));
+        std::shared_ptr<ConvCell_Frame<Float_T> > conv2b(
+            new ConvCell_Frame<Float_T>(deepNet, "conv2b",
+            std::vector<unsigned int>({1, 1}), 3));
+        std::shared_ptr<FcCell_Frame_Gradient> fc(
+            new FcCell_Frame_Gradient(deepNet, "fc", 5));
+
+        deepNet.addCell(conv1, std::vector<std::shared_ptr<Cell> >(1));
+        deepNet.addCell(conv2a,
+                        std::vector<std::shared_ptr<Cell> >(1, conv1));
+        deepNet.addCell(conv2b,
+                        std::vector<std::shared_ptr<Cell> >(1, conv1));
+        deepNet.addCell(fc, {conv2a, conv2b});
+
+        conv1->addInput(sp);
+        conv2a->addInput(conv1.get());
+        conv2b->addInput(conv1.get());
+        fc->addInput(conv2a.get());
+        fc->addInput(conv2b.get());
+
+        conv1->initialize();
+        conv2a->initialize();
+        conv2b->initialize();
+        fc->initialize();
+
+        deepNet.setParameter("ConcurrentExecution", (bool)concurrent);
+
+        // The gradients are drawn beforehand, as the concurrent execution
+        // draws its seed from the global generator
+        const unsigned int nbSteps = 3;
+        std::vector<Float_T> gradients(nbSteps * fc->getOutputs().size());
+
+        for (unsigned int i = 0; i < gradients.size(); ++i)
+            gradients[i] = Random::randUniform(-1.0, 1.0);
+
+        for (unsigned int step = 0; step < nbSteps; ++step) {
+            fc->gradient.assign(
+                gradients.begin() + step * fc->getOutputs().size(),
+                gradients.begin() + (step + 1) * fc->getOutputs().size());
+            deepNet.learn();
+        }
+
+        deepNet.test(Database::Test);
+
+        const Tensor<Float_T>& outputsTensor
+            = tensor_cast<Float_T>(fc->getOutputs());
+        const std::vector<Float_T> outputs(outputsTensor.begin(),
+                                           outputsTensor.end());
+        std::vector<Float_T> weights;
+
+        for (unsigned int output = 0; output < conv1->getNbOutputs();
+            ++output)
+        {
+            Tensor<Float_T> kernel;
+            conv1->getWeight(output, 0, kernel);
+            weights.insert(weights.end(), kernel.begin(), kernel.end());
+        }
+
+        if (!concurrent) {
+            outputsRef = outputs;
+            weightsRef = weights;
+            continue;
+        }
+
+        ASSERT_EQUALS(outputs.size(), outputsRef.size());
+
+        for (unsigned int i = 0; i < outputs.size(); ++i)
+            ASSERT_EQUALS(outputs[i], outputsRef[i]);
+
+        ASSERT_EQUALS(weights.size(), weightsRef.size());
+
+        for (unsigned int i = 0; i < weights.size(); ++i)
+            ASSERT_EQUALS(weights[i], weightsRef[i]);
+    }
+}
+
 RUN_TESTS()
@@ -22,6 +22,7 @@
 #include "Environment.hpp"
 #include "N2D2.hpp"
 #include "Network.hpp"
+#include "NodeEnv.hpp"
 #include "Transformation/RescaleTransformation.hpp"
 #include "utils/UnitTest.hpp"
 
@@ -70,4 +71,76 @@ TEST_DATASET(Environment,
     env.readRandomBatch(Database::Test);
 }
 
+TEST_DATASET(Environment,
+             propagate__streamInputs,
+             (std::string stimulusType),
+             std::make_tuple(std::string("SingleBurst")),
+             std::make_tuple(std::string("Periodic")),
+             std::make_tuple(std::string("Linear")))
+{
+    cv::Mat img(4, 4, CV_8UC1);
+
+    for (int y = 0; y < img.rows; ++y) {
+        for (int x = 0; x < img.cols; ++x)
+            img.at<unsigned char>(y, x) = 16 * (x + 4 * y);
+    }
+
+    // Without random jitter, the spikes generated on demand must be the same
+    // as the spikes generated up front
+    std::vector<std::vector<std::pair<Time_T, bool> > > spikes[2];
+
+    for (unsigned int stream = 0; stream < 2; ++stream) {
+        Network net(1);
+        Environment env(net, EmptyDatabase, {4, 4, 1});
+        env.setParameter("StreamInputs", (bool)stream);
+        env.setParameter("StimulusType", stimulusType);
+        env.setParameter("PeriodMeanMin", 1 * TimeMs);
+        env.setParameter("PeriodMeanMax", 100 * TimeMs);
+        env.setParameter("PeriodMin", 1 * TimeMs);
+        env.setParameter("PeriodRelStdDev", 0.0);
+        env.setParameter("MaxFrequency", 1.0 / (10 * TimeMs));
+        env.setNbQuantizationLevels(256);
+
+        const std::vector<NodeEnv*> nodes = env.getNodes();
+
+        for (std::vector<NodeEnv*>::const_iterator it = nodes.begin(),
+             itEnd = nodes.end(); it != itEnd; ++it)
+        {
+            (*it)->setActivityRecording(true);
+        }
+
+        env.streamStimulus(img, Database::Learn);
+        env.propagate(0, 1 * TimeS);
+        net.run();
+
+        for (std::vector<NodeEnv*>::const_iterator it = nodes.begin(),
+             itEnd = nodes.end(); it != itEnd; ++it)
+        {
+            const NodeEvents_T& events
+                = net.getSpikeRecording((*it)->getId());
+            std::vector<std::pair<Time_T, bool> > nodeSpikes;
+
+            for (NodeEvents_T::const_iterator itEvent = events.begin(),
+                 itEventEnd = events.end(); itEvent != itEventEnd; ++itEvent)
+            {
+                nodeSpikes.push_back(std::make_pair((*itEvent).first,
+                                                    (*itEvent).second != 0));
+            }
+
+            spikes[stream].push_back(nodeSpikes);
+        }
+    }
+
+    ASSERT_EQUALS(spikes[1].size(), spikes[0].size());
+
+    unsigned int nbSpikes = 0;
+
+    for (unsigned int node = 0; node < spikes[0].size(); ++node) {
+        ASSERT_TRUE(spikes[1][node] == spikes[0][node]);
+        nbSpikes += spikes[0][node].size();
+    }
+
+    ASSERT_TRUE(nbSpikes > 0);
+}
+
 RUN_TESTS()
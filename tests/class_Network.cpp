@@ -0,0 +1,317 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Network.hpp"
+#include "Node.hpp"
+#include "utils/Random.hpp"
+#include "utils/TimingWheel.hpp"
+#include "utils/UnitTest.hpp"
+
+#include <omp.h>
+
+using namespace N2D2;
+
+class Network_Node : public Node {
+public:
+    Network_Node(Network& net,
+                 unsigned int index,
+                 Time_T delay,
+                 bool randomEmit)
+        : Node(net),
+          mIndex(index),
+          mDelay(delay),
+          mRandomEmit(randomEmit),
+          mPotential(0)
+    {
+        setActivityRecording(true);
+    }
+    unsigned int getIndex() const
+    {
+        return mIndex;
+    }
+    void propagateSpike(Node* origin, Time_T timestamp, EventType_T type)
+    {
+        mNet.newEvent(origin, this, timestamp + mDelay, type);
+    }
+    void incomingSpike(Node* link, Time_T timestamp, EventType_T /*type*/)
+    {
+        mPotential += 1 + static_cast<Network_Node*>(link)->getIndex() % 3;
+
+        if (mPotential >= 2 + mIndex % 3) {
+            mPotential = 0;
+
+            Time_T emitDelay = 1 + (mIndex + timestamp) % 7;
+
+            if (mRandomEmit)
+                emitDelay += Random::randUniform(0, 3);
+
+            mNet.newEvent(this, NULL, timestamp + emitDelay);
+        }
+    }
+
+private:
+    const unsigned int mIndex;
+    const Time_T mDelay;
+    const bool mRandomEmit;
+    unsigned int mPotential;
+};
+
+class Network_RecordNode : public Node {
+public:
+    Network_RecordNode(Network& net, std::vector<EventType_T>& record)
+        : Node(net), mRecord(record)
+    {
+    }
+    void incomingSpike(Node* /*link*/, Time_T /*timestamp*/, EventType_T type)
+    {
+        mRecord.push_back(type);
+    }
+    void emitSpike(Time_T /*timestamp*/, EventType_T type)
+    {
+        mRecord.push_back(type);
+    }
+
+private:
+    std::vector<EventType_T>& mRecord;
+};
+
+/// Event ordered as by the SpikeEvent comparator of the sequential mode
+/// before the partitioned mode
+struct Network_SequentialEvent {
+    Time_T timestamp;
+    bool emit;
+    EventType_T type;
+
+    bool operator<(const Network_SequentialEvent& event) const
+    {
+        return (timestamp > event.timestamp
+                || (timestamp == event.timestamp && emit && !event.emit));
+    }
+};
+
+struct Network_SequentialEventTimestamp {
+    Time_T operator()(const Network_SequentialEvent* event) const
+    {
+        return event->timestamp;
+    }
+};
+
+std::vector<NodeEvents_T> Network_run(Network::EventsScheduler scheduler,
+                                      unsigned int nbPartitions,
+                                      bool randomEmit = false,
+                                      Time_T delay = 10)
+{
+    const unsigned int nbLayers = 4;
+    const unsigned int nbNodesPerLayer = 8;
+
+    Network net(1, scheduler, 16, 16);
+
+    if (nbPartitions > 0)
+        net.setPartitioning(nbPartitions, 10);
+
+    std::vector<Network_Node*> nodes;
+
+    for (unsigned int i = 0; i < nbLayers * nbNodesPerLayer; ++i) {
+        nodes.push_back(new Network_Node(net, i, delay, randomEmit));
+
+        if (nbPartitions > 0)
+            nodes.back()->setPartition(i % nbPartitions);
+    }
+
+    // Feed-forward connections, and lateral connections that form loops
+    for (unsigned int layer = 0; layer < nbLayers; ++layer) {
+        for (unsigned int i = 0; i < nbNodesPerLayer; ++i) {
+            Node* origin = nodes[layer * nbNodesPerLayer + i];
+
+            for (unsigned int j = 0; j < nbNodesPerLayer; ++j) {
+                if (layer + 1 < nbLayers && Random::randBernoulli(0.5))
+                    origin->addBranch(nodes[(layer + 1) * nbNodesPerLayer + j]);
+
+                if (j != i && Random::randBernoulli(0.1))
+                    origin->addBranch(nodes[layer * nbNodesPerLayer + j]);
+            }
+        }
+    }
+
+    // Input events, several of them simultaneous
+    for (unsigned int t = 0; t < 200; t += 5) {
+        for (unsigned int i = 0; i < nbNodesPerLayer; ++i) {
+            if (Random::randBernoulli(0.5))
+                net.newEvent(nodes[i], NULL, t);
+        }
+    }
+
+    net.run(2000);
+
+    std::vector<NodeEvents_T> spikes;
+
+    for (std::vector<Network_Node*>::const_iterator it = nodes.begin(),
+         itEnd = nodes.end(); it != itEnd; ++it)
+    {
+        spikes.push_back(net.getSpikeRecording((*it)->getId()));
+        delete (*it);
+    }
+
+    return spikes;
+}
+
+TEST(Network, setPartitioning)
+{
+    Network net(1);
+
+    ASSERT_EQUALS(net.getNbPartitions(), 0U);
+
+    net.setPartitioning(4, 10);
+
+    ASSERT_EQUALS(net.getNbPartitions(), 4U);
+    ASSERT_EQUALS(net.getLookahead(), 10ULL);
+    ASSERT_THROW(net.setPartitioning(4, 0), std::domain_error);
+
+    Network_Node node(net, 0, 10, false);
+    node.setPartition(4);
+
+    ASSERT_THROW(net.newEvent(&node, NULL, 0), std::runtime_error);
+
+    node.setPartition(3);
+    net.newEvent(&node, NULL, 0);
+
+    ASSERT_THROW(net.setPartitioning(0), std::runtime_error);
+
+    net.run();
+    net.setPartitioning(0);
+
+    ASSERT_EQUALS(net.getNbPartitions(), 0U);
+}
+
+TEST_DATASET(Network,
+             run_partitioned,
+             (Network::EventsScheduler scheduler,
+              unsigned int nbPartitions,
+              bool randomEmit),
+             std::make_tuple(Network::HeapScheduler, 2U, false),
+             std::make_tuple(Network::HeapScheduler, 5U, false),
+             std::make_tuple(Network::WheelScheduler, 3U, false),
+             std::make_tuple(Network::HeapScheduler, 2U, true),
+             std::make_tuple(Network::HeapScheduler, 4U, true),
+             std::make_tuple(Network::WheelScheduler, 3U, true))
+{
+    // A single partition gives the reference results of the partitioned mode
+    const std::vector<NodeEvents_T> spikes
+        = Network_run(scheduler, 1, randomEmit);
+    const std::vector<NodeEvents_T> spikesPartitioned
+        = Network_run(scheduler, nbPartitions, randomEmit);
+
+    unsigned int nbSpikes = 0;
+
+    for (unsigned int i = 0; i < spikes.size(); ++i)
+        nbSpikes += spikes[i].size();
+
+    ASSERT_TRUE(nbSpikes > 100);
+    ASSERT_TRUE(spikesPartitioned == spikes);
+}
+
+TEST_DATASET(Network,
+             run__sequentialOrder,
+             (Network::EventsScheduler scheduler),
+             std::make_tuple(Network::HeapScheduler),
+             std::make_tuple(Network::WheelScheduler))
+{
+    // The sequential mode keeps the ordering of the simultaneous events
+    std::vector<EventType_T> record;
+
+    Network net(1, scheduler, 16, 16);
+    std::vector<Network_RecordNode*> nodes;
+
+    for (unsigned int i = 0; i < 8; ++i)
+        nodes.push_back(new Network_RecordNode(net, record));
+
+    std::vector<Network_SequentialEvent> events(1000);
+    std::priority_queue<Network_SequentialEvent*,
+                        std::vector<Network_SequentialEvent*>,
+                        Utils::PtrLess<Network_SequentialEvent*> > heap;
+    TimingWheel<Network_SequentialEvent*,
+                Utils::PtrLess<Network_SequentialEvent*>,
+                Network_SequentialEventTimestamp> wheel(16, 16);
+
+    for (unsigned int i = 0; i < events.size(); ++i) {
+        events[i].timestamp = 10 * Random::randUniform(0, 50);
+        events[i].emit = Random::randBernoulli(0.3);
+        events[i].type = i;
+
+        Node* origin = nodes[Random::randUniform(0, nodes.size() - 1)];
+        Node* destination = (events[i].emit)
+            ? NULL : nodes[Random::randUniform(0, nodes.size() - 1)];
+
+        net.newEvent(origin, destination, events[i].timestamp, i);
+
+        if (scheduler == Network::HeapScheduler)
+            heap.push(&events[i]);
+        else
+            wheel.push(&events[i]);
+    }
+
+    net.run();
+
+    ASSERT_EQUALS(record.size(), events.size());
+
+    for (unsigned int i = 0; i < record.size(); ++i) {
+        if (scheduler == Network::HeapScheduler) {
+            ASSERT_EQUALS(record[i], heap.top()->type);
+            heap.pop();
+        }
+        else {
+            ASSERT_EQUALS(record[i], wheel.top()->type);
+            wheel.pop();
+        }
+    }
+
+    for (std::vector<Network_RecordNode*>::const_iterator it = nodes.begin(),
+         itEnd = nodes.end(); it != itEnd; ++it)
+    {
+        delete (*it);
+    }
+}
+
+TEST(Network, run_partitioned_random)
+{
+    const int nbThreads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    const std::vector<NodeEvents_T> spikes
+        = Network_run(Network::HeapScheduler, 4, true);
+
+    omp_set_num_threads(4);
+    const std::vector<NodeEvents_T> spikesThreads
+        = Network_run(Network::HeapScheduler, 4, true);
+
+    omp_set_num_threads(nbThreads);
+
+    ASSERT_TRUE(spikesThreads == spikes);
+}
+
+TEST(Network, run_partitioned_lookahead)
+{
+    // The delay between two partitions is shorter than the lookahead
+    ASSERT_THROW(Network_run(Network::HeapScheduler, 2, false, 5),
+                 std::runtime_error);
+    ASSERT_NOTHROW_ANY(Network_run(Network::HeapScheduler, 1, false, 5));
+}
+
+RUN_TESTS()
@@ -0,0 +1,296 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "StimuliCache.hpp"
+#include "utils/UnitTest.hpp"
+#include "utils/Utils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <stdint.h>
+
+using namespace N2D2;
+
+namespace {
+void clearCache(const std::string& path)
+{
+    Utils::createDirectories(path);
+
+    for (unsigned int shard = 0; shard < 100; ++shard) {
+        std::stringstream fileName;
+        fileName << path << "/shard_" << Database::Learn << "_"
+                 << std::setfill('0') << std::setw(4) << shard << ".bin";
+        std::remove(fileName.str().c_str());
+    }
+
+    std::stringstream fileName;
+    fileName << path << "/index_" << Database::Learn << ".bin";
+    std::remove(fileName.str().c_str());
+}
+
+void makeStimulus(unsigned int id,
+                  std::vector<cv::Mat>& data,
+                  std::vector<cv::Mat>& labels)
+{
+    data.clear();
+    labels.clear();
+
+    cv::Mat dataF(3 + id % 2, 5, CV_32FC1);
+    cv::Mat dataU(7, 1 + id % 3, CV_8UC1);
+    cv::Mat labelsI(2, 3, CV_32SC1);
+
+    for (int i = 0; i < dataF.rows; ++i) {
+        for (int j = 0; j < dataF.cols; ++j)
+            dataF.at<float>(i, j) = id + 0.5f * i - 0.25f * j;
+    }
+
+    for (int i = 0; i < dataU.rows; ++i) {
+        for (int j = 0; j < dataU.cols; ++j)
+            dataU.at<unsigned char>(i, j) = (id + i * dataU.cols + j) % 256;
+    }
+
+    for (int i = 0; i < labelsI.rows; ++i) {
+        for (int j = 0; j < labelsI.cols; ++j)
+            labelsI.at<int>(i, j) = (int)id - i * labelsI.cols - j;
+    }
+
+    data.push_back(dataF);
+    data.push_back(dataU);
+    labels.push_back(labelsI);
+}
+
+bool checkStimulus(unsigned int id,
+                   const std::vector<cv::Mat>& data,
+                   const std::vector<cv::Mat>& labels)
+{
+    std::vector<cv::Mat> refData, refLabels;
+    makeStimulus(id, refData, refLabels);
+
+    if (data.size() != refData.size() || labels.size() != refLabels.size())
+        return false;
+
+    for (unsigned int k = 0; k < data.size() + labels.size(); ++k) {
+        const cv::Mat& mat = (k < data.size()) ? data[k]
+                                               : labels[k - data.size()];
+        const cv::Mat& ref = (k < data.size()) ? refData[k]
+                                               : refLabels[k - data.size()];
+
+        if (mat.rows != ref.rows || mat.cols != ref.cols
+            || mat.type() != ref.type())
+        {
+            return false;
+        }
+
+        // The matrices data must be aligned in the mapped shard
+        if (((uintptr_t)mat.data) % 16 != 0)
+            return false;
+
+        const std::size_t size = ref.elemSize() * ref.rows * ref.cols;
+
+        if (!std::equal(ref.data, ref.data + size, mat.data))
+            return false;
+    }
+
+    return true;
+}
+}
+
+TEST_DATASET(StimuliCache,
+             save_load,
+             (std::size_t maxShardSize),
+             std::make_tuple(StimuliCache::DefaultMaxShardSize),
+             std::make_tuple(256U))
+{
+    const std::string path = "StimuliCache/save_load";
+    clearCache(path);
+
+    const unsigned int nbStimuli = 20;
+
+    {
+        StimuliCache cache(path, maxShardSize);
+
+        for (unsigned int id = 0; id < nbStimuli; id += 2) {
+            std::vector<cv::Mat> data, labels;
+            makeStimulus(id, data, labels);
+
+            ASSERT_EQUALS(cache.isCached(id, Database::Learn), false);
+            cache.save(id, Database::Learn, data, labels);
+            ASSERT_EQUALS(cache.isCached(id, Database::Learn), true);
+        }
+
+        for (unsigned int id = 0; id < nbStimuli; ++id) {
+            std::vector<cv::Mat> data, labels;
+            std::shared_ptr<MemoryMappedFile> mapping;
+
+            ASSERT_EQUALS(cache.isCached(id, Database::Test), false);
+            ASSERT_EQUALS(cache.load(id, Database::Learn, data, labels,
+                                     mapping), (id % 2 == 0));
+
+            if (id % 2 == 0)
+                ASSERT_TRUE(checkStimulus(id, data, labels));
+        }
+    }
+
+    // Cache persistence
+    StimuliCache cache(path, maxShardSize);
+
+    for (unsigned int id = 1; id < nbStimuli; id += 2) {
+        std::vector<cv::Mat> data, labels;
+        makeStimulus(id, data, labels);
+        cache.save(id, Database::Learn, data, labels);
+    }
+
+    for (unsigned int id = 0; id < nbStimuli; ++id) {
+        std::vector<cv::Mat> data, labels;
+        std::shared_ptr<MemoryMappedFile> mapping;
+
+        ASSERT_EQUALS(cache.load(id, Database::Learn, data, labels, mapping),
+                      true);
+        ASSERT_TRUE(checkStimulus(id, data, labels));
+    }
+
+    std::ifstream shard1((path + "/shard_Learn_0001.bin").c_str());
+    ASSERT_EQUALS(shard1.good(), (maxShardSize == 256U));
+}
+
+TEST(StimuliCache, load_truncated)
+{
+    const std::string path = "StimuliCache/load_truncated";
+    clearCache(path);
+
+    {
+        StimuliCache cache(path);
+
+        for (unsigned int id = 0; id < 3; ++id) {
+            std::vector<cv::Mat> data, labels;
+            makeStimulus(id, data, labels);
+            cache.save(id, Database::Learn, data, labels);
+        }
+    }
+
+    // Simulate an interrupted write: partial index entry...
+    {
+        std::ofstream index((path + "/index_Learn.bin").c_str(),
+                            std::ios::binary | std::ios::app);
+        const char partial[5] = {0};
+        index.write(partial, sizeof(partial));
+    }
+
+    // ... and truncated last record
+    std::vector<char> shard;
+
+    {
+        std::ifstream shardFile((path + "/shard_Learn_0000.bin").c_str(),
+                                std::ios::binary);
+        shard.assign(std::istreambuf_iterator<char>(shardFile),
+                     std::istreambuf_iterator<char>());
+    }
+
+    {
+        std::ofstream shardFile((path + "/shard_Learn_0000.bin").c_str(),
+                                std::ios::binary | std::ios::trunc);
+        shardFile.write(&shard[0], shard.size() - 8);
+    }
+
+    StimuliCache cache(path);
+
+    ASSERT_EQUALS(cache.isCached(0, Database::Learn), true);
+    ASSERT_EQUALS(cache.isCached(1, Database::Learn), true);
+    ASSERT_EQUALS(cache.isCached(2, Database::Learn), false);
+
+    for (unsigned int id = 0; id < 2; ++id) {
+        std::vector<cv::Mat> data, labels;
+        std::shared_ptr<MemoryMappedFile> mapping;
+
+        ASSERT_EQUALS(cache.load(id, Database::Learn, data, labels, mapping),
+                      true);
+        ASSERT_TRUE(checkStimulus(id, data, labels));
+    }
+
+    // The dropped stimulus can be saved again
+    std::vector<cv::Mat> data, labels;
+    makeStimulus(2, data, labels);
+    cache.save(2, Database::Learn, data, labels);
+
+    std::shared_ptr<MemoryMappedFile> mapping;
+    ASSERT_EQUALS(cache.load(2, Database::Learn, data, labels, mapping), true);
+    ASSERT_TRUE(checkStimulus(2, data, labels));
+}
+
+TEST(StimuliCache, save_orphanShard)
+{
+    const std::string path = "StimuliCache/save_orphanShard";
+    clearCache(path);
+
+    // Shard left by an interrupted run, not referenced by the index
+    {
+        std::ofstream shardFile((path + "/shard_Learn_0001.bin").c_str(),
+                                std::ios::binary);
+        const std::vector<char> orphan(100, 'x');
+        shardFile.write(&orphan[0], orphan.size());
+    }
+
+    const unsigned int nbStimuli = 10;
+
+    {
+        StimuliCache cache(path, 256U);
+
+        for (unsigned int id = 0; id < nbStimuli; ++id) {
+            std::vector<cv::Mat> data, labels;
+            makeStimulus(id, data, labels);
+            cache.save(id, Database::Learn, data, labels);
+        }
+
+        for (unsigned int id = 0; id < nbStimuli; ++id) {
+            std::vector<cv::Mat> data, labels;
+            std::shared_ptr<MemoryMappedFile> mapping;
+
+            ASSERT_EQUALS(cache.load(id, Database::Learn, data, labels,
+                                     mapping), true);
+            ASSERT_TRUE(checkStimulus(id, data, labels));
+        }
+    }
+
+    StimuliCache cache(path, 256U);
+
+    for (unsigned int id = 0; id < nbStimuli; ++id) {
+        std::vector<cv::Mat> data, labels;
+        std::shared_ptr<MemoryMappedFile> mapping;
+
+        ASSERT_EQUALS(cache.isCached(id, Database::Learn), true);
+        ASSERT_EQUALS(cache.load(id, Database::Learn, data, labels, mapping),
+                      true);
+        ASSERT_TRUE(checkStimulus(id, data, labels));
+    }
+}
+
+TEST(StimuliCache, open)
+{
+    std::shared_ptr<StimuliCache> cache1 = StimuliCache::open("StimuliCache/a");
+    std::shared_ptr<StimuliCache> cache2 = StimuliCache::open("StimuliCache/a");
+    std::shared_ptr<StimuliCache> cache3 = StimuliCache::open("StimuliCache/b");
+
+    ASSERT_TRUE(cache1 == cache2);
+    ASSERT_TRUE(cache1 != cache3);
+    ASSERT_EQUALS(cache3->getPath(), "StimuliCache/b");
+}
+
+RUN_TESTS()
@@ -351,4 +351,280 @@ TEST(StimuliProvider, streamStimulus)
     }
 }
 
+class StimuliProvider_MemoryDatabase : public Database {
+public:
+    StimuliProvider_MemoryDatabase() : Database(true) {};
+
+    void addData(const cv::Mat& data, int label)
+    {
+        std::ostringstream name;
+        name << "stimulus_" << mStimuli.size();
+
+        std::ostringstream labelName;
+        labelName << label;
+
+        addStimulus(name.str(), labelName.str(), Learn);
+        mStimuliData.push_back(data);
+        mStimuliLabelsData.push_back(cv::Mat(1, 1, CV_32SC1,
+                                             cv::Scalar(labelID(labelName.str()))));
+    };
+};
+
+TEST_DATASET(StimuliProvider,
+             startPrefetch,
+             (unsigned int depth, unsigned int batchSize),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(1U, 4U),
+             std::make_tuple(4U, 4U),
+             std::make_tuple(8U, 3U))
+{
+    const unsigned int nbStimuli = 20;
+    const unsigned int nbBatches = 10;
+
+    StimuliProvider_MemoryDatabase database;
+
+    for (unsigned int i = 0; i < nbStimuli; ++i)
+        database.addData(cv::Mat(8, 8, CV_32FC1, cv::Scalar(i)), i % 3);
+
+    std::vector<int> batches;
+
+    for (unsigned int run = 0; run < 2; ++run) {
+        Random::mtSeed(0);
+
+        StimuliProvider sp(database, {8, 8, 1}, batchSize);
+        sp.setParameter("PrefetchDepth", depth);
+
+        ASSERT_EQUALS(sp.isPrefetching(Database::Learn), false);
+
+        sp.startPrefetch(Database::Learn);
+
+        ASSERT_EQUALS(sp.isPrefetching(Database::Learn), true);
+        ASSERT_EQUALS(sp.isPrefetching(Database::Test), false);
+
+        for (unsigned int b = 0; b < nbBatches; ++b) {
+            // The batches are swapped in the future buffers as well
+            if (b % 2)
+                sp.future();
+
+            sp.readRandomBatch(Database::Learn);
+            sp.synchronize();
+
+            for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+                const int id = sp.getBatch()[batchPos];
+
+                ASSERT_TRUE(id >= 0 && id < (int)nbStimuli);
+                ASSERT_EQUALS(sp.getData()[batchPos](4, 4, 0), (Float_T)id);
+                ASSERT_EQUALS(database.getLabelName(
+                                    sp.getLabelsData()[batchPos](0)),
+                              database.getLabelName(
+                                    database.getStimulusLabel(id)));
+
+                if (run == 0)
+                    batches.push_back(id);
+                else {
+                    // Reproducible regardless of the thread scheduling
+                    ASSERT_EQUALS(id, batches[b * batchSize + batchPos]);
+                }
+            }
+        }
+
+        const StimuliProvider::PrefetchStats stats = sp.getPrefetchStats();
+
+        ASSERT_EQUALS(stats.depth, depth);
+        ASSERT_EQUALS(stats.nbBatches, (unsigned long long int)nbBatches);
+        ASSERT_TRUE(stats.avgOccupancy >= 0.0
+                    && stats.avgOccupancy <= (double)depth);
+
+        sp.stopPrefetch();
+
+        ASSERT_EQUALS(sp.isPrefetching(Database::Learn), false);
+    }
+}
+
+TEST(StimuliProvider, pausePrefetch)
+{
+    const unsigned int nbStimuli = 20;
+    const unsigned int nbBatches = 6;
+    const unsigned int batchSize = 4;
+
+    StimuliProvider_MemoryDatabase database;
+
+    for (unsigned int i = 0; i < nbStimuli; ++i)
+        database.addData(cv::Mat(8, 8, CV_32FC1, cv::Scalar(i)), i % 3);
+
+    std::vector<int> batches;
+
+    for (unsigned int run = 0; run < 2; ++run) {
+        Random::mtSeed(0);
+
+        StimuliProvider sp(database, {8, 8, 1}, batchSize);
+        sp.setParameter("PrefetchDepth", 2U);
+        sp.startPrefetch(Database::Learn);
+
+        for (unsigned int b = 0; b < nbBatches; ++b) {
+            if (run == 1 && b % 2) {
+                // The producer shares the reads with the consumer
+                ASSERT_THROW(sp.readBatch(Database::Learn, 0),
+                             std::runtime_error);
+
+                sp.pausePrefetch();
+                sp.readBatch(Database::Learn, 4);
+
+                for (unsigned int batchPos = 0; batchPos < batchSize;
+                     ++batchPos)
+                {
+                    ASSERT_EQUALS(sp.getBatch()[batchPos],
+                                  (int)(4 + batchPos));
+                    ASSERT_EQUALS(sp.getData()[batchPos](4, 4, 0),
+                                  (Float_T)(4 + batchPos));
+                }
+
+                sp.resumePrefetch();
+            }
+
+            sp.readRandomBatch(Database::Learn);
+
+            for (unsigned int batchPos = 0; batchPos < batchSize; ++batchPos) {
+                const int id = sp.getBatch()[batchPos];
+
+                ASSERT_EQUALS(sp.getData()[batchPos](4, 4, 0), (Float_T)id);
+
+                if (run == 0)
+                    batches.push_back(id);
+                else {
+                    // The pauses do not change the prefetched batches
+                    ASSERT_EQUALS(id, batches[b * batchSize + batchPos]);
+                }
+            }
+        }
+
+        sp.stopPrefetch();
+    }
+}
+
+TEST_DATASET(StimuliProvider,
+             readStimulus__batchWrite,
+             (bool signedMapping),
+             std::make_tuple(false),
+             std::make_tuple(true))
+{
+    StimuliProvider_MemoryDatabase database;
+
+    cv::Mat img(8, 8, CV_8UC1);
+
+    for (int y = 0; y < img.rows; ++y) {
+        for (int x = 0; x < img.cols; ++x)
+            img.at<unsigned char>(y, x) = x + 8 * y + 100;
+    }
+
+    database.addData(img, 0);
+
+    StimuliProvider sp(database, {8, 8, 1}, 2);
+    sp.setParameter("DataSignedMapping", signedMapping);
+    sp.addChannelOnTheFlyTransformation(FlipTransformation(true, false));
+    sp.addChannelOnTheFlyTransformation(FlipTransformation(false, false));
+
+    ASSERT_EQUALS(sp.getNbChannels(), 2U);
+
+    for (unsigned int batchPos = 0; batchPos < 2; ++batchPos) {
+        sp.readStimulus(0, Database::Learn, batchPos);
+
+        // The channels are written in their batch slot
+        const Tensor<Float_T> data = sp.getData()[batchPos];
+
+        ASSERT_EQUALS(data.dimX(), 8U);
+        ASSERT_EQUALS(data.dimY(), 8U);
+        ASSERT_EQUALS(data.dimZ(), 2U);
+
+        for (unsigned int y = 0; y < 8; ++y) {
+            for (unsigned int x = 0; x < 8; ++x) {
+                const double value = img.at<unsigned char>(y, x);
+                const double flipped = img.at<unsigned char>(y, 7 - x);
+
+                ASSERT_EQUALS_DELTA(data(x, y, 0), (signedMapping)
+                    ? (flipped - 128.0) / 128.0 : flipped / 255.0, 1e-6);
+                ASSERT_EQUALS_DELTA(data(x, y, 1), (signedMapping)
+                    ? (value - 128.0) / 128.0 : value / 255.0, 1e-6);
+            }
+        }
+    }
+
+    // The database image is left unchanged
+    ASSERT_EQUALS(database.getStimulusData(0).at<unsigned char>(0, 0), 100);
+}
+
+TEST_DATASET(StimuliProvider,
+             getRandomID__sampling,
+             (std::string sampling, std::string labelsWeights,
+              double label1Ratio),
+             std::make_tuple("Uniform", "", 0.2),
+             std::make_tuple("LabelBalanced", "", 0.5),
+             std::make_tuple("LabelWeighted", "1.0 3.0", 0.75),
+             std::make_tuple("LabelWeighted", "0.0", 1.0))
+{
+    Random::mtSeed(0);
+
+    StimuliProvider_MemoryDatabase database;
+
+    // 16 stimuli with label 0 and 4 stimuli with label 1
+    for (unsigned int i = 0; i < 20; ++i)
+        database.addData(cv::Mat(8, 8, CV_32FC1, cv::Scalar(i)), i / 16);
+
+    StimuliProvider sp(database, {8, 8, 1});
+    sp.setParameter("Sampling", sampling);
+    sp.setParameter("LabelsWeights", labelsWeights);
+
+    const unsigned int nbDraws = 10000;
+    unsigned int nbLabel1 = 0;
+
+    for (unsigned int i = 0; i < nbDraws; ++i) {
+        const Database::StimulusID id = sp.getRandomID(Database::Learn);
+
+        ASSERT_TRUE(id < 20U);
+
+        if (database.getStimulusLabel(id) == database.getLabelID("1"))
+            ++nbLabel1;
+    }
+
+    ASSERT_EQUALS_DELTA(nbLabel1 / (double)nbDraws, label1Ratio, 0.02);
+
+    const Database::StimulusID id
+        = sp.getRandomIDWithLabel(Database::Learn, database.getLabelID("1"));
+
+    ASSERT_TRUE(id >= 16U && id < 20U);
+}
+
+TEST(StimuliProvider, getRandomID__epochShuffle)
+{
+    Random::mtSeed(0);
+
+    StimuliProvider_MemoryDatabase database;
+
+    for (unsigned int i = 0; i < 20; ++i)
+        database.addData(cv::Mat(8, 8, CV_32FC1, cv::Scalar(i)), i % 3);
+
+    StimuliProvider sp(database, {8, 8, 1});
+    sp.setParameter("Sampling", std::string("EpochShuffle"));
+    sp.setParameter("EpochShardSize", 4U);
+    sp.setParameter("EpochBufferSize", 6U);
+
+    std::vector<Database::StimulusID> prevEpoch;
+
+    for (unsigned int epoch = 0; epoch < 3; ++epoch) {
+        std::vector<Database::StimulusID> ids;
+
+        for (unsigned int i = 0; i < 20; ++i)
+            ids.push_back(sp.getRandomID(Database::Learn));
+
+        ASSERT_TRUE(ids != prevEpoch);
+        prevEpoch = ids;
+
+        // Each epoch draws every stimulus once
+        std::sort(ids.begin(), ids.end());
+
+        for (unsigned int i = 0; i < ids.size(); ++i)
+            ASSERT_EQUALS(ids[i], i);
+    }
+}
+
 RUN_TESTS()
@@ -0,0 +1,187 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "Synapse_Static.hpp"
+#include "SynapseStore_Static.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST(SynapseStore_Static, push_back)
+{
+    SynapseStore_Static store(true);
+
+    ASSERT_EQUALS(store.size(), 0U);
+    ASSERT_TRUE(store.empty());
+
+    store.push_back(Synapse_Static(true, 0, 0.5));
+    store.push_back(Synapse_Static(true, 0, -0.25));
+
+    ASSERT_EQUALS(store.size(), 2U);
+    ASSERT_TRUE(store.isBipolar());
+    ASSERT_TRUE(!store.hasDelays());
+    ASSERT_EQUALS(store.getDelay(1), 0U);
+    ASSERT_EQUALS(store.getWeight(0), 0.5);
+    ASSERT_EQUALS(store.getWeight(1), -0.25);
+    ASSERT_EQUALS(store.getRelativeWeight(1), 0.375);
+    ASSERT_EQUALS(store.getRelativeWeight(1, true), -0.25);
+
+    // The delays array is allocated on the first non-zero delay
+    store.push_back(Synapse_Static(true, 10 * TimePs, 1.0));
+
+    ASSERT_TRUE(store.hasDelays());
+    ASSERT_EQUALS(store.getDelay(0), 0U);
+    ASSERT_EQUALS(store.getDelay(1), 0U);
+    ASSERT_EQUALS(store.getDelay(2), 10 * TimePs);
+    ASSERT_EQUALS(store.getMinDelay(), 0U);
+
+    ASSERT_THROW(store.push_back(Synapse_Static(false, 0, 0.5)),
+                 std::domain_error);
+
+    // ... including when it is the delay of the first synapse
+    SynapseStore_Static storeDelays(true);
+    storeDelays.push_back(Synapse_Static(true, 5 * TimePs, 0.5));
+    storeDelays.push_back(Synapse_Static(true, 0, 0.5));
+
+    ASSERT_TRUE(storeDelays.hasDelays());
+    ASSERT_EQUALS(storeDelays.getDelay(0), 5 * TimePs);
+    ASSERT_EQUALS(storeDelays.getDelay(1), 0U);
+
+    ASSERT_EQUALS(storeDelays.getMinDelay(), 0U);
+
+    SynapseStore_Static storeMinDelay(true);
+    storeMinDelay.push_back(Synapse_Static(true, 5 * TimePs, 0.5));
+    storeMinDelay.push_back(Synapse_Static(true, 2 * TimePs, 0.5));
+    storeMinDelay.push_back(Synapse_Static(true, 7 * TimePs, 0.5));
+
+    ASSERT_EQUALS(storeMinDelay.getMinDelay(), 2 * TimePs);
+    ASSERT_EQUALS(SynapseStore_Static(true).getMinDelay(), 0U);
+}
+
+TEST(SynapseStore_Static, setRelativeWeight)
+{
+    SynapseStore_Static store(true);
+    store.push_back(Synapse_Static(true, 0, 0.0));
+
+    store.setRelativeWeight(0, -0.75);
+    ASSERT_EQUALS(store.getWeight(0), -0.75);
+
+    ASSERT_THROW(store.setRelativeWeight(0, 1.5), std::domain_error);
+    ASSERT_THROW(store.setRelativeWeight(0, -1.5), std::domain_error);
+}
+
+TEST(SynapseStore_Static, read)
+{
+    SynapseStore_Static store(true, true);
+    store.push_back(Synapse_Static(true, 0, 0.5));
+    store.push_back(Synapse_Static(true, 0, 0.25));
+
+    ASSERT_EQUALS(store.read(1), 0.25);
+    ASSERT_EQUALS(store.read(1), 0.25);
+    ASSERT_EQUALS(store.read(0), 0.5);
+
+    Synapse::Stats stats;
+    store.getStats(0, &stats);
+    store.getStats(1, &stats);
+
+    ASSERT_EQUALS(stats.nbSynapses, 2U);
+    ASSERT_EQUALS(stats.readEvents, 3ULL);
+    ASSERT_EQUALS(stats.maxReadEvents, 2ULL);
+
+    store.clearStats();
+
+    Synapse::Stats statsCleared;
+    store.getStats(1, &statsCleared);
+
+    ASSERT_EQUALS(statsCleared.readEvents, 0ULL);
+
+    // Without stats, the read events are not counted
+    SynapseStore_Static storeNoStats(true, false);
+    storeNoStats.push_back(Synapse_Static(true, 0, 0.5));
+
+    ASSERT_TRUE(!storeNoStats.hasStats());
+    ASSERT_EQUALS(storeNoStats.read(0), 0.5);
+
+    Synapse::Stats statsNoStats;
+    storeNoStats.getStats(0, &statsNoStats);
+
+    ASSERT_EQUALS(statsNoStats.nbSynapses, 1U);
+    ASSERT_EQUALS(statsNoStats.readEvents, 0ULL);
+}
+
+TEST(SynapseStore_Static, save__load)
+{
+    // The store file format must be the same as the one of consecutive
+    // Synapse_Static::saveInternal() calls
+    std::vector<Synapse_Static> synapses;
+    synapses.push_back(Synapse_Static(true, 0, 0.5));
+    synapses.push_back(Synapse_Static(true, 3 * TimePs, -0.125));
+    synapses.push_back(Synapse_Static(true, 1 * TimeFs, 0.75));
+
+    {
+        std::ofstream syn("SynapseStore_Static_save__load.syn",
+                          std::fstream::binary);
+
+        for (std::vector<Synapse_Static>::const_iterator it
+             = synapses.begin(), itEnd = synapses.end(); it != itEnd; ++it)
+        {
+            (*it).saveInternal(syn);
+        }
+    }
+
+    SynapseStore_Static store(true);
+
+    for (unsigned int i = 0; i < 3; ++i)
+        store.push_back(Synapse_Static(true, 0, 0.0));
+
+    ASSERT_TRUE(!store.hasDelays());
+
+    {
+        std::ifstream syn("SynapseStore_Static_save__load.syn",
+                          std::fstream::binary);
+        store.load(syn);
+    }
+
+    for (unsigned int i = 0; i < 3; ++i) {
+        ASSERT_EQUALS(store.getDelay(i), synapses[i].delay);
+        ASSERT_EQUALS(store.getWeight(i), synapses[i].weight);
+    }
+
+    {
+        std::ofstream syn("SynapseStore_Static_save__load_store.syn",
+                          std::fstream::binary);
+        store.save(syn);
+    }
+
+    std::ifstream syn("SynapseStore_Static_save__load_store.syn",
+                      std::fstream::binary);
+
+    for (unsigned int i = 0; i < 3; ++i) {
+        Synapse_Static synapse(true, 0, 0.0);
+        synapse.loadInternal(syn);
+
+        ASSERT_EQUALS(synapse.delay, synapses[i].delay);
+        ASSERT_EQUALS(synapse.weight, synapses[i].weight);
+    }
+
+    ASSERT_TRUE(syn.get() == std::fstream::traits_type::eof());
+}
+
+RUN_TESTS()
@@ -0,0 +1,89 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "TransformationsProfile.hpp"
+#include "utils/UnitTest.hpp"
+
+#include <sstream>
+
+using namespace N2D2;
+
+TEST(TransformationsProfile, add)
+{
+    TransformationsProfile profile;
+    ASSERT_TRUE(profile.empty());
+
+    profile.add("OnTheFly", "Flip", 0.5, 100);
+    profile.add("OnTheFly", "Flip", 1.5, 300);
+    profile.add("OnTheFly", "*", 3.0, 400);
+
+    ASSERT_TRUE(!profile.empty());
+    ASSERT_EQUALS(profile.getEntries().size(), 2U);
+
+    const TransformationsProfile::Entry& entry = profile.getEntries()
+        .at(std::make_pair(std::string("OnTheFly"), std::string("Flip")));
+
+    ASSERT_EQUALS(entry.nbCalls, 2U);
+    ASSERT_EQUALS_DELTA(entry.time, 2.0, 1.0e-12);
+    ASSERT_EQUALS(entry.nbBytes, 400U);
+
+    profile.clear();
+    ASSERT_TRUE(profile.empty());
+}
+
+TEST(TransformationsProfile, merge)
+{
+    TransformationsProfile profile1;
+    profile1.add("Load", "Database", 1.0, 1000);
+    profile1.add("Cacheable", "Rescale", 2.0, 500);
+
+    TransformationsProfile profile2;
+    profile2.add("Load", "Database", 0.5, 1000);
+    profile2.add("Load", "Cache", 0.25, 200);
+
+    profile1.merge(profile2);
+
+    ASSERT_EQUALS(profile1.getEntries().size(), 3U);
+
+    const TransformationsProfile::Entry& entry = profile1.getEntries()
+        .at(std::make_pair(std::string("Load"), std::string("Database")));
+
+    ASSERT_EQUALS(entry.nbCalls, 2U);
+    ASSERT_EQUALS_DELTA(entry.time, 1.5, 1.0e-12);
+    ASSERT_EQUALS(entry.nbBytes, 2000U);
+}
+
+TEST(TransformationsProfile, log)
+{
+    TransformationsProfile profile;
+    profile.add("Tensor", "Conversion", 2.0, 4 * 1024 * 1024);
+    profile.add("Tensor", "Conversion", 2.0, 4 * 1024 * 1024);
+
+    std::ostringstream csv;
+    TransformationsProfile::logHeader(csv, "Thread,");
+    profile.log(csv, "All,");
+
+    ASSERT_EQUALS(csv.str(),
+        "Thread,Stage,Name,Calls,Time(s),Bytes,TimePerCall(s),"
+            "Throughput(MB/s)\n"
+        "All,Tensor,Conversion,2,4,8388608,2,2\n");
+}
+
+RUN_TESTS()
@@ -457,6 +457,49 @@ TEST_DATASET(Tensor3d,
     }
 }
 
+TEST_DATASET(Tensor3d,
+             Tensor3d__convertFrom,
+             (unsigned int dimX, unsigned int dimY, bool signedMapping),
+             std::make_tuple(1U, 1U, false),
+             std::make_tuple(3U, 1U, false),
+             std::make_tuple(12U, 34U, false),
+             std::make_tuple(1U, 1U, true),
+             std::make_tuple(3U, 1U, true),
+             std::make_tuple(12U, 34U, true))
+{
+    const unsigned int dimZ = 3;
+    const unsigned int batchSize = 3;
+
+    cv::Mat mat(cv::Size(dimX, dimY), CV_8UC3);
+
+    for (unsigned int i = 0; i < dimX; ++i) {
+        for (unsigned int j = 0; j < dimY; ++j) {
+            for (unsigned int k = 0; k < dimZ; ++k)
+                mat.ptr<unsigned char>(j)[i * dimZ + k] = (i + j + 64 * k);
+        }
+    }
+
+    Tensor<float> A({dimX, dimY, dimZ, batchSize}, -1.0f);
+    Tensor<float> slot = A[1];
+    slot.convertFrom(mat, signedMapping);
+
+    for (unsigned int i = 0; i < dimX; ++i) {
+        for (unsigned int j = 0; j < dimY; ++j) {
+            for (unsigned int k = 0; k < dimZ; ++k) {
+                const double value = mat.ptr<unsigned char>(j)[i * dimZ + k];
+
+                ASSERT_EQUALS(A(i, j, k, 0), -1.0f);
+                ASSERT_EQUALS_DELTA(A(i, j, k, 1), (signedMapping)
+                    ? (value - 128.0) / 128.0 : value / 255.0, 1e-6);
+                ASSERT_EQUALS(A(i, j, k, 2), -1.0f);
+            }
+        }
+    }
+
+    Tensor<float> B({dimX + 1, dimY, dimZ});
+    ASSERT_THROW_ANY(B.convertFrom(mat));
+}
+
 TEST_DATASET(Tensor3d,
              Tensor3d__toCV,
              (unsigned int dimX, unsigned int dimY, unsigned int dimZ),
@@ -0,0 +1,164 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/TaskGraph.hpp"
+#include "utils/UnitTest.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace N2D2;
+
+TEST(TaskGraph, TaskGraph)
+{
+    TaskGraph graph;
+
+    ASSERT_EQUALS(graph.getNbNodes(), 0U);
+    ASSERT_EQUALS(graph.addNode(), 0U);
+    ASSERT_EQUALS(graph.addNode(), 1U);
+    ASSERT_EQUALS(graph.getNbNodes(), 2U);
+    ASSERT_THROW(graph.addEdge(0, 2), std::out_of_range);
+    ASSERT_THROW(graph.addEdge(1, 1), std::runtime_error);
+}
+
+TEST_DATASET(TaskGraph,
+             run,
+             (unsigned int nbBranches, unsigned int depth),
+             std::make_tuple(1U, 1U),
+             std::make_tuple(1U, 10U),
+             std::make_tuple(4U, 1U),
+             std::make_tuple(4U, 5U),
+             std::make_tuple(16U, 3U))
+{
+    // Inception-like graph: a root node, nbBranches chains of depth nodes,
+    // and a final node joining the branches
+    TaskGraph graph;
+    const unsigned int root = graph.addNode();
+    std::vector<unsigned int> lasts;
+
+    for (unsigned int branch = 0; branch < nbBranches; ++branch) {
+        unsigned int prev = root;
+
+        for (unsigned int d = 0; d < depth; ++d) {
+            const unsigned int node = graph.addNode();
+            graph.addEdge(prev, node);
+            prev = node;
+        }
+
+        lasts.push_back(prev);
+    }
+
+    const unsigned int join = graph.addNode();
+
+    for (unsigned int branch = 0; branch < nbBranches; ++branch)
+        graph.addEdge(lasts[branch], join);
+
+    std::vector<unsigned int> order(graph.getNbNodes(), 0U);
+    std::vector<unsigned int> nbRuns(graph.getNbNodes(), 0U);
+    unsigned int counter = 0;
+
+    graph.run([&](unsigned int node) {
+        unsigned int pos;
+
+#pragma omp atomic capture
+        pos = counter++;
+
+        order[node] = pos;
+        ++nbRuns[node];
+    });
+
+    ASSERT_EQUALS(counter, graph.getNbNodes());
+
+    for (unsigned int node = 0; node < graph.getNbNodes(); ++node)
+        ASSERT_EQUALS(nbRuns[node], 1U);
+
+    // Each node runs after its predecessor
+    ASSERT_EQUALS(order[root], 0U);
+    ASSERT_EQUALS(order[join], graph.getNbNodes() - 1);
+
+    for (unsigned int node = 1; node < join; ++node) {
+        const unsigned int d = (node - 1) % depth;
+        const unsigned int prev = (d == 0) ? root : node - 1;
+        ASSERT_TRUE(order[prev] < order[node]);
+    }
+}
+
+TEST(TaskGraph, run_nested)
+{
+    TaskGraph graph(4);
+    std::vector<unsigned int> sums(graph.getNbNodes(), 0U);
+
+    graph.run([&](unsigned int node) {
+        unsigned int sum = 0;
+
+#pragma omp parallel for reduction(+:sum)
+        for (int i = 0; i < 1000; ++i)
+            sum += i;
+
+        sums[node] = sum;
+    });
+
+    for (unsigned int node = 0; node < graph.getNbNodes(); ++node)
+        ASSERT_EQUALS(sums[node], 499500U);
+
+#ifdef _OPENMP
+    // The nested parallelism is restored
+    ASSERT_EQUALS(omp_get_level(), 0);
+#endif
+}
+
+TEST(TaskGraph, run_exception)
+{
+    TaskGraph graph(3);
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+
+    std::vector<unsigned int> nbRuns(graph.getNbNodes(), 0U);
+
+    ASSERT_THROW(graph.run([&](unsigned int node) {
+        ++nbRuns[node];
+
+        if (node == 1)
+            throw std::runtime_error("node 1");
+    }), std::runtime_error);
+
+    ASSERT_EQUALS(nbRuns[0], 1U);
+    ASSERT_EQUALS(nbRuns[1], 1U);
+    ASSERT_EQUALS(nbRuns[2], 0U);
+}
+
+TEST(TaskGraph, run_cycle)
+{
+    TaskGraph graph(3);
+    graph.addEdge(0, 1);
+    graph.addEdge(1, 2);
+    graph.addEdge(2, 1);
+
+    unsigned int nbRuns = 0;
+
+    ASSERT_THROW(graph.run([&](unsigned int /*node*/) {
+        ++nbRuns;
+    }), std::runtime_error);
+
+    ASSERT_EQUALS(nbRuns, 1U);
+}
+
+RUN_TESTS()
@@ -0,0 +1,159 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "utils/Random.hpp"
+#include "utils/TimingWheel.hpp"
+#include "utils/UnitTest.hpp"
+
+#include <queue>
+
+using namespace N2D2;
+
+struct TimingWheel_Event {
+    unsigned long long int timestamp;
+    // Events with a destination are released first at the same timestamp,
+    // as with N2D2::SpikeEvent
+    bool internal;
+    unsigned int id;
+
+    bool operator<(const TimingWheel_Event& event) const
+    {
+        return (timestamp > event.timestamp
+                || (timestamp == event.timestamp
+                    && (internal > event.internal
+                        || (internal == event.internal && id > event.id))));
+    }
+};
+
+struct TimingWheel_Timestamp {
+    unsigned long long int operator()(const TimingWheel_Event& event) const
+    {
+        return event.timestamp;
+    }
+};
+
+typedef TimingWheel<TimingWheel_Event, std::less<TimingWheel_Event>,
+                    TimingWheel_Timestamp> TimingWheel_T;
+
+TEST(TimingWheel, TimingWheel)
+{
+    TimingWheel_T wheel(10, 16);
+
+    ASSERT_EQUALS(wheel.getResolution(), 10ULL);
+    ASSERT_EQUALS(wheel.getNbSlots(), 16U);
+    ASSERT_EQUALS(wheel.size(), 0U);
+    ASSERT_TRUE(wheel.empty());
+
+    ASSERT_THROW(TimingWheel_T(0, 16), std::domain_error);
+    ASSERT_THROW(TimingWheel_T(10, 12), std::domain_error);
+    ASSERT_THROW(TimingWheel_T(10, 1), std::domain_error);
+}
+
+TEST_DATASET(TimingWheel,
+             pop,
+             (unsigned long long int resolution,
+              unsigned int nbSlots,
+              unsigned long long int maxDelay),
+             std::make_tuple(1ULL, 2U, 10ULL),
+             std::make_tuple(1ULL, 1024U, 10ULL),
+             std::make_tuple(10ULL, 16U, 100ULL),
+             std::make_tuple(10ULL, 16U, 100000ULL),
+             std::make_tuple(1000ULL, 4096U, 10ULL))
+{
+    Random::mtSeed(0);
+
+    // Same sequence of push() and pop() on a std::priority_queue and on the
+    // timing wheel. New events are pushed after each pop(), at or after the
+    // current time, like in Network::run().
+    std::priority_queue<TimingWheel_Event> queue;
+    TimingWheel_T wheel(resolution, nbSlots);
+    unsigned int id = 0;
+
+    for (unsigned int i = 0; i < 100; ++i) {
+        TimingWheel_Event event;
+        event.timestamp = Random::randUniform(0, (int)maxDelay);
+        event.internal = (Random::randUniform(0, 1) == 1);
+        event.id = id++;
+
+        queue.push(event);
+        wheel.push(event);
+    }
+
+    unsigned long long int lastTimestamp = 0;
+
+    while (!queue.empty()) {
+        ASSERT_EQUALS(wheel.size(), queue.size());
+        ASSERT_EQUALS(wheel.top().id, queue.top().id);
+
+        const TimingWheel_Event top = queue.top();
+        ASSERT_TRUE(top.timestamp >= lastTimestamp);
+        lastTimestamp = top.timestamp;
+
+        queue.pop();
+        wheel.pop();
+
+        if (id < 10000) {
+            const unsigned int nbNew = Random::randUniform(0, 2);
+
+            for (unsigned int n = 0; n < nbNew; ++n) {
+                TimingWheel_Event event;
+                event.timestamp = top.timestamp
+                    + Random::randUniform(0, (int)maxDelay);
+                event.internal = (Random::randUniform(0, 1) == 1);
+                event.id = id++;
+
+                queue.push(event);
+                wheel.push(event);
+            }
+        }
+    }
+
+    ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimingWheel, push__past)
+{
+    TimingWheel_T wheel(10, 16);
+
+    TimingWheel_Event event;
+    event.internal = false;
+    event.id = 0;
+    event.timestamp = 1000;
+    wheel.push(event);
+
+    ASSERT_EQUALS(wheel.top().timestamp, 1000ULL);
+
+    // An event in the past is popped next, as with a std::priority_queue
+    event.id = 1;
+    event.timestamp = 500;
+    wheel.push(event);
+
+    ASSERT_EQUALS(wheel.top().id, 1U);
+    wheel.pop();
+    ASSERT_EQUALS(wheel.top().id, 0U);
+    wheel.pop();
+    ASSERT_TRUE(wheel.empty());
+
+    wheel.push(event);
+    wheel.clear();
+    ASSERT_TRUE(wheel.empty());
+}
+
+RUN_TESTS()
@@ -0,0 +1,244 @@
+/*
+    (C) Copyright 2019 CEA LIST. All Rights Reserved.
+    Contributor(s): Olivier BICHLER (olivier.bichler@cea.fr)
+
+    This software is governed by the CeCILL-C license under French law and
+    abiding by the rules of distribution of free software.  You can  use,
+    modify and/ or redistribute the software under the terms of the CeCILL-C
+    license as circulated by CEA, CNRS and INRIA at the following URL
+    "http://www.cecill.info".
+
+    As a counterpart to the access to the source code and  rights to copy,
+    modify and redistribute granted by the license, users are provided only
+    with a limited warranty  and the software's author,  the holder of the
+    economic rights,  and the successive licensors  have only  limited
+    liability.
+
+    The fact that you are presently reading this means that you have had
+    knowledge of the CeCILL-C license and that you accept its terms.
+*/
+
+#include "N2D2.hpp"
+
+#include "utils/Gemm.hpp"
+#include "utils/Random.hpp"
+#include "utils/UnitTest.hpp"
+
+using namespace N2D2;
+
+TEST_DATASET(Gemm,
+             gemm,
+             (bool transA,
+              bool transB,
+              unsigned int M,
+              unsigned int N,
+              unsigned int K,
+              double alpha,
+              double beta),
+             std::make_tuple(false, false, 1U, 1U, 1U, 1.0, 0.0),
+             std::make_tuple(false, false, 4U, 8U, 9U, 1.0, 0.0),
+             std::make_tuple(false, false, 5U, 13U, 7U, 0.5, 1.0),
+             std::make_tuple(true, false, 37U, 29U, 300U, 1.0, 0.5),
+             std::make_tuple(false, true, 130U, 17U, 260U, 2.0, 1.0),
+             std::make_tuple(true, true, 3U, 1030U, 11U, 1.0, -1.0),
+             std::make_tuple(false, false, 150U, 1100U, 513U, 1.0, 0.0))
+{
+    Random::mtSeed(0);
+
+    std::vector<double> A(M * K);
+    std::vector<double> B(K * N);
+    std::vector<double> C(M * N);
+
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = Random::randUniform(-1.0, 1.0);
+
+    std::vector<double> result(C);
+    std::vector<double> workspace;
+
+    Gemm::gemm((transA) ? Gemm::Trans : Gemm::NoTrans,
+               (transB) ? Gemm::Trans : Gemm::NoTrans,
+               M, N, K,
+               alpha, &A[0], (transA) ? M : K,
+               &B[0], (transB) ? K : N,
+               beta, &result[0], N,
+               workspace);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int j = 0; j < N; ++j) {
+            double sum = 0.0;
+
+            for (unsigned int k = 0; k < K; ++k) {
+                sum += ((transA) ? A[k * M + i] : A[i * K + k])
+                       * ((transB) ? B[j * K + k] : B[k * N + j]);
+            }
+
+            ASSERT_EQUALS_DELTA(result[i * N + j],
+                                alpha * sum + beta * C[i * N + j],
+                                1.0e-12);
+        }
+    }
+}
+
+TEST_DATASET(Gemm,
+             gemmParallel,
+             (bool transA,
+              bool transB,
+              unsigned int M,
+              unsigned int N,
+              unsigned int K),
+             std::make_tuple(false, false, 1U, 1U, 1U),
+             std::make_tuple(false, true, 32U, 1000U, 300U),
+             std::make_tuple(true, false, 1000U, 3U, 40U),
+             std::make_tuple(true, true, 77U, 65U, 513U))
+{
+    Random::mtSeed(0);
+
+    std::vector<double> A(M * K);
+    std::vector<double> B(K * N);
+    std::vector<double> C(M * N);
+
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = Random::randUniform(-1.0, 1.0);
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = Random::randUniform(-1.0, 1.0);
+
+    std::vector<double> result(C);
+    std::vector<double> workspace;
+
+    Gemm::gemm((transA) ? Gemm::Trans : Gemm::NoTrans,
+               (transB) ? Gemm::Trans : Gemm::NoTrans,
+               M, N, K,
+               1.0, &A[0], (transA) ? M : K,
+               &B[0], (transB) ? K : N,
+               0.5, &result[0], N,
+               workspace);
+
+    std::vector<double> resultParallel(C);
+    std::vector<std::vector<double> > workspaces;
+
+    Gemm::gemmParallel((transA) ? Gemm::Trans : Gemm::NoTrans,
+                       (transB) ? Gemm::Trans : Gemm::NoTrans,
+                       M, N, K,
+                       1.0, &A[0], (transA) ? M : K,
+                       &B[0], (transB) ? K : N,
+                       0.5, &resultParallel[0], N,
+                       workspaces);
+
+    for (unsigned int i = 0; i < result.size(); ++i)
+        ASSERT_EQUALS(resultParallel[i], result[i]);
+}
+
+TEST_DATASET(Gemm,
+             gemm_half,
+             (bool transA,
+              bool transB,
+              unsigned int M,
+              unsigned int N,
+              unsigned int K,
+              double beta),
+             std::make_tuple(false, false, 5U, 13U, 7U, 0.0),
+             std::make_tuple(true, false, 37U, 29U, 300U, 0.5),
+             std::make_tuple(false, true, 20U, 1030U, 600U, 1.0),
+             std::make_tuple(true, true, 3U, 17U, 11U, -1.0))
+{
+    Random::mtSeed(0);
+
+    std::vector<half_float::half> A(M * K);
+    std::vector<half_float::half> B(K * N);
+    std::vector<half_float::half> C(M * N);
+
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = half_float::half(Random::randUniform(-1.0, 1.0));
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = half_float::half(Random::randUniform(-1.0, 1.0));
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = half_float::half(Random::randUniform(-1.0, 1.0));
+
+    std::vector<half_float::half> result(C);
+    std::vector<half_float::half> workspace;
+
+    Gemm::gemm((transA) ? Gemm::Trans : Gemm::NoTrans,
+               (transB) ? Gemm::Trans : Gemm::NoTrans,
+               M, N, K,
+               half_float::half(1.0), &A[0], (transA) ? M : K,
+               &B[0], (transB) ? K : N,
+               half_float::half(beta), &result[0], N,
+               workspace);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int j = 0; j < N; ++j) {
+            double sum = 0.0;
+
+            for (unsigned int k = 0; k < K; ++k) {
+                sum += (double)((transA) ? A[k * M + i] : A[i * K + k])
+                       * (double)((transB) ? B[j * K + k] : B[k * N + j]);
+            }
+
+            const double expected = sum + beta * (double)C[i * N + j];
+
+            // Accumulation in float: only the final rounding to half
+            ASSERT_EQUALS_DELTA((double)result[i * N + j], expected,
+                                1.0e-3 * std::max(1.0, std::fabs(expected)));
+        }
+    }
+}
+
+TEST_DATASET(Gemm,
+             gemmInt8,
+             (unsigned int M,
+              unsigned int N,
+              unsigned int K),
+             std::make_tuple(1U, 1U, 1U),
+             std::make_tuple(5U, 13U, 7U),
+             std::make_tuple(64U, 4U, 33U),
+             std::make_tuple(70U, 130U, 300U),
+             std::make_tuple(1000U, 3U, 1025U))
+{
+    Random::mtSeed(0);
+
+    std::vector<int8_t> A(M * K);
+    std::vector<uint8_t> B(N * K);
+    std::vector<int32_t> C(M * N);
+
+    for (unsigned int i = 0; i < A.size(); ++i)
+        A[i] = (int8_t)Random::randUniform(-128, 127);
+
+    for (unsigned int i = 0; i < B.size(); ++i)
+        B[i] = (uint8_t)Random::randUniform(0, 255);
+
+    for (unsigned int i = 0; i < C.size(); ++i)
+        C[i] = (int32_t)Random::randUniform(-1000, 1000);
+
+    std::vector<int32_t> result(C);
+    Gemm::gemmInt8(M, N, K, &A[0], K, &B[0], K, &result[0], N);
+
+    std::vector<int32_t> resultParallel(C);
+    Gemm::gemmInt8Parallel(M, N, K, &A[0], K, &B[0], K,
+                           &resultParallel[0], N);
+
+    for (unsigned int i = 0; i < M; ++i) {
+        for (unsigned int j = 0; j < N; ++j) {
+            int32_t sum = C[i * N + j];
+
+            for (unsigned int k = 0; k < K; ++k)
+                sum += (int32_t)A[i * K + k] * (int32_t)B[j * K + k];
+
+            ASSERT_EQUALS(result[i * N + j], sum);
+            ASSERT_EQUALS(resultParallel[i * N + j], sum);
+        }
+    }
+}
+
+RUN_TESTS()
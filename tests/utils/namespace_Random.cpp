@@ -18,6 +18,7 @@
     knowledge of the CeCILL-C license and that you accept its terms.
 */
 
+#include "Filler/UniformFiller.hpp"
 #include "utils/Random.hpp"
 #include "utils/UnitTest.hpp"
 
@@ -70,4 +71,154 @@ TEST(Random, mtRand)
         ASSERT_EQUALS(Random::mtRand(), mtRand_0xFFFFFFFF[i]);
 }
 
+TEST(Random, Stream)
+{
+    // Philox4x32-10 known answer test, from the Random123 library
+    Random::Stream stream(0, 0);
+    const unsigned int philox_0[] = {0x6627e8d5, 0xe169c58d,
+                                     0xbc57ac4c, 0x9b00dbd8};
+
+    for (unsigned int i = 0, size = sizeof(philox_0) / sizeof(philox_0[0]);
+         i < size;
+         ++i)
+        ASSERT_EQUALS(stream.rand(), philox_0[i]);
+
+    // The sequence only depends on the key
+    Random::Stream stream1(42, 1);
+    Random::Stream stream1Copy(42, 1);
+    Random::Stream stream2(42, 2);
+    unsigned int nbEquals = 0;
+
+    for (unsigned int i = 0; i < 1000; ++i) {
+        const unsigned int value = stream1.rand();
+        ASSERT_EQUALS(stream1Copy.rand(), value);
+
+        if (stream2.rand() == value)
+            ++nbEquals;
+    }
+
+    ASSERT_TRUE(nbEquals < 2);
+}
+
+TEST(Random, Stream_fill)
+{
+    const unsigned int size = 100001;
+
+    std::vector<double> uniform(size);
+    Random::Stream(1, 0).fillUniform(uniform.begin(), uniform.end(),
+                                     -1.0, 3.0);
+
+    std::vector<double> normal(size);
+    Random::Stream(1, 1).fillNormal(normal.begin(), normal.end(), 2.0, 0.5);
+
+    std::vector<bool> bernoulli(size);
+    Random::Stream(1, 2).fillBernoulli(bernoulli.begin(), bernoulli.end(),
+                                       0.3);
+
+    double sumUniform = 0.0;
+    double sumNormal = 0.0;
+    double sumSqNormal = 0.0;
+    unsigned int nbTrue = 0;
+
+    for (unsigned int i = 0; i < size; ++i) {
+        ASSERT_TRUE(uniform[i] >= -1.0 && uniform[i] <= 3.0);
+
+        sumUniform += uniform[i];
+        sumNormal += normal[i];
+        sumSqNormal += normal[i] * normal[i];
+
+        if (bernoulli[i])
+            ++nbTrue;
+    }
+
+    const double meanNormal = sumNormal / size;
+
+    ASSERT_EQUALS_DELTA(sumUniform / size, 1.0, 0.02);
+    ASSERT_EQUALS_DELTA(meanNormal, 2.0, 0.01);
+    ASSERT_EQUALS_DELTA(std::sqrt(sumSqNormal / size
+                                  - meanNormal * meanNormal), 0.5, 0.01);
+    ASSERT_EQUALS_DELTA(nbTrue / (double)size, 0.3, 0.01);
+
+    // Same results as the scalar Bernoulli generation
+    Random::Stream stream(1, 2);
+
+    for (unsigned int i = 0; i < 1000; ++i)
+        ASSERT_EQUALS(stream.randBernoulli(0.3), (bool)bernoulli[i]);
+}
+
+TEST(Random, ThreadStream)
+{
+    const unsigned int size = 64;
+    std::vector<double> values(size);
+    std::vector<double> valuesParallel(size);
+
+    Random::mtSeed(1);
+    const unsigned int seed = Random::mtRand();
+
+    for (unsigned int i = 0; i < size; ++i) {
+        Random::ThreadStream stream(seed, i);
+        values[i] = Random::randUniform() + Random::randNormal();
+    }
+
+#pragma omp parallel for
+    for (int i = 0; i < (int)size; ++i) {
+        Random::ThreadStream stream(seed, i);
+        valuesParallel[i] = Random::randUniform() + Random::randNormal();
+    }
+
+    for (unsigned int i = 0; i < size; ++i)
+        ASSERT_EQUALS(valuesParallel[i], values[i]);
+
+    // The global generator is left untouched
+    Random::mtSeed(1);
+    ASSERT_EQUALS(Random::mtRand(), seed);
+    ASSERT_EQUALS(Random::mtRand(), 4282876139U);
+}
+
+TEST(Random, ThreadStream__redirect)
+{
+    Random::Stream stream(3, 4);
+    Random::Stream streamRef(3, 4);
+
+    {
+        Random::ThreadStream redirect(&stream);
+        ASSERT_EQUALS(Random::randUniform(), streamRef.randUniform());
+
+        // A NULL stream keeps the current generator
+        Random::ThreadStream keep(NULL);
+        ASSERT_EQUALS(Random::randNormal(), streamRef.randNormal());
+    }
+
+    // The state of the stream is kept
+    ASSERT_EQUALS(stream.rand(), streamRef.rand());
+
+    // The global generator is used again
+    Random::mtSeed(1);
+    ASSERT_EQUALS(Random::mtRand(), 1791095845U);
+}
+
+TEST(Random, ThreadStream__filler)
+{
+    Tensor<double> weights({4, 3});
+    UniformFiller<double> filler(-1.0, 1.0);
+
+    // The fillers draw from the global generator by default
+    Random::mtSeed(1);
+    filler.apply(weights);
+    Random::mtSeed(1);
+
+    for (unsigned int i = 0; i < weights.size(); ++i)
+        ASSERT_EQUALS(weights(i), Random::randUniform(-1.0, 1.0));
+
+    {
+        Random::ThreadStream stream(5, 6);
+        filler.apply(weights);
+    }
+
+    Random::Stream streamRef(5, 6);
+
+    for (unsigned int i = 0; i < weights.size(); ++i)
+        ASSERT_EQUALS(weights(i), streamRef.randUniform(-1.0, 1.0));
+}
+
 RUN_TESTS()